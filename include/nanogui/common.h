@@ -163,27 +163,40 @@ class GLFramebuffer;
 class GLShader;
 class GridLayout;
 class GroupLayout;
+class Heatmap;
+class ImageFileList;
+class ImageLoader;
 class ImagePanel;
+class ImageSource;
 class ImageView;
 class Label;
 class Layout;
 class MessageDialog;
 class Object;
+class Plot;
 class Popup;
 class PopupButton;
 class ProgressBar;
 class RenderPass;
 class Shader;
 class Screen;
+class SDFFont;
 class Serializer;
 class Slider;
 class TabWidgetBase;
 class TabWidget;
 class TextBox;
 class TextArea;
+class TextMetricsCache;
 class Texture;
+class TextureAtlas;
+class TextureTransfer;
 class Theme;
+class ThumbnailCache;
+class TileCache;
+class TileSource;
 class ToolButton;
+class UniformBuffer;
 class VScrollPanel;
 class Widget;
 class Window;
@@ -342,6 +355,32 @@ extern NANOGUI_EXPORT std::vector<std::pair<int, std::string>>
 extern NANOGUI_EXPORT int __nanogui_get_image(NVGcontext *ctx, const std::string &name,
                                               uint8_t *data, uint32_t size);
 
+/**
+ * \brief Like \ref nvgImageIcon(), but packs the icon into the icon atlas of
+ * the \ref Screen owning the NanoVG context
+ *
+ * Consecutive atlas icons can be drawn without switching textures. Small
+ * icons receive a negative identifier that is not a NanoVG image handle:
+ * use \ref nvg_image_icon_size() and \ref nvg_image_icon_pattern() to draw
+ * them (the built-in widgets accept both kinds of icons).
+ */
+#define nvgAtlasIcon(ctx, name) nanogui::nvg_atlas_icon(ctx, #name, name##_png, name##_png_size)
+/// Helper function used by nvgAtlasIcon
+extern NANOGUI_EXPORT int nvg_atlas_icon(NVGcontext *ctx, const std::string &name,
+                                         const uint8_t *data, uint32_t size);
+
+/**
+ * \brief Return the name of a temporary file next to \c filename that is
+ * unique to the calling process and thread
+ *
+ * Caches write to such a file and rename it into place, so that other
+ * processes sharing the cache directory never observe partial files.
+ */
+extern NANOGUI_EXPORT std::string __nanogui_temporary_filename(const std::string &filename);
+
+/// Delete the icons created by \ref nvgImageIcon() for a NanoVG context that is about to be destroyed
+extern NANOGUI_EXPORT void __nanogui_release_images(NVGcontext *ctx);
+
 NAMESPACE_END(nanogui)
 
 NAMESPACE_BEGIN(enoki)
@@ -13,6 +13,8 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <nanogui/pyramid.h>
+#include <mutex>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -20,6 +22,18 @@ NAMESPACE_BEGIN(nanogui)
  * \class Graph graph.h nanogui/graph.h
  *
  * \brief Simple graph widget for showing a function plot.
+ *
+ * Values can either be set in bulk (\ref set_values()), or streamed using
+ * \ref push_value() and \ref push_values(), which may be called from any
+ * thread. When a \ref capacity() is set, the graph retains only the most
+ * recent values (i.e. it acts as a ring buffer).
+ *
+ * The cost of drawing is bounded by the widget width: when there are more
+ * than two values per horizontal pixel, each pixel column is reduced to the
+ * minimum and maximum of the values it covers. Without a capacity limit,
+ * these envelopes are looked up in a \ref SamplePyramid that is extended
+ * as values arrive, so that arbitrarily long histories are drawn in time
+ * proportional to the widget width.
  */
 class NANOGUI_EXPORT Graph : public Widget {
 public:
@@ -46,16 +60,71 @@ public:
     const Color &text_color() const { return m_text_color; }
     void set_text_color(const Color &text_color) { m_text_color = text_color; }
 
-    const std::vector<float> &values() const { return m_values; }
-    std::vector<float> &values() { return m_values; }
-    void set_values(const std::vector<float> &values) { m_values = values; }
+    /**
+     * \brief Return the values in chronological order (incorporates pending
+     * pushes)
+     *
+     * The values can only be modified through \ref set_values() and \ref
+     * push_values(), which keep the summary used for drawing long histories
+     * up to date.
+     */
+    const std::vector<float> &values() const;
+    /// Replace all values
+    void set_values(const std::vector<float> &values);
+
+    /// Return the maximum number of retained values (0: unlimited)
+    size_t capacity() const { return m_capacity; }
+    /// Set the maximum number of retained values (0: unlimited)
+    void set_capacity(size_t capacity);
+
+    /**
+     * \brief Append a value
+     *
+     * This function is thread-safe: the value is queued and incorporated by
+     * the GUI thread when the graph is drawn next. Note that the caller
+     * remains responsible for requesting a redraw of the screen.
+     */
+    void push_value(float value) { push_values(&value, 1); }
+
+    /// Append a sequence of values (thread-safe, see \ref push_value())
+    void push_values(const float *values, size_t count);
+
+    /// Append a sequence of values (thread-safe, see \ref push_value())
+    void push_values(const std::vector<float> &values) {
+        push_values(values.data(), values.size());
+    }
 
     virtual Vector2i preferred_size(NVGcontext *ctx) const override;
     virtual void draw(NVGcontext *ctx) override;
+protected:
+    /// Move values queued by \ref push_values() into the ring buffer
+    void flush_pending() const;
+
+    /// Rotate the ring buffer so that the oldest value is stored first
+    void linearize() const;
+
+    /// Return the i-th oldest value
+    float value(size_t i) const {
+        size_t j = m_head + i;
+        return m_values[j < m_values.size() ? j : j - m_values.size()];
+    }
+
 protected:
     std::string m_caption, m_header, m_footer;
     Color m_background_color, m_fill_color, m_stroke_color, m_text_color;
-    std::vector<float> m_values;
+    /**
+     * Ring buffer storage, \c m_head refers to the oldest entry. Both are
+     * mutable since \ref flush_pending() and \ref linearize() don't change
+     * the logical contents of the graph.
+     */
+    mutable std::vector<float> m_values;
+    mutable size_t m_head = 0;
+    size_t m_capacity = 0;
+    /// Summary of \c m_values for drawing (only used when \c m_capacity == 0)
+    SamplePyramid m_pyramid;
+    /// Values pushed since the last draw (protected by \c m_pending_mutex)
+    mutable std::vector<float> m_pending;
+    mutable std::mutex m_pending_mutex;
 };
 
 NAMESPACE_END(nanogui)
@@ -0,0 +1,116 @@
+/*
+    nanogui/heatmap.h -- Widget that displays scalar data (e.g. a scrolling
+    spectrogram) through a colormap
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/canvas.h>
+#include <nanogui/texture.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class Heatmap heatmap.h nanogui/heatmap.h
+ *
+ * \brief Displays a 2D array of scalar values through a colormap
+ *
+ * The raw values are stored in a single-channel floating point texture, and
+ * colors are only assigned in the fragment shader using a lookup table.
+ * Changing the value range or the colormap therefore doesn't require any
+ * uploads.
+ *
+ * The texture is used as a circular buffer of columns: \ref push_column()
+ * overwrites the oldest column and shifts the displayed image to the left,
+ * which is what a live spectrogram needs. Each call uploads a single column.
+ *
+ * The data is organized in \c columns x \c rows (see \ref data_size()),
+ * with row 0 shown at the bottom and the oldest column shown on the left.
+ */
+class NANOGUI_EXPORT Heatmap : public Canvas {
+public:
+    /// Built-in colormaps
+    enum class Colormap {
+        Grayscale,
+        Viridis,
+        Inferno
+    };
+
+    /**
+     * \brief Create a heatmap widget
+     *
+     * \param parent
+     *     The parent widget
+     *
+     * \param data_size
+     *     Number of columns and rows of the data
+     *
+     * \param component_format
+     *     Storage format of the values on the GPU. Must be
+     *     \c Float32 or \c Float16 (which halves the upload cost).
+     */
+    Heatmap(Widget *parent, const Vector2i &data_size,
+            Texture::ComponentFormat component_format = Texture::ComponentFormat::Float32);
+
+    /// Return the number of columns and rows of the data
+    const Vector2i &data_size() const { return m_data_size; }
+
+    /**
+     * \brief Replace the oldest column and scroll the image by one column
+     *
+     * \c values must contain \c rows entries, starting with the bottom row.
+     */
+    void push_column(const float *values);
+
+    /**
+     * \brief Replace all data
+     *
+     * \c values must contain <tt>columns * rows</tt> entries stored row by
+     * row, starting with the bottom row. Column 0 is shown on the left.
+     */
+    void set_data(const float *values);
+
+    /// Return the value that is mapped to the first entry of the colormap
+    float range_min() const { return m_range_min; }
+
+    /// Return the value that is mapped to the last entry of the colormap
+    float range_max() const { return m_range_max; }
+
+    /// Set the range of values that is covered by the colormap
+    void set_range(float range_min, float range_max);
+
+    /// Select one of the built-in colormaps
+    void set_colormap(Colormap colormap);
+
+    /// Set a colormap that interpolates between evenly spaced colors
+    void set_colormap(const std::vector<Color> &colors);
+
+    /// Return the number of bytes uploaded to the GPU so far
+    size_t upload_bytes() const { return m_upload_bytes; }
+
+    virtual void draw_contents() override;
+
+protected:
+    /// Convert values to the storage format and upload them to a region of the texture
+    void upload(const float *values, const Vector2i &origin, const Vector2i &size);
+
+protected:
+    ref<Shader> m_shader;
+    ref<Texture> m_values;
+    ref<Texture> m_colormap;
+    Vector2i m_data_size;
+    /// Index of the oldest column, which will be overwritten next
+    int m_column = 0;
+    float m_range_min = 0.f, m_range_max = 1.f;
+    size_t m_upload_bytes = 0;
+};
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,199 @@
+/*
+    nanogui/imageloader.h -- Decodes images using a pool of background
+    threads and uploads them to the GPU in per-frame batches
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/texture.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class ImageLoader imageloader.h nanogui/imageloader.h
+ *
+ * \brief Loads large numbers of images without blocking the user interface
+ *
+ * Files are decoded by a pool of worker threads using stb_image (PNG, JPEG,
+ * ...). The decoded pixels are handed back to the thread owning the graphics
+ * context, where \ref process() uploads at most \ref upload_limit() images
+ * per call, either as NanoVG images or as \ref Texture instances. Calling
+ * \ref process() once per frame (e.g. from \ref Screen::draw_contents())
+ * keeps the application responsive while entire directories are loaded.
+ *
+ * To bound memory usage, the workers pause when \ref decoded_limit() decoded
+ * images are waiting to be uploaded.
+ */
+class NANOGUI_EXPORT ImageLoader : public Object {
+public:
+    /// Kind of GPU object that is created for each image
+    enum class Target {
+        /// NanoVG image handle (RGBA, for use with nvgImagePattern or \ref ImagePanel)
+        NanoVG,
+        /// \ref Texture instance with the channel count of the file
+        Texture
+    };
+
+    /// Describes an image that finished loading
+    struct Image {
+        /// Position of the image in the order of \ref load() calls
+        size_t index;
+        /// Name of the file
+        std::string filename;
+        /// Size of the image in pixels
+        Vector2i size;
+        /// NanoVG image handle (only for \ref Target::NanoVG)
+        int nvg_image = 0;
+        /// Texture (only for \ref Target::Texture)
+        ref<nanogui::Texture> texture;
+    };
+
+    /// Function that is called by \ref process() for each uploaded image
+    using Callback = std::function<void(const Image &)>;
+
+    /// Function that is called by \ref process() with the number of finished and requested images
+    using ProgressCallback = std::function<void(size_t, size_t)>;
+
+    /// Function that is called (from a worker thread) when an image was decoded
+    using WakeupCallback = std::function<void()>;
+
+    /**
+     * \brief Create an image loader
+     *
+     * \param target
+     *     Kind of GPU object that is created for each image
+     *
+     * \param threads
+     *     Number of worker threads (0: choose automatically)
+     */
+    ImageLoader(Target target = Target::NanoVG, size_t threads = 0);
+
+    /// Return the kind of GPU object that is created for each image
+    Target target() const { return m_target; }
+
+    /// Queue an image file for loading and return its index
+    size_t load(const std::string &filename);
+
+    /**
+     * \brief Queue all files of a directory whose name contains \c extension
+     *
+     * Returns the number of queued files. Throws an exception if the
+     * directory cannot be opened.
+     */
+    size_t load_directory(const std::string &path, const std::string &extension = "png");
+
+    /// Set a function that is called by \ref process() for each uploaded image
+    void set_callback(const Callback &callback) { m_callback = callback; }
+
+    /// Set a function that is called by \ref process() to report progress
+    void set_progress_callback(const ProgressCallback &callback) { m_progress_callback = callback; }
+
+    /**
+     * \brief Set a function that is called (from a worker thread) when an
+     * image was decoded
+     *
+     * This is typically used to schedule a redraw, e.g. via \ref Screen::redraw().
+     */
+    void set_wakeup_callback(const WakeupCallback &callback);
+
+    /// Return the maximum number of images uploaded by \ref process()
+    size_t upload_limit() const { return m_upload_limit; }
+
+    /// Set the maximum number of images uploaded by \ref process() (0: unlimited)
+    void set_upload_limit(size_t upload_limit) { m_upload_limit = upload_limit; }
+
+    /// Return the maximum number of decoded images waiting to be uploaded
+    size_t decoded_limit() const { return m_decoded_limit; }
+
+    /// Set the maximum number of decoded images waiting to be uploaded
+    void set_decoded_limit(size_t decoded_limit);
+
+    /**
+     * \brief Upload images that finished decoding
+     *
+     * Must be called on the thread that owns the graphics context. \c ctx is
+     * only needed for \ref Target::NanoVG. Returns \c true if images are
+     * still being loaded, in which case the caller should schedule another
+     * frame.
+     */
+    bool process(NVGcontext *ctx = nullptr);
+
+    /**
+     * \brief Block until all queued images are uploaded
+     *
+     * Calls \ref process() without an upload limit whenever images finish
+     * decoding. This still decodes in parallel, but does not return to the
+     * event loop in the meantime.
+     */
+    void wait(NVGcontext *ctx = nullptr);
+
+    /// Return the number of images queued so far
+    size_t total_count() const { return m_total_count; }
+
+    /// Return the number of images uploaded so far
+    size_t loaded_count() const { return m_loaded_count; }
+
+    /// Return the names of files that could not be decoded or uploaded
+    const std::vector<std::string> &failed() const { return m_failed; }
+
+protected:
+    struct Request {
+        size_t index;
+        std::string filename;
+    };
+
+    struct Decoded {
+        size_t index;
+        std::string filename;
+        Vector2i size;
+        int channels;
+        std::unique_ptr<uint8_t[], void(*)(void *)> pixels;
+    };
+
+    /// Main function of the worker threads
+    void worker();
+
+    /// Create the GPU object for a decoded image (throws on failure)
+    void upload(NVGcontext *ctx, const Decoded &decoded, Image &image);
+
+    /// Release all resources
+    virtual ~ImageLoader();
+
+protected:
+    Target m_target;
+    Callback m_callback;
+    ProgressCallback m_progress_callback;
+    size_t m_upload_limit = 16;
+    size_t m_total_count = 0;
+    size_t m_loaded_count = 0;
+    std::vector<std::string> m_failed;
+
+    /* State shared with the worker threads (protected by m_mutex) */
+    std::mutex m_mutex;
+    std::condition_variable m_cv, m_decoded_cv;
+    std::deque<Request> m_queue;
+    std::deque<Decoded> m_decoded;
+    size_t m_decoded_limit = 64;
+    size_t m_in_flight = 0;
+    bool m_shutdown = false;
+    WakeupCallback m_wakeup_callback;
+
+    std::vector<std::thread> m_workers;
+};
+
+NAMESPACE_END(nanogui)
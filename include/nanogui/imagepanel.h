@@ -14,13 +14,60 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <nanogui/thumbnailcache.h>
 
 NAMESPACE_BEGIN(nanogui)
 
+/**
+ * \class ImageSource imagepanel.h nanogui/imagepanel.h
+ *
+ * \brief Interface to the image files browsed by an \ref ImagePanel
+ *
+ * \ref ImagePanel only queries the entries that are currently visible, so
+ * implementations can provide very large collections (e.g. the result of a
+ * database query) without materializing a list of file names.
+ */
+class NANOGUI_EXPORT ImageSource : public Object {
+public:
+    /// Return the number of images
+    virtual size_t size() const = 0;
+
+    /// Return the file name of the image with the given index
+    virtual std::string filename(size_t index) const = 0;
+};
+
+/**
+ * \class ImageFileList imagepanel.h nanogui/imagepanel.h
+ *
+ * \brief \ref ImageSource backed by a list of file names
+ */
+class NANOGUI_EXPORT ImageFileList : public ImageSource {
+public:
+    ImageFileList(const std::vector<std::string> &files) : m_files(files) { }
+
+    virtual size_t size() const override { return m_files.size(); }
+    virtual std::string filename(size_t index) const override { return m_files[index]; }
+
+    /// Return the list of file names
+    const std::vector<std::string> &files() const { return m_files; }
+
+protected:
+    std::vector<std::string> m_files;
+};
+
 /**
  * \class ImagePanel imagepanel.h nanogui/imagepanel.h
  *
  * \brief Image panel widget which shows a number of square-shaped icons.
+ *
+ * The icons are either NanoVG images specified via \ref set_images(), or
+ * image files provided by an \ref ImageSource (see \ref set_source() and
+ * \ref set_files()). In the latter case, a \ref ThumbnailCache generates
+ * thumbnails in the background, so that only thumbnail-sized copies of the
+ * images are kept on the GPU.
+ *
+ * Only the rows that intersect the visible region of the panel (e.g. within
+ * a \ref VScrollPanel) are drawn, and only their thumbnails are requested.
  */
 class NANOGUI_EXPORT ImagePanel : public Widget {
 public:
@@ -28,9 +75,34 @@ public:
 public:
     ImagePanel(Widget *parent);
 
-    void set_images(const Images &data) { m_images = data; }
+    void set_images(const Images &data) { m_images = data; m_source = nullptr; }
     const Images& images() const { return m_images; }
 
+    /**
+     * \brief Show thumbnails of image files instead of NanoVG images
+     *
+     * \param source
+     *     Source of the image file names
+     *
+     * \param cache_directory
+     *     Directory storing generated thumbnails on disk (empty: disable the
+     *     disk cache)
+     */
+    void set_source(ImageSource *source, const std::string &cache_directory = "");
+    ImageSource *source() { return m_source; }
+
+    /// Convenience function that calls \ref set_source() with an \ref ImageFileList
+    void set_files(const std::vector<std::string> &files,
+                   const std::string &cache_directory = "") {
+        set_source(new ImageFileList(files), cache_directory);
+    }
+
+    /// Return the thumbnail cache (created when the panel is first drawn after \ref set_source())
+    ThumbnailCache *thumbnail_cache() { return m_thumbnails; }
+
+    /// Return the number of icons
+    size_t image_count() const { return m_source ? m_source->size() : m_images.size(); }
+
     std::function<void(int)> callback() const { return m_callback; }
     void set_callback(const std::function<void(int)> &callback) { m_callback = callback; }
 
@@ -44,8 +116,20 @@ public:
 protected:
     Vector2i grid_size() const;
     int index_for_position(const Vector2i &p) const;
+
+    /**
+     * \brief Return the range <tt>[begin, end)</tt> of grid rows that
+     * intersect the visible region of the panel
+     *
+     * The visible region is the part of the panel that is not clipped by the
+     * bounds of its ancestors, which scissor the drawing of their children.
+     */
+    Vector2i visible_rows() const;
 protected:
     Images m_images;
+    ref<ImageSource> m_source;
+    std::string m_cache_directory;
+    ref<ThumbnailCache> m_thumbnails;
     std::function<void(int)> m_callback;
     int m_thumb_size;
     int m_spacing;
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <nanogui/canvas.h>
+#include <nanogui/tiledimage.h>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -21,6 +22,12 @@ NAMESPACE_BEGIN(nanogui)
  *
  * \brief A widget for displaying, panning, and zooming images. Numerical RGBA
  * pixel information is shown at large magnifications.
+ *
+ * Images that are too large to fit into GPU memory can be displayed in tiled
+ * mode (see \ref set_tile_source()). Only the visible tiles of the resolution
+ * level that matches the current magnification are then loaded, in the
+ * background, while coarser tiles that are already resident are shown in
+ * their place.
  */
 class NANOGUI_EXPORT ImageView : public Canvas {
 public:
@@ -36,19 +43,55 @@ public:
     /// Set the currently active image
     void set_image(Texture *image);
 
+    /**
+     * \brief Display a tiled multi-resolution image instead of a texture
+     *
+     * \param source
+     *     Source of the image tiles
+     *
+     * \param cache_capacity
+     *     Number of tiles that can be resident on the GPU at once
+     */
+    void set_tile_source(TileSource *source, size_t cache_capacity = 256);
+    /// Return the source of the tiled image (if any)
+    TileSource *tile_source() { return m_tile_cache ? m_tile_cache->source() : nullptr; }
+    /// Return the tile cache of the tiled image (if any)
+    TileCache *tile_cache() { return m_tile_cache; }
+
+    /// Return the size of the active image or tiled image in pixels
+    Vector2i image_size() const;
+
     /// Center the image on the screen
     void center();
 
     /// Center the image on the screen and set the scale to 1:1
     void reset();
 
-    /// Set the callback that is used to acquire information about pixel components
+    /**
+     * \brief Set the callback that is used to acquire information about pixel components
+     *
+     * The callback writes up to four strings (one per component, each with
+     * the given maximum length) for the given pixel. Results are cached, so
+     * that each pixel is only queried once while it remains visible.
+     */
     void set_pixel_callback(const PixelCallback &pixel_callback) {
         m_pixel_callback = pixel_callback;
+        invalidate_pixel_values();
     }
     /// Return the callback that is used to acquire information about pixel components
     const PixelCallback &pixel_callback() const { return m_pixel_callback; }
 
+    /**
+     * \brief Discard the cached output of the pixel callback
+     *
+     * Must be called when the contents of the image changed without a call
+     * to \ref set_image().
+     */
+    void invalidate_pixel_values();
+
+    /// Return the number of times the pixel callback has been invoked so far
+    size_t pixel_callback_count() const { return m_pixel_callback_count; }
+
     /// Return the pixel offset of the zoomed image rectangle
     Vector2f offset() const { return m_offset; }
     /// Set the pixel offset of the zoomed image rectangle
@@ -71,15 +114,34 @@ public:
     virtual void draw(NVGcontext *ctx) override;
     virtual void draw_contents() override;
 
+protected:
+    /// Draw the visible tiles of the tiled image
+    void draw_tiles(const Matrix4f &matrix_image, const Matrix4f &matrix_background);
+
+    /// Draw the numerical values of the visible pixels (at large magnifications)
+    void draw_pixel_values(const Matrix4f &matrix_pixels);
+
+    /// Maximum length of a string produced by the pixel callback
+    static const size_t pixel_text_size = 20;
+
 protected:
     nanogui::ref<Shader> m_image_shader;
     nanogui::ref<Texture> m_image;
+    nanogui::ref<Shader> m_tile_shader;
+    nanogui::ref<TileCache> m_tile_cache;
     float m_scale = 0;
     Vector2f m_offset = 0;
     bool m_draw_image_border;
     Color m_image_border_color;
     Color m_image_background_color;
     PixelCallback m_pixel_callback;
+
+    /* Cached pixel callback output and text layout of the visible region */
+    nanogui::ref<SDFFont> m_pixel_font;
+    std::vector<char> m_pixel_text;
+    Vector2i m_pixel_text_origin = 0, m_pixel_text_size = 0;
+    float m_pixel_text_ratio = 0.f;
+    size_t m_pixel_callback_count = 0;
 };
 
 NAMESPACE_END(nanogui)
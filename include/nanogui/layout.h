@@ -238,6 +238,16 @@ protected:
  * widgets are also appended on this axis. The spacing between items can be
  * specified per axis. The horizontal/vertical alignment can be specified per
  * row and column.
+ *
+ * When \ref set_parallel() is enabled, the preferred sizes and layouts of the
+ * child widgets (which form independent subtrees) are computed by a
+ * persistent pool of worker threads; layouts with only a few children are
+ * still processed serially. Children must only measure text via \ref
+ * Widget::measure_text() and must not otherwise touch the NanoVG context
+ * during layout. This holds for the built-in widgets except fixed-width
+ * \ref Label instances and \ref TextBox instances with a NanoVG image as
+ * units, whose presence anywhere in the children's subtrees causes the
+ * layout to fall back to serial processing.
  */
 class NANOGUI_EXPORT GridLayout : public Layout {
 public:
@@ -315,6 +325,11 @@ public:
     /// Use this to set variable Alignment for rows.
     void set_row_alignment(const std::vector<Alignment> &value) { m_alignment[1] = value; }
 
+    /// Are child widgets laid out using multiple threads?
+    bool parallel() const { return m_parallel; }
+    /// Specify whether child widgets should be laid out using multiple threads
+    void set_parallel(bool parallel) { m_parallel = parallel; }
+
     /* Implementation of the layout interface */
     /// See \ref Layout::preferred_size.
     virtual Vector2i preferred_size(NVGcontext *ctx, const Widget *widget) const override;
@@ -323,9 +338,10 @@ public:
     virtual void perform_layout(NVGcontext *ctx, Widget *widget) const override;
 
 protected:
-    // Compute the maximum row and column sizes
+    // Compute the maximum row and column sizes, and the target size of each visible child
     void compute_layout(NVGcontext *ctx, const Widget *widget,
-                        std::vector<int> *grid) const;
+                        std::vector<int> *grid,
+                        std::vector<Vector2i> &target_sizes) const;
 
 protected:
     /// The Orientation of the GridLayout.
@@ -340,6 +356,8 @@ protected:
     Vector2i m_spacing;
     /// The margin around this GridLayout.
     int m_margin;
+    /// Whether child widgets are laid out using multiple threads.
+    bool m_parallel = false;
 };
 
 /**
@@ -371,6 +389,9 @@ protected:
  * of any widgets contained in the same row or column. Any remaining space is
  * redistributed according to the row and column stretch factors.
  *
+ * Like \ref GridLayout, this layout can process its children using multiple
+ * threads (see \ref set_parallel()).
+ *
  * The high level usage somewhat resembles the classic HIG layout:
  *
  * - https://web.archive.org/web/20070813221705/http://www.autel.cz/dmi/tutorial.html
@@ -454,6 +475,11 @@ public:
         return it->second;
     }
 
+    /// Are child widgets laid out using multiple threads?
+    bool parallel() const { return m_parallel; }
+    /// Specify whether child widgets should be laid out using multiple threads
+    void set_parallel(bool parallel) { m_parallel = parallel; }
+
     /* Implementation of the layout interface */
 
     /// See \ref Layout::preferred_size.
@@ -463,9 +489,14 @@ public:
     virtual void perform_layout(NVGcontext *ctx, Widget *widget) const override;
 
 protected:
+    // Compute the preferred size of every visible anchored widget
+    void compute_preferred_sizes(
+        NVGcontext *ctx,
+        std::unordered_map<const Widget *, Vector2i> &preferred_sizes) const;
+
     // Compute the maximum row and column sizes
-    void compute_layout(NVGcontext *ctx, const Widget *widget,
-                        std::vector<int> *grid) const;
+    void compute_layout(const Widget *widget, std::vector<int> *grid,
+                        const std::unordered_map<const Widget *, Vector2i> &preferred_sizes) const;
 
 protected:
     /// The columns of this AdvancedGridLayout.
@@ -485,6 +516,9 @@ protected:
 
     /// The margin around this AdvancedGridLayout.
     int m_margin;
+
+    /// Whether child widgets are laid out using multiple threads.
+    bool m_parallel = false;
 };
 
 NAMESPACE_END(nanogui)
@@ -16,6 +16,7 @@
 #include <nanogui/widget.h>
 #include <nanogui/screen.h>
 #include <nanogui/theme.h>
+#include <nanogui/textmetrics.h>
 #include <nanogui/window.h>
 #include <nanogui/layout.h>
 #include <nanogui/label.h>
@@ -35,10 +36,20 @@
 #include <nanogui/vscrollpanel.h>
 #include <nanogui/colorwheel.h>
 #include <nanogui/graph.h>
+#include <nanogui/pyramid.h>
 #include <nanogui/formhelper.h>
 #include <nanogui/tabwidget.h>
 #include <nanogui/texture.h>
+#include <nanogui/pixelconvert.h>
 #include <nanogui/shader.h>
+#include <nanogui/uniformbuffer.h>
 #include <nanogui/renderpass.h>
 #include <nanogui/canvas.h>
+#include <nanogui/tiledimage.h>
+#include <nanogui/imageloader.h>
+#include <nanogui/thumbnailcache.h>
+#include <nanogui/textureatlas.h>
 #include <nanogui/imageview.h>
+#include <nanogui/plot.h>
+#include <nanogui/heatmap.h>
+#include <nanogui/sdffont.h>
@@ -75,7 +75,8 @@ inline Color::operator const NVGcolor &() const {
  * The implementation defines all ``value < 1024`` as image icons, and
  * everything ``>= 1024`` as an Entypo icon (see :ref:`file_nanogui_entypo.h`).
  * The value ``1024`` exists to provide a generous buffer on how many images
- * may have been loaded by NanoVG.
+ * may have been loaded by NanoVG. Values ``<= -2`` refer to icons stored in
+ * the icon atlas of a screen (see :func:`nanogui::nvg_is_atlas_icon`).
  * \endrst
  *
  * \param value
@@ -101,6 +102,37 @@ inline bool nvg_is_image_icon(int value) { return value < 1024; }
  */
 inline bool nvg_is_font_icon(int value) { return value >= 1024; }
 
+/**
+ * \brief Determine whether an icon ID refers to the icon atlas of a screen
+ *
+ * \rst
+ * Such icons are created by :c:macro:`nvgAtlasIcon` and must be drawn using
+ * :func:`nanogui::nvg_image_icon_pattern`. The value ``-1`` is not used, since
+ * several widgets use it to indicate that no image is set.
+ * \endrst
+ */
+inline bool nvg_is_atlas_icon(int value) { return value <= -2; }
+
+/**
+ * \brief Return the size of an image icon in pixels (NanoVG image or icon
+ * atlas entry)
+ *
+ * Throws an exception if an atlas icon does not belong to the screen owning
+ * \c ctx.
+ */
+extern NANOGUI_EXPORT Vector2i nvg_image_icon_size(NVGcontext *ctx, int icon);
+
+/**
+ * \brief Create a NanoVG paint that maps an image icon onto the rectangle
+ * (x, y, w, h)
+ *
+ * Unlike \c nvgImagePattern(), this function also handles icons stored in
+ * the icon atlas of a screen.
+ */
+extern NANOGUI_EXPORT NVGpaint nvg_image_icon_pattern(NVGcontext *ctx, int icon,
+                                                      float x, float y, float w,
+                                                      float h, float alpha);
+
 
 /// Check for OpenGL errors and warn if one is found (returns 'true' in that case')
 extern NANOGUI_EXPORT bool nanogui_check_glerror(const char *cmd);
@@ -0,0 +1,59 @@
+/*
+    nanogui/pixelconvert.h -- Vectorized conversions between the pixel
+    formats supported by the Texture class
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/texture.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+/// Convert a single precision value to half precision (round to nearest even)
+extern NANOGUI_EXPORT uint16_t float_to_half(float value);
+
+/// Convert a half precision value to single precision
+extern NANOGUI_EXPORT float half_to_float(uint16_t value);
+
+/**
+ * \brief Convert packed pixels between the formats supported by \ref Texture
+ *
+ * Supports the pixel formats \c R, \c RA, \c RGB, \c RGBA, \c BGR, and \c
+ * BGRA along with the component formats \c UInt8, \c Int8, \c UInt16, \c
+ * Int16, \c Float16, and \c Float32. Integer components are interpreted as
+ * normalized values (e.g. <tt>[0, 65535]</tt> maps to <tt>[0, 1]</tt>).
+ * Grayscale sources are replicated into all color channels, missing alpha
+ * channels are set to one, and conversions to \c R or \c RA keep the red
+ * channel. Throws an exception for other formats.
+ *
+ * The following common cases are vectorized using SSE2/SSSE3/F16C or NEON
+ * (depending on the instruction sets enabled at compile time) and fall back
+ * to scalar code otherwise: swapping the red and blue channels of 8-bit
+ * data, padding 8-bit RGB data to RGBA, and converting \c Float32 to \c
+ * Float16 or \c UInt8, as well as \c UInt16 to \c Float32 or \c Float16
+ * without changing the channel layout.
+ *
+ * \param count
+ *     Number of pixels
+ *
+ * \param srgb
+ *     Encode the color channels (but not alpha) using the sRGB transfer
+ *     function. Conversions to \c UInt8 use a lookup table that is accurate
+ *     to within one quantization level.
+ */
+extern NANOGUI_EXPORT void
+convert_pixels(const void *src, Texture::PixelFormat src_pixel_format,
+               Texture::ComponentFormat src_component_format, void *dst,
+               Texture::PixelFormat dst_pixel_format,
+               Texture::ComponentFormat dst_component_format, size_t count,
+               bool srgb = false);
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,133 @@
+/*
+    nanogui/plot.h -- GPU-accelerated widget for plotting large time series
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/canvas.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class Plot plot.h nanogui/plot.h
+ *
+ * \brief GPU-accelerated line plot for large time series
+ *
+ * In contrast to \ref Graph, which tessellates its polyline using NanoVG in
+ * every frame, this widget keeps the samples of all data series in GPU
+ * vertex buffers, where each series occupies a separate range. Appending
+ * samples only uploads the new vertices, and lines are expanded into
+ * anti-aliased strips of the requested thickness by a dedicated vertex
+ * shader that is shared by all series. Panning and zooming merely change a
+ * uniform.
+ *
+ * The visible region is specified in data coordinates using \ref set_view().
+ * The mouse can be used to pan (dragging) and zoom (scrolling).
+ *
+ * Samples are stored in single precision. Large offsets (e.g. absolute
+ * timestamps) should therefore be subtracted before calling \ref append().
+ */
+class NANOGUI_EXPORT Plot : public Canvas {
+public:
+    /// Create an empty plot
+    Plot(Widget *parent);
+
+    /// Add a data series and return its index
+    size_t add_series(const Color &color, float thickness = 1.5f);
+
+    /// Return the number of data series
+    size_t series_count() const { return m_series.size(); }
+
+    /// Return the color of a data series
+    const Color &series_color(size_t series) const { return get(series).color; }
+
+    /// Set the color of a data series
+    void set_series_color(size_t series, const Color &color) { get(series).color = color; }
+
+    /// Return the line thickness of a data series (in pixels)
+    float series_thickness(size_t series) const { return get(series).thickness; }
+
+    /// Set the line thickness of a data series (in pixels)
+    void set_series_thickness(size_t series, float thickness) { get(series).thickness = thickness; }
+
+    /// Return the number of samples of a data series
+    size_t sample_count(size_t series) const { return get(series).points.size(); }
+
+    /**
+     * \brief Append samples to a data series
+     *
+     * The samples are uploaded to the GPU when the plot is drawn next.
+     * Only the vertices of new samples (and of the previous last sample,
+     * whose line join changes) are transferred.
+     */
+    void append(size_t series, const float *x, const float *y, size_t count);
+
+    /// Append a single sample to a data series
+    void append(size_t series, float x, float y) { append(series, &x, &y, 1); }
+
+    /// Remove all samples of a data series
+    void clear(size_t series);
+
+    /// Return the lower left corner of the visible region (data coordinates)
+    const Vector2f &view_min() const { return m_view_min; }
+
+    /// Return the upper right corner of the visible region (data coordinates)
+    const Vector2f &view_max() const { return m_view_max; }
+
+    /// Set the visible region (data coordinates)
+    void set_view(const Vector2f &view_min, const Vector2f &view_max);
+
+    /// Adjust the visible region so that all samples are shown
+    void fit_view();
+
+    /// Return the number of bytes uploaded to the GPU so far
+    size_t upload_bytes() const { return m_upload_bytes; }
+
+    // Widget implementation
+    virtual bool mouse_drag_event(const Vector2i &p, const Vector2i &rel, int button, int modifiers) override;
+    virtual bool scroll_event(const Vector2i &p, const Vector2f &rel) override;
+    virtual void draw_contents() override;
+
+protected:
+    struct Series {
+        Color color;
+        float thickness;
+        /// CPU copy of the samples
+        std::vector<Vector2f> points;
+        /// Number of samples whose vertices are up to date on the GPU
+        size_t uploaded = 0;
+        /// Number of samples for which GPU storage is allocated
+        size_t capacity = 0;
+        /// Index of the first sample slot of the series within the vertex buffers
+        size_t offset = 0;
+    };
+
+    Series &get(size_t series);
+    const Series &get(size_t series) const;
+
+    /// Synchronize the vertex buffers with the samples of all series
+    void upload();
+
+    /// Write the vertices of samples [start, end) into the given arrays
+    void fill_vertices(const Series &series, size_t start, size_t end,
+                       float *position, float *prev, float *next) const;
+
+    /// Convert a position within the widget into data coordinates
+    Vector2f pos_to_data(const Vector2i &p) const;
+
+protected:
+    std::vector<Series> m_series;
+    ref<Shader> m_shader;
+    Vector2f m_view_min, m_view_max;
+    size_t m_upload_bytes = 0;
+};
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,89 @@
+/*
+    nanogui/pyramid.h -- Multi-resolution min/max/mean pyramid for
+    summarizing long sample sequences at any zoom level
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/common.h>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class SamplePyramid pyramid.h nanogui/pyramid.h
+ *
+ * \brief Multi-resolution summary of a sequence of samples
+ *
+ * Level \c l of the pyramid stores the minimum, maximum, and sum of every
+ * complete block of <tt>8^l</tt> consecutive samples. The envelope of an
+ * arbitrary range (e.g. the samples covered by one pixel column of a chart)
+ * is assembled from at most 14 entries per level, hence queries take
+ * O(log n) time regardless of the length of the range. The pyramid
+ * requires roughly 3/7 additional floats per sample, and the reductions
+ * are vectorized using SSE or NEON when available.
+ *
+ * The samples themselves (level 0) are not copied. They are owned by the
+ * caller, who passes them to \ref extend() and to the query functions. New
+ * samples may only be appended: when existing samples change, call \ref
+ * clear() and extend the pyramid again.
+ */
+class NANOGUI_EXPORT SamplePyramid {
+public:
+    /// Summary of a range of samples
+    struct Envelope {
+        float min = 0.f;
+        float max = 0.f;
+        float mean = 0.f;
+        size_t count = 0;
+    };
+
+    /// Number of entries of a level that are combined into one entry of the next level
+    static constexpr size_t Fanout = 8;
+
+    /**
+     * \brief Incorporate samples that were appended since the last call
+     *
+     * \c values must point to \c size samples, of which the first \ref
+     * size() must be identical to the ones seen previously. The amortized
+     * cost per new sample is O(1).
+     */
+    void extend(const float *values, size_t size);
+
+    /// Remove all levels, e.g. after the samples were modified
+    void clear();
+
+    /// Return the number of samples that are incorporated in the pyramid
+    size_t size() const { return m_size; }
+
+    /// Return the number of levels (excluding the samples themselves)
+    size_t levels() const { return m_levels.size(); }
+
+    /// Return the envelope of the samples <tt>[begin, end)</tt>
+    Envelope envelope(const float *values, size_t begin, size_t end) const;
+
+    /**
+     * \brief Split the samples <tt>[begin, end)</tt> into \c count columns
+     * of (nearly) equal length and compute the envelope of each
+     */
+    void envelopes(const float *values, size_t begin, size_t end,
+                   size_t count, Envelope *out) const;
+
+protected:
+    struct Level {
+        std::vector<float> min, max, sum;
+    };
+
+    std::vector<Level> m_levels;
+    size_t m_size = 0;
+};
+
+NAMESPACE_END(nanogui)
@@ -139,9 +139,43 @@ public:
      */
     std::vector<ref<Object>> &targets() { return m_targets; }
 
-    /// Resize all texture targets attached to the render pass
+    /**
+     * \brief Resize all texture targets attached to the render pass
+     *
+     * Also resets the viewport to cover the requested size (see \ref
+     * set_resize_slack()).
+     */
     void resize(const Vector2i &size);
 
+    /**
+     * \brief Allow texture targets to be larger than the rendered region
+     *
+     * Reallocating render targets on every frame of a window resize or
+     * layout animation is expensive. When this option is enabled, \ref
+     * resize() rounds the size of texture targets up using \ref
+     * slack_size() and keeps them as long as the requested size fits
+     * without wasting too much memory. Rendering is then restricted to a
+     * viewport within the targets, located at the origin of the texture
+     * coordinate system of the backend (bottom left for OpenGL, top left for
+     * Metal). \ref viewport() reports this region, and \ref blit_to() calls
+     * with a source offset of zero copy it.
+     *
+     * Disabled by default, since shaders sampling the targets would otherwise
+     * need to account for the unused border.
+     */
+    void set_resize_slack(bool resize_slack) { m_resize_slack = resize_slack; }
+
+    /// Are texture targets allowed to be larger than the rendered region?
+    bool resize_slack() const { return m_resize_slack; }
+
+    /**
+     * \brief Round a render target size up to a coarse bucket
+     *
+     * Each dimension is rounded up to a multiple of 1/8 of the next power of
+     * two (at least 64 pixels), which bounds the unused area to roughly 25%.
+     */
+    static Vector2i slack_size(const Vector2i &size);
+
     /**
      * Blit the framebuffer to another target (which can either be another \ref
      * RenderPass instance or a \ref Screen instance).
@@ -175,6 +209,7 @@ protected:
     DepthTest m_depth_test;
     bool m_depth_write;
     CullMode m_cull_mode;
+    bool m_resize_slack = false;
     ref<Object> m_blit_target;
     bool m_active;
 #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
@@ -16,6 +16,9 @@
 
 #include <nanogui/widget.h>
 #include <nanogui/texture.h>
+#include <nanogui/textmetrics.h>
+#include <nanogui/textureatlas.h>
+#include <atomic>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -110,7 +113,12 @@ public:
     /// Return the framebuffer size (potentially larger than size() on high-DPI screens)
     const Vector2i &framebuffer_size() const { return m_fbsize; }
 
-    /// Send an event that will cause the screen to be redrawn at the next event loop iteration
+    /**
+     * \brief Send an event that will cause the screen to be redrawn at the
+     * next event loop iteration
+     *
+     * This function may be called from any thread.
+     */
     void redraw();
 
     /**
@@ -189,6 +197,61 @@ public:
     /// Return a pointer to the underlying NanoVG draw context
     NVGcontext *nvg_context() const { return m_nvg_context; }
 
+    /**
+     * \brief Return the text measurement cache shared by all widgets of this screen
+     *
+     * Measuring text only memoizes results, hence the cache is also
+     * available from a const screen.
+     */
+    TextMetricsCache *text_metrics_cache() const { return m_text_metrics_cache; }
+
+    /**
+     * \brief Pre-rasterize glyphs into NanoVG's font atlas
+     *
+     * NanoVG rasterizes glyphs lazily the first time they are drawn, which
+     * causes a stall when many new glyphs appear at once (e.g. the first
+     * frame of a screen, or a window full of icons). This function declares
+     * a set of glyphs that will be drawn using the given font and size. They
+     * are rasterized at the beginning of the next frame, and again whenever
+     * the pixel ratio changes (which requires new atlas entries).
+     *
+     * \param font
+     *     Name of a font known to NanoVG (e.g. \c "sans" or \c "icons")
+     *
+     * \param font_size
+     *     Font size at which the glyphs will be drawn
+     *
+     * \param glyphs
+     *     UTF-8 encoded string containing the glyphs
+     */
+    void warm_up_glyphs(const std::string &font, float font_size,
+                        const std::string &glyphs);
+
+    /**
+     * \brief Return the atlas storing the image icons of this screen
+     *
+     * Icons created using \ref nvgAtlasIcon() are packed into the pages of
+     * this atlas, so that consecutive icons can be drawn without switching
+     * textures. They are referenced by negative icon identifiers (see \ref
+     * nvg_image_icon_pattern()).
+     */
+    TextureAtlas *icon_atlas();
+
+    /**
+     * \brief Return the identifier of a PNG icon in \ref icon_atlas(), adding
+     * it on first use (see \ref nvgAtlasIcon())
+     *
+     * Icons larger than a quarter of an atlas page are loaded as separate
+     * NanoVG images instead.
+     */
+    int atlas_icon(const std::string &name, const uint8_t *data, uint32_t size);
+
+    /// Return the number of NanoVG draw calls (fills, strokes, and text) of the last frame
+    size_t nvg_draw_call_count() const { return m_nvg_draw_call_count; }
+
+    /// Return how often NanoVG switched between images during the last frame
+    size_t nvg_image_switch_count() const { return m_nvg_image_switch_count; }
+
     /// Return the component format underlying the screen
     Texture::ComponentFormat component_format() const;
 
@@ -268,6 +331,16 @@ public:
     void move_window_to_front(Window *window);
     void draw_widgets();
 
+protected:
+    /// Rasterize the glyphs declared via \ref warm_up_glyphs() if needed
+    void rasterize_glyphs();
+
+    struct GlyphWarmUp {
+        std::string font;
+        float font_size;
+        std::string glyphs;
+    };
+
 protected:
     GLFWwindow *m_glfw_window = nullptr;
     NVGcontext *m_nvg_context = nullptr;
@@ -289,8 +362,18 @@ protected:
     bool m_depth_buffer;
     bool m_stencil_buffer;
     bool m_float_buffer;
-    bool m_redraw;
+    /// Set by \ref redraw(), which may also be called from other threads
+    std::atomic<bool> m_redraw;
     std::function<void(Vector2i)> m_resize_callback;
+    mutable ref<TextMetricsCache> m_text_metrics_cache;
+    std::vector<GlyphWarmUp> m_glyph_warm_up;
+    size_t m_glyph_warm_up_done = 0;
+    float m_glyph_warm_up_ratio = 0.f;
+    ref<TextureAtlas> m_icon_atlas;
+    /// Identifiers returned by \ref atlas_icon(), indexed by icon name
+    std::unordered_map<std::string, int> m_atlas_icons;
+    size_t m_nvg_draw_call_count = 0;
+    size_t m_nvg_image_switch_count = 0;
 #if defined(NANOGUI_USE_METAL)
     void *m_metal_texture = nullptr;
     void *m_metal_drawable = nullptr;
@@ -0,0 +1,266 @@
+/*
+    nanogui/sdffont.h -- Text rendering using a signed distance field glyph
+    atlas that is shared by all font sizes
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <nanogui/vector.h>
+#include <memory>
+#include <unordered_map>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class SDFFont sdffont.h nanogui/sdffont.h
+ *
+ * \brief Renders text from a signed distance field (SDF) glyph atlas
+ *
+ * NanoVG rasterizes a separate atlas entry for every combination of glyph,
+ * font size, and device pixel ratio. Zooming interfaces therefore keep
+ * rasterizing and re-uploading glyphs. This class instead stores a single
+ * distance field per glyph, rendered once at a fixed reference size, and
+ * reconstructs crisp outlines at any size in the fragment shader. Atlas
+ * memory and uploads hence stay constant across font sizes and pixel ratios.
+ *
+ * The font is looked up by name in \ref TextMetricsService, so the fonts of
+ * \ref Theme (\c "sans", \c "sans-bold", \c "icons", and \c "mono") are
+ * available out of the box. Font sizes follow the NanoVG convention.
+ *
+ * Text is drawn with the GPU backend of NanoGUI rather than NanoVG, hence
+ * \ref draw_text() must be called while the given \ref RenderPass is
+ * active, e.g. from \ref Canvas::draw_contents().
+ *
+ * Computing distance fields is considerably more expensive than rasterizing
+ * bitmaps. Glyphs can be generated ahead of time using \ref warm_up(), and
+ * the atlas can be persisted across application launches via \ref
+ * save_cache() and \ref load_cache().
+ */
+class NANOGUI_EXPORT SDFFont : public Object {
+public:
+    /**
+     * \brief Create an SDF font
+     *
+     * \param render_pass
+     *     The render pass into which text will be drawn
+     *
+     * \param font
+     *     Name of a font registered with \ref TextMetricsService
+     *
+     * \param glyph_size
+     *     Reference size (in pixels) at which distance fields are computed
+     *
+     * \param atlas_size
+     *     Initial width and height of the glyph atlas. The atlas grows
+     *     vertically when needed.
+     */
+    SDFFont(RenderPass *render_pass, const std::string &font,
+            int glyph_size = 48, int atlas_size = 512);
+
+    /// Return the name of the font
+    const std::string &font() const { return m_font; }
+
+    /// Return the reference size at which distance fields are computed
+    int glyph_size() const { return m_glyph_size; }
+
+    /// Return the number of device pixels per unit of the drawing coordinates
+    float pixel_ratio() const { return m_pixel_ratio; }
+
+    /// Set the number of device pixels per unit (controls anti-aliasing)
+    void set_pixel_ratio(float pixel_ratio) { m_pixel_ratio = pixel_ratio; }
+
+    /**
+     * \brief Draw a single line of text
+     *
+     * \param mvp
+     *     Transformation from drawing coordinates to clip space
+     *
+     * \param pos
+     *     Anchor position of the text
+     *
+     * \param font_size
+     *     Font size following the NanoVG convention
+     *
+     * \param align
+     *     Combination of \c NVGalign flags (e.g. <tt>NVG_ALIGN_LEFT |
+     *     NVG_ALIGN_BASELINE</tt>)
+     *
+     * \param color
+     *     Text color
+     *
+     * \param text
+     *     UTF-8 encoded string
+     */
+    void draw_text(const Matrix4f &mvp, const Vector2f &pos, float font_size,
+                   int align, const Color &color, const std::string &text);
+
+    /// Return the color of the glyph outlines
+    const Color &outline_color() const { return m_outline_color; }
+
+    /// Return the width of the glyph outlines relative to the font size
+    float outline_width() const { return m_outline_width; }
+
+    /**
+     * \brief Draw an outline around the glyphs
+     *
+     * Outlines keep text legible on arbitrary backgrounds in a single pass,
+     * unlike a blurred shadow that is drawn underneath the text. The width is
+     * specified relative to the font size (e.g. \c 0.1) and limited by the
+     * padding of the distance fields. A width of zero disables the outline.
+     */
+    void set_outline(const Color &color, float width);
+
+    /**
+     * \brief Append a line of text to the batch (see \ref draw_batch())
+     *
+     * The parameters match those of \ref draw_text(). Anti-aliasing is
+     * tuned for the font size of the most recently added text, hence text
+     * within a batch should share the same font size.
+     */
+    void add_text(const Vector2f &pos, float font_size, int align,
+                  const Color &color, const std::string &text);
+
+    /// Remove all text from the batch
+    void clear_batch();
+
+    /// Return the number of glyph quads in the batch
+    size_t batch_size() const { return m_batch_positions.size() / 12; }
+
+    /**
+     * \brief Draw all text of the batch using a single draw call
+     *
+     * The batch is retained, so that static text can be redrawn with a
+     * different transformation (e.g. after panning or zooming) without
+     * laying it out again. Vertex data is only uploaded after the batch
+     * changed. Use \ref set_pixel_ratio() to specify the current number of
+     * device pixels per unit of the drawing coordinates.
+     *
+     * \param mvp
+     *     Transformation from drawing coordinates to clip space
+     *
+     * \param opacity
+     *     Factor applied to the alpha channel of all text
+     */
+    void draw_batch(const Matrix4f &mvp, float opacity = 1.f);
+
+    /// Return the horizontal advance of a string drawn at the given size
+    float text_width(float font_size, const std::string &text);
+
+    /// Generate the distance fields of the given (UTF-8 encoded) glyphs ahead of time
+    void warm_up(const std::string &glyphs);
+
+    /**
+     * \brief Return a key that identifies the atlas contents
+     *
+     * Combines the font name, a hash of the font data, and the distance
+     * field parameters. Used to name the files of the on-disk cache.
+     */
+    std::string cache_key() const;
+
+    /**
+     * \brief Load glyphs from an on-disk atlas cache
+     *
+     * Looks for a file named after \ref cache_key() in \c directory. Returns
+     * \c false if there is no matching cache file, in which case the atlas
+     * remains unchanged.
+     */
+    bool load_cache(const std::string &directory);
+
+    /// Write the current atlas to the on-disk cache in \c directory
+    void save_cache(const std::string &directory) const;
+
+    /// Return the number of glyphs that are stored in the atlas
+    size_t glyph_count() const { return m_glyphs.size(); }
+
+    /// Return the size of the glyph atlas
+    Vector2i atlas_size() const { return m_atlas_size; }
+
+    /// Return the number of texture uploads issued so far
+    size_t upload_count() const { return m_upload_count; }
+
+protected:
+    struct Glyph {
+        /// Region covered by the glyph in the atlas
+        Vector2i pos, size;
+        /// Offset of the bitmap relative to the pen position (reference size)
+        Vector2f offset;
+        /// Horizontal advance (reference size)
+        float advance;
+        /// Glyph index within the font
+        int index;
+    };
+
+    /// Look up a glyph, rasterizing it into the atlas if needed
+    const Glyph &glyph(uint32_t codepoint);
+
+    /// Return the path of the cache file within \c directory
+    std::string cache_filename(const std::string &directory) const;
+
+    /// Generate quads for a string (positions and texture coordinates)
+    float layout(const Vector2f &pos, float font_size, int align,
+                 const std::string &text, std::vector<float> *positions,
+                 std::vector<float> *uvs);
+
+    /// Upload the modified part of the atlas to the GPU
+    void update_texture();
+
+    /// Adapt the texture coordinates of the first vertices of the batch after the atlas has grown
+    void rescale_batch(size_t vertex_count);
+
+    /// Draw triangles from the vertex data that is currently bound
+    void draw(const Matrix4f &mvp, size_t vertex_count, float font_size,
+              float opacity);
+
+    /// Release all resources
+    virtual ~SDFFont();
+
+protected:
+    std::string m_font;
+    int m_glyph_size;
+    int m_padding;
+    float m_pixel_ratio = 1.f;
+
+    /// Opaque handle to the TrueType font information
+    struct FontInfo;
+    std::unique_ptr<FontInfo> m_info;
+    uint64_t m_font_hash;
+    float m_scale;
+    float m_ascent, m_descent;
+
+    std::unordered_map<uint32_t, Glyph> m_glyphs;
+
+    /// CPU copy of the atlas and shelf packing state
+    std::unique_ptr<uint8_t[]> m_atlas;
+    Vector2i m_atlas_size;
+    Vector2i m_shelf_pos;
+    int m_shelf_height = 0;
+    /// Range of atlas rows that need to be uploaded
+    int m_dirty_begin, m_dirty_end;
+    bool m_texture_stale = true;
+    size_t m_upload_count = 0;
+
+    ref<Texture> m_texture;
+    ref<Shader> m_shader;
+    std::vector<float> m_positions, m_uvs, m_colors;
+
+    Color m_outline_color = Color(0.f, 0.f);
+    float m_outline_width = 0.f;
+
+    /// Retained batch of text (see \ref draw_batch())
+    std::vector<float> m_batch_positions, m_batch_uvs, m_batch_colors;
+    Vector2i m_batch_atlas_size;
+    float m_batch_font_size = 0.f;
+    /// Whether the shader buffers currently hold the batch
+    bool m_batch_uploaded = false;
+};
+
+NAMESPACE_END(nanogui)
@@ -18,6 +18,7 @@
 
 #include <nanogui/object.h>
 #include <nanogui/traits.h>
+#include <nanogui/uniformbuffer.h>
 #include <unordered_map>
 
 NAMESPACE_BEGIN(nanogui)
@@ -39,6 +40,33 @@ public:
         AlphaBlend // alpha * new_color + (1 - alpha) * old_color
     };
 
+    /**
+     * \brief Hint describing how often the contents of a vertex or index
+     * buffer change (see \ref set_buffer_usage())
+     */
+    enum class BufferUsage {
+        /// Uploaded once and drawn many times
+        Static,
+        /// Modified occasionally, e.g. using \ref update_buffer_range() (default)
+        Dynamic,
+        /// Replaced using \ref set_buffer() every frame or more often
+        Stream
+    };
+
+    /// Location of a vertex attribute within an interleaved vertex buffer
+    struct VertexAttribute {
+        /// Name of the attribute in the vertex shader
+        std::string name;
+        /// Type of the components
+        VariableType type;
+        /// Number of components (1-4)
+        size_t components;
+        /// Byte offset of the attribute relative to the start of a vertex
+        size_t offset;
+        /// Map integer components to <tt>[0, 1]</tt> (unsigned) or <tt>[-1, 1]</tt> (signed)
+        bool normalized = false;
+    };
+
     /**
      * \brief Initialize the shader using the specified source strings.
      *
@@ -70,6 +98,18 @@ public:
     /// Return the blending mode of this shader
     BlendMode blend_mode() const { return m_blend_mode; }
 
+    /**
+     * \brief Return a handle that identifies the named shader parameter
+     *
+     * Shader parameters are compiled into a flat binding table when the
+     * shader is linked. The returned handle indexes this table and can be
+     * passed to the handle-based overloads of \ref set_buffer(), \ref
+     * set_uniform(), \ref set_texture(), and \ref update_buffer_range() to
+     * avoid a string lookup per call. Handles remain valid for the lifetime
+     * of the shader. Throws an exception if no such parameter exists.
+     */
+    size_t argument_handle(const std::string &name) const;
+
     /**
      * \brief Upload a buffer (e.g. vertex positions) that will be associated
      * with a named shader parameter.
@@ -81,19 +121,156 @@ public:
      * The buffer will be replaced if it is already present.
      */
     void set_buffer(const std::string &name, VariableType type, size_t ndim,
-                    const size_t *shape, const void *data);
+                    const size_t *shape, const void *data) {
+        set_buffer(argument_handle(name), type, ndim, shape, data);
+    }
 
     void set_buffer(const std::string &name, VariableType type,
                     std::initializer_list<size_t> shape, const void *data) {
         set_buffer(name, type, shape.end() - shape.begin(), shape.begin(), data);
     }
 
+    /// Upload a buffer to the shader parameter with the given handle
+    void set_buffer(size_t handle, VariableType type, size_t ndim,
+                    const size_t *shape, const void *data);
+
+    void set_buffer(size_t handle, VariableType type,
+                    std::initializer_list<size_t> shape, const void *data) {
+        set_buffer(handle, type, shape.end() - shape.begin(), shape.begin(), data);
+    }
+
+    /**
+     * \brief Upload a vertex buffer whose entries contain several attributes
+     *
+     * The buffer holds \c count vertices of \c stride bytes each, and is
+     * stored once on the GPU and shared by all attributes in \c
+     * attributes. Integer components with \ref VertexAttribute::normalized
+     * set are converted to floating point values in <tt>[0, 1]</tt> or
+     * <tt>[-1, 1]</tt>, which allows e.g. storing colors as four \c UInt8
+     * values or normals as three \c Int16 values.
+     *
+     * Attributes that the shader does not declare (or that were optimized
+     * away by the compiler) are skipped, so that a mesh layout can be used
+     * with different shaders. Calling \ref set_buffer() for one of the
+     * attributes later on gives it separate storage again, and \ref
+     * update_buffer_range() overwrites entire interleaved vertices.
+     *
+     * On Metal, vertex functions read the buffer through an argument named
+     * after one of the attributes, declared as a pointer to a struct that
+     * matches the layout. Normalization is then performed by the shader.
+     */
+    void set_interleaved_buffer(const std::vector<VertexAttribute> &attributes,
+                                size_t stride, size_t count, const void *data);
+
+    /**
+     * \brief Overwrite part of a vertex or index buffer that was previously
+     * uploaded using \ref set_buffer().
+     *
+     * \c offset and \c count refer to entries along the first dimension
+     * (e.g. vertices), and \c data must contain \c count entries with the
+     * type and shape that were specified when the buffer was uploaded. Only
+     * the modified bytes are transferred to the GPU.
+     */
+    void update_buffer_range(const std::string &name, size_t offset,
+                             size_t count, const void *data) {
+        update_buffer_range(argument_handle(name), offset, count, data);
+    }
+
+    /// Overwrite part of the buffer with the given handle
+    void update_buffer_range(size_t handle, size_t offset, size_t count,
+                             const void *data);
+
+    /**
+     * \brief Overwrite part of a buffer, validating the type and shape of
+     * the data
+     *
+     * \c shape[0] specifies the number of entries, and the remaining
+     * dimensions must match those of the uploaded buffer.
+     */
+    void update_buffer_range(const std::string &name, size_t offset,
+                             VariableType type, size_t ndim,
+                             const size_t *shape, const void *data) {
+        update_buffer_range(argument_handle(name), offset, type, ndim, shape, data);
+    }
+
+    /// Overwrite part of the buffer with the given handle, validating the data
+    void update_buffer_range(size_t handle, size_t offset, VariableType type,
+                             size_t ndim, const size_t *shape, const void *data);
+
+    /**
+     * \brief Specify how the named vertex or index buffer will be updated
+     *
+     * - \ref BufferUsage::Static and \ref BufferUsage::Dynamic buffers are
+     *   stored in a single allocation. \ref update_buffer_range() only
+     *   transfers the modified bytes, but may wait for pending draw calls
+     *   that read the buffer. On OpenGL, the hint is passed to \c
+     *   glBufferData(). On Metal, both are kept in GPU-private memory.
+     *
+     * - \ref BufferUsage::Stream buffers are meant to be replaced in full
+     *   using \ref set_buffer(). On OpenGL 3 and OpenGL ES 3, each upload
+     *   is written into the next segment of a ring of \ref
+     *   stream_ring_size segments without synchronizing with the GPU. A
+     *   fence guards every segment, hence uploads only block when the GPU
+     *   falls more than two uploads behind. On OpenGL ES 2, the driver
+     *   orphans the previous storage. On Metal, every upload allocates a
+     *   new shared buffer, while buffers referenced by pending command
+     *   buffers are kept alive by Metal. \ref update_buffer_range()
+     *   remains supported for streaming buffers, but is not faster than
+     *   for dynamic ones.
+     *
+     * The usage takes effect at the next call to \ref set_buffer().
+     */
+    void set_buffer_usage(const std::string &name, BufferUsage usage) {
+        set_buffer_usage(argument_handle(name), usage);
+    }
+
+    /// Specify how the buffer with the given handle will be updated
+    void set_buffer_usage(size_t handle, BufferUsage usage);
+
+    /// Return the usage hint of the named vertex or index buffer
+    BufferUsage buffer_usage(const std::string &name) const {
+        return m_buffers[argument_handle(name)].usage;
+    }
+
+    /**
+     * \brief Turn the named vertex attribute into a per-instance attribute
+     *
+     * The attribute advances by one entry every \c divisor instances when
+     * rendering with \ref draw_array_instanced(). The default value \c 0
+     * advances it once per vertex. The shape of the buffer uploaded via
+     * \ref set_buffer() is then <tt>(instances / divisor, components)</tt>.
+     *
+     * On Metal, vertex functions access their buffers explicitly, hence
+     * the divisor is only recorded and per-instance data must be indexed
+     * using the \c [[instance_id]] attribute. OpenGL ES 2 only supports a
+     * divisor of zero.
+     */
+    void set_instance_divisor(const std::string &name, size_t divisor) {
+        set_instance_divisor(argument_handle(name), divisor);
+    }
+
+    /// Set the instance divisor of the vertex attribute with the given handle
+    void set_instance_divisor(size_t handle, size_t divisor);
+
+    /// Return the instance divisor of the named vertex attribute
+    size_t instance_divisor(const std::string &name) const {
+        return m_buffers[argument_handle(name)].divisor;
+    }
+
+    /// Number of segments of the ring used by streaming buffers
+    static const size_t stream_ring_size = 3;
+
     /**
      * \brief Upload a uniform variable (e.g. a vector or matrix) that will be
      * associated with a named shader parameter.
      */
     template <typename Array> void set_uniform(const std::string &name,
                                                const Array &value) {
+        set_uniform(argument_handle(name), value);
+    }
+
+    /// Upload a uniform variable to the shader parameter with the given handle
+    template <typename Array> void set_uniform(size_t handle, const Array &value) {
         size_t shape[3] = { 1, 1, 1 };
         size_t ndim = (size_t) -1;
         const void *data;
@@ -135,7 +312,7 @@ public:
         if (ndim == (size_t) -1)
             throw std::runtime_error("Shader::set_uniform(): invalid input array dimension!");
 
-        set_buffer(name, vtype, ndim, shape, data);
+        set_buffer(handle, vtype, ndim, shape, data);
     }
 
     /**
@@ -143,7 +320,38 @@ public:
      *
      * The association will be replaced if it is already present.
      */
-    void set_texture(const std::string &name, Texture *texture);
+    void set_texture(const std::string &name, Texture *texture) {
+        set_texture(argument_handle(name), texture);
+    }
+
+    /// Associate a texture with the shader parameter with the given handle
+    void set_texture(size_t handle, Texture *texture);
+
+    /**
+     * \brief Associate a range of a uniform buffer with a named uniform block
+     *
+     * On OpenGL, uniform blocks (e.g. <tt>layout(std140) uniform Camera {
+     * ... };</tt>) are discovered when the shader is linked and referenced by
+     * their block name. On Metal, any buffer argument can be associated with
+     * a uniform buffer. \c offset must be a multiple of \ref
+     * UniformBuffer::offset_alignment(), and the buffer must hold the
+     * complete block starting at this offset.
+     *
+     * The binding is re-issued by \ref begin(), hence the same buffer can be
+     * shared by any number of shaders. Per-draw data can be appended using
+     * \ref UniformBuffer::push(), followed by a call to this function with
+     * the returned offset.
+     */
+    void set_uniform_buffer(const std::string &name, nanogui::UniformBuffer *buffer,
+                            size_t offset = 0) {
+        set_uniform_buffer(argument_handle(name), buffer, offset);
+    }
+
+    /// Associate a range of a uniform buffer with the given handle
+    void set_uniform_buffer(size_t handle, nanogui::UniformBuffer *buffer, size_t offset = 0);
+
+    /// Return the size of a uniform block in bytes (as reported by the shader compiler)
+    size_t uniform_block_size(const std::string &name) const;
 
     /**
      * \brief Begin drawing using this shader
@@ -184,6 +392,47 @@ public:
                     size_t offset, size_t count,
                     bool indexed = false);
 
+    /**
+     * \brief Render \c instance_count instances of the geometry using a
+     * single draw call
+     *
+     * The parameters match those of \ref draw_array(). Vertex attributes
+     * with a nonzero divisor (see \ref set_instance_divisor()) advance once
+     * per instance instead of once per vertex. Requires OpenGL 3.3, OpenGL
+     * ES 3, or Metal.
+     */
+    void draw_array_instanced(PrimitiveType primitive_type,
+                              size_t offset, size_t count,
+                              size_t instance_count,
+                              bool indexed = false);
+
+    /**
+     * \brief Set a directory that caches linked shader programs across runs
+     *
+     * When set, the OpenGL backend stores the binary of every linked program
+     * (obtained via \c glGetProgramBinary) along with the reflected
+     * attributes, uniforms, and uniform blocks in this directory. Subsequent
+     * shaders with identical source code are restored from the cache instead
+     * of being compiled and linked. Entries are keyed by the source code and
+     * the driver vendor, renderer, and version string. The shader is
+     * compiled from source if an entry does not match or is rejected by the
+     * driver, and the entry is then replaced.
+     *
+     * The cache is disabled by default (empty string). The directory must
+     * exist. This setting has no effect on Metal and on drivers that do not
+     * support program binaries (OpenGL < 4.1, OpenGL ES 2).
+     */
+    static void set_binary_cache_directory(const std::string &directory);
+
+    /// Return the directory of the program binary cache (empty if disabled)
+    static std::string binary_cache_directory();
+
+    /// Return the number of shaders that were restored from the program binary cache
+    static size_t binary_cache_hits();
+
+    /// Return the number of shaders that were not found in the program binary cache
+    static size_t binary_cache_misses();
+
 #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
     uint32_t shader_handle() const { return m_shader_handle; }
 #elif defined(NANOGUI_USE_METAL)
@@ -205,9 +454,11 @@ protected:
         FragmentSampler,
         UniformBuffer,
         IndexBuffer,
+        UniformBlock,
     };
 
     struct Buffer {
+        std::string name;
         void *buffer = nullptr;
         BufferType type = Unknown;
         VariableType dtype = VariableType::Invalid;
@@ -216,17 +467,87 @@ protected:
         size_t shape[3] { 0, 0, 0 };
         size_t size = 0;
         bool dirty = false;
+        BufferUsage usage = BufferUsage::Dynamic;
+        size_t divisor = 0;
+
+        /// Layout of vertex attributes (a stride of 0 means tightly packed)
+        size_t stride = 0;
+        size_t vertex_offset = 0;
+        size_t components = 0;
+        bool normalized = false;
+        /// Is the storage owned by another attribute of the same interleaved buffer?
+        bool shared = false;
+
+        /// Uniform buffer range associated with a uniform block
+        ref<nanogui::UniformBuffer> block;
+        size_t offset = 0;
+        size_t block_size = 0;
+
+    #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        /// Component type passed to glVertexAttribPointer() (vertex buffers)
+        uint32_t gl_type = 0;
+        /// Texture unit assigned at link time (textures)
+        int texture_unit = -1;
+        /// glUniform*() call matching the dtype and shape (uniforms)
+        void (*uniform_setter)(int index, const void *data) = nullptr;
+        /// Byte offset of the ring segment holding the current contents (streaming buffers)
+        size_t stream_offset = 0;
+        /// Size of each ring segment in bytes (streaming buffers)
+        size_t stream_segment_size = 0;
+        /// Fences signaled once the GPU is done with each ring segment (streaming buffers)
+        void *stream_fences[stream_ring_size] { };
+    #endif
 
         std::string to_string() const;
     };
 
+    /// Append an entry to the binding table (used by the constructor)
+    Buffer &add_buffer(const std::string &name, BufferType type);
+
+    /// Look up a binding table entry, validating the handle
+    Buffer &buffer(size_t handle, const char *caller);
+
+    /**
+     * \brief Validate an interleaved vertex layout and return the handle of
+     * each attribute (or <tt>(size_t) -1</tt> if the shader lacks it)
+     */
+    std::vector<size_t> interleaved_handles(const std::vector<VertexAttribute> &attributes,
+                                            size_t stride);
+
+    /// Record a lookup in the program binary cache
+    static void count_binary_cache_access(bool hit);
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+    /// Compile and link the program, then reflect its parameters
+    void link_program(const std::string &vertex_shader,
+                      const std::string &fragment_shader, bool retrievable);
+
+    /// Restore the program and its parameters from the binary cache
+    bool load_program_binary(const std::string &filename, const std::string &key);
+
+    /// Store the program and its parameters in the binary cache
+    void store_program_binary(const std::string &filename, const std::string &key);
+
+    /// Upload the contents of a vertex or index buffer, allocating it if necessary
+    void upload_buffer(Buffer &buf, const void *data, size_t size);
+
+    /// Write the contents of a streaming buffer into the next segment of its ring
+    void stream_buffer(Buffer &buf, uint32_t target, const void *data, size_t size);
+#endif
+
+    /// Give up the storage of a vertex buffer that is part of an interleaved buffer
+    void detach_buffer(Buffer &buf);
+
     /// Release all resources
     virtual ~Shader();
 
 protected:
     RenderPass* m_render_pass;
     std::string m_name;
-    std::unordered_map<std::string, Buffer> m_buffers;
+    /// Binding table with one entry per shader parameter, addressed by handle
+    std::vector<Buffer> m_buffers;
+    /// Maps parameter names to handles
+    std::unordered_map<std::string, size_t> m_buffer_handles;
     BlendMode m_blend_mode;
 
     #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
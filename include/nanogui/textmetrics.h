@@ -0,0 +1,214 @@
+/*
+    nanogui/textmetrics.h -- Thread-safe text measurement service and LRU
+    cache for text measurements shared by all widgets of a Screen
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct FONScontext;
+
+NAMESPACE_BEGIN(nanogui)
+
+/// Result of measuring a single line of text (see \ref TextMetricsCache)
+struct TextMetrics {
+    /// Horizontal advance (i.e. the return value of ``nvgTextBounds()``)
+    float advance = 0.f;
+
+    /// Bounding box ``[xmin, ymin, xmax, ymax]`` of the text drawn at the origin
+    float bounds[4] { 0.f, 0.f, 0.f, 0.f };
+};
+
+/**
+ * \class TextMetricsService textmetrics.h nanogui/textmetrics.h
+ *
+ * \brief Thread-safe text measurement that does not require a NanoVG context
+ *
+ * NanoVG only measures text through an \c NVGcontext, which may only be
+ * used from the thread that owns the OpenGL/Metal context. This class keeps
+ * its own set of font stashes (NanoVG's glyph metric backend) so that text
+ * can be measured from any thread, which in turn makes it possible to run
+ * \ref Widget::preferred_size() and \ref Widget::perform_layout() off the
+ * render thread (see e.g. \ref GridLayout::set_parallel()).
+ *
+ * The process-wide instance returned by \ref instance() knows about the
+ * fonts embedded by \ref Theme (\c "sans", \c "sans-bold", \c "icons", and
+ * \c "mono"). Applications that load further fonts via
+ * \c nvgCreateFontMem() should register them using \ref add_font() as well;
+ * measurements involving unknown fonts fall back to NanoVG.
+ *
+ * Results match \c nvgTextBounds() for an untransformed NanoVG context
+ * with the given device pixel ratio.
+ */
+class NANOGUI_EXPORT TextMetricsService : public Object {
+public:
+    /// Return the process-wide instance with the fonts of \ref Theme preloaded
+    static TextMetricsService *instance();
+
+    /// Create a measurement service without any fonts
+    TextMetricsService();
+
+    /**
+     * \brief Register a TrueType font stored in memory
+     *
+     * The memory region is not copied and must remain valid for the lifetime
+     * of the service. Registering a name twice has no effect.
+     */
+    void add_font(const std::string &name, const uint8_t *data, size_t size);
+
+    /// Check whether a font with the given name has been registered
+    bool has_font(const std::string &name) const;
+
+    /**
+     * \brief Look up the TrueType data of a registered font
+     *
+     * Returns \c false if \c name has not been registered. This allows other
+     * text backends (e.g. \ref SDFFont) to share the fonts of \ref Theme.
+     */
+    bool font_data(const std::string &name, const uint8_t **data,
+                   size_t *size) const;
+
+    /**
+     * \brief Measure a single line of text
+     *
+     * Returns \c false (and leaves \c metrics untouched) if \c font has not
+     * been registered. Safe to call concurrently from multiple threads.
+     */
+    bool measure(const std::string &font, float font_size, int align,
+                 const std::string &text, float pixel_ratio,
+                 TextMetrics &metrics) const;
+
+protected:
+    /// Release all font stashes
+    virtual ~TextMetricsService();
+
+    /// Create a font stash containing all registered fonts
+    FONScontext *create_stash() const;
+
+    /// Remove a font stash from the pool (or create a new one)
+    FONScontext *acquire_stash() const;
+
+    /// Return a font stash to the pool
+    void release_stash(FONScontext *stash) const;
+
+protected:
+    struct Font {
+        std::string name;
+        const uint8_t *data;
+        size_t size;
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<Font> m_fonts;
+    /// Idle font stashes, one is needed per concurrently measuring thread
+    mutable std::vector<FONScontext *> m_pool;
+    /// All font stashes created so far (idle or in use)
+    mutable std::vector<FONScontext *> m_stashes;
+};
+
+/**
+ * \class TextMetricsCache textmetrics.h nanogui/textmetrics.h
+ *
+ * \brief Least-recently-used cache of text measurements
+ *
+ * Computing the extents of a string via ``nvgTextBounds()`` requires a
+ * glyph lookup for every character. Widgets re-measure the same captions
+ * during every layout pass and often during every frame, hence each \ref
+ * Screen owns an instance of this class that memoizes measurements keyed by
+ * font face, font size, alignment and string contents.
+ *
+ * Widgets normally access the cache via \ref Widget::measure_text(). The
+ * cache is thread-safe and obtains measurements from \ref
+ * TextMetricsService, so it can be queried during off-thread layout.
+ */
+class NANOGUI_EXPORT TextMetricsCache : public Object {
+public:
+    /// Create an empty cache holding up to \c capacity measurements
+    TextMetricsCache(size_t capacity = 4096);
+
+    /**
+     * \brief Measure a single line of text
+     *
+     * Returns the cached metrics and only measures the string on a cache
+     * miss. The NanoVG context \c ctx is merely used as a fallback for
+     * fonts that are unknown to \ref TextMetricsService; its state is saved
+     * and restored in this case. The font state of \c ctx is otherwise left
+     * untouched, hence drawing code must set it explicitly.
+     */
+    TextMetrics measure(NVGcontext *ctx, const std::string &font,
+                        float font_size, int align, const std::string &text);
+
+    /**
+     * \brief Inform the cache about the device pixel ratio used by NanoVG
+     *
+     * NanoVG measures text at the device resolution, hence results change
+     * slightly with the pixel ratio. The cache is cleared when it changes.
+     */
+    void set_pixel_ratio(float pixel_ratio);
+
+    /// Return the maximum number of cached measurements
+    size_t capacity() const { return m_capacity; }
+
+    /// Set the maximum number of cached measurements (evicts as needed)
+    void set_capacity(size_t capacity);
+
+    /// Return the number of cached measurements
+    size_t size() const;
+
+    /// Remove all cached measurements
+    void clear();
+
+    /// Return the number of lookups that were answered from the cache
+    size_t hits() const;
+
+    /// Return the number of lookups that required measuring the string
+    size_t misses() const;
+
+    /// Return the fraction of lookups answered from the cache
+    float hit_rate() const;
+
+    /// Reset the hit/miss counters
+    void reset_statistics();
+
+protected:
+    struct Entry {
+        uint64_t hash;
+        std::string font;
+        float font_size;
+        int align;
+        std::string text;
+        TextMetrics metrics;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    /// Look up an entry and move it to the front (caller must hold the lock)
+    bool lookup(uint64_t hash, const std::string &font, float font_size,
+                int align, const std::string &text, TextMetrics &metrics);
+
+    /// Shrink the cache down to its capacity (caller must hold the lock)
+    void evict();
+
+protected:
+    mutable std::mutex m_mutex;
+    EntryList m_entries; // most recently used entries first
+    std::unordered_map<uint64_t, EntryList::iterator> m_lookup;
+    size_t m_capacity;
+    size_t m_hits = 0, m_misses = 0;
+    float m_pixel_ratio = 0.f;
+};
+
+NAMESPACE_END(nanogui)
@@ -19,9 +19,88 @@
 #include <nanogui/object.h>
 #include <nanogui/vector.h>
 #include <nanogui/traits.h>
+#include <memory>
+#include <vector>
 
 NAMESPACE_BEGIN(nanogui)
 
+/**
+ * \class TextureTransfer texture.h nanogui/texture.h
+ *
+ * \brief Handle to an asynchronous transfer between CPU and GPU memory
+ *
+ * Returned by \ref Texture::begin_upload(), \ref Texture::upload_async(), and
+ * \ref Texture::download_async(). The pixel data is staged in a buffer that
+ * the GPU reads from or writes to (a pixel buffer object on OpenGL and
+ * OpenGL ES 3, a shared buffer on Metal), and \ref ready() reports when the
+ * GPU has finished the copy.
+ *
+ * The staging memory returned by \ref data() may be filled from any thread,
+ * but all other functions must be called from the thread that owns the
+ * graphics context.
+ */
+class NANOGUI_EXPORT TextureTransfer : public Object {
+public:
+    /// Return the staging memory (only valid until the transfer is submitted)
+    uint8_t *data() { return m_data; }
+
+    /// Return the size of the staging memory in bytes
+    size_t size() const { return m_bytes; }
+
+    /// Return the origin of the texture region
+    const Vector2i &region_origin() const { return m_origin; }
+
+    /// Return the size of the texture region
+    const Vector2i &region_size() const { return m_size; }
+
+    /// Return whether this transfer reads back from the texture
+    bool is_download() const { return m_download; }
+
+    /// Return whether the GPU has finished the transfer (doesn't block)
+    bool ready();
+
+    /// Block until the GPU has finished the transfer
+    void wait();
+
+protected:
+    friend class Texture;
+
+    enum class State : uint8_t {
+        /// No transfer in progress, the staging buffer can be reused
+        Idle,
+
+        /// Staging memory is being filled by the caller
+        Mapped,
+
+        /// Submitted to the GPU
+        Pending
+    };
+
+    TextureTransfer(Texture *texture, bool download)
+        : m_texture(texture), m_download(download) { }
+
+    /// Release all resources
+    virtual ~TextureTransfer();
+
+protected:
+    Texture *m_texture;
+    bool m_download;
+    State m_state = State::Idle;
+    Vector2i m_origin = 0, m_size = 0;
+    uint8_t *m_data = nullptr;
+    size_t m_bytes = 0, m_capacity = 0;
+    /// CPU staging memory (used when the backend lacks pixel buffer objects)
+    std::unique_ptr<uint8_t[]> m_staging;
+
+    #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        uint32_t m_buffer = 0;
+        void *m_fence = nullptr;
+    #elif defined(NANOGUI_USE_METAL)
+        void *m_buffer = nullptr;
+        void *m_command_buffer = nullptr;
+    #endif
+};
+
 class NANOGUI_EXPORT Texture : public Object {
 public:
     /// Overall format of the texture (e.g. luminance-only or RGBA)
@@ -120,7 +199,7 @@ public:
             uint8_t flags = (uint8_t) TextureFlags::ShaderRead,
             bool mipmap_manual = false);
 
-    /// Load an image from the given file using stb-image
+    /// Load an image from the given file using stb-image (see \ref ImageLoader for bulk loading)
     Texture(const std::string &filename,
             InterpolationMode min_interpolation_mode = InterpolationMode::Bilinear,
             InterpolationMode mag_interpolation_mode = InterpolationMode::Bilinear,
@@ -159,15 +238,115 @@ public:
     /// Upload packed pixel data from the CPU to the GPU
     void upload(const uint8_t *data);
 
-    /// Upload packed pixel data to a rectangular sub-region of the texture from the CPU to the GPU
-    void upload_sub_region(const uint8_t *data, const Vector2i& origin, const Vector2i& size);
+    /**
+     * \brief Convert packed pixel data to the format of the texture and
+     * upload it from the CPU to the GPU
+     *
+     * The data is converted using \ref convert_pixels() (e.g. to swizzle BGR
+     * data, pad RGB data with an alpha channel, or convert single to half
+     * precision), which is skipped when the formats already match.
+     *
+     * \param srgb
+     *     Encode the color channels using the sRGB transfer function
+     */
+    void upload(const uint8_t *data, PixelFormat pixel_format,
+                ComponentFormat component_format, bool srgb = false);
+
+    /**
+     * \brief Upload pixel data to a rectangular sub-region of the texture from the CPU to the GPU
+     *
+     * \param data
+     *     Pointer to the source image
+     *
+     * \param origin
+     *     Position of the region within the texture
+     *
+     * \param size
+     *     Size of the region
+     *
+     * \param row_stride
+     *     Distance between consecutive rows of the source image in bytes
+     *     (must be a multiple of \ref bytes_per_pixel()). The default value
+     *     of zero refers to packed rows of \c size.x() pixels.
+     *
+     * \param source_origin
+     *     Position of the region within the source image. Together with \c
+     *     row_stride, this allows uploading a rectangle of a larger image
+     *     (e.g. the dirty region of a CPU framebuffer) without copying it to
+     *     a temporary buffer first.
+     */
+    void upload_sub_region(const uint8_t *data, const Vector2i& origin, const Vector2i& size,
+                           size_t row_stride = 0, const Vector2i &source_origin = Vector2i(0));
+
+    /**
+     * \brief Begin an asynchronous upload to a rectangular sub-region of the texture
+     *
+     * Returns a handle whose staging memory (\ref TextureTransfer::data())
+     * must be filled with packed pixel data, possibly from a worker thread,
+     * before calling \ref submit_upload(). Staging buffers are recycled from
+     * a ring of \ref transfer_ring_size entries, so that a frame can be filled
+     * while the GPU is still copying the previous ones. This function only
+     * blocks when all buffers of the ring are still in use by the GPU.
+     */
+    ref<TextureTransfer> begin_upload(const Vector2i &origin, const Vector2i &size);
+
+    /**
+     * \brief Issue the transfer of an upload started with \ref begin_upload()
+     *
+     * Returns immediately. The texture contents are updated before any
+     * subsequent draw call that reads from the texture executes on the GPU.
+     */
+    void submit_upload(TextureTransfer *transfer);
+
+    /**
+     * \brief Upload packed pixel data to a sub-region of the texture without
+     * waiting for the transfer to complete
+     *
+     * Copies the data into a staging buffer and then behaves like \ref
+     * submit_upload(). The parameters match those of \ref upload_sub_region().
+     */
+    ref<TextureTransfer> upload_async(const uint8_t *data, const Vector2i &origin,
+                                      const Vector2i &size, size_t row_stride = 0,
+                                      const Vector2i &source_origin = Vector2i(0));
+
+    /// Number of staging buffers used by asynchronous uploads and downloads (each)
+    static const size_t transfer_ring_size = 3;
 
     /// Download packed pixel data from the GPU to the CPU
     void download(uint8_t *data);
 
+    /**
+     * \brief Start downloading the texture without waiting for the GPU
+     *
+     * Copies the texture into a staging buffer on the GPU timeline, which
+     * avoids the pipeline stall of \ref download(). Poll \ref
+     * TextureTransfer::ready() on later frames, and retrieve the pixels
+     * using \ref finish_download() once it returns \c true. Staging
+     * buffers are recycled after \ref transfer_ring_size further downloads.
+     */
+    ref<TextureTransfer> download_async();
+
+    /**
+     * \brief Copy the result of \ref download_async() to packed CPU memory
+     *
+     * Blocks if the transfer hasn't completed yet. Rows of render targets
+     * are flipped as in \ref download().
+     */
+    void finish_download(TextureTransfer *transfer, uint8_t *data);
+
     /// Resize the texture (discards the current contents)
     void resize(const Vector2i &size);
 
+    /**
+     * \brief Return the number of times that texture storage was allocated
+     *
+     * This counter is shared by all textures and increases whenever storage
+     * is (re-)specified, e.g. on construction, \ref resize(), or a full
+     * \ref upload() in the OpenGL backend. Sampling it periodically reveals
+     * reallocations caused by resizing render targets.
+     */
+    static size_t allocation_count();
+
     /// Generates the mipmap. Done automatically upon upload if manual mipmapping is disabled.
     void generate_mipmap();
 
@@ -183,6 +362,20 @@ protected:
     /// Initialize the texture handle
     void init();
 
+    /// Validate the stride of a source image and return the address of the region within it
+    const uint8_t *source_region(const char *func, const uint8_t *data, const Vector2i &size,
+                                 size_t &row_stride, const Vector2i &source_origin) const;
+
+    /// Provide staging memory of the given size for an upload
+    void map_upload(TextureTransfer *transfer, size_t bytes);
+
+    /// Return the next staging buffer of a ring, waiting for the GPU if necessary
+    ref<TextureTransfer> next_transfer(std::vector<ref<TextureTransfer>> &ring,
+                                       size_t &index, bool download, const char *caller);
+
+    /// Increase the counter returned by \ref allocation_count()
+    static void count_allocation();
+
     /// Release all resources
     virtual ~Texture();
 
@@ -197,6 +390,10 @@ protected:
     Vector2i m_size;
     bool m_mipmap_manual;
 
+    /// Staging buffers of asynchronous transfers, reused round-robin
+    std::vector<ref<TextureTransfer>> m_upload_ring, m_download_ring;
+    size_t m_upload_index = 0, m_download_index = 0;
+
     #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
         uint32_t m_texture_handle = 0;
         uint32_t m_renderbuffer_handle = 0;
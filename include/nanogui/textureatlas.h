@@ -0,0 +1,171 @@
+/*
+    nanogui/textureatlas.h -- Packs small images into shared texture pages
+    that can be drawn using NanoVG
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/texture.h>
+#include <unordered_map>
+#include <vector>
+
+struct NVGpaint;
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \brief Expose a texture as a NanoVG image
+ *
+ * The texture must use the \c RGBA pixel format and the \c UInt8 component
+ * format. NanoVG does not take ownership: the texture must outlive all uses
+ * of the returned image handle.
+ */
+extern NANOGUI_EXPORT int nvg_texture_image(NVGcontext *ctx, Texture *texture);
+
+/**
+ * \class TextureAtlas textureatlas.h nanogui/textureatlas.h
+ *
+ * \brief Dynamic texture atlas for icons and other small images
+ *
+ * Every NanoVG image is a separate texture, and NanoVG must switch textures
+ * whenever consecutive draw calls reference different images. This class
+ * packs many small RGBA images into a few large pages (see \ref
+ * nvg_texture_image()), which are referenced by sub-rectangles.
+ *
+ * Each page is filled by a skyline packer (the same strategy that NanoVG's
+ * font atlas uses). New pages are allocated when the existing ones are full.
+ * If a page limit is set and eviction is enabled, the least recently used
+ * page is cleared instead, which invalidates the identifiers of the images
+ * it contained.
+ *
+ * The NanoVG images of the pages are released when the atlas is destroyed,
+ * which must therefore happen before the NanoVG context is deleted.
+ */
+class NANOGUI_EXPORT TextureAtlas : public Object {
+public:
+    /// Location of an image within the atlas
+    struct Entry {
+        /// NanoVG image of the page containing the entry
+        int image;
+        /// Index of the page containing the entry
+        int page;
+        /// Position of the entry within the page in pixels
+        Vector2i origin;
+        /// Size of the entry in pixels
+        Vector2i size;
+    };
+
+    /**
+     * \brief Create an empty texture atlas
+     *
+     * \param page_size
+     *     Size of an atlas page in pixels
+     *
+     * \param max_pages
+     *     Maximum number of pages (0: unlimited)
+     *
+     * \param padding
+     *     Border around every entry that replicates its edge pixels, which
+     *     prevents neighboring entries from bleeding into each other when
+     *     they are drawn using bilinear interpolation
+     */
+    TextureAtlas(const Vector2i &page_size = Vector2i(1024), size_t max_pages = 0,
+                 int padding = 1);
+
+    /// Return the size of an atlas page in pixels
+    const Vector2i &page_size() const { return m_page_size; }
+
+    /// Return the maximum number of pages (0: unlimited)
+    size_t max_pages() const { return m_max_pages; }
+
+    /// Should the least recently used page be cleared when all pages are full?
+    bool eviction() const { return m_eviction; }
+
+    /// Specify whether the least recently used page should be cleared when all pages are full
+    void set_eviction(bool eviction) { m_eviction = eviction; }
+
+    /**
+     * \brief Add an RGBA image (8 bits per component) to the atlas
+     *
+     * Returns an identifier for \ref lookup(), or \c -1 if the atlas is
+     * full and eviction is disabled. Throws an exception if the image is
+     * larger than a page.
+     */
+    int add(NVGcontext *ctx, const uint8_t *rgba, const Vector2i &size);
+
+    /**
+     * \brief Look up an image and mark its page as recently used
+     *
+     * Returns \c false if the identifier is unknown or the image was evicted.
+     */
+    bool lookup(int id, Entry &entry);
+
+    /// Remove an image (its space is reclaimed when the page is cleared)
+    void remove(int id);
+
+    /// Create a NanoVG paint that maps an entry onto the rectangle (x, y, w, h)
+    NVGpaint pattern(NVGcontext *ctx, const Entry &entry, float x, float y,
+                     float w, float h, float alpha) const;
+
+    /// Return the number of allocated pages
+    size_t page_count() const { return m_pages.size(); }
+
+    /// Return the texture of a page
+    Texture *page_texture(size_t page) { return m_pages[page].texture; }
+
+    /// Return the number of images stored in the atlas
+    size_t entry_count() const { return m_entries.size(); }
+
+    /// Return the number of pages that were cleared to make room for new images
+    size_t eviction_count() const { return m_eviction_count; }
+
+protected:
+    /// Horizontal segment of the skyline of a page
+    struct Node {
+        int x, y, width;
+    };
+
+    struct Page {
+        ref<Texture> texture;
+        int image;
+        std::vector<Node> skyline;
+        std::vector<int> entries;
+        size_t last_use;
+    };
+
+    /// Allocate a new page
+    void add_page(NVGcontext *ctx);
+
+    /// Remove all entries of a page and reset its skyline
+    void clear_page(Page &page);
+
+    /// Find space for a rectangle of the given size within a page
+    static bool pack(Page &page, const Vector2i &page_size, const Vector2i &size,
+                     Vector2i &origin);
+
+    /// Release all resources
+    virtual ~TextureAtlas();
+
+protected:
+    /// NanoVG context that owns the page images
+    NVGcontext *m_nvg_context = nullptr;
+    Vector2i m_page_size;
+    size_t m_max_pages;
+    int m_padding;
+    bool m_eviction = false;
+    std::vector<Page> m_pages;
+    std::unordered_map<int, Entry> m_entries;
+    int m_next_id = 0;
+    size_t m_use_count = 0;
+    size_t m_eviction_count = 0;
+};
+
+NAMESPACE_END(nanogui)
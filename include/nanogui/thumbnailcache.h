@@ -0,0 +1,224 @@
+/*
+    nanogui/thumbnailcache.h -- Generates image thumbnails using background
+    threads and packs them into atlas textures
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/texture.h>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class ThumbnailCache thumbnailcache.h nanogui/thumbnailcache.h
+ *
+ * \brief Cache of square image thumbnails stored in atlas textures
+ *
+ * Thumbnails are generated by a pool of worker threads, which decode the
+ * image file, crop it to a centered square and reduce it to \ref resolution()
+ * pixels using a box filter. Finished thumbnails are uploaded by \ref
+ * begin_frame() into the slots of atlas pages (square RGBA textures that are
+ * also exposed as NanoVG images), so that GPU memory grows with the number of
+ * thumbnails rather than with the resolution of the images. Once \ref
+ * capacity() thumbnails are resident, the least recently used ones are
+ * replaced. As in \ref TileCache, requests that were not repeated in the
+ * previous frame are discarded.
+ *
+ * If a cache directory is specified, generated thumbnails are also stored
+ * on disk, keyed by a hash of the file contents and the resolution. Renamed
+ * or copied files thus reuse their thumbnail, while modified files receive a
+ * new one.
+ *
+ * The NanoVG images of the atlas pages are released when the cache is
+ * destroyed, which must therefore happen before the NanoVG context is deleted.
+ */
+class NANOGUI_EXPORT ThumbnailCache : public Object {
+public:
+    /// Function that is called (from a worker thread) when a thumbnail was generated
+    using Callback = std::function<void()>;
+
+    /**
+     * \brief Create a thumbnail cache
+     *
+     * \param resolution
+     *     Width and height of the thumbnails in pixels
+     *
+     * \param capacity
+     *     Maximum number of thumbnails that are resident on the GPU
+     *
+     * \param cache_directory
+     *     Directory storing thumbnails on disk (empty: disable the disk cache).
+     *     The directory must exist.
+     *
+     * \param threads
+     *     Number of worker threads (0: choose automatically)
+     */
+    ThumbnailCache(int resolution, size_t capacity = 4096,
+                   const std::string &cache_directory = "", size_t threads = 0);
+
+    /// Return the width and height of the thumbnails in pixels
+    int resolution() const { return m_resolution; }
+
+    /// Return the maximum number of thumbnails that are resident on the GPU
+    size_t capacity() const { return m_capacity; }
+
+    /**
+     * \brief Set the maximum number of thumbnails that are resident on the GPU
+     *
+     * Atlas pages are allocated on demand. Lowering the capacity does not
+     * release pages that were already allocated.
+     */
+    void set_capacity(size_t capacity);
+
+    /// Return the directory storing thumbnails on disk
+    const std::string &cache_directory() const { return m_cache_directory; }
+
+    /// Set a function that is called (from a worker thread) when a thumbnail was generated
+    void set_callback(const Callback &callback);
+
+    /// Return the maximum number of thumbnails uploaded per frame
+    size_t upload_limit() const { return m_upload_limit; }
+
+    /// Set the maximum number of thumbnails uploaded per frame
+    void set_upload_limit(size_t upload_limit) { m_upload_limit = upload_limit; }
+
+    /// Return the size of an atlas page in pixels
+    Vector2i page_size() const { return Vector2i(m_page_slots * m_resolution); }
+
+    /// Return the number of allocated atlas pages
+    size_t page_count() const { return m_pages.size(); }
+
+    /// Return the texture of an atlas page
+    Texture *page_texture(size_t page) { return m_pages[page].texture; }
+
+    /**
+     * \brief Start a new frame and upload thumbnails that finished loading
+     *
+     * Atlas pages are allocated on demand and registered with the NanoVG
+     * context \c ctx. Returns \c true if thumbnails are still being
+     * generated, in which case the caller should schedule another frame.
+     */
+    bool begin_frame(NVGcontext *ctx);
+
+    /**
+     * \brief Look up the thumbnail of an image file and mark it as recently used
+     *
+     * If the thumbnail is resident, returns \c true and writes the NanoVG
+     * image of its atlas page to \c image and the position of the thumbnail
+     * within that page (in pixels) to \c origin. Otherwise, the thumbnail
+     * is requested if \c request is set.
+     */
+    bool lookup(const std::string &filename, bool request, int &image,
+                Vector2i &origin);
+
+    /// Discard all resident thumbnails and pending requests
+    void clear();
+
+    /// Return the number of resident thumbnails
+    size_t resident_count() const { return m_resident.size(); }
+
+    /// Return the number of thumbnails uploaded so far
+    size_t load_count() const { return m_load_count; }
+
+    /// Return the number of thumbnails evicted so far
+    size_t eviction_count() const { return m_eviction_count; }
+
+    /// Return the number of thumbnails that were found in the disk cache
+    size_t disk_hit_count() const { return m_disk_hit_count; }
+
+    /**
+     * \brief Crop an RGBA image to a centered square and reduce it to
+     * <tt>resolution * resolution</tt> pixels using a box filter
+     *
+     * Images smaller than the thumbnail are magnified using nearest neighbor
+     * interpolation.
+     */
+    static void downsample(const uint8_t *rgba, const Vector2i &size,
+                           int resolution, uint8_t *out);
+
+protected:
+    struct Resident {
+        std::string filename;
+        int slot;
+    };
+
+    struct Request {
+        size_t frame;
+    };
+
+    struct Loaded {
+        std::string filename;
+        std::unique_ptr<uint8_t[]> pixels;
+        bool disk_hit;
+    };
+
+    struct Page {
+        ref<Texture> texture;
+        int nvg_image;
+    };
+
+    /// Main function of the worker threads
+    void worker();
+
+    /// Generate a thumbnail (or load it from the disk cache)
+    bool generate(const std::string &filename, uint8_t *out, bool &disk_hit);
+
+    /// Return a free atlas slot, allocating a page or evicting a thumbnail if needed
+    int allocate_slot(NVGcontext *ctx);
+
+    /// Release all resources
+    virtual ~ThumbnailCache();
+
+protected:
+    int m_resolution;
+    size_t m_capacity;
+    std::string m_cache_directory;
+    int m_page_slots;
+    size_t m_upload_limit = 32;
+
+    /* Atlas pages and slots (only accessed by the rendering thread) */
+    NVGcontext *m_nvg_context = nullptr;
+    std::vector<Page> m_pages;
+    size_t m_slot_count = 0;
+    std::vector<int> m_free_slots;
+
+    /// Resident thumbnails, most recently used first
+    std::list<Resident> m_resident;
+    std::unordered_map<std::string, std::list<Resident>::iterator> m_resident_lookup;
+    size_t m_load_count = 0, m_eviction_count = 0, m_disk_hit_count = 0;
+
+    /// Files whose thumbnail could not be generated (not requested again)
+    std::unordered_set<std::string> m_failed;
+
+    /* State shared with the worker threads (protected by m_mutex) */
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::unordered_map<std::string, Request> m_requests;
+    std::vector<std::string> m_queue;
+    std::vector<Loaded> m_loaded;
+    size_t m_in_flight = 0;
+    size_t m_frame = 0;
+    bool m_shutdown = false;
+    Callback m_callback;
+
+    std::vector<std::thread> m_workers;
+};
+
+NAMESPACE_END(nanogui)
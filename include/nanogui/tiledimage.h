@@ -0,0 +1,252 @@
+/*
+    nanogui/tiledimage.h -- Multi-resolution tile sources and a GPU tile
+    cache that streams tiles using background threads
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <nanogui/vector.h>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class TileSource tiledimage.h nanogui/tiledimage.h
+ *
+ * \brief Interface to images that are too large to be loaded at once
+ *
+ * The image is organized as a pyramid of resolution levels. Level 0 has the
+ * full resolution, and every subsequent level halves the width and height
+ * (rounding up). Each level is split into square tiles of \ref tile_size()
+ * pixels, which are loaded on demand by \ref TileCache.
+ */
+class NANOGUI_EXPORT TileSource : public Object {
+public:
+    /// Return the size of the image at full resolution
+    virtual Vector2i size() const = 0;
+
+    /// Return the width and height of a tile in pixels
+    virtual int tile_size() const = 0;
+
+    /**
+     * \brief Return the number of resolution levels
+     *
+     * The default implementation adds levels until the entire image fits
+     * into a single tile.
+     */
+    virtual int level_count() const;
+
+    /// Return the size of the image at the given resolution level
+    Vector2i level_size(int level) const;
+
+    /// Return the number of tiles along each axis at the given resolution level
+    Vector2i tile_count(int level) const;
+
+    /**
+     * \brief Load a tile
+     *
+     * Writes <tt>tile_size() * tile_size()</tt> RGBA pixels (8 bits per
+     * component) to \c rgba. Pixels outside of the image may be left
+     * uninitialized. This function is called from worker threads, possibly
+     * concurrently, and should return \c false if the tile could not be
+     * loaded.
+     */
+    virtual bool load_tile(int level, const Vector2i &tile, uint8_t *rgba) = 0;
+};
+
+/**
+ * \class DirectoryTileSource tiledimage.h nanogui/tiledimage.h
+ *
+ * \brief Loads tiles from image files stored as <tt>directory/level/x_y.ext</tt>
+ *
+ * Any file format supported by stb_image (PNG, JPEG, ...) can be used.
+ */
+class NANOGUI_EXPORT DirectoryTileSource : public TileSource {
+public:
+    /**
+     * \brief Create a tile source for a directory of tiles
+     *
+     * \param directory
+     *     Directory containing one subdirectory per resolution level
+     *
+     * \param size
+     *     Size of the image at full resolution
+     *
+     * \param tile_size
+     *     Width and height of a tile in pixels (tiles at the right and bottom
+     *     border may be smaller)
+     *
+     * \param extension
+     *     File extension of the tiles
+     */
+    DirectoryTileSource(const std::string &directory, const Vector2i &size,
+                        int tile_size = 256, const std::string &extension = "png");
+
+    virtual Vector2i size() const override { return m_size; }
+    virtual int tile_size() const override { return m_tile_size; }
+    virtual bool load_tile(int level, const Vector2i &tile, uint8_t *rgba) override;
+
+protected:
+    std::string m_directory;
+    Vector2i m_size;
+    int m_tile_size;
+    std::string m_extension;
+};
+
+/**
+ * \class TileCache tiledimage.h nanogui/tiledimage.h
+ *
+ * \brief Fixed-size GPU cache of image tiles with LRU eviction
+ *
+ * The tiles are stored in the slots of a single RGBA texture. Tiles that
+ * are requested but not resident are loaded by a pool of worker threads,
+ * most recent requests first. Requests that were not repeated in the
+ * previous frame are discarded, so that the workers only process tiles
+ * that are still visible. Loaded tiles are uploaded by \ref begin_frame()
+ * (at most \ref upload_limit() per frame to keep zooming interactive),
+ * replacing the least recently used tiles. Loaded tiles that are no longer
+ * requested by the time they would be uploaded are discarded as well.
+ *
+ * GPU memory is bounded by the cache capacity, and CPU memory by the number
+ * of tiles that are visible at once (but at most the cache capacity).
+ */
+class NANOGUI_EXPORT TileCache : public Object {
+public:
+    /// Function that is called (from a worker thread) when a tile was loaded
+    using Callback = std::function<void()>;
+
+    /**
+     * \brief Create a tile cache
+     *
+     * \param source
+     *     Source of the tiles
+     *
+     * \param capacity
+     *     Number of tiles that can be resident on the GPU
+     *
+     * \param threads
+     *     Number of worker threads (0: choose automatically)
+     */
+    TileCache(TileSource *source, size_t capacity = 256, size_t threads = 0);
+
+    /// Return the source of the tiles
+    TileSource *source() { return m_source; }
+    /// Return the source of the tiles (const version)
+    const TileSource *source() const { return m_source.get(); }
+
+    /// Return the texture that stores the resident tiles
+    Texture *texture() { return m_texture; }
+    /// Return the texture that stores the resident tiles (const version)
+    const Texture *texture() const { return m_texture.get(); }
+
+    /// Set a function that is called (from a worker thread) when a tile was loaded
+    void set_callback(const Callback &callback);
+
+    /// Return the maximum number of tiles uploaded per frame
+    size_t upload_limit() const { return m_upload_limit; }
+
+    /// Set the maximum number of tiles uploaded per frame
+    void set_upload_limit(size_t upload_limit) { m_upload_limit = upload_limit; }
+
+    /**
+     * \brief Start a new frame and upload tiles that finished loading
+     *
+     * Returns \c true if tiles are still being loaded, in which case the
+     * caller should schedule another frame.
+     */
+    bool begin_frame();
+
+    /**
+     * \brief Look up a tile and mark it as recently used
+     *
+     * If the tile is resident, returns \c true and writes the region it
+     * occupies within \ref texture() (in texture coordinates) to \c uv_min
+     * and \c uv_max. Otherwise, the tile is requested if \c request is set.
+     */
+    bool lookup(int level, const Vector2i &tile, bool request,
+                Vector2f &uv_min, Vector2f &uv_max);
+
+    /// Return the number of resident tiles
+    size_t resident_count() const { return m_resident.size(); }
+
+    /// Return the number of tiles loaded so far
+    size_t load_count() const { return m_load_count; }
+
+    /// Return the number of tiles evicted so far
+    size_t eviction_count() const { return m_eviction_count; }
+
+protected:
+    using Key = uint64_t;
+
+    static Key key(int level, const Vector2i &tile) {
+        return ((Key) level << 48) | ((Key) (uint32_t) tile.y() << 24) |
+               (Key) (uint32_t) tile.x();
+    }
+
+    struct Resident {
+        Key key;
+        int slot;
+    };
+
+    struct Request {
+        int level;
+        Vector2i tile;
+        size_t frame;
+    };
+
+    struct Loaded {
+        Key key;
+        std::unique_ptr<uint8_t[]> pixels;
+    };
+
+    /// Main function of the worker threads
+    void worker();
+
+    /// Release all resources
+    virtual ~TileCache();
+
+protected:
+    ref<TileSource> m_source;
+    ref<Texture> m_texture;
+    int m_tile_size;
+    size_t m_capacity;
+    Vector2i m_slots;
+    size_t m_upload_limit = 8;
+
+    /// Resident tiles, most recently used first
+    std::list<Resident> m_resident;
+    std::unordered_map<Key, std::list<Resident>::iterator> m_resident_lookup;
+    std::vector<int> m_free_slots;
+    size_t m_load_count = 0, m_eviction_count = 0;
+
+    /* State shared with the worker threads (protected by m_mutex) */
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::unordered_map<Key, Request> m_requests;
+    std::vector<Key> m_queue;
+    std::vector<Loaded> m_loaded;
+    size_t m_in_flight = 0;
+    size_t m_frame = 0;
+    bool m_shutdown = false;
+    Callback m_callback;
+
+    std::vector<std::thread> m_workers;
+};
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,105 @@
+/*
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+/**
+ * \file nanogui/uniformbuffer.h
+ *
+ * \brief Defines an abstraction for GPU buffers that back uniform blocks
+ * in OpenGL (3.3+, ES 3) and Metal.
+ */
+
+#pragma once
+
+#include <nanogui/object.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class UniformBuffer uniformbuffer.h nanogui/uniformbuffer.h
+ *
+ * \brief GPU buffer holding the contents of one or more uniform blocks
+ *
+ * A range of the buffer is associated with a uniform block of a shader
+ * using \ref Shader::set_uniform_buffer(). On OpenGL, uniform blocks must be
+ * declared with the \c std140 layout (e.g. <tt>layout(std140) uniform Camera
+ * { mat4 view; mat4 proj; };</tt>), and the data written to the buffer must
+ * follow the same layout. \ref Matrix4f, \ref Vector4f and \ref Color match
+ * it directly, while 3D vectors and scalar arrays are padded to 16 bytes.
+ *
+ * Two usage patterns are supported:
+ *
+ * - Shared data (e.g. camera matrices) is written once per frame using \ref
+ *   upload() and bound by any number of shaders.
+ *
+ * - Per-draw data is appended using \ref push(), which returns the offset of
+ *   a freshly allocated range. When the end of the buffer is reached, the
+ *   storage is orphaned and allocation restarts at the beginning, so that
+ *   ranges referenced by pending draw calls are never overwritten. Orphaning
+ *   discards the previous contents, hence the two patterns should use
+ *   separate buffers.
+ */
+class NANOGUI_EXPORT UniformBuffer : public Object {
+public:
+    /// Allocate a uniform buffer with the given size in bytes
+    UniformBuffer(size_t size);
+
+    /// Return the size of the buffer in bytes
+    size_t size() const { return m_size; }
+
+    /**
+     * \brief Return the required alignment of ranges bound to a uniform
+     * block (e.g. 256 bytes on many GPUs)
+     */
+    size_t offset_alignment() const { return m_offset_alignment; }
+
+    /// Overwrite \c size bytes of the buffer starting at \c offset
+    void upload(const void *data, size_t size, size_t offset = 0);
+
+    /**
+     * \brief Copy \c size bytes into the next free range of the buffer and
+     * return its offset
+     *
+     * The offset is a multiple of \ref offset_alignment(). The data is
+     * written without synchronizing with the GPU.
+     */
+    size_t push(const void *data, size_t size);
+
+    /// Return how many times \ref push() wrapped around and orphaned the storage
+    size_t orphan_count() const { return m_orphan_count; }
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+    uint32_t buffer_handle() const { return m_buffer_handle; }
+#elif defined(NANOGUI_USE_METAL)
+    void *buffer_handle() const { return m_buffer_handle; }
+#endif
+
+protected:
+    /// Write data to the buffer, optionally without synchronizing with the GPU
+    void write(const void *data, size_t size, size_t offset, bool unsynchronized);
+
+    /// Replace the storage while pending draw calls keep using the old one
+    void orphan();
+
+    /// Release all resources
+    virtual ~UniformBuffer();
+
+protected:
+    size_t m_size;
+    size_t m_offset_alignment = 256;
+    size_t m_head = 0;
+    size_t m_orphan_count = 0;
+
+    #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        uint32_t m_buffer_handle = 0;
+    #elif defined(NANOGUI_USE_METAL)
+        void *m_buffer_handle = nullptr;
+    #endif
+};
+
+NAMESPACE_END(nanogui)
@@ -14,6 +14,7 @@
 
 #include <nanogui/object.h>
 #include <nanogui/theme.h>
+#include <nanogui/textmetrics.h>
 #include <vector>
 #include <algorithm>
 
@@ -270,6 +271,19 @@ protected:
      */
     float icon_scale() const { return m_theme->m_icon_scale * m_icon_extra_scale; }
 
+    /**
+     * \brief Measure a single line of text using the given font, size and
+     * alignment.
+     *
+     * Measurements are served from the parent screen's \ref TextMetricsCache
+     * when possible and otherwise computed by \ref TextMetricsService. The
+     * state of the NanoVG context is left untouched, and this function is
+     * safe to call from \ref preferred_size() during off-thread layout.
+     */
+    TextMetrics measure_text(NVGcontext *ctx, const std::string &font,
+                             float font_size, int align,
+                             const std::string &text) const;
+
 protected:
     Widget *m_parent;
     ref<Theme> m_theme;
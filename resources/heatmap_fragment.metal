@@ -0,0 +1,22 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+struct VertexOut {
+    float4 position [[position]];
+    float2 uv;
+};
+
+fragment float4 fragment_main(VertexOut vert [[stage_in]],
+                              texture2d<float, access::sample> values,
+                              sampler values_sampler,
+                              texture2d<float, access::sample> colormap,
+                              sampler colormap_sampler,
+                              constant float &offset,
+                              constant float2 &range) {
+    /* The oldest column of the circular texture is shown on the left */
+    float value = values.sample(values_sampler,
+                                float2(fract(vert.uv.x + offset), vert.uv.y)).r;
+    float t = clamp((value - range.x) * range.y, 0.f, 1.f);
+    return colormap.sample(colormap_sampler, float2((t * 255.f + .5f) / 256.f, .5f));
+}
@@ -0,0 +1,16 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+struct VertexOut {
+    float4 position [[position]];
+    float2 uv;
+};
+
+vertex VertexOut vertex_main(const device float2 *position,
+                             uint id [[vertex_id]]) {
+    VertexOut vert;
+    vert.position = float4(position[id] * 2.f - 1.f, 0.f, 1.f);
+    vert.uv = position[id];
+    return vert;
+}
@@ -0,0 +1,51 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+struct VertexOut {
+    float4 position [[position]];
+    float dist;
+};
+
+static float2 safe_normal(float2 d) {
+    float l = length(d);
+    return l > 1e-6f ? float2(-d.y, d.x) / l : float2(0.f);
+}
+
+vertex VertexOut vertex_main(const device float2 *position,
+                             const device float2 *prev,
+                             const device float2 *next,
+                             const device float *side,
+                             constant float4 &transform,
+                             constant float2 &viewport,
+                             constant float &thickness,
+                             uint id [[vertex_id]]) {
+    float2 half_viewport = .5f * viewport;
+    float2 p  = (position[id] * transform.xy + transform.zw) * half_viewport,
+           p0 = (prev[id]     * transform.xy + transform.zw) * half_viewport,
+           p1 = (next[id]     * transform.xy + transform.zw) * half_viewport,
+           n0 = safe_normal(p - p0),
+           n1 = safe_normal(p1 - p);
+
+    if (all(n0 == 0.f))
+        n0 = n1;
+    if (all(n1 == 0.f))
+        n1 = n0;
+    if (all(n0 == 0.f))
+        n0 = n1 = float2(0.f, 1.f);
+
+    /* Miter join, limited to avoid spikes at sharp corners */
+    float2 miter = n0 + n1;
+    float l = length(miter);
+    miter = l > 1e-6f ? miter / l : n1;
+    float scale = 1.f / max(dot(miter, n1), .25f);
+
+    /* Extend by one pixel to leave room for the anti-aliased edge */
+    float width = .5f * thickness + 1.f;
+    p += miter * (side[id] * width * scale);
+
+    VertexOut vert;
+    vert.position = float4(p / half_viewport, 0.f, 1.f);
+    vert.dist = side[id] * width;
+    return vert;
+}
@@ -0,0 +1,29 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+struct VertexOut {
+    float4 position [[position]];
+    float2 uv;
+    float4 color;
+};
+
+fragment float4 fragment_main(VertexOut vert [[stage_in]],
+                              texture2d<float, access::sample> atlas,
+                              sampler atlas_sampler,
+                              constant float &smoothing,
+                              constant float &outline,
+                              constant float4 &outline_color,
+                              constant float &opacity) {
+    float dist = atlas.sample(atlas_sampler, vert.uv).r;
+    float alpha = smoothstep(.5f - smoothing, .5f + smoothing, dist);
+    float alpha_outline = smoothstep(.5f - outline - smoothing,
+                                     .5f - outline + smoothing, dist);
+
+    /* Composite the glyph over its outline (premultiplied) */
+    float4 fill = float4(vert.color.rgb, 1.f) * (vert.color.a * alpha);
+    float4 result = fill + float4(outline_color.rgb, 1.f) *
+                    (outline_color.a * alpha_outline * (1.f - fill.a));
+
+    return float4(result.rgb / max(result.a, 1e-6f), result.a * opacity);
+}
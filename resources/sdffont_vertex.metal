@@ -0,0 +1,21 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+struct VertexOut {
+    float4 position [[position]];
+    float2 uv;
+    float4 color;
+};
+
+vertex VertexOut vertex_main(const device float2 *position,
+                             const device float2 *uv,
+                             const device float4 *color,
+                             constant float4x4 &mvp,
+                             uint id [[vertex_id]]) {
+    VertexOut vert;
+    vert.position = mvp * float4(position[id], 0.f, 1.f);
+    vert.uv = uv[id];
+    vert.color = color[id];
+    return vert;
+}
@@ -0,0 +1,145 @@
+/*
+    src/benchmark_convert.cpp -- Benchmark that compares the vectorized
+    pixel format conversions of nanogui::convert_pixels() against the
+    straightforward per-pixel loops that callers would otherwise write.
+
+    Build with -march=native (or -mssse3 -mf16c) to enable all kernels.
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/pixelconvert.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+
+using namespace nanogui;
+using PixelFormat = Texture::PixelFormat;
+using ComponentFormat = Texture::ComponentFormat;
+
+/// Number of pixels per conversion (a 4K frame)
+static const size_t pixel_count = 3840 * 2160;
+static const int iterations = 20;
+
+/// Return the average time per call in milliseconds
+static double measure(const std::function<void()> &func) {
+    func(); // warm up
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        func();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+static void report(const char *name, size_t bytes, const std::function<void()> &scalar,
+                   const std::function<void()> &vectorized) {
+    double t_scalar = measure(scalar), t_vectorized = measure(vectorized);
+    printf("%-28s scalar: %8.2f ms (%6.2f GB/s)   convert_pixels: %8.2f ms (%6.2f GB/s)   "
+           "speedup: %5.2fx\n", name, t_scalar, bytes / t_scalar * 1e-6, t_vectorized,
+           bytes / t_vectorized * 1e-6, t_scalar / t_vectorized);
+}
+
+int main() {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+
+    std::unique_ptr<uint8_t[]>  u8_in(new uint8_t[pixel_count * 4]),
+                                u8_out(new uint8_t[pixel_count * 4]);
+    std::unique_ptr<uint16_t[]> u16_in(new uint16_t[pixel_count * 4]),
+                                u16_out(new uint16_t[pixel_count * 4]);
+    std::unique_ptr<float[]>    f32_in(new float[pixel_count * 4]),
+                                f32_out(new float[pixel_count * 4]);
+
+    for (size_t i = 0; i < pixel_count * 4; ++i) {
+        u8_in[i]  = (uint8_t) rng();
+        u16_in[i] = (uint16_t) rng();
+        f32_in[i] = dist(rng);
+    }
+
+    size_t n = pixel_count;
+    printf("Converting %zu pixels, average of %i runs\n\n", n, iterations);
+
+    report("BGRA8 -> RGBA8", n * 8,
+        [&] {
+            for (size_t i = 0; i < n; ++i) {
+                const uint8_t *s = u8_in.get() + 4 * i;
+                uint8_t *d = u8_out.get() + 4 * i;
+                d[0] = s[2]; d[1] = s[1]; d[2] = s[0]; d[3] = s[3];
+            }
+        },
+        [&] {
+            convert_pixels(u8_in.get(), PixelFormat::BGRA, ComponentFormat::UInt8,
+                           u8_out.get(), PixelFormat::RGBA, ComponentFormat::UInt8, n);
+        });
+
+    report("BGR8 -> RGB8", n * 6,
+        [&] {
+            for (size_t i = 0; i < n; ++i) {
+                const uint8_t *s = u8_in.get() + 3 * i;
+                uint8_t *d = u8_out.get() + 3 * i;
+                d[0] = s[2]; d[1] = s[1]; d[2] = s[0];
+            }
+        },
+        [&] {
+            convert_pixels(u8_in.get(), PixelFormat::BGR, ComponentFormat::UInt8,
+                           u8_out.get(), PixelFormat::RGB, ComponentFormat::UInt8, n);
+        });
+
+    report("RGB8 -> RGBA8", n * 7,
+        [&] {
+            for (size_t i = 0; i < n; ++i) {
+                const uint8_t *s = u8_in.get() + 3 * i;
+                uint8_t *d = u8_out.get() + 4 * i;
+                d[0] = s[0]; d[1] = s[1]; d[2] = s[2]; d[3] = 255;
+            }
+        },
+        [&] {
+            convert_pixels(u8_in.get(), PixelFormat::RGB, ComponentFormat::UInt8,
+                           u8_out.get(), PixelFormat::RGBA, ComponentFormat::UInt8, n);
+        });
+
+    report("RGBA32F -> RGBA16F", n * 24,
+        [&] {
+            for (size_t i = 0; i < n * 4; ++i)
+                u16_out[i] = float_to_half(f32_in[i]);
+        },
+        [&] {
+            convert_pixels(f32_in.get(), PixelFormat::RGBA, ComponentFormat::Float32,
+                           u16_out.get(), PixelFormat::RGBA, ComponentFormat::Float16, n);
+        });
+
+    report("RGBA16 -> RGBA32F", n * 24,
+        [&] {
+            for (size_t i = 0; i < n * 4; ++i)
+                f32_out[i] = u16_in[i] / 65535.f;
+        },
+        [&] {
+            convert_pixels(u16_in.get(), PixelFormat::RGBA, ComponentFormat::UInt16,
+                           f32_out.get(), PixelFormat::RGBA, ComponentFormat::Float32, n);
+        });
+
+    report("RGBA32F -> RGBA8 (sRGB)", n * 20,
+        [&] {
+            for (size_t i = 0; i < n * 4; ++i) {
+                float v = std::min(std::max(f32_in[i], 0.f), 1.f);
+                if ((i & 3) != 3)
+                    v = v <= 0.0031308f ? v * 12.92f
+                                        : 1.055f * std::pow(v, 1.f / 2.4f) - 0.055f;
+                u8_out[i] = (uint8_t) (v * 255.f + .5f);
+            }
+        },
+        [&] {
+            convert_pixels(f32_in.get(), PixelFormat::RGBA, ComponentFormat::Float32,
+                           u8_out.get(), PixelFormat::RGBA, ComponentFormat::UInt8, n, true);
+        });
+
+    return 0;
+}
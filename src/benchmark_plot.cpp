@@ -0,0 +1,159 @@
+/*
+    src/benchmark_plot.cpp -- Benchmark that compares the frame rate of the
+    NanoVG-based nanogui::Graph widget against the GPU-accelerated
+    nanogui::Plot widget when displaying one million samples.
+
+    To measure software rendering performance on Linux, run the benchmark
+    with Mesa's llvmpipe driver (LIBGL_ALWAYS_SOFTWARE=1).
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/screen.h>
+#include <nanogui/graph.h>
+#include <nanogui/plot.h>
+#include <nanogui/opengl.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using namespace nanogui;
+
+static const size_t sample_count = 1000000;
+static const size_t append_count = 1000;
+
+/// Synthetic signal in [0, 1]
+static float sample_value(size_t i) {
+    float t = (float) i;
+    return .5f + .3f * std::sin(t * 1e-4f) + .15f * std::sin(t * .37f) *
+                 std::sin(t * 3e-3f);
+}
+
+class PlotBenchmark : public Screen {
+public:
+    PlotBenchmark() : Screen(Vector2i(1024, 768), "NanoGUI plot benchmark", false) {
+        m_graph = new Graph(this, "Graph");
+        m_graph->set_position(Vector2i(0, 0));
+        m_graph->set_size(m_size);
+
+        m_plot = new Plot(this);
+        m_plot->set_position(Vector2i(0, 0));
+        m_plot->set_size(m_size);
+        m_plot->add_series(Color(255, 192, 0, 255), 1.5f);
+    }
+
+    void reset(bool plot) {
+        std::vector<float> x(sample_count), y(sample_count);
+        for (size_t i = 0; i < sample_count; ++i) {
+            x[i] = (float) i;
+            y[i] = sample_value(i);
+        }
+
+        m_graph->set_visible(!plot);
+        m_graph->set_capacity(sample_count);
+        m_graph->set_values(y);
+        m_plot->set_visible(plot);
+        m_plot->clear(0);
+        m_plot->append(0, x.data(), y.data(), sample_count);
+        m_plot->fit_view();
+        m_next = sample_count;
+    }
+
+    /// Append new samples, dropping old ones from the graph
+    void stream() {
+        std::vector<float> x(append_count), y(append_count);
+        for (size_t i = 0; i < append_count; ++i) {
+            x[i] = (float) (m_next + i);
+            y[i] = sample_value(m_next + i);
+        }
+        m_next += append_count;
+
+        if (m_graph->visible()) {
+            m_graph->push_values(y);
+        } else {
+            m_plot->append(0, x.data(), y.data(), append_count);
+            pan((float) append_count);
+        }
+    }
+
+    /// Shift the visible region of the plot horizontally
+    void pan(float amount) {
+        Vector2f shift(amount, 0.f);
+        m_plot->set_view(m_plot->view_min() + shift, m_plot->view_max() + shift);
+    }
+
+    Plot *plot() { return m_plot; }
+
+    void draw_contents() override {
+        clear();
+    }
+
+    /// Render a frame and return the time spent in milliseconds
+    double time_frame() {
+        auto start = std::chrono::high_resolution_clock::now();
+        redraw();
+        draw_all();
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        glFinish();
+#endif
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+protected:
+    ref<Graph> m_graph;
+    ref<Plot> m_plot;
+    size_t m_next = 0;
+};
+
+int main(int /* argc */, char ** /* argv */) {
+    nanogui::init();
+
+    /* scoped variables */ {
+        const int frames = 100;
+        ref<PlotBenchmark> app = new PlotBenchmark();
+        app->set_visible(true);
+
+        printf("%zu samples, %zu appended per frame in streaming mode\n\n",
+               sample_count, append_count);
+        printf("%-6s %-10s | %12s %12s %10s\n", "widget", "mode",
+               "first (ms)", "avg (ms)", "fps");
+
+        const char *modes[] = { "static", "pan", "streaming" };
+
+        for (int plot = 0; plot < 2; ++plot) {
+            for (int mode = 0; mode < 3; ++mode) {
+                /* Graph has no notion of panning */
+                if (plot == 0 && mode == 1)
+                    continue;
+
+                app->reset(plot == 1);
+
+                double first = app->time_frame(), avg = 0.0;
+                for (int i = 0; i < frames; ++i) {
+                    if (mode == 1)
+                        app->pan(10.f);
+                    else if (mode == 2)
+                        app->stream();
+                    avg += app->time_frame();
+                }
+
+                avg /= frames;
+                printf("%-6s %-10s | %12.3f %12.3f %10.1f\n",
+                       plot ? "Plot" : "Graph", modes[mode], first, avg,
+                       1000.0 / avg);
+            }
+        }
+
+        printf("\nPlot uploaded %.1f MiB in total\n",
+               app->plot()->upload_bytes() / (1024.0 * 1024.0));
+    }
+
+    nanogui::shutdown();
+    return 0;
+}
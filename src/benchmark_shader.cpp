@@ -0,0 +1,489 @@
+/*
+    src/benchmark_shader.cpp -- Benchmark that measures the CPU overhead of
+    nanogui::Shader by issuing thousands of small begin()/draw_array()/end()
+    cycles per frame, with uniforms updated either by name, by handle, or
+    via ranges of a ring-allocated uniform buffer, and compares this to a
+    single instanced draw call with per-instance attributes. On OpenGL, it
+    also measures the time needed to create a batch of shaders with and
+    without the program binary cache (set MESA_SHADER_CACHE_DISABLE=true or
+    the equivalent driver option so that only NanoGUI's cache is measured).
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/screen.h>
+#include <nanogui/shader.h>
+#include <nanogui/renderpass.h>
+#include <nanogui/texture.h>
+#include <nanogui/uniformbuffer.h>
+#include <nanogui/opengl.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace nanogui;
+
+static const int draw_count = 5000;
+static const int frames = 20;
+
+/* Uniform blocks and instancing require OpenGL 3.3 or Metal (the GLES shaders below target ES 2) */
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_METAL)
+#  define BENCHMARK_UNIFORM_BLOCKS
+#  define BENCHMARK_INSTANCING
+#endif
+
+#if defined(NANOGUI_USE_OPENGL)
+static const char *vertex_shader_source = R"(#version 330
+uniform mat4 mvp;
+in vec2 position;
+out vec2 uv;
+void main() {
+    uv = position * .5 + .5;
+    gl_Position = mvp * vec4(position, 0.0, 1.0);
+})";
+
+static const char *fragment_shader_source = R"(#version 330
+uniform sampler2D image;
+uniform vec4 color;
+in vec2 uv;
+out vec4 frag_color;
+void main() {
+    frag_color = color * texture(image, uv);
+})";
+#elif defined(NANOGUI_USE_GLES)
+static const char *vertex_shader_source = R"(precision highp float;
+uniform mat4 mvp;
+attribute vec2 position;
+varying vec2 uv;
+void main() {
+    uv = position * .5 + .5;
+    gl_Position = mvp * vec4(position, 0.0, 1.0);
+})";
+
+static const char *fragment_shader_source = R"(precision highp float;
+uniform sampler2D image;
+uniform vec4 color;
+varying vec2 uv;
+void main() {
+    gl_FragColor = color * texture2D(image, uv);
+})";
+#elif defined(NANOGUI_USE_METAL)
+static const char *vertex_shader_source = R"(using namespace metal;
+struct VertexOut {
+    float4 position [[position]];
+    float2 uv;
+};
+
+vertex VertexOut vertex_main(const device float2 *position,
+                             constant float4x4 &mvp,
+                             uint id [[vertex_id]]) {
+    VertexOut vert;
+    vert.position = mvp * float4(position[id], 0.f, 1.f);
+    vert.uv = position[id] * .5f + .5f;
+    return vert;
+})";
+
+static const char *fragment_shader_source = R"(using namespace metal;
+struct VertexOut {
+    float4 position [[position]];
+    float2 uv;
+};
+
+fragment float4 fragment_main(VertexOut vert [[stage_in]],
+                              const constant float4 &color,
+                              texture2d<float, access::sample> image,
+                              sampler image_sampler) {
+    return color * image.sample(image_sampler, vert.uv);
+})";
+#endif
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+/// Number of distinct shaders created by the startup benchmark
+static const int startup_shader_count = 32;
+
+/// Make the source unique so that the driver cannot reuse earlier compilations
+static std::string shader_variant(const char *source, int variant) {
+    std::string result(source), define = "#define VARIANT " + std::to_string(variant) + "\n";
+    size_t pos = result.compare(0, 8, "#version") == 0 ? result.find('\n') + 1 : 0;
+    result.insert(pos, define);
+    return result;
+}
+#endif
+
+/// Per-draw data in std140 layout
+struct DrawData {
+    Matrix4f mvp;
+    Color color;
+};
+
+class ShaderBenchmark : public Screen {
+public:
+    enum Mode { Static = 0, ByName, ByHandle, ByBlock, Instanced, ModeCount };
+
+    ShaderBenchmark() : Screen(Vector2i(1024, 768), "NanoGUI shader benchmark", false) {
+        m_render_pass = new RenderPass({ this });
+        m_render_pass->set_clear_color(0, Color(0.3f, 0.3f, 0.32f, 1.f));
+
+        m_shader = new Shader(m_render_pass, "benchmark_shader",
+                              vertex_shader_source, fragment_shader_source);
+
+        uint32_t indices[3*2] = { 0, 1, 2, 2, 3, 0 };
+        float positions[2*4] = { -1.f, -1.f, 1.f, -1.f, 1.f, 1.f, -1.f, 1.f };
+        uint8_t pixels[4*4] = { 255, 255, 255, 255, 192, 192, 192, 255,
+                                192, 192, 192, 255, 255, 255, 255, 255 };
+
+        m_texture = new Texture(Texture::PixelFormat::RGBA,
+                                Texture::ComponentFormat::UInt8, Vector2i(2, 2));
+        m_texture->upload(pixels);
+
+        m_shader->set_buffer("indices", VariableType::UInt32, { 3*2 }, indices);
+        m_shader->set_buffer("position", VariableType::Float32, { 4, 2 }, positions);
+        m_shader->set_texture("image", m_texture);
+        m_shader->set_uniform("mvp", Matrix4f::scale(Vector3f(.01f)));
+        m_shader->set_uniform("color", Color(1.f, .5f, 0.f, 1.f));
+
+        m_mvp_handle = m_shader->argument_handle("mvp");
+        m_color_handle = m_shader->argument_handle("color");
+
+#if defined(BENCHMARK_UNIFORM_BLOCKS)
+        m_block_shader = new Shader(
+            m_render_pass,
+            "benchmark_block_shader",
+
+#  if defined(NANOGUI_USE_OPENGL)
+            R"(#version 330
+            layout(std140) uniform Draw {
+                mat4 mvp;
+                vec4 color;
+            };
+            in vec2 position;
+            out vec2 uv;
+            out vec4 draw_color;
+            void main() {
+                uv = position * .5 + .5;
+                draw_color = color;
+                gl_Position = mvp * vec4(position, 0.0, 1.0);
+            })",
+
+            /* Fragment shader */
+            R"(#version 330
+            uniform sampler2D image;
+            in vec2 uv;
+            in vec4 draw_color;
+            out vec4 frag_color;
+            void main() {
+                frag_color = draw_color * texture(image, uv);
+            })"
+#  elif defined(NANOGUI_USE_METAL)
+            R"(using namespace metal;
+            struct VertexOut {
+                float4 position [[position]];
+                float2 uv;
+                float4 color;
+            };
+
+            struct DrawData {
+                float4x4 mvp;
+                float4 color;
+            };
+
+            vertex VertexOut vertex_main(const device float2 *position,
+                                         constant DrawData &Draw,
+                                         uint id [[vertex_id]]) {
+                VertexOut vert;
+                vert.position = Draw.mvp * float4(position[id], 0.f, 1.f);
+                vert.uv = position[id] * .5f + .5f;
+                vert.color = Draw.color;
+                return vert;
+            })",
+
+            /* Fragment shader */
+            R"(using namespace metal;
+            struct VertexOut {
+                float4 position [[position]];
+                float2 uv;
+                float4 color;
+            };
+
+            fragment float4 fragment_main(VertexOut vert [[stage_in]],
+                                          texture2d<float, access::sample> image,
+                                          sampler image_sampler) {
+                return vert.color * image.sample(image_sampler, vert.uv);
+            })"
+#  endif
+        );
+
+        m_block_shader->set_buffer("indices", VariableType::UInt32, { 3*2 }, indices);
+        m_block_shader->set_buffer("position", VariableType::Float32, { 4, 2 }, positions);
+        m_block_shader->set_texture("image", m_texture);
+        m_block_handle = m_block_shader->argument_handle("Draw");
+        m_uniform_buffer = new UniformBuffer(4 * 1024 * 1024);
+#endif
+
+#if defined(BENCHMARK_INSTANCING)
+        m_instanced_shader = new Shader(
+            m_render_pass,
+            "benchmark_instanced_shader",
+
+#  if defined(NANOGUI_USE_OPENGL)
+            R"(#version 330
+            in vec2 position;
+            in vec2 offset;
+            in vec4 color;
+            out vec2 uv;
+            out vec4 draw_color;
+            void main() {
+                uv = position * .5 + .5;
+                draw_color = color;
+                gl_Position = vec4(position * .01 + offset, 0.0, 1.0);
+            })",
+
+            /* Fragment shader */
+            R"(#version 330
+            uniform sampler2D image;
+            in vec2 uv;
+            in vec4 draw_color;
+            out vec4 frag_color;
+            void main() {
+                frag_color = draw_color * texture(image, uv);
+            })"
+#  elif defined(NANOGUI_USE_METAL)
+            R"(using namespace metal;
+            struct VertexOut {
+                float4 position [[position]];
+                float2 uv;
+                float4 color;
+            };
+
+            vertex VertexOut vertex_main(const device float2 *position,
+                                         const device float2 *offset,
+                                         const device float4 *color,
+                                         uint id [[vertex_id]],
+                                         uint instance [[instance_id]]) {
+                VertexOut vert;
+                vert.position = float4(position[id] * .01f + offset[instance], 0.f, 1.f);
+                vert.uv = position[id] * .5f + .5f;
+                vert.color = color[instance];
+                return vert;
+            })",
+
+            /* Fragment shader */
+            R"(using namespace metal;
+            struct VertexOut {
+                float4 position [[position]];
+                float2 uv;
+                float4 color;
+            };
+
+            fragment float4 fragment_main(VertexOut vert [[stage_in]],
+                                          texture2d<float, access::sample> image,
+                                          sampler image_sampler) {
+                return vert.color * image.sample(image_sampler, vert.uv);
+            })"
+#  endif
+        );
+
+        m_instanced_shader->set_buffer("indices", VariableType::UInt32, { 3*2 }, indices);
+        m_instanced_shader->set_buffer("position", VariableType::Float32, { 4, 2 }, positions);
+        m_instanced_shader->set_texture("image", m_texture);
+        for (const char *name : { "offset", "color" }) {
+            m_instanced_shader->set_instance_divisor(name, 1);
+            m_instanced_shader->set_buffer_usage(name, Shader::BufferUsage::Stream);
+        }
+        m_instance_offsets.resize(draw_count * 2);
+        m_instance_colors.resize(draw_count * 4);
+#endif
+    }
+
+    static bool supported(Mode mode) {
+#if !defined(BENCHMARK_UNIFORM_BLOCKS)
+        if (mode == ByBlock)
+            return false;
+#endif
+#if !defined(BENCHMARK_INSTANCING)
+        if (mode == Instanced)
+            return false;
+#endif
+        (void) mode;
+        return true;
+    }
+
+    void draw_contents() override {
+        m_render_pass->resize(framebuffer_size());
+        m_render_pass->begin();
+
+#if defined(BENCHMARK_INSTANCING)
+        if (m_mode == Instanced) {
+            /* Regenerate the per-instance data every frame, like the other modes */
+            for (int i = 0; i < draw_count; ++i) {
+                m_instance_offsets[2 * i]     = (float) (i % 100) * .02f - .99f;
+                m_instance_offsets[2 * i + 1] = (float) (i / 100) * .04f - .98f;
+                Color color((float) (i % 7) / 6.f, .5f, 1.f, 1.f);
+                for (int j = 0; j < 4; ++j)
+                    m_instance_colors[4 * i + j] = color[j];
+            }
+
+            m_instanced_shader->set_buffer("offset", VariableType::Float32,
+                                           { (size_t) draw_count, 2 },
+                                           m_instance_offsets.data());
+            m_instanced_shader->set_buffer("color", VariableType::Float32,
+                                           { (size_t) draw_count, 4 },
+                                           m_instance_colors.data());
+            m_instanced_shader->begin();
+            m_instanced_shader->draw_array_instanced(Shader::PrimitiveType::Triangle, 0, 6,
+                                                     draw_count, true);
+            m_instanced_shader->end();
+            m_render_pass->end();
+            return;
+        }
+#endif
+
+        Shader *shader = m_shader;
+#if defined(BENCHMARK_UNIFORM_BLOCKS)
+        if (m_mode == ByBlock)
+            shader = m_block_shader;
+#endif
+
+        for (int i = 0; i < draw_count; ++i) {
+            if (m_mode != Static) {
+                float x = (float) (i % 100) * .02f - .99f,
+                      y = (float) (i / 100) * .04f - .98f;
+                Matrix4f mvp = Matrix4f::translate(Vector3f(x, y, 0.f)) *
+                               Matrix4f::scale(Vector3f(.01f));
+                Color color((float) (i % 7) / 6.f, .5f, 1.f, 1.f);
+                if (m_mode == ByName) {
+                    m_shader->set_uniform("mvp", mvp);
+                    m_shader->set_uniform("color", color);
+                } else if (m_mode == ByHandle) {
+                    m_shader->set_uniform(m_mvp_handle, mvp);
+                    m_shader->set_uniform(m_color_handle, color);
+                }
+#if defined(BENCHMARK_UNIFORM_BLOCKS)
+                else {
+                    DrawData data { mvp, color };
+                    size_t offset = m_uniform_buffer->push(&data, sizeof(DrawData));
+                    m_block_shader->set_uniform_buffer(m_block_handle, m_uniform_buffer,
+                                                       offset);
+                }
+#endif
+            }
+
+            shader->begin();
+            shader->draw_array(Shader::PrimitiveType::Triangle, 0, 6, true);
+            shader->end();
+        }
+
+        m_render_pass->end();
+    }
+
+    /// Render a frame in the given mode and return the time spent in milliseconds
+    double time_frame(Mode mode) {
+        m_mode = mode;
+        auto start = std::chrono::high_resolution_clock::now();
+        redraw();
+        draw_all();
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        glFinish();
+#endif
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+    /// Create shader variants [first, first + startup_shader_count) and return the time in milliseconds
+    double time_startup(int first) {
+        std::vector<ref<Shader>> shaders;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = first; i < first + startup_shader_count; ++i)
+            shaders.push_back(new Shader(m_render_pass, "startup_shader",
+                                         shader_variant(vertex_shader_source, i),
+                                         shader_variant(fragment_shader_source, i)));
+        glFinish();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+#endif
+
+protected:
+    ref<RenderPass> m_render_pass;
+    ref<Shader> m_shader;
+    ref<Texture> m_texture;
+    size_t m_mvp_handle = 0, m_color_handle = 0;
+#if defined(BENCHMARK_UNIFORM_BLOCKS)
+    ref<Shader> m_block_shader;
+    ref<UniformBuffer> m_uniform_buffer;
+    size_t m_block_handle = 0;
+#endif
+#if defined(BENCHMARK_INSTANCING)
+    ref<Shader> m_instanced_shader;
+    std::vector<float> m_instance_offsets, m_instance_colors;
+#endif
+    Mode m_mode = Static;
+};
+
+int main(int /* argc */, char ** /* argv */) {
+    nanogui::init();
+
+    /* scoped variables */ {
+        ref<ShaderBenchmark> app = new ShaderBenchmark();
+        app->set_visible(true);
+
+        printf("%i begin()/draw_array()/end() cycles per frame, average of %i frames\n\n",
+               draw_count, frames);
+        printf("%-24s | %12s %14s\n", "per-draw data", "frame (ms)", "per draw (us)");
+
+        const char *modes[] = { "none", "set_uniform(name)", "set_uniform(handle)",
+                                "UniformBuffer::push()", "draw_array_instanced()" };
+
+        for (int mode = 0; mode < ShaderBenchmark::ModeCount; ++mode) {
+            ShaderBenchmark::Mode m = (ShaderBenchmark::Mode) mode;
+            if (!ShaderBenchmark::supported(m))
+                continue;
+            app->time_frame(m); // warm up
+
+            double avg = 0.0;
+            for (int i = 0; i < frames; ++i)
+                avg += app->time_frame(m);
+            avg /= frames;
+
+            printf("%-24s | %12.3f %14.3f\n", modes[mode], avg,
+                   avg * 1000.0 / draw_count);
+        }
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        namespace fs = std::filesystem;
+        fs::path cache_dir = fs::temp_directory_path() / "nanogui_shader_cache";
+        fs::remove_all(cache_dir);
+        fs::create_directories(cache_dir);
+
+        printf("\nCreating %i shaders\n\n", startup_shader_count);
+        printf("%-24s | %12s %14s\n", "binary cache", "total (ms)", "per shader (ms)");
+
+        double t_none = app->time_startup(0);
+        Shader::set_binary_cache_directory(cache_dir.string());
+        double t_cold = app->time_startup(startup_shader_count);
+        double t_warm = app->time_startup(startup_shader_count);
+        Shader::set_binary_cache_directory("");
+
+        const char *labels[] = { "disabled", "cold", "warm" };
+        double times[] = { t_none, t_cold, t_warm };
+        for (int i = 0; i < 3; ++i)
+            printf("%-24s | %12.3f %14.3f\n", labels[i], times[i],
+                   times[i] / startup_shader_count);
+        printf("\n%zu cache hits, %zu cache misses\n", Shader::binary_cache_hits(),
+               Shader::binary_cache_misses());
+
+        fs::remove_all(cache_dir);
+#endif
+    }
+
+    nanogui::shutdown();
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*
+    src/benchmark_text.cpp -- Benchmark that sweeps over font sizes and
+    compares text rendering via NanoVG against the SDF glyph atlas
+    (nanogui::SDFFont).
+
+    For every font size, the first frame (which includes rasterizing new
+    glyphs into the respective atlas) and the average of subsequent frames
+    are reported.
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/screen.h>
+#include <nanogui/renderpass.h>
+#include <nanogui/sdffont.h>
+#include <nanogui/opengl.h>
+#include <chrono>
+#include <cstdio>
+
+using namespace nanogui;
+
+static const char *sample_text =
+    "The quick brown fox jumps over the lazy dog 0123456789 !?&%";
+
+class TextBenchmark : public Screen {
+public:
+    TextBenchmark() : Screen(Vector2i(1024, 768), "NanoGUI text benchmark", false) {
+        m_render_pass = new RenderPass({ this }, nullptr, nullptr, nullptr, false);
+        m_sdf_font = new SDFFont(m_render_pass, "sans");
+        m_sdf_font->set_pixel_ratio(pixel_ratio());
+    }
+
+    void set_mode(bool sdf, float font_size) {
+        m_sdf = sdf;
+        m_font_size = font_size;
+    }
+
+    SDFFont *sdf_font() { return m_sdf_font; }
+
+    void draw_contents() override {
+        clear();
+
+        /* Fill the window with lines of text */
+        int lines = std::max(1, (int) (m_size.y() / m_font_size));
+
+        if (m_sdf) {
+            Matrix4f mvp = Matrix4f::ortho(0.f, (float) m_size.x(),
+                                           (float) m_size.y(), 0.f, -1.f, 1.f);
+            m_render_pass->resize(framebuffer_size());
+            m_render_pass->begin();
+            for (int i = 0; i < lines; ++i)
+                m_sdf_font->draw_text(mvp, Vector2f(10.f, i * m_font_size),
+                                      m_font_size, NVG_ALIGN_LEFT | NVG_ALIGN_TOP,
+                                      Color(255, 255), sample_text);
+            m_render_pass->end();
+        } else {
+            NVGcontext *ctx = m_nvg_context;
+            nvgBeginFrame(ctx, m_size.x(), m_size.y(), m_pixel_ratio);
+            nvgFontFace(ctx, "sans");
+            nvgFontSize(ctx, m_font_size);
+            nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+            nvgFillColor(ctx, Color(255, 255));
+            for (int i = 0; i < lines; ++i)
+                nvgText(ctx, 10.f, i * m_font_size, sample_text, nullptr);
+            nvgEndFrame(ctx);
+        }
+    }
+
+    /// Render a frame and return the time spent in milliseconds
+    double time_frame() {
+        auto start = std::chrono::high_resolution_clock::now();
+        redraw();
+        draw_all();
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        glFinish();
+#endif
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+protected:
+    ref<RenderPass> m_render_pass;
+    ref<SDFFont> m_sdf_font;
+    bool m_sdf = false;
+    float m_font_size = 16.f;
+};
+
+int main(int /* argc */, char ** /* argv */) {
+    nanogui::init();
+
+    /* scoped variables */ {
+        const int frames = 50;
+        ref<TextBenchmark> app = new TextBenchmark();
+        app->set_visible(true);
+
+        printf("%9s | %17s %17s | %17s %17s | %7s %11s %8s\n", "font size",
+               "nanovg first (ms)", "nanovg avg (ms)", "sdf first (ms)",
+               "sdf avg (ms)", "glyphs", "atlas", "uploads");
+
+        for (float font_size = 8.f; font_size <= 192.f; font_size *= 1.25f) {
+            double time[2][2];
+            for (int sdf = 0; sdf < 2; ++sdf) {
+                app->set_mode(sdf == 1, font_size);
+                time[sdf][0] = app->time_frame();
+                time[sdf][1] = 0.0;
+                for (int i = 0; i < frames; ++i)
+                    time[sdf][1] += app->time_frame();
+                time[sdf][1] /= frames;
+            }
+
+            SDFFont *font = app->sdf_font();
+            printf("%9.1f | %17.3f %17.3f | %17.3f %17.3f | %7zu %5ix%-5i %8zu\n",
+                   font_size, time[0][0], time[0][1], time[1][0], time[1][1],
+                   font->glyph_count(), font->atlas_size().x(),
+                   font->atlas_size().y(), font->upload_count());
+        }
+    }
+
+    nanogui::shutdown();
+    return 0;
+}
@@ -24,23 +24,19 @@ Button::Button(Widget *parent, const std::string &caption, int icon)
 
 Vector2i Button::preferred_size(NVGcontext *ctx) const {
     int font_size = m_font_size == -1 ? m_theme->m_button_font_size : m_font_size;
-    nvgFontSize(ctx, font_size);
-    nvgFontFace(ctx, "sans-bold");
-    float tw = nvgTextBounds(ctx, 0,0, m_caption.c_str(), nullptr, nullptr);
+    float tw = measure_text(ctx, "sans-bold", font_size,
+                            NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE, m_caption).advance;
     float iw = 0.0f, ih = font_size;
 
     if (m_icon) {
         if (nvg_is_font_icon(m_icon)) {
             ih *= icon_scale();
-            nvgFontFace(ctx, "icons");
-            nvgFontSize(ctx, ih);
-            iw = nvgTextBounds(ctx, 0, 0, utf8(m_icon).data(), nullptr, nullptr)
-                + m_size.y() * 0.15f;
+            iw = measure_text(ctx, "icons", ih, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE,
+                              utf8(m_icon)).advance + m_size.y() * 0.15f;
         } else {
-            int w, h;
             ih *= 0.9f;
-            nvgImageSize(ctx, m_icon, &w, &h);
-            iw = w * ih / h;
+            Vector2i size = nvg_image_icon_size(ctx, m_icon);
+            iw = size.x() * ih / size.y();
         }
     }
     return Vector2i((int)(tw + iw) + 20, font_size + 10);
@@ -162,9 +158,8 @@ void Button::draw(NVGcontext *ctx) {
     nvgStroke(ctx);
 
     int font_size = m_font_size == -1 ? m_theme->m_button_font_size : m_font_size;
-    nvgFontSize(ctx, font_size);
-    nvgFontFace(ctx, "sans-bold");
-    float tw = nvgTextBounds(ctx, 0,0, m_caption.c_str(), nullptr, nullptr);
+    float tw = measure_text(ctx, "sans-bold", font_size,
+                            NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE, m_caption).advance;
 
     Vector2f center = Vector2f(m_pos) + Vector2f(m_size) * 0.5f;
     Vector2f text_pos(center.x() - tw * 0.5f, center.y() - 1);
@@ -179,17 +174,17 @@ void Button::draw(NVGcontext *ctx) {
         float iw, ih = font_size;
         if (nvg_is_font_icon(m_icon)) {
             ih *= icon_scale();
-            nvgFontSize(ctx, ih);
-            nvgFontFace(ctx, "icons");
-            iw = nvgTextBounds(ctx, 0, 0, icon.data(), nullptr, nullptr);
+            iw = measure_text(ctx, "icons", ih, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE,
+                              icon).advance;
         } else {
-            int w, h;
             ih *= 0.9f;
-            nvgImageSize(ctx, m_icon, &w, &h);
-            iw = w * ih / h;
+            Vector2i size = nvg_image_icon_size(ctx, m_icon);
+            iw = size.x() * ih / size.y();
         }
         if (m_caption != "")
             iw += m_size.y() * 0.15f;
+        nvgFontSize(ctx, ih);
+        nvgFontFace(ctx, "icons");
         nvgFillColor(ctx, text_color);
         nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
         Vector2f icon_pos = center;
@@ -210,8 +205,8 @@ void Button::draw(NVGcontext *ctx) {
         if (nvg_is_font_icon(m_icon)) {
             nvgText(ctx, icon_pos.x(), icon_pos.y()+1, icon.data(), nullptr);
         } else {
-            NVGpaint img_paint = nvgImagePattern(ctx,
-                    icon_pos.x(), icon_pos.y() - ih/2, iw, ih, 0, m_icon, m_enabled ? 0.5f : 0.25f);
+            NVGpaint img_paint = nvg_image_icon_pattern(ctx, m_icon,
+                    icon_pos.x(), icon_pos.y() - ih/2, iw, ih, m_enabled ? 0.5f : 0.25f);
 
             nvgFillPaint(ctx, img_paint);
             nvgFill(ctx);
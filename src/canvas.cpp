@@ -113,6 +113,15 @@ Canvas::Canvas(Widget *parent, uint8_t samples,
 #endif
         clear
     );
+
+    /* Avoid reallocating the targets on every frame while the canvas is resized */
+    if (m_render_to_texture) {
+        m_render_pass->set_resize_slack(true);
+#if defined(NANOGUI_USE_METAL)
+        if (m_render_pass_resolved)
+            m_render_pass_resolved->set_resize_slack(true);
+#endif
+    }
 }
 
 void Canvas::set_background_color(const Color &background_color) {
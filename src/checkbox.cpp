@@ -47,11 +47,11 @@ bool CheckBox::mouse_button_event(const Vector2i &p, int button, bool down,
 Vector2i CheckBox::preferred_size(NVGcontext *ctx) const {
     if (m_fixed_size != Vector2i(0))
         return m_fixed_size;
-    nvgFontSize(ctx, font_size());
-    nvgFontFace(ctx, "sans");
+    TextMetrics metrics = measure_text(ctx, "sans", font_size(),
+                                       NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE,
+                                       m_caption);
     return Vector2i(
-        nvgTextBounds(ctx, 0, 0, m_caption.c_str(), nullptr, nullptr) +
-            1.8f * font_size(),
+        metrics.advance + 1.8f * font_size(),
         font_size() * 1.3f);
 }
 
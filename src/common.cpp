@@ -10,6 +10,7 @@
 */
 
 #include <nanogui/screen.h>
+#include <nanogui/imageloader.h>
 
 #if defined(_WIN32)
 #  ifndef NOMINMAX
@@ -20,6 +21,7 @@
 
 #include <nanogui/opengl.h>
 #include <nanogui/metal.h>
+#include <stb_image.h>
 #include <map>
 #include <thread>
 #include <chrono>
@@ -29,7 +31,7 @@
 #if !defined(_WIN32)
 #  include <locale.h>
 #  include <signal.h>
-#  include <dirent.h>
+#  include <unistd.h>
 #endif
 
 #if defined(EMSCRIPTEN)
@@ -253,52 +255,108 @@ std::string utf8(uint32_t c) {
     return std::string(seq, seq + n);
 }
 
+/* Return the screen owning a NanoVG context */
+static Screen *nvg_screen(NVGcontext *ctx) {
+    for (auto kv : __nanogui_screens) {
+        if (kv.second->nvg_context() == ctx)
+            return kv.second;
+    }
+    return nullptr;
+}
+
+/* NanoVG images created by nvgImageIcon(), indexed by context and name */
+static std::map<std::pair<NVGcontext *, std::string>, int> icon_cache;
+
+std::string __nanogui_temporary_filename(const std::string &filename) {
+#if defined(_WIN32)
+    unsigned long pid = (unsigned long) GetCurrentProcessId();
+#else
+    unsigned long pid = (unsigned long) getpid();
+#endif
+    size_t tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+    return filename + ".tmp" + std::to_string(pid) + "-" + std::to_string(tid);
+}
+
 int __nanogui_get_image(NVGcontext *ctx, const std::string &name, uint8_t *data, uint32_t size) {
-    static std::map<std::string, int> icon_cache;
-    auto it = icon_cache.find(name);
+    auto key = std::make_pair(ctx, name);
+    auto it = icon_cache.find(key);
     if (it != icon_cache.end())
         return it->second;
+
     int icon_id = nvgCreateImageMem(ctx, 0, data, size);
     if (icon_id == 0)
         throw std::runtime_error("Unable to load resource data.");
-    icon_cache[name] = icon_id;
+    icon_cache[key] = icon_id;
     return icon_id;
 }
 
+void __nanogui_release_images(NVGcontext *ctx) {
+    for (auto it = icon_cache.begin(); it != icon_cache.end();) {
+        if (it->first.first == ctx) {
+            nvgDeleteImage(ctx, it->second);
+            it = icon_cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+int nvg_atlas_icon(NVGcontext *ctx, const std::string &name, const uint8_t *data,
+                   uint32_t size) {
+    Screen *screen = nvg_screen(ctx);
+    if (!screen)
+        throw std::runtime_error("nvg_atlas_icon(): NanoVG context does not belong to a screen!");
+    return screen->atlas_icon(name, data, size);
+}
+
+Vector2i nvg_image_icon_size(NVGcontext *ctx, int icon) {
+    if (nvg_is_atlas_icon(icon)) {
+        Screen *screen = nvg_screen(ctx);
+        TextureAtlas::Entry entry;
+        if (!screen || !screen->icon_atlas()->lookup(-2 - icon, entry))
+            throw std::runtime_error("nvg_image_icon_size(): unknown atlas icon!");
+        return entry.size;
+    }
+
+    int w = 0, h = 0;
+    nvgImageSize(ctx, icon, &w, &h);
+    return Vector2i(w, h);
+}
+
+NVGpaint nvg_image_icon_pattern(NVGcontext *ctx, int icon, float x, float y,
+                                float w, float h, float alpha) {
+    if (nvg_is_atlas_icon(icon)) {
+        Screen *screen = nvg_screen(ctx);
+        TextureAtlas::Entry entry;
+        if (!screen || !screen->icon_atlas()->lookup(-2 - icon, entry))
+            throw std::runtime_error("nvg_image_icon_pattern(): unknown atlas icon!");
+        return screen->icon_atlas()->pattern(ctx, entry, x, y, w, h, alpha);
+    }
+
+    return nvgImagePattern(ctx, x, y, w, h, 0.f, icon, alpha);
+}
+
 std::vector<std::pair<int, std::string>>
 load_image_directory(NVGcontext *ctx, const std::string &path) {
-    std::vector<std::pair<int, std::string> > result;
-#if !defined(_WIN32)
-    DIR *dp = opendir(path.c_str());
-    if (!dp)
-        throw std::runtime_error("Could not open image directory!");
-    struct dirent *ep;
-    while ((ep = readdir(dp))) {
-        const char *fname = ep->d_name;
-#else
-    WIN32_FIND_DATA ffd;
-    std::string search_path = path + "/*.*";
-    HANDLE handle = FindFirstFileA(search_path.c_str(), &ffd);
-    if (handle == INVALID_HANDLE_VALUE)
-        throw std::runtime_error("Could not open image directory!");
-    do {
-        const char *fname = ffd.cFileName;
-#endif
-        if (strstr(fname, "png") == nullptr)
-            continue;
-        std::string full_name = path + "/" + std::string(fname);
-        int img = nvgCreateImage(ctx, full_name.c_str(), 0);
-        if (img == 0)
-            throw std::runtime_error("Could not open image data!");
-        result.push_back(
-            std::make_pair(img, full_name.substr(0, full_name.length() - 4)));
-#if !defined(_WIN32)
+    ref<ImageLoader> loader = new ImageLoader(ImageLoader::Target::NanoVG);
+    std::vector<std::pair<int, std::string>> result(loader->load_directory(path));
+
+    loader->set_callback([&result](const ImageLoader::Image &image) {
+        const std::string &name = image.filename;
+        result[image.index] =
+            std::make_pair(image.nvg_image, name.substr(0, name.length() - 4));
+    });
+    loader->wait(ctx);
+
+    if (!loader->failed().empty()) {
+        /* Don't leak the images that were loaded successfully */
+        for (const auto &entry : result) {
+            if (entry.first > 0)
+                nvgDeleteImage(ctx, entry.first);
+        }
+        throw std::runtime_error("Could not open image data!");
     }
-    closedir(dp);
-#else
-    } while (FindNextFileA(handle, &ffd) != 0);
-    FindClose(handle);
-#endif
+
     return result;
 }
 
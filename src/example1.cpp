@@ -285,11 +285,11 @@ public:
 
         graph->set_header("E = 2.35e-3");
         graph->set_footer("Iteration 89");
-        std::vector<float> &func = graph->values();
-        func.resize(100);
+        std::vector<float> func(100);
         for (int i = 0; i < 100; ++i)
             func[i] = 0.5f * (0.5f * std::sin(i / 10.f) +
                               0.5f * std::cos(i / 23.f) + 1);
+        graph->set_values(func);
 
         // Dummy tab used to represent the last tab button.
         int plus_id = tab_widget->append_tab("+", new Widget(tab_widget));
@@ -309,12 +309,12 @@ public:
 
                 graph_dyn->set_header("E = 2.35e-3");
                 graph_dyn->set_footer("Iteration " + std::to_string(new_id*counter));
-                std::vector<float> &func_dyn = graph_dyn->values();
-                func_dyn.resize(100);
+                std::vector<float> func_dyn(100);
                 for (int i = 0; i < 100; ++i)
                     func_dyn[i] = 0.5f *
                         std::abs((0.5f * std::sin(i / 10.f + counter) +
                                   0.5f * std::cos(i / 23.f + 1 + counter)));
+                graph_dyn->set_values(func_dyn);
                 ++counter;
                 tab_widget->set_selected_id(new_id);
 
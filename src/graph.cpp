@@ -12,6 +12,8 @@
 #include <nanogui/graph.h>
 #include <nanogui/theme.h>
 #include <nanogui/opengl.h>
+#include <algorithm>
+#include <cmath>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -23,6 +25,85 @@ Graph::Graph(Widget *parent, const std::string &caption)
     m_text_color = Color(240, 192);
 }
 
+const std::vector<float> &Graph::values() const {
+    flush_pending();
+    linearize();
+    return m_values;
+}
+
+void Graph::set_values(const std::vector<float> &values) {
+    size_t offset = 0;
+    if (m_capacity > 0 && values.size() > m_capacity)
+        offset = values.size() - m_capacity;
+    m_values.assign(values.begin() + offset, values.end());
+    m_head = 0;
+    m_pyramid.clear();
+
+    /* Discard values that were pushed before the replacement */
+    std::lock_guard<std::mutex> guard(m_pending_mutex);
+    m_pending.clear();
+}
+
+void Graph::set_capacity(size_t capacity) {
+    flush_pending();
+    linearize();
+
+    /* push_values() reads the capacity on other threads */
+    std::lock_guard<std::mutex> guard(m_pending_mutex);
+    m_capacity = capacity;
+    if (m_capacity > 0 && m_values.size() > m_capacity)
+        m_values.erase(m_values.begin(), m_values.end() - m_capacity);
+    if (m_capacity > 0 && m_pending.size() > m_capacity)
+        m_pending.erase(m_pending.begin(), m_pending.end() - m_capacity);
+    m_pyramid.clear();
+}
+
+void Graph::push_values(const float *values, size_t count) {
+    std::lock_guard<std::mutex> guard(m_pending_mutex);
+    m_pending.insert(m_pending.end(), values, values + count);
+
+    /* Don't let the queue grow beyond what can be retained */
+    if (m_capacity > 0 && m_pending.size() > m_capacity)
+        m_pending.erase(m_pending.begin(), m_pending.end() - m_capacity);
+}
+
+void Graph::flush_pending() const {
+    std::vector<float> pending;
+    {
+        std::lock_guard<std::mutex> guard(m_pending_mutex);
+        if (m_pending.empty())
+            return;
+        pending.swap(m_pending);
+    }
+
+    if (m_capacity == 0) {
+        linearize();
+        m_values.insert(m_values.end(), pending.begin(), pending.end());
+        return;
+    }
+
+    size_t offset = 0;
+    if (pending.size() > m_capacity)
+        offset = pending.size() - m_capacity;
+
+    for (size_t i = offset; i < pending.size(); ++i) {
+        if (m_values.size() < m_capacity) {
+            /* Still filling up, m_head == 0 */
+            m_values.push_back(pending[i]);
+        } else {
+            m_values[m_head] = pending[i];
+            m_head = (m_head + 1) % m_capacity;
+        }
+    }
+}
+
+void Graph::linearize() const {
+    if (m_head == 0)
+        return;
+    std::rotate(m_values.begin(), m_values.begin() + m_head, m_values.end());
+    m_head = 0;
+}
+
 Vector2i Graph::preferred_size(NVGcontext *) const {
     return Vector2i(180, 45);
 }
@@ -35,16 +116,69 @@ void Graph::draw(NVGcontext *ctx) {
     nvgFillColor(ctx, m_background_color);
     nvgFill(ctx);
 
-    if (m_values.size() < 2)
+    flush_pending();
+
+    size_t n = m_values.size();
+    if (n < 2)
         return;
 
     nvgBeginPath(ctx);
     nvgMoveTo(ctx, m_pos.x(), m_pos.y()+m_size.y());
-    for (size_t i = 0; i < (size_t) m_values.size(); i++) {
-        float value = m_values[i];
-        float vx = m_pos.x() + i * m_size.x() / (float) (m_values.size() - 1);
-        float vy = m_pos.y() + (1-value) * m_size.y();
-        nvgLineTo(ctx, vx, vy);
+
+    size_t columns = (size_t) std::max(m_size.x(), 2);
+    if (n <= 2 * columns) {
+        for (size_t i = 0; i < n; i++) {
+            float vx = m_pos.x() + i * m_size.x() / (float) (n - 1);
+            float vy = m_pos.y() + (1 - value(i)) * m_size.y();
+            nvgLineTo(ctx, vx, vy);
+        }
+    } else if (m_capacity == 0) {
+        /* More than two values per pixel: only draw the envelope of each
+           pixel column, looked up in O(log n) time from the pyramid */
+        m_pyramid.extend(m_values.data(), n);
+        std::vector<SamplePyramid::Envelope> envelopes(columns);
+        m_pyramid.envelopes(m_values.data(), 0, n, columns, envelopes.data());
+
+        float last = envelopes[0].mean;
+        for (size_t c = 0; c < columns; c++) {
+            const SamplePyramid::Envelope &e = envelopes[c];
+            float vx = m_pos.x() + c * m_size.x() / (float) (columns - 1);
+
+            /* Continue the line with the extremum that is closest */
+            bool min_first = std::abs(e.min - last) < std::abs(e.max - last);
+            float first = min_first ? e.min : e.max,
+                  second = min_first ? e.max : e.min;
+            nvgLineTo(ctx, vx, m_pos.y() + (1 - first) * m_size.y());
+            if (first != second)
+                nvgLineTo(ctx, vx, m_pos.y() + (1 - second) * m_size.y());
+            last = second;
+        }
+    } else {
+        /* Same for ring buffers, whose values are overwritten. Emit the
+           extrema of each column in chronological order. */
+        for (size_t c = 0; c < columns; c++) {
+            size_t start = c * n / columns, end = (c + 1) * n / columns;
+            size_t i_min = start, i_max = start;
+            float v_min = value(start), v_max = v_min;
+            for (size_t i = start + 1; i < end; i++) {
+                float v = value(i);
+                if (v < v_min) {
+                    v_min = v;
+                    i_min = i;
+                }
+                if (v > v_max) {
+                    v_max = v;
+                    i_max = i;
+                }
+            }
+
+            float vx = m_pos.x() + c * m_size.x() / (float) (columns - 1);
+            float first = i_min < i_max ? v_min : v_max,
+                  second = i_min < i_max ? v_max : v_min;
+            nvgLineTo(ctx, vx, m_pos.y() + (1 - first) * m_size.y());
+            if (i_min != i_max)
+                nvgLineTo(ctx, vx, m_pos.y() + (1 - second) * m_size.y());
+        }
     }
 
     nvgLineTo(ctx, m_pos.x() + m_size.x(), m_pos.y() + m_size.y());
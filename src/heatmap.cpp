@@ -0,0 +1,172 @@
+/*
+    src/heatmap.cpp -- Widget that displays scalar data (e.g. a scrolling
+    spectrogram) through a colormap
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/heatmap.h>
+#include <nanogui/renderpass.h>
+#include <nanogui/shader.h>
+#include <nanogui/pixelconvert.h>
+#include <nanogui/opengl.h>
+#include <nanogui_resources.h>
+#include <cstring>
+#include <memory>
+
+NAMESPACE_BEGIN(nanogui)
+
+/// Number of entries of the colormap lookup table
+static const int colormap_size = 256;
+
+Heatmap::Heatmap(Widget *parent, const Vector2i &data_size,
+                 Texture::ComponentFormat component_format)
+    : Canvas(parent, 1, false, false, false), m_data_size(data_size) {
+    if (component_format != Texture::ComponentFormat::Float32 &&
+        component_format != Texture::ComponentFormat::Float16)
+        throw std::runtime_error(
+            "Heatmap::Heatmap(): component format must be Float32 or Float16!");
+    if (data_size.x() <= 0 || data_size.y() <= 0)
+        throw std::runtime_error("Heatmap::Heatmap(): invalid data size!");
+
+    m_shader = new Shader(
+        render_pass(),
+        "heatmap",
+        NANOGUI_SHADER(heatmap_vertex),
+        NANOGUI_SHADER(heatmap_fragment)
+    );
+
+    const float positions[] = {
+        0.f, 0.f, 1.f, 0.f, 0.f, 1.f,
+        1.f, 0.f, 1.f, 1.f, 0.f, 1.f
+    };
+
+    m_shader->set_buffer("position", VariableType::Float32, { 6, 2 }, positions);
+    m_render_pass->set_cull_mode(RenderPass::CullMode::Disabled);
+
+    /* Columns wrap around, see the fragment shader */
+    m_values = new Texture(
+        Texture::PixelFormat::R,
+        component_format,
+        data_size,
+        Texture::InterpolationMode::Nearest,
+        Texture::InterpolationMode::Nearest,
+        Texture::WrapMode::Repeat
+    );
+
+    std::unique_ptr<float[]> zeros(new float[(size_t) data_size.x() * data_size.y()]());
+    set_data(zeros.get());
+    m_upload_bytes = 0;
+
+    m_colormap = new Texture(
+        Texture::PixelFormat::RGBA,
+        Texture::ComponentFormat::UInt8,
+        Vector2i(colormap_size, 1),
+        Texture::InterpolationMode::Bilinear,
+        Texture::InterpolationMode::Bilinear,
+        Texture::WrapMode::ClampToEdge
+    );
+
+    set_colormap(Colormap::Viridis);
+
+    m_shader->set_texture("values", m_values);
+    m_shader->set_texture("colormap", m_colormap);
+}
+
+void Heatmap::upload(const float *values, const Vector2i &origin,
+                     const Vector2i &size) {
+    size_t count = (size_t) size.x() * (size_t) size.y();
+
+    if (m_values->component_format() == Texture::ComponentFormat::Float16) {
+        std::unique_ptr<uint16_t[]> half(new uint16_t[count]);
+        convert_pixels(values, Texture::PixelFormat::R, Texture::ComponentFormat::Float32,
+                       half.get(), Texture::PixelFormat::R, Texture::ComponentFormat::Float16,
+                       count);
+        m_values->upload_sub_region((const uint8_t *) half.get(), origin, size);
+        m_upload_bytes += count * sizeof(uint16_t);
+    } else {
+        m_values->upload_sub_region((const uint8_t *) values, origin, size);
+        m_upload_bytes += count * sizeof(float);
+    }
+}
+
+void Heatmap::push_column(const float *values) {
+    upload(values, Vector2i(m_column, 0), Vector2i(1, m_data_size.y()));
+    m_column = (m_column + 1) % m_data_size.x();
+}
+
+void Heatmap::set_data(const float *values) {
+    upload(values, Vector2i(0, 0), m_data_size);
+    m_column = 0;
+}
+
+void Heatmap::set_range(float range_min, float range_max) {
+    if (!(range_min < range_max))
+        throw std::runtime_error("Heatmap::set_range(): invalid range!");
+    m_range_min = range_min;
+    m_range_max = range_max;
+}
+
+void Heatmap::set_colormap(Colormap colormap) {
+    switch (colormap) {
+        case Colormap::Grayscale:
+            set_colormap({ Color(0, 255), Color(255, 255) });
+            break;
+
+        case Colormap::Viridis:
+            set_colormap({
+                Color(0x44, 0x01, 0x54, 0xff), Color(0x47, 0x2d, 0x7b, 0xff),
+                Color(0x3b, 0x52, 0x8b, 0xff), Color(0x2c, 0x72, 0x8e, 0xff),
+                Color(0x21, 0x91, 0x8c, 0xff), Color(0x28, 0xae, 0x80, 0xff),
+                Color(0x5e, 0xc9, 0x62, 0xff), Color(0xad, 0xdc, 0x30, 0xff),
+                Color(0xfd, 0xe7, 0x25, 0xff)
+            });
+            break;
+
+        case Colormap::Inferno:
+            set_colormap({
+                Color(0x00, 0x00, 0x04, 0xff), Color(0x1f, 0x0c, 0x48, 0xff),
+                Color(0x55, 0x0f, 0x6d, 0xff), Color(0x88, 0x22, 0x6a, 0xff),
+                Color(0xba, 0x36, 0x55, 0xff), Color(0xe3, 0x59, 0x33, 0xff),
+                Color(0xf9, 0x8e, 0x09, 0xff), Color(0xf8, 0xc9, 0x32, 0xff),
+                Color(0xfc, 0xff, 0xa4, 0xff)
+            });
+            break;
+
+        default:
+            throw std::runtime_error("Heatmap::set_colormap(): invalid colormap!");
+    }
+}
+
+void Heatmap::set_colormap(const std::vector<Color> &colors) {
+    if (colors.empty())
+        throw std::runtime_error("Heatmap::set_colormap(): no colors specified!");
+
+    uint8_t lut[colormap_size * 4];
+    for (int i = 0; i < colormap_size; ++i) {
+        float t = (float) i / (colormap_size - 1) * (colors.size() - 1);
+        size_t j = std::min((size_t) t, colors.size() - 1),
+               k = std::min(j + 1, colors.size() - 1);
+        Color c = colors[j] * (1.f - (t - j)) + colors[k] * (t - j);
+        for (int ch = 0; ch < 4; ++ch)
+            lut[i * 4 + ch] = (uint8_t) std::max(0.f, std::min(255.f, c[ch] * 255.f + .5f));
+    }
+
+    m_colormap->upload(lut);
+}
+
+void Heatmap::draw_contents() {
+    m_shader->set_uniform("offset", (float) m_column / (float) m_data_size.x());
+    m_shader->set_uniform("range", Vector2f(m_range_min, 1.f / (m_range_max - m_range_min)));
+
+    m_shader->begin();
+    m_shader->draw_array(Shader::PrimitiveType::Triangle, 0, 6, false);
+    m_shader->end();
+}
+
+NAMESPACE_END(nanogui)
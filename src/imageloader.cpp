@@ -0,0 +1,250 @@
+/*
+    src/imageloader.cpp -- Decodes images using a pool of background
+    threads and uploads them to the GPU in per-frame batches
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#  define NOMINMAX 1
+#  endif
+#  include <windows.h>
+#else
+#  include <dirent.h>
+#endif
+
+#include <nanogui/imageloader.h>
+#include <nanovg.h>
+#include <stb_image.h>
+#include <algorithm>
+#include <cstring>
+
+NAMESPACE_BEGIN(nanogui)
+
+ImageLoader::ImageLoader(Target target, size_t threads) : m_target(target) {
+    if (threads == 0)
+        threads = std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+    for (size_t i = 0; i < threads; ++i)
+        m_workers.emplace_back([this]() { worker(); });
+}
+
+ImageLoader::~ImageLoader() {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_shutdown = true;
+    }
+    m_cv.notify_all();
+    for (std::thread &t : m_workers)
+        t.join();
+}
+
+size_t ImageLoader::load(const std::string &filename) {
+    size_t index = m_total_count++;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_queue.push_back(Request { index, filename });
+    }
+    m_cv.notify_one();
+    return index;
+}
+
+size_t ImageLoader::load_directory(const std::string &path, const std::string &extension) {
+    size_t count = 0;
+#if !defined(_WIN32)
+    DIR *dp = opendir(path.c_str());
+    if (!dp)
+        throw std::runtime_error("ImageLoader::load_directory(): could not open image directory!");
+    struct dirent *ep;
+    while ((ep = readdir(dp))) {
+        const char *fname = ep->d_name;
+#else
+    WIN32_FIND_DATA ffd;
+    std::string search_path = path + "/*.*";
+    HANDLE handle = FindFirstFileA(search_path.c_str(), &ffd);
+    if (handle == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("ImageLoader::load_directory(): could not open image directory!");
+    do {
+        const char *fname = ffd.cFileName;
+#endif
+        if (strstr(fname, extension.c_str()) == nullptr)
+            continue;
+        load(path + "/" + std::string(fname));
+        count++;
+#if !defined(_WIN32)
+    }
+    closedir(dp);
+#else
+    } while (FindNextFileA(handle, &ffd) != 0);
+    FindClose(handle);
+#endif
+    return count;
+}
+
+void ImageLoader::set_wakeup_callback(const WakeupCallback &callback) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_wakeup_callback = callback;
+}
+
+void ImageLoader::set_decoded_limit(size_t decoded_limit) {
+    if (decoded_limit == 0)
+        throw std::runtime_error("ImageLoader::set_decoded_limit(): limit must be positive!");
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_decoded_limit = decoded_limit;
+    }
+    m_cv.notify_all();
+}
+
+void ImageLoader::worker() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this]() {
+            return m_shutdown || (!m_queue.empty() &&
+                                  m_decoded.size() + m_in_flight < m_decoded_limit);
+        });
+        if (m_shutdown)
+            break;
+
+        Request request = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_in_flight++;
+        lock.unlock();
+
+        /* NanoVG expects RGBA data, textures keep the channels of the file */
+        int w = 0, h = 0, n = 0;
+        uint8_t *pixels = stbi_load(request.filename.c_str(), &w, &h, &n,
+                                    m_target == Target::NanoVG ? 4 : 0);
+        if (m_target == Target::NanoVG)
+            n = 4;
+
+        lock.lock();
+        m_in_flight--;
+        m_decoded.push_back(Decoded {
+            request.index, std::move(request.filename), Vector2i(w, h), n,
+            std::unique_ptr<uint8_t[], void(*)(void *)>(pixels, stbi_image_free) });
+        m_decoded_cv.notify_all();
+
+        if (m_wakeup_callback) {
+            WakeupCallback callback = m_wakeup_callback;
+            lock.unlock();
+            callback();
+            lock.lock();
+        }
+    }
+}
+
+void ImageLoader::upload(NVGcontext *ctx, const Decoded &decoded, Image &image) {
+    image.index = decoded.index;
+    image.filename = decoded.filename;
+    image.size = decoded.size;
+
+    if (m_target == Target::NanoVG) {
+        image.nvg_image = nvgCreateImageRGBA(ctx, decoded.size.x(), decoded.size.y(),
+                                             0, decoded.pixels.get());
+        if (image.nvg_image == 0)
+            throw std::runtime_error("ImageLoader::upload(): could not create NanoVG image!");
+    } else {
+        Texture::PixelFormat pixel_format;
+        switch (decoded.channels) {
+            case 1: pixel_format = Texture::PixelFormat::R;    break;
+            case 2: pixel_format = Texture::PixelFormat::RA;   break;
+            case 3: pixel_format = Texture::PixelFormat::RGB;  break;
+            case 4: pixel_format = Texture::PixelFormat::RGBA; break;
+            default:
+                throw std::runtime_error("ImageLoader::upload(): unsupported channel count!");
+        }
+        image.texture = new Texture(pixel_format, Texture::ComponentFormat::UInt8,
+                                    decoded.size);
+
+        /* Converts the pixels if the backend substituted another format (e.g. RGBA for RGB) */
+        image.texture->upload(decoded.pixels.get(), pixel_format,
+                              Texture::ComponentFormat::UInt8);
+    }
+}
+
+bool ImageLoader::process(NVGcontext *ctx) {
+    if (m_target == Target::NanoVG && !ctx)
+        throw std::runtime_error("ImageLoader::process(): a NanoVG context is required!");
+
+    std::vector<Decoded> decoded;
+    bool pending;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        size_t count = m_decoded.size();
+        if (m_upload_limit != 0)
+            count = std::min(count, m_upload_limit);
+        for (size_t i = 0; i < count; ++i) {
+            decoded.push_back(std::move(m_decoded.front()));
+            m_decoded.pop_front();
+        }
+        pending = !m_queue.empty() || m_in_flight > 0 || !m_decoded.empty();
+    }
+
+    if (decoded.empty())
+        return pending;
+
+    /* Let the workers continue while this thread is uploading */
+    m_cv.notify_all();
+
+    for (Decoded &d : decoded) {
+        /* A failed upload must not drop the remaining images of the batch */
+        Image image;
+        bool success = false;
+        if (d.pixels) {
+            try {
+                upload(ctx, d, image);
+                success = true;
+            } catch (const std::exception &) {
+                /* Reported through failed() */
+            }
+        }
+
+        if (!success) {
+            m_failed.push_back(std::move(d.filename));
+            continue;
+        }
+
+        m_loaded_count++;
+        if (m_callback)
+            m_callback(image);
+    }
+
+    if (m_progress_callback)
+        m_progress_callback(m_loaded_count + m_failed.size(), m_total_count);
+
+    return pending;
+}
+
+void ImageLoader::wait(NVGcontext *ctx) {
+    size_t upload_limit = m_upload_limit;
+    m_upload_limit = 0;
+
+    try {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_decoded_cv.wait(lock, [this]() {
+                    return !m_decoded.empty() ||
+                           (m_queue.empty() && m_in_flight == 0);
+                });
+            }
+            if (!process(ctx))
+                break;
+        }
+    } catch (...) {
+        m_upload_limit = upload_limit;
+        throw;
+    }
+
+    m_upload_limit = upload_limit;
+}
+
+NAMESPACE_END(nanogui)
@@ -11,6 +11,7 @@
 */
 
 #include <nanogui/imagepanel.h>
+#include <nanogui/screen.h>
 #include <nanogui/opengl.h>
 
 NAMESPACE_BEGIN(nanogui)
@@ -19,11 +20,23 @@ ImagePanel::ImagePanel(Widget *parent)
     : Widget(parent), m_thumb_size(64), m_spacing(10), m_margin(10),
       m_mouse_index(-1) {}
 
+void ImagePanel::set_source(ImageSource *source, const std::string &cache_directory) {
+    m_source = source;
+    m_images.clear();
+
+    /* Reuse the atlas pages of the previous thumbnail cache if possible */
+    if (m_thumbnails && m_thumbnails->cache_directory() == cache_directory)
+        m_thumbnails->clear();
+    else
+        m_thumbnails = nullptr;
+    m_cache_directory = cache_directory;
+}
+
 Vector2i ImagePanel::grid_size() const {
     int n_cols = 1 + std::max(0,
         (int) ((m_size.x() - 2 * m_margin - m_thumb_size) /
         (float) (m_thumb_size + m_spacing)));
-    int n_rows = ((int) m_images.size() + n_cols - 1) / n_cols;
+    int n_rows = ((int) image_count() + n_cols - 1) / n_cols;
     return Vector2i(n_cols, n_rows);
 }
 
@@ -40,6 +53,26 @@ int ImagePanel::index_for_position(const Vector2i &p) const {
     return over_image ? (grid_pos.x() + grid_pos.y() * grid.x()) : -1;
 }
 
+Vector2i ImagePanel::visible_rows() const {
+    /* Clip the panel (in its own coordinates) against all ancestors */
+    Vector2i min_p(0), max_p = m_size, offset = m_pos;
+    for (const Widget *w = parent(); w; w = w->parent()) {
+        min_p = max(min_p, -offset);
+        max_p = min(max_p, w->size() - offset);
+        offset += w->position();
+    }
+    if (min_p.y() >= max_p.y() || min_p.x() >= max_p.x())
+        return Vector2i(0);
+
+    /* Include the shadows, which extend 5 pixels beyond each icon */
+    float stride = (float) (m_thumb_size + m_spacing);
+    int rows = grid_size().y(),
+        begin = (int) std::floor((min_p.y() - m_margin - m_thumb_size - 5) / stride) + 1,
+        end = (int) std::ceil((max_p.y() - m_margin + 5) / stride);
+
+    return Vector2i(std::max(begin, 0), std::min(end, rows));
+}
+
 bool ImagePanel::mouse_motion_event(const Vector2i &p, const Vector2i & /* rel */,
                                     int /* button */, int /* modifiers */) {
     m_mouse_index = index_for_position(p);
@@ -49,7 +82,7 @@ bool ImagePanel::mouse_motion_event(const Vector2i &p, const Vector2i & /* rel *
 bool ImagePanel::mouse_button_event(const Vector2i &p, int /* button */, bool down,
                                     int /* modifiers */) {
     int index = index_for_position(p);
-    if (index >= 0 && index < (int) m_images.size() && m_callback && down)
+    if (index >= 0 && index < (int) image_count() && m_callback && down)
         m_callback(index);
     return true;
 }
@@ -63,34 +96,84 @@ Vector2i ImagePanel::preferred_size(NVGcontext *) const {
 }
 
 void ImagePanel::draw(NVGcontext* ctx) {
-    Vector2i grid = grid_size();
+    Vector2i grid = grid_size(), rows = visible_rows();
+    size_t begin = (size_t) rows.x() * grid.x(),
+           end = std::min((size_t) rows.y() * grid.x(), image_count());
+    if (begin >= end)
+        return;
+
+    if (m_source) {
+        Screen *scr = screen();
+        int resolution = (int) std::ceil(m_thumb_size * scr->pixel_ratio());
+        if (!m_thumbnails || m_thumbnails->resolution() != resolution) {
+            m_thumbnails = new ThumbnailCache(resolution, 1024, m_cache_directory);
+            /* Redraw as soon as thumbnails become available */
+            m_thumbnails->set_callback([scr]() { scr->redraw(); });
+        }
+
+        /* Keep the thumbnails of about three screens resident while scrolling */
+        size_t needed = (end - begin) * 3;
+        if (m_thumbnails->capacity() < needed)
+            m_thumbnails->set_capacity(needed);
+
+        /* Upload thumbnails that finished loading, keep drawing while others are pending */
+        if (m_thumbnails->begin_frame(ctx))
+            scr->redraw();
+
+        /* Prefetch the adjacent rows. Requests are processed most recent
+           first, so the visible thumbnails requested below take precedence */
+        int image;
+        Vector2i origin;
+        size_t prefetch_begin = begin - std::min(begin, (size_t) grid.x()),
+               prefetch_end = std::min(end + grid.x(), image_count());
+        for (size_t i = prefetch_begin; i < begin; ++i)
+            m_thumbnails->lookup(m_source->filename(i), true, image, origin);
+        for (size_t i = end; i < prefetch_end; ++i)
+            m_thumbnails->lookup(m_source->filename(i), true, image, origin);
+    }
 
-    for (size_t i = 0; i < m_images.size(); ++i) {
+    for (size_t i = begin; i < end; ++i) {
         Vector2i p = m_pos + Vector2i(m_margin) +
             Vector2i((int) i % grid.x(), (int) i / grid.x()) * (m_thumb_size + m_spacing);
-        int imgw, imgh;
-
-        nvgImageSize(ctx, m_images[i].first, &imgw, &imgh);
-        float iw, ih, ix, iy;
-        if (imgw < imgh) {
-            iw = m_thumb_size;
-            ih = iw * (float)imgh / (float)imgw;
-            ix = 0;
-            iy = -(ih - m_thumb_size) * 0.5f;
-        } else {
-            ih = m_thumb_size;
-            iw = ih * (float)imgw / (float)imgh;
-            ix = -(iw - m_thumb_size) * 0.5f;
-            iy = 0;
-        }
-
-        NVGpaint img_paint = nvgImagePattern(
-            ctx, p.x() + ix, p.y()+ iy, iw, ih, 0, m_images[i].first,
-            m_mouse_index == (int)i ? 1.0 : 0.7);
+        float alpha = m_mouse_index == (int) i ? 1.0f : 0.7f;
 
         nvgBeginPath(ctx);
         nvgRoundedRect(ctx, p.x(), p.y(), m_thumb_size, m_thumb_size, 5);
-        nvgFillPaint(ctx, img_paint);
+
+        if (m_source) {
+            int image;
+            Vector2i origin;
+            if (m_thumbnails->lookup(m_source->filename(i), true, image, origin)) {
+                /* Position the atlas page so that the thumbnail covers the icon */
+                float scale = m_thumb_size / (float) m_thumbnails->resolution();
+                Vector2f page_size = Vector2f(m_thumbnails->page_size()) * scale,
+                         page_pos = Vector2f(p) - Vector2f(origin) * scale;
+                nvgFillPaint(ctx, nvgImagePattern(ctx, page_pos.x(), page_pos.y(),
+                                                  page_size.x(), page_size.y(), 0,
+                                                  image, alpha));
+            } else {
+                nvgFillColor(ctx, nvgRGBA(0, 0, 0, (int) (alpha * 64)));
+            }
+        } else {
+            Vector2i image_size = nvg_image_icon_size(ctx, m_images[i].first);
+            int imgw = image_size.x(), imgh = image_size.y();
+            float iw, ih, ix, iy;
+            if (imgw < imgh) {
+                iw = m_thumb_size;
+                ih = iw * (float)imgh / (float)imgw;
+                ix = 0;
+                iy = -(ih - m_thumb_size) * 0.5f;
+            } else {
+                ih = m_thumb_size;
+                iw = ih * (float)imgw / (float)imgh;
+                ix = -(iw - m_thumb_size) * 0.5f;
+                iy = 0;
+            }
+
+            NVGpaint img_paint = nvg_image_icon_pattern(
+                ctx, m_images[i].first, p.x() + ix, p.y()+ iy, iw, ih, alpha);
+            nvgFillPaint(ctx, img_paint);
+        }
         nvgFill(ctx);
 
         NVGpaint shadow_paint =
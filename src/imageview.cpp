@@ -14,8 +14,10 @@
 #include <nanogui/shader.h>
 #include <nanogui/texture.h>
 #include <nanogui/screen.h>
+#include <nanogui/sdffont.h>
 #include <nanogui/opengl.h>
 #include <nanogui_resources.h>
+#include <cstring>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -51,6 +53,42 @@ void ImageView::set_image(Texture *image) {
             "ImageView::set_image(): interpolation mode must be set to 'Nearest'!");
     m_image_shader->set_texture("image", image);
     m_image = image;
+    m_tile_cache = nullptr;
+    invalidate_pixel_values();
+}
+
+void ImageView::set_tile_source(TileSource *source, size_t cache_capacity) {
+    if (!m_tile_shader) {
+        m_tile_shader = new Shader(
+            render_pass(),
+            "imageview_tiles",
+            NANOGUI_SHADER(imageview_tile_vertex),
+            NANOGUI_SHADER(imageview_tile_fragment),
+            Shader::BlendMode::AlphaBlend
+        );
+
+        /* Tile quads are regenerated every frame */
+        m_tile_shader->set_buffer_usage("position", Shader::BufferUsage::Stream);
+        m_tile_shader->set_buffer_usage("uv", Shader::BufferUsage::Stream);
+    }
+
+    m_tile_cache = new TileCache(source, cache_capacity);
+    m_tile_shader->set_texture("tiles", m_tile_cache->texture());
+
+    /* Redraw as soon as tiles become available */
+    Screen *scr = screen();
+    m_tile_cache->set_callback([scr]() { scr->redraw(); });
+    m_image = nullptr;
+    invalidate_pixel_values();
+}
+
+Vector2i ImageView::image_size() const {
+    if (m_image)
+        return m_image->size();
+    else if (m_tile_cache)
+        return m_tile_cache->source()->size();
+    else
+        return Vector2i(0);
 }
 
 float ImageView::scale() const {
@@ -62,9 +100,9 @@ void ImageView::set_scale(float scale) {
 }
 
 void ImageView::center() {
-    if (!m_image)
+    if (!m_image && !m_tile_cache)
         return;
-    m_offset = Vector2i(.5f * (Vector2f(m_size) * screen()->pixel_ratio() - Vector2f(m_image->size()) * scale()));
+    m_offset = Vector2i(.5f * (Vector2f(m_size) * screen()->pixel_ratio() - Vector2f(image_size()) * scale()));
 }
 
 void ImageView::reset() {
@@ -87,7 +125,7 @@ Vector2f ImageView::pixel_to_pos(const Vector2f &p) const {
 }
 
 bool ImageView::keyboard_event(int key, int /* scancode */, int action, int /* modifiers */) {
-    if (!m_enabled || !m_image)
+    if (!m_enabled || (!m_image && !m_tile_cache))
         return false;
 
     if (action == GLFW_PRESS) {
@@ -101,7 +139,7 @@ bool ImageView::keyboard_event(int key, int /* scancode */, int action, int /* m
 
 bool ImageView::mouse_drag_event(const Vector2i & /* p */, const Vector2i &rel,
                                  int /* button */, int /* modifiers */) {
-    if (!m_enabled || !m_image)
+    if (!m_enabled || (!m_image && !m_tile_cache))
         return false;
 
     m_offset += rel * screen()->pixel_ratio();
@@ -110,7 +148,7 @@ bool ImageView::mouse_drag_event(const Vector2i & /* p */, const Vector2i &rel,
 }
 
 bool ImageView::scroll_event(const Vector2i &p, const Vector2f &rel) {
-    if (!m_enabled || !m_image)
+    if (!m_enabled || (!m_image && !m_tile_cache))
         return false;
 
     Vector2f p1 = pos_to_pixel(p - m_pos);
@@ -118,8 +156,8 @@ bool ImageView::scroll_event(const Vector2i &p, const Vector2f &rel) {
 
     // Restrict scaling to a reasonable range
     m_scale = std::max(
-        m_scale, std::min(0.f, std::log2(40.f / std::max(m_image->size().x(),
-                                                         m_image->size().y())) * 5.f));
+        m_scale, std::min(0.f, std::log2(40.f / std::max(image_size().x(),
+                                                         image_size().y())) * 5.f));
     m_scale = std::min(m_scale, 45.f);
 
     Vector2f p2 = pos_to_pixel(p - m_pos);
@@ -128,13 +166,13 @@ bool ImageView::scroll_event(const Vector2i &p, const Vector2f &rel) {
 }
 
 void ImageView::draw(NVGcontext *ctx) {
-    if (!m_enabled || !m_image)
+    if (!m_enabled || (!m_image && !m_tile_cache))
         return;
 
     Canvas::draw(ctx);
 
     Vector2i top_left = Vector2i(pixel_to_pos(Vector2f(0.f, 0.f))),
-             size     = Vector2i(pixel_to_pos(Vector2f(m_image->size())) - Vector2f(top_left));
+             size     = Vector2i(pixel_to_pos(Vector2f(image_size())) - Vector2f(top_left));
 
     if (m_draw_image_border) {
         nvgBeginPath(ctx);
@@ -145,62 +183,20 @@ void ImageView::draw(NVGcontext *ctx) {
                      size.x() + 1.f, size.y() + 1.f);
         nvgStroke(ctx);
     }
-
-    nvgSave(ctx);
-    nvgIntersectScissor(ctx, m_pos.x(), m_pos.y(), m_size.x(), m_size.y());
-
-    if (scale() > 100 && m_pixel_callback) {
-        float font_size = scale() / 10.f;
-        float alpha = std::min(1.f, (scale() - 100) / 100.f);
-        nvgFontSize(ctx, font_size);
-        nvgFontFace(ctx, "sans-bold");
-        nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
-
-        Vector2i start = max(Vector2i(0), Vector2i(pos_to_pixel(Vector2f(0.f, 0.f))) - 1),
-                 end   = min(Vector2i(pos_to_pixel(Vector2f(m_size))) + 1, m_image->size() - 1);
-
-        char text_buf[80],
-            *text[4] = { text_buf, text_buf + 20, text_buf + 40, text_buf + 60 };
-
-        for (int y = start.y(); y <= end.y(); ++y) {
-            for (int x = start.x(); x <= end.x(); ++x) {
-                Vector2i pos = Vector2i(pixel_to_pos(Vector2f(x + .5f, y + .5f)));
-
-                m_pixel_callback(Vector2i(x, y), text, 20);
-
-                for (int ch = 0; ch < 4; ++ch) {
-                    Color col(0.f, 0.f, 0.f, alpha);
-                    nvgFillColor(ctx, col);
-                    nvgFontBlur(ctx, 2);
-                    float xpos = m_pos.x() + pos.x(),
-                          ypos = m_pos.y() + pos.y() + (ch - 1.5f) * font_size;
-                    nvgText(ctx, xpos, ypos, text[ch], nullptr);
-                    col = Color(0.3f, 0.3f, 0.3f, alpha);
-                    if (ch == 3)
-                        col[0] = col[1] = col[2] = 1.f;
-                    else
-                        col[ch] = 1.f;
-                    nvgFillColor(ctx, col);
-                    nvgFontBlur(ctx, 0);
-                    nvgText(ctx, xpos, ypos, text[ch], nullptr);
-                }
-            }
-        }
-    }
-
-    nvgRestore(ctx);
 }
 
 void ImageView::draw_contents() {
-    if (!m_image)
+    if (!m_image && !m_tile_cache)
         return;
 
+    Vector2i image_size = this->image_size();
+
     /* Ensure that 'offset' is a multiple of the pixel ratio */
     float pixel_ratio = screen()->pixel_ratio();
     m_offset = (Vector2f(Vector2i(m_offset / pixel_ratio)) * pixel_ratio);
 
     Vector2f bound1 = Vector2f(m_size) * pixel_ratio,
-             bound2 = -Vector2f(m_image->size()) * scale();
+             bound2 = -Vector2f(image_size) * scale();
 
     if ((m_offset.x() >= bound1.x()) != (m_offset.x() < bound2.x()))
         m_offset.x() = std::max(std::min(m_offset.x(), bound1.x()), bound2.x());
@@ -212,22 +208,201 @@ void ImageView::draw_contents() {
     float scale = std::pow(2.f, m_scale / 5.f);
 
     Matrix4f matrix_background =
-        Matrix4f::scale(Vector3f(m_image->size().x() * scale / 20.f,
-                                 m_image->size().y() * scale / 20.f, 1.f));
+        Matrix4f::scale(Vector3f(image_size.x() * scale / 20.f,
+                                 image_size.y() * scale / 20.f, 1.f));
 
     Matrix4f matrix_image =
         Matrix4f::ortho(0.f, viewport_size.x(), viewport_size.y(), 0.f, -1.f, 1.f) *
         Matrix4f::translate(Vector3f(m_offset.x(), (int) m_offset.y(), 0.f)) *
-        Matrix4f::scale(Vector3f(m_image->size().x() * scale,
-                                 m_image->size().y() * scale, 1.f));
+        Matrix4f::scale(Vector3f(image_size.x() * scale,
+                                 image_size.y() * scale, 1.f));
+
+    /* Tiles and pixel values are specified in image pixels */
+    Matrix4f to_unit = Matrix4f::scale(
+        Vector3f(1.f / image_size.x(), 1.f / image_size.y(), 1.f));
+
+    if (m_tile_cache) {
+        draw_tiles(matrix_image * to_unit, matrix_background * to_unit);
+    } else {
+        m_image_shader->set_uniform("matrix_image",      Matrix4f(matrix_image));
+        m_image_shader->set_uniform("matrix_background", Matrix4f(matrix_background));
+        m_image_shader->set_uniform("background_color",  m_image_background_color);
+
+        m_image_shader->begin();
+        m_image_shader->draw_array(Shader::PrimitiveType::Triangle, 0, 6, false);
+        m_image_shader->end();
+    }
+
+    if (scale > 100 && m_pixel_callback)
+        draw_pixel_values(matrix_image * to_unit);
+}
+
+void ImageView::invalidate_pixel_values() {
+    m_pixel_text.clear();
+    m_pixel_text_origin = m_pixel_text_size = Vector2i(0);
+}
+
+void ImageView::draw_pixel_values(const Matrix4f &matrix_pixels) {
+    Vector2i start = max(Vector2i(0), Vector2i(pos_to_pixel(Vector2f(0.f, 0.f))) - 1),
+             end   = min(Vector2i(pos_to_pixel(Vector2f(m_size))) + 1, image_size() - 1),
+             size  = end - start + 1;
+    if (size.x() <= 0 || size.y() <= 0)
+        return;
 
-    m_image_shader->set_uniform("matrix_image",      Matrix4f(matrix_image));
-    m_image_shader->set_uniform("matrix_background", Matrix4f(matrix_background));
-    m_image_shader->set_uniform("background_color",  m_image_background_color);
+    float pixel_ratio = screen()->pixel_ratio();
+
+    if (!m_pixel_font) {
+        m_pixel_font = new SDFFont(render_pass(), "sans-bold");
+        m_pixel_font->set_outline(Color(0.f, 1.f), .15f);
+    }
+
+    if (start != m_pixel_text_origin || size != m_pixel_text_size ||
+        pixel_ratio != m_pixel_text_ratio) {
+        /* Only query pixels that weren't visible in the previous frame */
+        std::vector<char> text((size_t) size.x() * (size_t) size.y() * 4 * pixel_text_size);
+        for (int y = 0; y < size.y(); ++y) {
+            for (int x = 0; x < size.x(); ++x) {
+                Vector2i p = start + Vector2i(x, y), q = p - m_pixel_text_origin;
+                char *dst = text.data() + ((size_t) y * size.x() + x) * 4 * pixel_text_size;
+
+                if (q.x() >= 0 && q.y() >= 0 && q.x() < m_pixel_text_size.x() &&
+                    q.y() < m_pixel_text_size.y()) {
+                    memcpy(dst, m_pixel_text.data() + ((size_t) q.y() * m_pixel_text_size.x() +
+                                                       q.x()) * 4 * pixel_text_size,
+                           4 * pixel_text_size);
+                } else {
+                    char *out[4] = { dst, dst + pixel_text_size, dst + 2 * pixel_text_size,
+                                     dst + 3 * pixel_text_size };
+                    m_pixel_callback(p, out, pixel_text_size);
+                    for (int ch = 0; ch < 4; ++ch)
+                        out[ch][pixel_text_size - 1] = '\0';
+                    m_pixel_callback_count++;
+                }
+            }
+        }
+
+        m_pixel_text.swap(text);
+        m_pixel_text_origin = start;
+        m_pixel_text_size = size;
+        m_pixel_text_ratio = pixel_ratio;
+
+        /* Lay out the text once, panning and zooming only change the transformation */
+        float font_size = pixel_ratio / 10.f;
+        m_pixel_font->clear_batch();
+        for (int y = 0; y < size.y(); ++y) {
+            for (int x = 0; x < size.x(); ++x) {
+                const char *src = m_pixel_text.data() +
+                                  ((size_t) y * size.x() + x) * 4 * pixel_text_size;
+                for (int ch = 0; ch < 4; ++ch) {
+                    Color col(.3f, .3f, .3f, 1.f);
+                    if (ch == 3)
+                        col[0] = col[1] = col[2] = 1.f;
+                    else
+                        col[ch] = 1.f;
+                    Vector2f pos(start.x() + x + .5f,
+                                 start.y() + y + .5f + (ch - 1.5f) * font_size);
+                    m_pixel_font->add_text(pos, font_size, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE,
+                                           col, src + ch * pixel_text_size);
+                }
+            }
+        }
+    }
+
+    m_pixel_font->set_pixel_ratio(scale());
+    m_pixel_font->draw_batch(matrix_pixels, std::min(1.f, (scale() - 100) / 100.f));
+}
+
+void ImageView::draw_tiles(const Matrix4f &matrix_image,
+                           const Matrix4f &matrix_background) {
+    /* Upload tiles that finished loading, keep drawing while others are pending */
+    if (m_tile_cache->begin_frame())
+        screen()->redraw();
+
+    TileSource *source = m_tile_cache->source();
+    int levels = source->level_count(),
+        tile_size = source->tile_size();
+
+    /* Pick the finest level that isn't magnified less than 1:1 */
+    int level = (int) std::floor(std::log2(1.f / scale()));
+    level = std::max(0, std::min(level, levels - 1));
+
+    Vector2f image_size(source->size()),
+             p0 = max(pos_to_pixel(Vector2f(0.f)), Vector2f(0.f)),
+             p1 = min(pos_to_pixel(Vector2f(m_size)), image_size);
+    if (p0.x() >= p1.x() || p0.y() >= p1.y())
+        return;
+
+    float extent = (float) tile_size * (float) (1 << level);
+    Vector2i count = source->tile_count(level),
+             first = min(Vector2i(p0 / extent), count - 1),
+             last  = min(Vector2i((int) std::ceil(p1.x() / extent),
+                                  (int) std::ceil(p1.y() / extent)) - 1, count - 1);
+
+    Vector2f half_texel = .5f / Vector2f(m_tile_cache->texture()->size());
+    std::vector<float> positions, uvs;
+
+    for (int y = first.y(); y <= last.y(); ++y) {
+        for (int x = first.x(); x <= last.x(); ++x) {
+            Vector2f rect_min = Vector2f((float) x, (float) y) * extent,
+                     rect_max = min(rect_min + extent, image_size),
+                     uv_min, uv_max;
+
+            int l = level;
+            Vector2i tile(x, y);
+            bool found = m_tile_cache->lookup(l, tile, true, uv_min, uv_max);
+
+            /* Show a coarser tile that is already resident while loading */
+            while (!found && l + 1 < levels) {
+                l++;
+                tile = tile / 2;
+                found = m_tile_cache->lookup(l, tile, false, uv_min, uv_max);
+            }
+
+            if (!found) {
+                /* Nothing to show yet, also fetch the coarsest level */
+                m_tile_cache->lookup(l, tile, true, uv_min, uv_max);
+                continue;
+            }
+
+            /* Map the part of the tile that is covered by the quad */
+            float tile_extent = (float) tile_size * (float) (1 << l);
+            Vector2f origin = Vector2f(tile) * tile_extent,
+                     uv_scale = (uv_max - uv_min) / tile_extent,
+                     q_min = max(uv_min + (rect_min - origin) * uv_scale, uv_min + half_texel),
+                     q_max = min(uv_min + (rect_max - origin) * uv_scale, uv_max - half_texel);
+
+            const float quad_positions[] = {
+                rect_min.x(), rect_min.y(), rect_max.x(), rect_min.y(),
+                rect_min.x(), rect_max.y(), rect_max.x(), rect_min.y(),
+                rect_max.x(), rect_max.y(), rect_min.x(), rect_max.y()
+            };
+
+            const float quad_uvs[] = {
+                q_min.x(), q_min.y(), q_max.x(), q_min.y(),
+                q_min.x(), q_max.y(), q_max.x(), q_min.y(),
+                q_max.x(), q_max.y(), q_min.x(), q_max.y()
+            };
+
+            positions.insert(positions.end(), quad_positions, quad_positions + 12);
+            uvs.insert(uvs.end(), quad_uvs, quad_uvs + 12);
+        }
+    }
+
+    if (positions.empty())
+        return;
 
-    m_image_shader->begin();
-    m_image_shader->draw_array(Shader::PrimitiveType::Triangle, 0, 6, false);
-    m_image_shader->end();
+    size_t vertex_count = positions.size() / 2;
+    m_tile_shader->set_buffer("position", VariableType::Float32,
+                              { vertex_count, 2 }, positions.data());
+    m_tile_shader->set_buffer("uv", VariableType::Float32,
+                              { vertex_count, 2 }, uvs.data());
+    m_tile_shader->set_uniform("matrix_image",      Matrix4f(matrix_image));
+    m_tile_shader->set_uniform("matrix_background", Matrix4f(matrix_background));
+    m_tile_shader->set_uniform("background_color",  m_image_background_color);
+
+    m_tile_shader->begin();
+    m_tile_shader->draw_array(Shader::PrimitiveType::Triangle, 0, vertex_count, false);
+    m_tile_shader->end();
 }
 
 NAMESPACE_END(nanogui)
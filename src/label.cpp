@@ -35,19 +35,18 @@ void Label::set_theme(Theme *theme) {
 Vector2i Label::preferred_size(NVGcontext *ctx) const {
     if (m_caption == "")
         return Vector2i(0);
-    nvgFontFace(ctx, m_font.c_str());
-    nvgFontSize(ctx, font_size());
     if (m_fixed_size.x() > 0) {
         float bounds[4];
+        nvgFontFace(ctx, m_font.c_str());
+        nvgFontSize(ctx, font_size());
         nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
         nvgTextBoxBounds(ctx, m_pos.x(), m_pos.y(), m_fixed_size.x(), m_caption.c_str(), nullptr, bounds);
         return Vector2i(m_fixed_size.x(), bounds[3] - bounds[1]);
     } else {
-        nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
-        return Vector2i(
-            nvgTextBounds(ctx, 0, 0, m_caption.c_str(), nullptr, nullptr) + 2,
-            font_size()
-        );
+        TextMetrics metrics = measure_text(ctx, m_font, font_size(),
+                                           NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE,
+                                           m_caption);
+        return Vector2i(metrics.advance + 2, font_size());
     }
 }
 
@@ -16,10 +16,169 @@
 #include <nanogui/window.h>
 #include <nanogui/theme.h>
 #include <nanogui/label.h>
+#include <nanogui/textbox.h>
 #include <numeric>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 NAMESPACE_BEGIN(nanogui)
 
+/// Set while a thread executes work on behalf of \ref parallel_for()
+static thread_local bool parallel_for_active = false;
+
+/// Smallest number of items for which \ref parallel_for() uses worker threads
+static constexpr size_t parallel_for_threshold = 32;
+
+/**
+ * Persistent pool of worker threads used by \ref parallel_for(). It is
+ * created on first use and intentionally never destroyed, so that no threads
+ * need to be joined during static destruction.
+ */
+class LayoutWorkerPool {
+public:
+    static LayoutWorkerPool &get() {
+        static LayoutWorkerPool *pool = new LayoutWorkerPool();
+        return *pool;
+    }
+
+    /// Number of worker threads (not counting the calling thread)
+    size_t size() const { return m_size; }
+
+    /// Run \c task on \c count workers and on the calling thread, then wait for completion
+    void run(size_t count, const std::function<void()> &task) {
+        std::lock_guard<std::mutex> run_guard(m_run_mutex);
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_task = &task;
+            m_unclaimed = m_active = count;
+        }
+        m_cv.notify_all();
+
+        task();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_cv.wait(lock, [this]() { return m_active == 0; });
+        m_task = nullptr;
+    }
+
+private:
+    LayoutWorkerPool() {
+        size_t count = std::thread::hardware_concurrency();
+        m_size = count > 1 ? count - 1 : 0;
+        for (size_t i = 0; i < m_size; ++i)
+            std::thread([this]() { worker(); }).detach();
+    }
+
+    void worker() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_cv.wait(lock, [this]() { return m_unclaimed > 0; });
+            m_unclaimed--;
+            const std::function<void()> *task = m_task;
+            lock.unlock();
+            (*task)();
+            lock.lock();
+            if (--m_active == 0)
+                m_done_cv.notify_one();
+        }
+    }
+
+private:
+    size_t m_size = 0;
+    /// Serializes concurrent callers of \ref run()
+    std::mutex m_run_mutex;
+    std::mutex m_mutex;
+    std::condition_variable m_cv, m_done_cv;
+    const std::function<void()> *m_task = nullptr;
+    size_t m_unclaimed = 0, m_active = 0;
+};
+
+/**
+ * Invoke \c func(i) for each \c i in <tt>[0, size)</tt>. When \c parallel is
+ * set and there are at least \ref parallel_for_threshold items, the work is
+ * distributed over a persistent pool of worker threads, with the calling
+ * thread participating. Nested invocations run serially to avoid
+ * oversubscription. The first exception raised by \c func is rethrown.
+ */
+template <typename Func>
+static void parallel_for(bool parallel, size_t size, const Func &func) {
+    if (!parallel || parallel_for_active || size < parallel_for_threshold ||
+        LayoutWorkerPool::get().size() == 0) {
+        for (size_t i = 0; i < size; ++i)
+            func(i);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    std::function<void()> worker = [&]() {
+        parallel_for_active = true;
+        while (true) {
+            size_t i = next++;
+            if (i >= size)
+                break;
+            try {
+                func(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+                next = size;
+            }
+        }
+        parallel_for_active = false;
+    };
+
+    LayoutWorkerPool &pool = LayoutWorkerPool::get();
+    pool.run(std::min(pool.size(), size - 1), worker);
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+/**
+ * Check whether the preferred size and layout of the subtree rooted at \c
+ * widget can be computed off the main thread. Fixed-width labels wrap their
+ * caption using the font state of the NanoVG context, and text boxes query
+ * the size of NanoVG images used as units, neither of which is thread-safe.
+ */
+static bool thread_safe_layout(const Widget *widget) {
+    if (auto label = dynamic_cast<const Label *>(widget)) {
+        if (label->fixed_width() > 0)
+            return false;
+    } else if (auto text_box = dynamic_cast<const TextBox *>(widget)) {
+        if (text_box->units_image() > 0)
+            return false;
+    }
+    for (const Widget *child : widget->children()) {
+        if (!thread_safe_layout(child))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Decide whether a layout should hand \c widgets to \ref parallel_for().
+ * Subtrees are only processed concurrently when none of them contains
+ * widgets that touch the NanoVG context during layout (see \ref
+ * thread_safe_layout()).
+ */
+template <typename Container>
+static bool parallel_layout(bool parallel, const Container &widgets) {
+    if (!parallel || parallel_for_active || widgets.size() < parallel_for_threshold)
+        return false;
+    for (const Widget *w : widgets) {
+        if (!thread_safe_layout(w))
+            return false;
+    }
+    return true;
+}
+
 BoxLayout::BoxLayout(Orientation orientation, Alignment alignment,
           int margin, int spacing)
     : m_orientation(orientation), m_alignment(alignment), m_margin(margin),
@@ -198,7 +357,8 @@ Vector2i GridLayout::preferred_size(NVGcontext *ctx,
                                    const Widget *widget) const {
     /* Compute minimum row / column sizes */
     std::vector<int> grid[2];
-    compute_layout(ctx, widget, grid);
+    std::vector<Vector2i> target_sizes;
+    compute_layout(ctx, widget, grid, target_sizes);
 
     Vector2i size(
         2*m_margin + std::accumulate(grid[0].begin(), grid[0].end(), 0)
@@ -214,11 +374,27 @@ Vector2i GridLayout::preferred_size(NVGcontext *ctx,
     return size;
 }
 
-void GridLayout::compute_layout(NVGcontext *ctx, const Widget *widget, std::vector<int> *grid) const {
+void GridLayout::compute_layout(NVGcontext *ctx, const Widget *widget,
+                                std::vector<int> *grid,
+                                std::vector<Vector2i> &target_sizes) const {
     int axis1 = (int) m_orientation, axis2 = (axis1 + 1) % 2;
-    size_t num_children = widget->children().size(), visible_children = 0;
-    for (auto w : widget->children())
-        visible_children += w->visible() ? 1 : 0;
+    std::vector<const Widget *> visible;
+    for (auto w : widget->children()) {
+        if (w->visible())
+            visible.push_back(w);
+    }
+    size_t visible_children = visible.size();
+
+    /* The children are independent of each other, query them concurrently */
+    target_sizes.resize(visible_children);
+    parallel_for(parallel_layout(m_parallel, visible), visible_children, [&](size_t i) {
+        Vector2i ps = visible[i]->preferred_size(ctx);
+        Vector2i fs = visible[i]->fixed_size();
+        target_sizes[i] = Vector2i(
+            fs[0] ? fs[0] : ps[0],
+            fs[1] ? fs[1] : ps[1]
+        );
+    });
 
     Vector2i dim;
     dim[axis1] = m_resolution;
@@ -230,19 +406,9 @@ void GridLayout::compute_layout(NVGcontext *ctx, const Widget *widget, std::vect
     size_t child = 0;
     for (int i2 = 0; i2 < dim[axis2]; i2++) {
         for (int i1 = 0; i1 < dim[axis1]; i1++) {
-            Widget *w = nullptr;
-            do {
-                if (child >= num_children)
-                    return;
-                w = widget->children()[child++];
-            } while (!w->visible());
-
-            Vector2i ps = w->preferred_size(ctx);
-            Vector2i fs = w->fixed_size();
-            Vector2i target_size(
-                fs[0] ? fs[0] : ps[0],
-                fs[1] ? fs[1] : ps[1]
-            );
+            if (child >= visible_children)
+                return;
+            const Vector2i &target_size = target_sizes[child++];
 
             grid[axis1][i1] = std::max(grid[axis1][i1], target_size[axis1]);
             grid[axis2][i2] = std::max(grid[axis2][i2], target_size[axis2]);
@@ -259,7 +425,8 @@ void GridLayout::perform_layout(NVGcontext *ctx, Widget *widget) const {
 
     /* Compute minimum row / column sizes */
     std::vector<int> grid[2];
-    compute_layout(ctx, widget, grid);
+    std::vector<Vector2i> target_sizes;
+    compute_layout(ctx, widget, grid, target_sizes);
     int dim[2] = { (int) grid[0].size(), (int) grid[1].size() };
 
     Vector2i extra(0);
@@ -291,26 +458,20 @@ void GridLayout::perform_layout(NVGcontext *ctx, Widget *widget) const {
     int axis1 = (int) m_orientation, axis2 = (axis1 + 1) % 2;
     Vector2i start = m_margin + extra;
 
-    size_t num_children = widget->children().size();
+    std::vector<Widget *> visible;
+    for (Widget *w : widget->children()) {
+        if (w->visible())
+            visible.push_back(w);
+    }
     size_t child = 0;
 
     Vector2i pos = start;
-    for (int i2 = 0; i2 < dim[axis2]; i2++) {
+    for (int i2 = 0; i2 < dim[axis2] && child < visible.size(); i2++) {
         pos[axis1] = start[axis1];
-        for (int i1 = 0; i1 < dim[axis1]; i1++) {
-            Widget *w = nullptr;
-            do {
-                if (child >= num_children)
-                    return;
-                w = widget->children()[child++];
-            } while (!w->visible());
-
-            Vector2i ps = w->preferred_size(ctx);
+        for (int i1 = 0; i1 < dim[axis1] && child < visible.size(); i1++) {
+            Widget *w = visible[child];
             Vector2i fs = w->fixed_size();
-            Vector2i target_size(
-                fs[0] ? fs[0] : ps[0],
-                fs[1] ? fs[1] : ps[1]
-            );
+            Vector2i target_size = target_sizes[child++];
 
             Vector2i item_pos(pos);
             for (int j = 0; j < 2; j++) {
@@ -334,11 +495,14 @@ void GridLayout::perform_layout(NVGcontext *ctx, Widget *widget) const {
             }
             w->set_position(item_pos);
             w->set_size(target_size);
-            w->perform_layout(ctx);
             pos[axis1] += grid[axis1][i1] + m_spacing[axis1];
         }
         pos[axis2] += grid[axis2][i2] + m_spacing[axis2];
     }
+
+    /* The children were placed, now lay out their subtrees concurrently */
+    parallel_for(parallel_layout(m_parallel, visible), child,
+                 [&](size_t i) { visible[i]->perform_layout(ctx); });
 }
 
 AdvancedGridLayout::AdvancedGridLayout(const std::vector<int> &cols, const std::vector<int> &rows, int margin)
@@ -349,8 +513,10 @@ AdvancedGridLayout::AdvancedGridLayout(const std::vector<int> &cols, const std::
 
 Vector2i AdvancedGridLayout::preferred_size(NVGcontext *ctx, const Widget *widget) const {
     /* Compute minimum row / column sizes */
+    std::unordered_map<const Widget *, Vector2i> preferred_sizes;
+    compute_preferred_sizes(ctx, preferred_sizes);
     std::vector<int> grid[2];
-    compute_layout(ctx, widget, grid);
+    compute_layout(widget, grid, preferred_sizes);
 
     Vector2i size(
         std::accumulate(grid[0].begin(), grid[0].end(), 0),
@@ -365,8 +531,10 @@ Vector2i AdvancedGridLayout::preferred_size(NVGcontext *ctx, const Widget *widge
 }
 
 void AdvancedGridLayout::perform_layout(NVGcontext *ctx, Widget *widget) const {
+    std::unordered_map<const Widget *, Vector2i> preferred_sizes;
+    compute_preferred_sizes(ctx, preferred_sizes);
     std::vector<int> grid[2];
-    compute_layout(ctx, widget, grid);
+    compute_layout(widget, grid, preferred_sizes);
 
     grid[0].insert(grid[0].begin(), m_margin);
     const Window *window = dynamic_cast<const Window *>(widget);
@@ -375,18 +543,23 @@ void AdvancedGridLayout::perform_layout(NVGcontext *ctx, Widget *widget) const {
     else
         grid[1].insert(grid[1].begin(), m_margin);
 
+    std::vector<Widget *> placed;
+    for (Widget *w : widget->children()) {
+        if (!w->visible() || dynamic_cast<const Window *>(w) != nullptr)
+            continue;
+        placed.push_back(w);
+    }
+
     for (int axis=0; axis<2; ++axis) {
         for (size_t i=1; i<grid[axis].size(); ++i)
             grid[axis][i] += grid[axis][i-1];
 
-        for (Widget *w : widget->children()) {
-            if (!w->visible() || dynamic_cast<const Window *>(w) != nullptr)
-                continue;
+        for (Widget *w : placed) {
             Anchor anchor = this->anchor(w);
 
             int item_pos = grid[axis][anchor.pos[axis]];
             int cell_size  = grid[axis][anchor.pos[axis] + anchor.size[axis]] - item_pos;
-            int ps = w->preferred_size(ctx)[axis], fs = w->fixed_size()[axis];
+            int ps = preferred_sizes.at(w)[axis], fs = w->fixed_size()[axis];
             int target_size = fs ? fs : ps;
 
             switch (anchor.align[axis]) {
@@ -408,13 +581,36 @@ void AdvancedGridLayout::perform_layout(NVGcontext *ctx, Widget *widget) const {
             size[axis] = target_size;
             w->set_position(pos);
             w->set_size(size);
-            w->perform_layout(ctx);
         }
     }
+
+    /* The children were placed, now lay out their subtrees concurrently */
+    parallel_for(parallel_layout(m_parallel, placed), placed.size(),
+                 [&](size_t i) { placed[i]->perform_layout(ctx); });
+}
+
+void AdvancedGridLayout::compute_preferred_sizes(
+    NVGcontext *ctx,
+    std::unordered_map<const Widget *, Vector2i> &preferred_sizes) const {
+    std::vector<const Widget *> widgets;
+    for (auto pair : m_anchor) {
+        const Widget *w = pair.first;
+        if (!w->visible() || dynamic_cast<const Window *>(w) != nullptr)
+            continue;
+        widgets.push_back(w);
+    }
+
+    std::vector<Vector2i> sizes(widgets.size());
+    parallel_for(parallel_layout(m_parallel, widgets), widgets.size(),
+                 [&](size_t i) { sizes[i] = widgets[i]->preferred_size(ctx); });
+
+    for (size_t i = 0; i < widgets.size(); ++i)
+        preferred_sizes[widgets[i]] = sizes[i];
 }
 
-void AdvancedGridLayout::compute_layout(NVGcontext *ctx, const Widget *widget,
-                                       std::vector<int> *_grid) const {
+void AdvancedGridLayout::compute_layout(
+    const Widget *widget, std::vector<int> *_grid,
+    const std::unordered_map<const Widget *, Vector2i> &preferred_sizes) const {
     Vector2i fs_w = widget->fixed_size();
     Vector2i container_size(
         fs_w[0] ? fs_w[0] : widget->width(),
@@ -442,7 +638,7 @@ void AdvancedGridLayout::compute_layout(NVGcontext *ctx, const Widget *widget,
                 const Anchor &anchor = pair.second;
                 if ((anchor.size[axis] == 1) != (phase == 0))
                     continue;
-                int ps = w->preferred_size(ctx)[axis], fs = w->fixed_size()[axis];
+                int ps = preferred_sizes.at(w)[axis], fs = w->fixed_size()[axis];
                 int target_size = fs ? fs : ps;
 
                 if (anchor.pos[axis] + anchor.size[axis] > (int) grid.size())
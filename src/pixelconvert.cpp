@@ -0,0 +1,616 @@
+/*
+    src/pixelconvert.cpp -- Vectorized conversions between the pixel
+    formats supported by the Texture class
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/pixelconvert.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define NANOGUI_CONVERT_SSE2
+#  if defined(__SSSE3__)
+#    include <tmmintrin.h>
+#    define NANOGUI_CONVERT_SSSE3
+#  endif
+#  if defined(__F16C__)
+#    include <immintrin.h>
+#    define NANOGUI_CONVERT_F16C
+#  endif
+#elif defined(__ARM_NEON)
+#  include <arm_neon.h>
+#  define NANOGUI_CONVERT_NEON
+#endif
+
+NAMESPACE_BEGIN(nanogui)
+
+using PixelFormat = Texture::PixelFormat;
+using ComponentFormat = Texture::ComponentFormat;
+
+uint16_t float_to_half(float value) {
+    uint32_t x;
+    memcpy(&x, &value, sizeof(uint32_t));
+
+    uint32_t sign = (x >> 16) & 0x8000, mant = x & 0x7fffff;
+    int exp = (int) ((x >> 23) & 0xff) - 127 + 15;
+
+    if (((x >> 23) & 0xff) == 0xff) /* Infinity and NaN */
+        return (uint16_t) (sign | 0x7c00 | (mant ? 0x200 : 0));
+    else if (exp >= 31) /* Overflow */
+        return (uint16_t) (sign | 0x7c00);
+
+    uint32_t half, rem, halfway;
+    if (exp <= 0) {
+        /* Denormalized result (or zero) */
+        if (exp < -10)
+            return (uint16_t) sign;
+        mant |= 0x800000;
+        uint32_t shift = (uint32_t) (14 - exp);
+        half = mant >> shift;
+        rem = mant & ((1u << shift) - 1);
+        halfway = 1u << (shift - 1);
+    } else {
+        half = ((uint32_t) exp << 10) | (mant >> 13);
+        rem = mant & 0x1fff;
+        halfway = 0x1000;
+    }
+
+    /* A carry into the exponent correctly rounds up to the next binade */
+    if (rem > halfway || (rem == halfway && (half & 1)))
+        half++;
+
+    return (uint16_t) (sign | half);
+}
+
+float half_to_float(uint16_t value) {
+    uint32_t sign = (uint32_t) (value & 0x8000) << 16,
+             exp  = (value >> 10) & 0x1f,
+             mant = value & 0x3ff, x;
+
+    if (exp == 0x1f) {
+        /* Infinity and NaN */
+        x = sign | 0x7f800000 | (mant << 13);
+    } else if (exp != 0) {
+        x = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+    } else if (mant != 0) {
+        /* Denormalized value: renormalize */
+        exp = 127 - 15 + 1;
+        while (!(mant & 0x400)) {
+            mant <<= 1;
+            exp--;
+        }
+        x = sign | (exp << 23) | ((mant & 0x3ff) << 13);
+    } else {
+        x = sign;
+    }
+
+    float result;
+    memcpy(&result, &x, sizeof(float));
+    return result;
+}
+
+/* ---------------------------------------------------------------------- */
+/*                            Scalar building blocks                      */
+/* ---------------------------------------------------------------------- */
+
+/// Entries of the lookup table used for sRGB-encoded 8-bit conversions
+static const int srgb_lut_size = 1 << 14;
+
+/// Channel positions within a pixel (red, green, blue, alpha; -1 if missing)
+struct Layout {
+    int channels;
+    int index[4];
+};
+
+static bool pixel_layout(PixelFormat format, Layout &layout) {
+    switch (format) {
+        case PixelFormat::R:    layout = Layout { 1, { 0, 0, 0, -1 } }; break;
+        case PixelFormat::RA:   layout = Layout { 2, { 0, 0, 0,  1 } }; break;
+        case PixelFormat::RGB:  layout = Layout { 3, { 0, 1, 2, -1 } }; break;
+        case PixelFormat::RGBA: layout = Layout { 4, { 0, 1, 2,  3 } }; break;
+        case PixelFormat::BGR:  layout = Layout { 3, { 2, 1, 0, -1 } }; break;
+        case PixelFormat::BGRA: layout = Layout { 4, { 2, 1, 0,  3 } }; break;
+        default: return false;
+    }
+    return true;
+}
+
+static size_t component_size(ComponentFormat format) {
+    switch (format) {
+        case ComponentFormat::UInt8:
+        case ComponentFormat::Int8:    return 1;
+        case ComponentFormat::UInt16:
+        case ComponentFormat::Int16:
+        case ComponentFormat::Float16: return 2;
+        case ComponentFormat::Float32: return 4;
+        default: return 0;
+    }
+}
+
+/// Clamp to [0, 1], mapping NaN to zero
+static inline float clamp01(float value) {
+    return value > 0.f ? (value < 1.f ? value : 1.f) : 0.f;
+}
+
+static inline float srgb_encode(float value) {
+    return value <= 0.0031308f ? value * 12.92f
+                               : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+}
+
+static const uint8_t *srgb_lut() {
+    struct Table {
+        uint8_t values[srgb_lut_size];
+        Table() {
+            for (int i = 0; i < srgb_lut_size; ++i)
+                values[i] = (uint8_t) (srgb_encode(i / (float) (srgb_lut_size - 1)) * 255.f + .5f);
+        }
+    };
+    static const Table table;
+    return table.values;
+}
+
+static inline uint8_t unorm8(float value) {
+    return (uint8_t) (clamp01(value) * 255.f + .5f);
+}
+
+static inline int srgb_lut_index(float value) {
+    return (int) (clamp01(value) * (float) (srgb_lut_size - 1) + .5f);
+}
+
+static float load_component(const uint8_t *ptr, ComponentFormat format) {
+    switch (format) {
+        case ComponentFormat::UInt8:
+            return *ptr * (1.f / 255.f);
+
+        case ComponentFormat::Int8: {
+                int8_t value;
+                memcpy(&value, ptr, sizeof(int8_t));
+                return std::max(value * (1.f / 127.f), -1.f);
+            }
+
+        case ComponentFormat::UInt16: {
+                uint16_t value;
+                memcpy(&value, ptr, sizeof(uint16_t));
+                return value * (1.f / 65535.f);
+            }
+
+        case ComponentFormat::Int16: {
+                int16_t value;
+                memcpy(&value, ptr, sizeof(int16_t));
+                return std::max(value * (1.f / 32767.f), -1.f);
+            }
+
+        case ComponentFormat::Float16: {
+                uint16_t value;
+                memcpy(&value, ptr, sizeof(uint16_t));
+                return half_to_float(value);
+            }
+
+        case ComponentFormat::Float32: {
+                float value;
+                memcpy(&value, ptr, sizeof(float));
+                return value;
+            }
+
+        default:
+            return 0.f;
+    }
+}
+
+static void store_component(uint8_t *ptr, ComponentFormat format, float value) {
+    switch (format) {
+        case ComponentFormat::UInt8:
+            *ptr = unorm8(value);
+            break;
+
+        case ComponentFormat::Int8: {
+                float v = clamp01(value * .5f + .5f) * 2.f - 1.f;
+                int8_t result = (int8_t) std::lround(v * 127.f);
+                memcpy(ptr, &result, sizeof(int8_t));
+            }
+            break;
+
+        case ComponentFormat::UInt16: {
+                uint16_t result = (uint16_t) (clamp01(value) * 65535.f + .5f);
+                memcpy(ptr, &result, sizeof(uint16_t));
+            }
+            break;
+
+        case ComponentFormat::Int16: {
+                float v = clamp01(value * .5f + .5f) * 2.f - 1.f;
+                int16_t result = (int16_t) std::lround(v * 32767.f);
+                memcpy(ptr, &result, sizeof(int16_t));
+            }
+            break;
+
+        case ComponentFormat::Float16: {
+                uint16_t result = float_to_half(value);
+                memcpy(ptr, &result, sizeof(uint16_t));
+            }
+            break;
+
+        case ComponentFormat::Float32:
+            memcpy(ptr, &value, sizeof(float));
+            break;
+
+        default:
+            break;
+    }
+}
+
+/// Convert one pixel at a time via single precision RGBA values
+static void convert_generic(const uint8_t *src, const Layout &src_layout,
+                            ComponentFormat src_format, uint8_t *dst,
+                            const Layout &dst_layout, ComponentFormat dst_format,
+                            size_t count, bool srgb) {
+    size_t src_size = component_size(src_format),
+           dst_size = component_size(dst_format),
+           src_stride = src_size * (size_t) src_layout.channels,
+           dst_stride = dst_size * (size_t) dst_layout.channels;
+    const uint8_t *lut =
+        (srgb && dst_format == ComponentFormat::UInt8) ? srgb_lut() : nullptr;
+
+    for (size_t i = 0; i < count; ++i, src += src_stride, dst += dst_stride) {
+        float value[4];
+        for (int k = 0; k < 4; ++k) {
+            int index = src_layout.index[k];
+            value[k] = index >= 0 ? load_component(src + index * src_size, src_format) : 1.f;
+        }
+
+        /* Blue first: when the target only has a red channel, red is written last */
+        for (int k : { 2, 1, 0, 3 }) {
+            int index = dst_layout.index[k];
+            if (index < 0)
+                continue;
+            uint8_t *ptr = dst + index * dst_size;
+
+            if (!srgb || k == 3)
+                store_component(ptr, dst_format, value[k]);
+            else if (lut)
+                *ptr = lut[srgb_lut_index(value[k])];
+            else
+                store_component(ptr, dst_format, srgb_encode(value[k]));
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/*                              Vectorized kernels                        */
+/* ---------------------------------------------------------------------- */
+
+#if defined(NANOGUI_CONVERT_SSE2)
+/// Convert four single precision values to half precision (stored in 32-bit lanes)
+static inline __m128i float_to_half_sse2(__m128 value) {
+    const __m128i sign_mask      = _mm_set1_epi32((int) 0x80000000u),
+                  half_max       = _mm_set1_epi32((127 + 16) << 23),
+                  nan_bit        = _mm_set1_epi32(0x200),
+                  infinity       = _mm_set1_epi32(0x7c00),
+                  min_normal     = _mm_set1_epi32((127 - 14) << 23),
+                  subnormal_bias = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23),
+                  normal_bias    = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+
+    __m128 sign = _mm_and_ps(_mm_castsi128_ps(sign_mask), value),
+           absv = _mm_xor_ps(value, sign);
+    __m128i absi = _mm_castps_si128(absv);
+
+    /* Infinity and NaN */
+    __m128i is_regular = _mm_cmpgt_epi32(half_max, absi),
+            is_nan     = _mm_castps_si128(_mm_cmpunord_ps(absv, absv)),
+            special    = _mm_or_si128(_mm_and_si128(is_nan, nan_bit), infinity);
+
+    /* Denormalized results: let the FPU round the mantissa */
+    __m128i is_subnormal = _mm_cmpgt_epi32(min_normal, absi),
+            subnormal = _mm_sub_epi32(
+                _mm_castps_si128(_mm_add_ps(absv, _mm_castsi128_ps(subnormal_bias))),
+                subnormal_bias);
+
+    /* Normalized results: round to nearest even */
+    __m128i odd    = _mm_srai_epi32(_mm_slli_epi32(absi, 31 - 13), 31),
+            normal = _mm_srli_epi32(
+                _mm_sub_epi32(_mm_add_epi32(absi, normal_bias), odd), 13);
+
+    __m128i result = _mm_or_si128(_mm_and_si128(is_subnormal, subnormal),
+                                  _mm_andnot_si128(is_subnormal, normal));
+    result = _mm_or_si128(_mm_and_si128(is_regular, result),
+                          _mm_andnot_si128(is_regular, special));
+
+    /* The sign is shifted arithmetically, so that _mm_packs_epi32 preserves it */
+    return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+#endif
+
+static void swap_red_blue_4x8(const uint8_t *src, uint8_t *dst, size_t count) {
+    size_t i = 0;
+#if defined(NANOGUI_CONVERT_SSE2)
+    const __m128i mask = _mm_set1_epi32((int) 0xff00ff00u);
+    for (; i + 4 <= count; i += 4) {
+        __m128i value = _mm_loadu_si128((const __m128i *) (src + 4 * i)),
+                rb    = _mm_andnot_si128(mask, value);
+        rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+        _mm_storeu_si128((__m128i *) (dst + 4 * i),
+                         _mm_or_si128(_mm_and_si128(value, mask), rb));
+    }
+#elif defined(NANOGUI_CONVERT_NEON)
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x4_t value = vld4q_u8(src + 4 * i);
+        uint8x16_t red = value.val[0];
+        value.val[0] = value.val[2];
+        value.val[2] = red;
+        vst4q_u8(dst + 4 * i, value);
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint8_t *s = src + 4 * i;
+        uint8_t *d = dst + 4 * i, red = s[0];
+        d[0] = s[2]; d[1] = s[1]; d[2] = red; d[3] = s[3];
+    }
+}
+
+static void swap_red_blue_3x8(const uint8_t *src, uint8_t *dst, size_t count) {
+    size_t i = 0;
+#if defined(NANOGUI_CONVERT_SSSE3)
+    /* 5 pixels per iteration, the 16th byte is rewritten by the next one */
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9,
+                                          14, 13, 12, 15);
+    for (; i + 6 <= count; i += 5)
+        _mm_storeu_si128((__m128i *) (dst + 3 * i),
+                         _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (src + 3 * i)),
+                                          shuffle));
+#elif defined(NANOGUI_CONVERT_NEON)
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x3_t value = vld3q_u8(src + 3 * i);
+        uint8x16_t red = value.val[0];
+        value.val[0] = value.val[2];
+        value.val[2] = red;
+        vst3q_u8(dst + 3 * i, value);
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint8_t *s = src + 3 * i;
+        uint8_t *d = dst + 3 * i, red = s[0];
+        d[0] = s[2]; d[1] = s[1]; d[2] = red;
+    }
+}
+
+/// Pad 8-bit RGB data with an opaque alpha channel (optionally swapping red and blue)
+static void pad_alpha_3x8(const uint8_t *src, uint8_t *dst, size_t count, bool swap) {
+    size_t i = 0;
+#if defined(NANOGUI_CONVERT_SSSE3)
+    const __m128i shuffle = swap
+        ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1)
+        : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32((int) 0xff000000u);
+    /* 4 pixels per iteration, reading 16 of the source bytes */
+    for (; i + 6 <= count; i += 4) {
+        __m128i value = _mm_loadu_si128((const __m128i *) (src + 3 * i));
+        _mm_storeu_si128((__m128i *) (dst + 4 * i),
+                         _mm_or_si128(_mm_shuffle_epi8(value, shuffle), alpha));
+    }
+#elif defined(NANOGUI_CONVERT_NEON)
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x3_t value = vld3q_u8(src + 3 * i);
+        uint8x16x4_t result;
+        result.val[0] = value.val[swap ? 2 : 0];
+        result.val[1] = value.val[1];
+        result.val[2] = value.val[swap ? 0 : 2];
+        result.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst + 4 * i, result);
+    }
+#endif
+    int r = swap ? 2 : 0, b = swap ? 0 : 2;
+    for (; i < count; ++i) {
+        const uint8_t *s = src + 3 * i;
+        uint8_t *d = dst + 4 * i;
+        d[0] = s[r]; d[1] = s[1]; d[2] = s[b]; d[3] = 255;
+    }
+}
+
+static void float_to_half_n(const float *src, uint16_t *dst, size_t count) {
+    size_t i = 0;
+#if defined(NANOGUI_CONVERT_F16C)
+    for (; i + 4 <= count; i += 4)
+        _mm_storel_epi64((__m128i *) (dst + i),
+                         _mm_cvtps_ph(_mm_loadu_ps(src + i), 0));
+#elif defined(NANOGUI_CONVERT_SSE2)
+    for (; i + 8 <= count; i += 8) {
+        __m128i lo = float_to_half_sse2(_mm_loadu_ps(src + i)),
+                hi = float_to_half_sse2(_mm_loadu_ps(src + i + 4));
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_packs_epi32(lo, hi));
+    }
+#elif defined(NANOGUI_CONVERT_NEON) && defined(__aarch64__)
+    for (; i + 4 <= count; i += 4)
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+#endif
+    for (; i < count; ++i)
+        dst[i] = float_to_half(src[i]);
+}
+
+static void unorm16_to_float_n(const uint16_t *src, float *dst, size_t count) {
+    const float scale = 1.f / 65535.f;
+    size_t i = 0;
+#if defined(NANOGUI_CONVERT_SSE2)
+    const __m128 scale_v = _mm_set1_ps(scale);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= count; i += 8) {
+        __m128i value = _mm_loadu_si128((const __m128i *) (src + i));
+        _mm_storeu_ps(dst + i, _mm_mul_ps(
+            _mm_cvtepi32_ps(_mm_unpacklo_epi16(value, zero)), scale_v));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(
+            _mm_cvtepi32_ps(_mm_unpackhi_epi16(value, zero)), scale_v));
+    }
+#elif defined(NANOGUI_CONVERT_NEON)
+    for (; i + 8 <= count; i += 8) {
+        uint16x8_t value = vld1q_u16(src + i);
+        vst1q_f32(dst + i, vmulq_n_f32(
+            vcvtq_f32_u32(vmovl_u16(vget_low_u16(value))), scale));
+        vst1q_f32(dst + i + 4, vmulq_n_f32(
+            vcvtq_f32_u32(vmovl_u16(vget_high_u16(value))), scale));
+    }
+#endif
+    for (; i < count; ++i)
+        dst[i] = src[i] * scale;
+}
+
+static void unorm16_to_half_n(const uint16_t *src, uint16_t *dst, size_t count) {
+    float buf[256];
+    for (size_t i = 0; i < count; i += 256) {
+        size_t n = std::min(count - i, (size_t) 256);
+        unorm16_to_float_n(src + i, buf, n);
+        float_to_half_n(buf, dst + i, n);
+    }
+}
+
+/**
+ * Convert single precision values to 8-bit normalized values. With \c srgb,
+ * every element except for the alpha channel (of interleaved data with the
+ * given number of channels) is encoded.
+ */
+static void float_to_unorm8_n(const float *src, uint8_t *dst, size_t count,
+                              int channels, bool srgb) {
+    size_t i = 0;
+
+    if (!srgb) {
+#if defined(NANOGUI_CONVERT_SSE2)
+        const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f),
+                     scale = _mm_set1_ps(255.f), half = _mm_set1_ps(.5f);
+        __m128i v[4];
+        for (; i + 16 <= count; i += 16) {
+            for (int k = 0; k < 4; ++k) {
+                __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4 * k), zero), one);
+                v[k] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale), half));
+            }
+            _mm_storeu_si128((__m128i *) (dst + i),
+                             _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]),
+                                              _mm_packs_epi32(v[2], v[3])));
+        }
+#elif defined(NANOGUI_CONVERT_NEON)
+        const float32x4_t zero = vdupq_n_f32(0.f), one = vdupq_n_f32(1.f),
+                          half = vdupq_n_f32(.5f);
+        for (; i + 8 <= count; i += 8) {
+            float32x4_t lo = vminq_f32(vmaxq_f32(vld1q_f32(src + i), zero), one),
+                        hi = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 4), zero), one);
+            uint32x4_t lo_i = vcvtq_u32_f32(vmlaq_n_f32(half, lo, 255.f)),
+                       hi_i = vcvtq_u32_f32(vmlaq_n_f32(half, hi, 255.f));
+            vst1_u8(dst + i, vmovn_u16(vcombine_u16(vmovn_u32(lo_i), vmovn_u32(hi_i))));
+        }
+#endif
+        for (; i < count; ++i)
+            dst[i] = unorm8(src[i]);
+        return;
+    }
+
+    const uint8_t *lut = srgb_lut();
+    auto is_alpha = [channels](size_t index) {
+        return (channels == 2 && (index & 1) == 1) ||
+               (channels == 4 && (index & 3) == 3);
+    };
+
+#if defined(NANOGUI_CONVERT_SSE2) || defined(NANOGUI_CONVERT_NEON)
+    /* Compute table indices and linear values four at a time. The alpha
+       channel occupies the same lanes in every iteration. */
+    alignas(16) int32_t index[4], linear[4];
+    bool alpha[4] = { is_alpha(0), is_alpha(1), is_alpha(2), is_alpha(3) };
+#  if defined(NANOGUI_CONVERT_SSE2)
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f), half = _mm_set1_ps(.5f),
+                 lut_scale = _mm_set1_ps((float) (srgb_lut_size - 1)),
+                 scale = _mm_set1_ps(255.f);
+#  else
+    const float32x4_t zero = vdupq_n_f32(0.f), one = vdupq_n_f32(1.f),
+                      half = vdupq_n_f32(.5f);
+#  endif
+    for (; i + 4 <= count; i += 4) {
+#  if defined(NANOGUI_CONVERT_SSE2)
+        __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), zero), one);
+        _mm_store_si128((__m128i *) index,
+                        _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, lut_scale), half)));
+        _mm_store_si128((__m128i *) linear,
+                        _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale), half)));
+#  else
+        float32x4_t value = vminq_f32(vmaxq_f32(vld1q_f32(src + i), zero), one);
+        vst1q_s32(index, vreinterpretq_s32_u32(vcvtq_u32_f32(
+            vmlaq_n_f32(half, value, (float) (srgb_lut_size - 1)))));
+        vst1q_s32(linear, vreinterpretq_s32_u32(vcvtq_u32_f32(
+            vmlaq_n_f32(half, value, 255.f))));
+#  endif
+        for (int k = 0; k < 4; ++k)
+            dst[i + k] = alpha[k] ? (uint8_t) linear[k] : lut[index[k]];
+    }
+#endif
+
+    for (; i < count; ++i)
+        dst[i] = is_alpha(i) ? unorm8(src[i]) : lut[srgb_lut_index(src[i])];
+}
+
+/* ---------------------------------------------------------------------- */
+
+void convert_pixels(const void *src_, PixelFormat src_pixel_format,
+                    ComponentFormat src_component_format, void *dst_,
+                    PixelFormat dst_pixel_format,
+                    ComponentFormat dst_component_format, size_t count,
+                    bool srgb) {
+    Layout src_layout, dst_layout;
+    if (!pixel_layout(src_pixel_format, src_layout) ||
+        !pixel_layout(dst_pixel_format, dst_layout) ||
+        component_size(src_component_format) == 0 ||
+        component_size(dst_component_format) == 0)
+        throw std::runtime_error("convert_pixels(): unsupported pixel or component format!");
+
+    const uint8_t *src = (const uint8_t *) src_;
+    uint8_t *dst = (uint8_t *) dst_;
+    bool same_layout = src_pixel_format == dst_pixel_format;
+    size_t elements = count * (size_t) src_layout.channels;
+
+    if (src_component_format == dst_component_format && !srgb) {
+        if (same_layout) {
+            memcpy(dst, src, elements * component_size(src_component_format));
+            return;
+        }
+
+        if (src_component_format == ComponentFormat::UInt8) {
+            bool swap = src_layout.index[0] != dst_layout.index[0];
+            if (src_layout.channels == 4 && dst_layout.channels == 4) {
+                swap_red_blue_4x8(src, dst, count);
+                return;
+            } else if (src_layout.channels == 3 && dst_layout.channels == 3) {
+                swap_red_blue_3x8(src, dst, count);
+                return;
+            } else if (src_layout.channels == 3 && dst_layout.channels == 4) {
+                pad_alpha_3x8(src, dst, count, swap);
+                return;
+            }
+        }
+    } else if (same_layout) {
+        if (src_component_format == ComponentFormat::Float32) {
+            if (dst_component_format == ComponentFormat::UInt8) {
+                float_to_unorm8_n((const float *) src, dst, elements,
+                                  src_layout.channels, srgb);
+                return;
+            } else if (dst_component_format == ComponentFormat::Float16 && !srgb) {
+                float_to_half_n((const float *) src, (uint16_t *) dst, elements);
+                return;
+            }
+        } else if (src_component_format == ComponentFormat::UInt16 && !srgb) {
+            if (dst_component_format == ComponentFormat::Float32) {
+                unorm16_to_float_n((const uint16_t *) src, (float *) dst, elements);
+                return;
+            } else if (dst_component_format == ComponentFormat::Float16) {
+                unorm16_to_half_n((const uint16_t *) src, (uint16_t *) dst, elements);
+                return;
+            }
+        }
+    }
+
+    convert_generic(src, src_layout, src_component_format, dst, dst_layout,
+                    dst_component_format, count, srgb);
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,250 @@
+/*
+    src/plot.cpp -- GPU-accelerated widget for plotting large time series
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/plot.h>
+#include <nanogui/renderpass.h>
+#include <nanogui/shader.h>
+#include <nanogui/screen.h>
+#include <nanogui/opengl.h>
+#include <nanogui_resources.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+/* GPU storage is allocated for at least this many samples per series */
+static const size_t min_capacity = 1024;
+
+Plot::Plot(Widget *parent)
+    : Canvas(parent, 1, false, false, true), m_view_min(0.f), m_view_max(1.f) {
+    render_pass()->set_clear_color(0, Color(30, 255));
+
+    /* The two triangles of each strip segment have opposite orientation */
+    render_pass()->set_cull_mode(RenderPass::CullMode::Disabled);
+
+    m_shader = new Shader(
+        render_pass(),
+        "plot_series",
+        NANOGUI_SHADER(plot_vertex),
+        NANOGUI_SHADER(plot_fragment),
+        Shader::BlendMode::AlphaBlend
+    );
+}
+
+Plot::Series &Plot::get(size_t series) {
+    if (series >= m_series.size())
+        throw std::runtime_error("Plot::get(): invalid series index!");
+    return m_series[series];
+}
+
+const Plot::Series &Plot::get(size_t series) const {
+    if (series >= m_series.size())
+        throw std::runtime_error("Plot::get(): invalid series index!");
+    return m_series[series];
+}
+
+size_t Plot::add_series(const Color &color, float thickness) {
+    Series series;
+    series.color = color;
+    series.thickness = thickness;
+    m_series.push_back(series);
+    return m_series.size() - 1;
+}
+
+void Plot::append(size_t index, const float *x, const float *y, size_t count) {
+    Series &series = get(index);
+    series.points.reserve(series.points.size() + count);
+    for (size_t i = 0; i < count; ++i)
+        series.points.push_back(Vector2f(x[i], y[i]));
+}
+
+void Plot::clear(size_t index) {
+    Series &series = get(index);
+    series.points.clear();
+    series.uploaded = 0;
+}
+
+void Plot::set_view(const Vector2f &view_min, const Vector2f &view_max) {
+    if (!(view_min.x() < view_max.x() && view_min.y() < view_max.y()))
+        throw std::runtime_error("Plot::set_view(): invalid region!");
+    m_view_min = view_min;
+    m_view_max = view_max;
+}
+
+void Plot::fit_view() {
+    Vector2f lo(std::numeric_limits<float>::infinity()),
+             hi(-std::numeric_limits<float>::infinity());
+
+    for (const Series &series : m_series) {
+        for (const Vector2f &p : series.points) {
+            lo = min(lo, p);
+            hi = max(hi, p);
+        }
+    }
+
+    if (!(lo.x() <= hi.x()))
+        return;
+
+    /* Leave some space above and below the data */
+    Vector2f margin(0.f, (hi.y() - lo.y()) * .05f);
+    for (int i = 0; i < 2; ++i) {
+        if (hi[i] - lo[i] <= 0.f)
+            margin[i] = .5f;
+    }
+
+    set_view(lo - margin, hi + margin);
+}
+
+void Plot::fill_vertices(const Series &series, size_t start, size_t end,
+                         float *position, float *prev, float *next) const {
+    const std::vector<Vector2f> &p = series.points;
+    size_t n = p.size();
+
+    for (size_t k = start; k < end; ++k) {
+        const Vector2f &p0 = p[k > 0 ? k - 1 : k],
+                       &p1 = p[k],
+                       &p2 = p[k + 1 < n ? k + 1 : k];
+
+        /* Two vertices per sample (left and right side of the line) */
+        for (size_t j = 0; j < 2; ++j) {
+            size_t i = 2 * (2 * (k - start) + j);
+            position[i] = p1.x(); position[i + 1] = p1.y();
+            prev[i]     = p0.x(); prev[i + 1]     = p0.y();
+            next[i]     = p2.x(); next[i + 1]     = p2.y();
+        }
+    }
+}
+
+void Plot::upload() {
+    bool grow = false;
+    for (const Series &series : m_series)
+        grow |= series.points.size() > series.capacity;
+
+    if (grow) {
+        /* Grow geometrically, then lay out all series again and upload everything */
+        size_t total = 0;
+        for (Series &series : m_series) {
+            size_t n = series.points.size();
+            if (n > series.capacity)
+                series.capacity = std::max(min_capacity, 2 * n);
+            series.offset = total;
+            total += series.capacity;
+        }
+        size_t vertices = 2 * total;
+
+        std::vector<float> position(2 * vertices, 0.f), prev(2 * vertices, 0.f),
+                           next(2 * vertices, 0.f), side(vertices);
+        for (Series &series : m_series) {
+            size_t base = 4 * series.offset;
+            fill_vertices(series, 0, series.points.size(), position.data() + base,
+                          prev.data() + base, next.data() + base);
+            series.uploaded = series.points.size();
+        }
+        for (size_t i = 0; i < vertices; ++i)
+            side[i] = (i & 1) ? 1.f : -1.f;
+
+        m_shader->set_buffer("position", VariableType::Float32, { vertices, 2 }, position.data());
+        m_shader->set_buffer("prev", VariableType::Float32, { vertices, 2 }, prev.data());
+        m_shader->set_buffer("next", VariableType::Float32, { vertices, 2 }, next.data());
+        m_shader->set_buffer("side", VariableType::Float32, { vertices }, side.data());
+        m_upload_bytes += 7 * vertices * sizeof(float);
+        return;
+    }
+
+    for (Series &series : m_series) {
+        size_t n = series.points.size();
+        if (n == series.uploaded)
+            continue;
+
+        /* The line join of the previously last sample changes as well */
+        size_t start = series.uploaded > 0 ? series.uploaded - 1 : 0,
+               vertices = 2 * (n - start),
+               first = 2 * (series.offset + start);
+
+        std::vector<float> position(2 * vertices), prev(2 * vertices),
+                           next(2 * vertices);
+        fill_vertices(series, start, n, position.data(), prev.data(), next.data());
+
+        m_shader->update_buffer_range("position", first, vertices, position.data());
+        m_shader->update_buffer_range("prev", first, vertices, prev.data());
+        m_shader->update_buffer_range("next", first, vertices, next.data());
+        m_upload_bytes += 6 * vertices * sizeof(float);
+
+        series.uploaded = n;
+    }
+}
+
+Vector2f Plot::pos_to_data(const Vector2i &p) const {
+    Vector2f rel = Vector2f(p - m_pos) / Vector2f(max(m_size, Vector2i(1))),
+             extent = m_view_max - m_view_min;
+    return Vector2f(m_view_min.x() + rel.x() * extent.x(),
+                    m_view_max.y() - rel.y() * extent.y());
+}
+
+bool Plot::mouse_drag_event(const Vector2i & /* p */, const Vector2i &rel,
+                            int /* button */, int /* modifiers */) {
+    if (!m_enabled)
+        return false;
+
+    Vector2f extent = m_view_max - m_view_min,
+             shift = Vector2f(rel) * extent / Vector2f(max(m_size, Vector2i(1)));
+    shift.x() = -shift.x();
+
+    m_view_min += shift;
+    m_view_max += shift;
+    return true;
+}
+
+bool Plot::scroll_event(const Vector2i &p, const Vector2f &rel) {
+    if (!m_enabled)
+        return false;
+
+    /* Zoom about the position of the mouse cursor */
+    Vector2f center = pos_to_data(p);
+    float factor = std::pow(2.f, -rel.y() / 5.f);
+    Vector2f view_min = center + (m_view_min - center) * factor,
+             view_max = center + (m_view_max - center) * factor;
+
+    if (view_min.x() < view_max.x() && view_min.y() < view_max.y()) {
+        m_view_min = view_min;
+        m_view_max = view_max;
+    }
+    return true;
+}
+
+void Plot::draw_contents() {
+    Vector2f viewport = Vector2f(render_pass()->viewport().second);
+    float pixel_ratio = screen()->pixel_ratio();
+
+    /* Map the visible region onto clip space */
+    Vector2f scale = 2.f / (m_view_max - m_view_min),
+             offset = -1.f - m_view_min * scale;
+    Vector4f transform(scale.x(), scale.y(), offset.x(), offset.y());
+
+    upload();
+
+    m_shader->set_uniform("transform", transform);
+    m_shader->set_uniform("viewport", viewport);
+
+    for (const Series &series : m_series) {
+        size_t n = series.points.size();
+        if (n < 2)
+            continue;
+
+        m_shader->set_uniform("thickness", series.thickness * pixel_ratio);
+        m_shader->set_uniform("color", series.color);
+
+        m_shader->begin();
+        m_shader->draw_array(Shader::PrimitiveType::TriangleStrip,
+                             2 * series.offset, 2 * n, false);
+        m_shader->end();
+    }
+}
+
+NAMESPACE_END(nanogui)
@@ -46,12 +46,14 @@ void PopupButton::draw(NVGcontext* ctx) {
         NVGcolor text_color =
             m_text_color.w() == 0 ? m_theme->m_text_color : m_text_color;
 
-        nvgFontSize(ctx, (m_font_size < 0 ? m_theme->m_button_font_size : m_font_size) * icon_scale());
+        float font_size =
+            (m_font_size < 0 ? m_theme->m_button_font_size : m_font_size) * icon_scale();
+        float iw = measure_text(ctx, "icons", font_size,
+                                NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE, icon).advance;
+        nvgFontSize(ctx, font_size);
         nvgFontFace(ctx, "icons");
-        nvgFillColor(ctx, m_enabled ? text_color : NVGcolor(m_theme->m_disabled_text_color));
         nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
-
-        float iw = nvgTextBounds(ctx, 0, 0, icon.data(), nullptr, nullptr);
+        nvgFillColor(ctx, m_enabled ? text_color : NVGcolor(m_theme->m_disabled_text_color));
         Vector2f icon_pos(0, m_pos.y() + m_size.y() * 0.5f - 1);
 
         if (m_popup->side() == Popup::Right)
@@ -0,0 +1,180 @@
+/*
+    src/pyramid.cpp -- Multi-resolution min/max/mean pyramid for
+    summarizing long sample sequences at any zoom level
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/pyramid.h>
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#  include <xmmintrin.h>
+#  define NANOGUI_PYRAMID_SSE
+#elif defined(__ARM_NEON)
+#  include <arm_neon.h>
+#  define NANOGUI_PYRAMID_NEON
+#endif
+
+NAMESPACE_BEGIN(nanogui)
+
+static_assert(SamplePyramid::Fanout == 8, "The reduction kernels assume a fanout of 8");
+
+/**
+ * Reduce blocks of 8 consecutive entries. The inputs may alias (e.g. when
+ * reducing the samples themselves, which are their own min/max/sum).
+ */
+static void reduce_blocks(const float *in_min, const float *in_max,
+                          const float *in_sum, size_t blocks, float *out_min,
+                          float *out_max, float *out_sum) {
+    for (size_t i = 0; i < blocks; ++i) {
+        const float *mn = in_min + 8 * i, *mx = in_max + 8 * i,
+                    *sm = in_sum + 8 * i;
+#if defined(NANOGUI_PYRAMID_SSE)
+        __m128 vmin = _mm_min_ps(_mm_loadu_ps(mn), _mm_loadu_ps(mn + 4)),
+               vmax = _mm_max_ps(_mm_loadu_ps(mx), _mm_loadu_ps(mx + 4)),
+               vsum = _mm_add_ps(_mm_loadu_ps(sm), _mm_loadu_ps(sm + 4));
+
+        vmin = _mm_min_ps(vmin, _mm_movehl_ps(vmin, vmin));
+        vmax = _mm_max_ps(vmax, _mm_movehl_ps(vmax, vmax));
+        vsum = _mm_add_ps(vsum, _mm_movehl_ps(vsum, vsum));
+        vmin = _mm_min_ss(vmin, _mm_shuffle_ps(vmin, vmin, 1));
+        vmax = _mm_max_ss(vmax, _mm_shuffle_ps(vmax, vmax, 1));
+        vsum = _mm_add_ss(vsum, _mm_shuffle_ps(vsum, vsum, 1));
+
+        out_min[i] = _mm_cvtss_f32(vmin);
+        out_max[i] = _mm_cvtss_f32(vmax);
+        out_sum[i] = _mm_cvtss_f32(vsum);
+#elif defined(NANOGUI_PYRAMID_NEON)
+        float32x4_t vmin = vminq_f32(vld1q_f32(mn), vld1q_f32(mn + 4)),
+                    vmax = vmaxq_f32(vld1q_f32(mx), vld1q_f32(mx + 4)),
+                    vsum = vaddq_f32(vld1q_f32(sm), vld1q_f32(sm + 4));
+
+        float32x2_t hmin = vpmin_f32(vget_low_f32(vmin), vget_high_f32(vmin)),
+                    hmax = vpmax_f32(vget_low_f32(vmax), vget_high_f32(vmax)),
+                    hsum = vpadd_f32(vget_low_f32(vsum), vget_high_f32(vsum));
+
+        out_min[i] = vget_lane_f32(vpmin_f32(hmin, hmin), 0);
+        out_max[i] = vget_lane_f32(vpmax_f32(hmax, hmax), 0);
+        out_sum[i] = vget_lane_f32(vpadd_f32(hsum, hsum), 0);
+#else
+        float vmin = mn[0], vmax = mx[0], vsum = sm[0];
+        for (size_t j = 1; j < 8; ++j) {
+            vmin = std::min(vmin, mn[j]);
+            vmax = std::max(vmax, mx[j]);
+            vsum += sm[j];
+        }
+        out_min[i] = vmin;
+        out_max[i] = vmax;
+        out_sum[i] = vsum;
+#endif
+    }
+}
+
+void SamplePyramid::extend(const float *values, size_t size) {
+    if (size < m_size)
+        clear();
+    m_size = size;
+
+    const float *in_min = values, *in_max = values, *in_sum = values;
+    size_t in_size = size;
+
+    for (size_t l = 0; in_size >= Fanout; ++l) {
+        if (l == m_levels.size())
+            m_levels.emplace_back();
+
+        Level &level = m_levels[l];
+        size_t start = level.min.size(), end = in_size / Fanout;
+
+        if (end > start) {
+            level.min.resize(end);
+            level.max.resize(end);
+            level.sum.resize(end);
+            reduce_blocks(in_min + start * Fanout, in_max + start * Fanout,
+                          in_sum + start * Fanout, end - start,
+                          level.min.data() + start, level.max.data() + start,
+                          level.sum.data() + start);
+        }
+
+        in_min = level.min.data();
+        in_max = level.max.data();
+        in_sum = level.sum.data();
+        in_size = end;
+    }
+}
+
+void SamplePyramid::clear() {
+    m_levels.clear();
+    m_size = 0;
+}
+
+SamplePyramid::Envelope SamplePyramid::envelope(const float *values,
+                                                size_t begin, size_t end) const {
+    Envelope result;
+    end = std::min(end, m_size);
+    if (begin >= end)
+        return result;
+
+    float vmin = values[begin], vmax = vmin;
+    double sum = 0.0;
+    size_t count = end - begin;
+
+    auto add_sample = [&](size_t i) {
+        float v = values[i];
+        vmin = std::min(vmin, v);
+        vmax = std::max(vmax, v);
+        sum += v;
+    };
+
+    auto add_block = [&](const Level &level, size_t i) {
+        vmin = std::min(vmin, level.min[i]);
+        vmax = std::max(vmax, level.max[i]);
+        sum += level.sum[i];
+    };
+
+    /* Consume unaligned entries at both ends, then ascend one level */
+    size_t lo = begin, hi = end;
+    while (lo < hi && lo % Fanout != 0)
+        add_sample(lo++);
+    while (hi > lo && hi % Fanout != 0)
+        add_sample(--hi);
+    lo /= Fanout;
+    hi /= Fanout;
+
+    for (size_t l = 0; lo < hi; ++l) {
+        const Level &level = m_levels[l];
+        if (l + 1 == m_levels.size()) {
+            while (lo < hi)
+                add_block(level, lo++);
+            break;
+        }
+        while (lo < hi && lo % Fanout != 0)
+            add_block(level, lo++);
+        while (hi > lo && hi % Fanout != 0)
+            add_block(level, --hi);
+        lo /= Fanout;
+        hi /= Fanout;
+    }
+
+    result.min = vmin;
+    result.max = vmax;
+    result.mean = (float) (sum / (double) count);
+    result.count = count;
+    return result;
+}
+
+void SamplePyramid::envelopes(const float *values, size_t begin, size_t end,
+                              size_t count, Envelope *out) const {
+    end = std::min(end, m_size);
+    size_t length = end > begin ? end - begin : 0;
+    for (size_t i = 0; i < count; ++i)
+        out[i] = envelope(values, begin + i * length / count,
+                          begin + (i + 1) * length / count);
+}
+
+NAMESPACE_END(nanogui)
@@ -22,6 +22,26 @@ public:
     }
 };
 
+class PyPlot : public Plot {
+public:
+    using Plot::Plot;
+    NANOGUI_WIDGET_OVERLOADS(Plot);
+
+    void draw_contents() override {
+        PYBIND11_OVERLOAD(void, Plot, draw_contents);
+    }
+};
+
+class PyHeatmap : public Heatmap {
+public:
+    using Heatmap::Heatmap;
+    NANOGUI_WIDGET_OVERLOADS(Heatmap);
+
+    void draw_contents() override {
+        PYBIND11_OVERLOAD(void, Heatmap, draw_contents);
+    }
+};
+
 void register_canvas(py::module &m) {
     py::class_<Canvas, Widget, ref<Canvas>, PyCanvas>(m, "Canvas", D(Canvas))
         .def(py::init<Widget *, uint8_t, bool, bool, bool>(),
@@ -37,10 +57,36 @@ void register_canvas(py::module &m) {
         .def("set_background_color", &Canvas::set_background_color, D(Canvas, set_background_color))
         .def("draw_contents", &Canvas::draw_contents, D(Canvas, draw_contents));
 
+    py::class_<TileSource, Object, ref<TileSource>>(m, "TileSource", D(TileSource))
+        .def("size", &TileSource::size, D(TileSource, size))
+        .def("tile_size", &TileSource::tile_size, D(TileSource, tile_size))
+        .def("level_count", &TileSource::level_count, D(TileSource, level_count))
+        .def("level_size", &TileSource::level_size, D(TileSource, level_size))
+        .def("tile_count", &TileSource::tile_count, D(TileSource, tile_count));
+
+    py::class_<DirectoryTileSource, TileSource, ref<DirectoryTileSource>>(
+        m, "DirectoryTileSource", D(DirectoryTileSource))
+        .def(py::init<const std::string &, const Vector2i &, int, const std::string &>(),
+             "directory"_a, "size"_a, "tile_size"_a = 256, "extension"_a = "png",
+             D(DirectoryTileSource, DirectoryTileSource));
+
+    py::class_<TileCache, Object, ref<TileCache>>(m, "TileCache", D(TileCache))
+        .def("source", py::overload_cast<>(&TileCache::source), D(TileCache, source))
+        .def("upload_limit", &TileCache::upload_limit, D(TileCache, upload_limit))
+        .def("set_upload_limit", &TileCache::set_upload_limit, D(TileCache, set_upload_limit))
+        .def("resident_count", &TileCache::resident_count, D(TileCache, resident_count))
+        .def("load_count", &TileCache::load_count, D(TileCache, load_count))
+        .def("eviction_count", &TileCache::eviction_count, D(TileCache, eviction_count));
+
     py::class_<ImageView, Canvas, ref<ImageView>, PyImageView>(m, "ImageView", D(ImageView))
         .def(py::init<Widget *>(), D(ImageView, ImageView))
         .def("image", py::overload_cast<>(&ImageView::image, py::const_), D(ImageView, image))
         .def("set_image", &ImageView::set_image, D(ImageView, set_image))
+        .def("set_tile_source", &ImageView::set_tile_source, "source"_a,
+             "cache_capacity"_a = 256, D(ImageView, set_tile_source))
+        .def("tile_source", &ImageView::tile_source, D(ImageView, tile_source))
+        .def("tile_cache", &ImageView::tile_cache, D(ImageView, tile_cache))
+        .def("image_size", &ImageView::image_size, D(ImageView, image_size))
         .def("reset", &ImageView::reset, D(ImageView, reset))
         .def("center", &ImageView::center, D(ImageView, center))
         .def("offset", &ImageView::offset, D(ImageView, offset))
@@ -58,7 +104,73 @@ void register_canvas(py::module &m) {
                         strncpy(out[i], str[i].c_str(), size);
                 });
              },
-             D(ImageView, set_pixel_callback));
+             D(ImageView, set_pixel_callback))
+        .def("invalidate_pixel_values", &ImageView::invalidate_pixel_values,
+             D(ImageView, invalidate_pixel_values))
+        .def("pixel_callback_count", &ImageView::pixel_callback_count,
+             D(ImageView, pixel_callback_count));
+
+    py::class_<Plot, Canvas, ref<Plot>, PyPlot>(m, "Plot", D(Plot))
+        .def(py::init<Widget *>(), D(Plot, Plot))
+        .def("add_series", &Plot::add_series, "color"_a, "thickness"_a = 1.5f,
+             D(Plot, add_series))
+        .def("series_count", &Plot::series_count, D(Plot, series_count))
+        .def("series_color", &Plot::series_color, D(Plot, series_color))
+        .def("set_series_color", &Plot::set_series_color, D(Plot, set_series_color))
+        .def("series_thickness", &Plot::series_thickness, D(Plot, series_thickness))
+        .def("set_series_thickness", &Plot::set_series_thickness, D(Plot, set_series_thickness))
+        .def("sample_count", &Plot::sample_count, D(Plot, sample_count))
+        .def("append",
+             [](Plot &plot, size_t series, const std::vector<float> &x,
+                const std::vector<float> &y) {
+                 if (x.size() != y.size())
+                     throw py::value_error("Plot::append(): x and y must have the same size!");
+                 plot.append(series, x.data(), y.data(), x.size());
+             }, "series"_a, "x"_a, "y"_a, D(Plot, append))
+        .def("append", py::overload_cast<size_t, float, float>(&Plot::append),
+             "series"_a, "x"_a, "y"_a, D(Plot, append, 2))
+        .def("clear", &Plot::clear, D(Plot, clear))
+        .def("view_min", &Plot::view_min, D(Plot, view_min))
+        .def("view_max", &Plot::view_max, D(Plot, view_max))
+        .def("set_view", &Plot::set_view, D(Plot, set_view))
+        .def("fit_view", &Plot::fit_view, D(Plot, fit_view))
+        .def("upload_bytes", &Plot::upload_bytes, D(Plot, upload_bytes));
+
+    py::class_<Heatmap, Canvas, ref<Heatmap>, PyHeatmap> heatmap(m, "Heatmap", D(Heatmap));
+
+    py::enum_<Heatmap::Colormap>(heatmap, "Colormap", D(Heatmap, Colormap))
+        .value("Grayscale", Heatmap::Colormap::Grayscale)
+        .value("Viridis", Heatmap::Colormap::Viridis)
+        .value("Inferno", Heatmap::Colormap::Inferno);
+
+    heatmap
+        .def(py::init<Widget *, const Vector2i &>(), "parent"_a, "data_size"_a,
+             D(Heatmap, Heatmap))
+        /* No default argument: Texture.ComponentFormat is registered later */
+        .def(py::init<Widget *, const Vector2i &, Texture::ComponentFormat>(),
+             "parent"_a, "data_size"_a, "component_format"_a, D(Heatmap, Heatmap))
+        .def("data_size", &Heatmap::data_size, D(Heatmap, data_size))
+        .def("push_column",
+             [](Heatmap &heatmap, const std::vector<float> &values) {
+                 if (values.size() != (size_t) heatmap.data_size().y())
+                     throw py::value_error("Heatmap::push_column(): expected one value per row!");
+                 heatmap.push_column(values.data());
+             }, D(Heatmap, push_column))
+        .def("set_data",
+             [](Heatmap &heatmap, const std::vector<float> &values) {
+                 const Vector2i &size = heatmap.data_size();
+                 if (values.size() != (size_t) size.x() * (size_t) size.y())
+                     throw py::value_error("Heatmap::set_data(): expected columns * rows values!");
+                 heatmap.set_data(values.data());
+             }, D(Heatmap, set_data))
+        .def("range_min", &Heatmap::range_min, D(Heatmap, range_min))
+        .def("range_max", &Heatmap::range_max, D(Heatmap, range_max))
+        .def("set_range", &Heatmap::set_range, D(Heatmap, set_range))
+        .def("set_colormap", py::overload_cast<Heatmap::Colormap>(&Heatmap::set_colormap),
+             D(Heatmap, set_colormap))
+        .def("set_colormap", py::overload_cast<const std::vector<Color> &>(&Heatmap::set_colormap),
+             D(Heatmap, set_colormap, 2))
+        .def("upload_bytes", &Heatmap::upload_bytes, D(Heatmap, upload_bytes));
 }
 
 #endif
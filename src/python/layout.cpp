@@ -57,6 +57,8 @@ void register_layout(py::module &m) {
         .def("set_spacing", (void(GridLayout::*)(int)) &GridLayout::set_spacing, D(GridLayout, set_spacing))
         .def("set_spacing", (void(GridLayout::*)(int, int)) &GridLayout::set_spacing, D(GridLayout, set_spacing, 2))
         .def("alignment", &GridLayout::alignment, D(GridLayout, alignment))
+        .def("parallel", &GridLayout::parallel, D(GridLayout, parallel))
+        .def("set_parallel", &GridLayout::set_parallel, D(GridLayout, set_parallel))
         .def("set_col_alignment", (void(GridLayout::*)(Alignment)) &GridLayout::set_col_alignment, D(GridLayout, set_col_alignment))
         .def("set_row_alignment", (void(GridLayout::*)(Alignment)) &GridLayout::set_row_alignment, D(GridLayout, set_row_alignment))
         .def("set_col_alignment", (void(GridLayout::*)(const std::vector<Alignment>&)) &GridLayout::set_col_alignment/*, D(GridLayout, set_col_alignment, 2)*/)
@@ -80,7 +82,9 @@ void register_layout(py::module &m) {
         .def("set_row_stretch", &AdvancedGridLayout::set_row_stretch, D(AdvancedGridLayout, set_row_stretch))
         .def("set_col_stretch", &AdvancedGridLayout::set_col_stretch, D(AdvancedGridLayout, set_col_stretch))
         .def("set_anchor", &AdvancedGridLayout::set_anchor, D(AdvancedGridLayout, set_anchor))
-        .def("anchor", &AdvancedGridLayout::anchor, D(AdvancedGridLayout, anchor));
+        .def("anchor", &AdvancedGridLayout::anchor, D(AdvancedGridLayout, anchor))
+        .def("parallel", &AdvancedGridLayout::parallel, D(AdvancedGridLayout, parallel))
+        .def("set_parallel", &AdvancedGridLayout::set_parallel, D(AdvancedGridLayout, set_parallel));
 
     py::class_<AdvancedGridLayout::Anchor>(adv_grid_layout, "Anchor")
         .def(py::init<int, int, Alignment, Alignment>(),
@@ -233,6 +233,10 @@ PYBIND11_MODULE(nanogui_ext, m_) {
     #endif
     m.def("utf8", [](int c) { return std::string(utf8(c).data()); }, D(utf8));
     m.def("load_image_directory", &nanogui::load_image_directory, D(load_image_directory));
+    m.def("nvg_is_atlas_icon", &nvg_is_atlas_icon, D(nvg_is_atlas_icon));
+    m.def("nvg_image_icon_size", &nvg_image_icon_size, D(nvg_image_icon_size));
+    m.def("nvg_image_icon_pattern", &nvg_image_icon_pattern, "ctx"_a, "icon"_a, "x"_a,
+          "y"_a, "w"_a, "h"_a, "alpha"_a, D(nvg_image_icon_pattern));
 
     py::enum_<Cursor>(m, "Cursor", D(Cursor))
         .value("Arrow", Cursor::Arrow)
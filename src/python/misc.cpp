@@ -7,6 +7,17 @@ DECLARE_WIDGET(ColorPicker);
 DECLARE_WIDGET(Graph);
 DECLARE_WIDGET(ImagePanel);
 
+class PyImageSource : public ImageSource {
+public:
+    size_t size() const override {
+        PYBIND11_OVERLOAD_PURE(size_t, ImageSource, size);
+    }
+
+    std::string filename(size_t index) const override {
+        PYBIND11_OVERLOAD_PURE(std::string, ImageSource, filename, index);
+    }
+};
+
 void register_misc(py::module &m) {
     py::class_<ColorWheel, Widget, ref<ColorWheel>, PyColorWheel>(m, "ColorWheel", D(ColorWheel))
         .def(py::init<Widget *>(), "parent"_a, D(ColorWheel, ColorWheel))
@@ -43,13 +54,52 @@ void register_misc(py::module &m) {
         .def("set_stroke_color", &Graph::set_stroke_color, D(Graph, set_stroke_color))
         .def("text_color", &Graph::text_color, D(Graph, text_color))
         .def("set_text_color", &Graph::set_text_color, D(Graph, set_text_color))
-        .def("values", (std::vector<float> &(Graph::*)(void)) &Graph::values, D(Graph, values))
-        .def("set_values", &Graph::set_values, D(Graph, set_values));
+        .def("values", &Graph::values, D(Graph, values))
+        .def("set_values", &Graph::set_values, D(Graph, set_values))
+        .def("capacity", &Graph::capacity, D(Graph, capacity))
+        .def("set_capacity", &Graph::set_capacity, D(Graph, set_capacity))
+        .def("push_value", &Graph::push_value, D(Graph, push_value))
+        .def("push_values", (void (Graph::*)(const std::vector<float> &)) &Graph::push_values,
+             D(Graph, push_values));
+
+    py::class_<ThumbnailCache, Object, ref<ThumbnailCache>>(m, "ThumbnailCache", D(ThumbnailCache))
+        .def(py::init<int, size_t, const std::string &, size_t>(), "resolution"_a,
+             "capacity"_a = 4096, "cache_directory"_a = "", "threads"_a = 0,
+             D(ThumbnailCache, ThumbnailCache))
+        .def("resolution", &ThumbnailCache::resolution, D(ThumbnailCache, resolution))
+        .def("capacity", &ThumbnailCache::capacity, D(ThumbnailCache, capacity))
+        .def("set_capacity", &ThumbnailCache::set_capacity, D(ThumbnailCache, set_capacity))
+        .def("cache_directory", &ThumbnailCache::cache_directory, D(ThumbnailCache, cache_directory))
+        .def("upload_limit", &ThumbnailCache::upload_limit, D(ThumbnailCache, upload_limit))
+        .def("set_upload_limit", &ThumbnailCache::set_upload_limit, D(ThumbnailCache, set_upload_limit))
+        .def("page_size", &ThumbnailCache::page_size, D(ThumbnailCache, page_size))
+        .def("page_count", &ThumbnailCache::page_count, D(ThumbnailCache, page_count))
+        .def("clear", &ThumbnailCache::clear, D(ThumbnailCache, clear))
+        .def("resident_count", &ThumbnailCache::resident_count, D(ThumbnailCache, resident_count))
+        .def("load_count", &ThumbnailCache::load_count, D(ThumbnailCache, load_count))
+        .def("eviction_count", &ThumbnailCache::eviction_count, D(ThumbnailCache, eviction_count))
+        .def("disk_hit_count", &ThumbnailCache::disk_hit_count, D(ThumbnailCache, disk_hit_count));
+
+    py::class_<ImageSource, Object, ref<ImageSource>, PyImageSource>(m, "ImageSource", D(ImageSource))
+        .def(py::init<>())
+        .def("size", &ImageSource::size, D(ImageSource, size))
+        .def("filename", &ImageSource::filename, D(ImageSource, filename));
+
+    py::class_<ImageFileList, ImageSource, ref<ImageFileList>>(m, "ImageFileList", D(ImageFileList))
+        .def(py::init<const std::vector<std::string> &>(), "files"_a, D(ImageFileList, ImageFileList))
+        .def("files", &ImageFileList::files, D(ImageFileList, files));
 
     py::class_<ImagePanel, Widget, ref<ImagePanel>, PyImagePanel>(m, "ImagePanel", D(ImagePanel))
         .def(py::init<Widget *>(), "parent"_a, D(ImagePanel, ImagePanel))
         .def("images", &ImagePanel::images, D(ImagePanel, images))
         .def("set_images", &ImagePanel::set_images, D(ImagePanel, set_images))
+        .def("source", &ImagePanel::source, D(ImagePanel, source))
+        .def("set_source", &ImagePanel::set_source, "source"_a, "cache_directory"_a = "",
+             D(ImagePanel, set_source))
+        .def("set_files", &ImagePanel::set_files, "files"_a, "cache_directory"_a = "",
+             D(ImagePanel, set_files))
+        .def("thumbnail_cache", &ImagePanel::thumbnail_cache, D(ImagePanel, thumbnail_cache))
+        .def("image_count", &ImagePanel::image_count, D(ImagePanel, image_count))
         .def("callback", &ImagePanel::callback, D(ImagePanel, callback))
         .def("set_callback", &ImagePanel::set_callback, D(ImagePanel, set_callback));
 }
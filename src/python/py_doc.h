@@ -116,6 +116,8 @@ static const char *__doc_nanogui_AdvancedGridLayout_m_rows = R"doc(The rows of t
 
 static const char *__doc_nanogui_AdvancedGridLayout_margin = R"doc(The margin of this AdvancedGridLayout.)doc";
 
+static const char *__doc_nanogui_AdvancedGridLayout_parallel = R"doc(Are child widgets laid out using multiple threads?)doc";
+
 static const char *__doc_nanogui_AdvancedGridLayout_perform_layout = R"doc(See Layout::perform_layout.)doc";
 
 static const char *__doc_nanogui_AdvancedGridLayout_preferred_size = R"doc(See Layout::preferred_size.)doc";
@@ -128,6 +130,9 @@ static const char *__doc_nanogui_AdvancedGridLayout_set_col_stretch = R"doc(Set
 
 static const char *__doc_nanogui_AdvancedGridLayout_set_margin = R"doc(Sets the margin of this AdvancedGridLayout.)doc";
 
+static const char *__doc_nanogui_AdvancedGridLayout_set_parallel =
+R"doc(Specify whether child widgets should be laid out using multiple threads)doc";
+
 static const char *__doc_nanogui_AdvancedGridLayout_set_row_stretch = R"doc(Set the stretch factor of a given row)doc";
 
 static const char *__doc_nanogui_Alignment = R"doc(The different kinds of alignments a layout can perform.)doc";
@@ -860,6 +865,29 @@ static const char *__doc_nanogui_Cursor_IBeam = R"doc(< The I-beam cursor.)doc";
 
 static const char *__doc_nanogui_Cursor_VResize = R"doc(< The vertical resize cursor.)doc";
 
+static const char *__doc_nanogui_DirectoryTileSource =
+R"doc(\class DirectoryTileSource tiledimage.h nanogui/tiledimage.h
+
+Loads tiles from image files stored as directory/level/x_y.ext
+
+Any file format supported by stb_image (PNG, JPEG, ...) can be used.)doc";
+
+static const char *__doc_nanogui_DirectoryTileSource_DirectoryTileSource =
+R"doc(Create a tile source for a directory of tiles
+
+Parameter ``directory``:
+    Directory containing one subdirectory per resolution level
+
+Parameter ``size``:
+    Size of the image at full resolution
+
+Parameter ``tile_size``:
+    Width and height of a tile in pixels (tiles at the right and
+    bottom border may be smaller)
+
+Parameter ``extension``:
+    File extension of the tiles)doc";
+
 static const char *__doc_nanogui_FloatBox =
 R"doc(\class FloatBox textbox.h nanogui/textbox.h
 
@@ -1021,16 +1049,23 @@ static const char *__doc_nanogui_Graph_Graph = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_background_color = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_capacity = R"doc(Return the maximum number of retained values (0: unlimited))doc";
+
 static const char *__doc_nanogui_Graph_caption = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_draw = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_fill_color = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_flush_pending = R"doc(Move values queued by push_values() into the ring buffer)doc";
+
 static const char *__doc_nanogui_Graph_footer = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_header = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_linearize =
+R"doc(Rotate the ring buffer so that the oldest value is stored first)doc";
+
 static const char *__doc_nanogui_Graph_m_background_color = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_m_caption = R"doc()doc";
@@ -1049,8 +1084,21 @@ static const char *__doc_nanogui_Graph_m_values = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_preferred_size = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_push_value =
+R"doc(Append a value
+
+This function is thread-safe: the value is queued and incorporated by
+the GUI thread when the graph is drawn next. Note that the caller
+remains responsible for requesting a redraw of the screen.)doc";
+
+static const char *__doc_nanogui_Graph_push_values = R"doc(Append a sequence of values (thread-safe, see push_value()))doc";
+
+static const char *__doc_nanogui_Graph_push_values_2 = R"doc(Append a sequence of values (thread-safe, see push_value()))doc";
+
 static const char *__doc_nanogui_Graph_set_background_color = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_set_capacity = R"doc(Set the maximum number of retained values (0: unlimited))doc";
+
 static const char *__doc_nanogui_Graph_set_caption = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_set_fill_color = R"doc()doc";
@@ -1069,9 +1117,9 @@ static const char *__doc_nanogui_Graph_stroke_color = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_text_color = R"doc()doc";
 
-static const char *__doc_nanogui_Graph_values = R"doc()doc";
+static const char *__doc_nanogui_Graph_value = R"doc(Return the i-th oldest value)doc";
 
-static const char *__doc_nanogui_Graph_values_2 = R"doc()doc";
+static const char *__doc_nanogui_Graph_values = R"doc()doc";
 
 static const char *__doc_nanogui_GridLayout = R"doc()doc";
 
@@ -1129,6 +1177,8 @@ static const char *__doc_nanogui_GridLayout_margin = R"doc(The margin around thi
 
 static const char *__doc_nanogui_GridLayout_orientation = R"doc(The Orientation of this GridLayout.)doc";
 
+static const char *__doc_nanogui_GridLayout_parallel = R"doc(Are child widgets laid out using multiple threads?)doc";
+
 static const char *__doc_nanogui_GridLayout_perform_layout = R"doc(See Layout::perform_layout.)doc";
 
 static const char *__doc_nanogui_GridLayout_preferred_size = R"doc(See Layout::preferred_size.)doc";
@@ -1145,6 +1195,9 @@ static const char *__doc_nanogui_GridLayout_set_margin = R"doc(Sets the margin o
 
 static const char *__doc_nanogui_GridLayout_set_orientation = R"doc(Sets the Orientation of this GridLayout.)doc";
 
+static const char *__doc_nanogui_GridLayout_set_parallel =
+R"doc(Specify whether child widgets should be laid out using multiple threads)doc";
+
 static const char *__doc_nanogui_GridLayout_set_resolution =
 R"doc(Sets the number of rows or columns (depending on the Orientation) of
 this GridLayout.)doc";
@@ -1225,12 +1278,199 @@ static const char *__doc_nanogui_GroupLayout_set_spacing = R"doc(Sets the spacin
 
 static const char *__doc_nanogui_GroupLayout_spacing = R"doc(The spacing between widgets of this GroupLayout.)doc";
 
+static const char *__doc_nanogui_Heatmap =
+R"doc(\class Heatmap heatmap.h nanogui/heatmap.h
+
+Displays a 2D array of scalar values through a colormap
+
+The raw values are stored in a single-channel floating point texture,
+and colors are only assigned in the fragment shader using a lookup
+table. Changing the value range or the colormap therefore doesn't
+require any uploads.
+
+The texture is used as a circular buffer of columns: push_column()
+overwrites the oldest column and shifts the displayed image to the
+left, which is what a live spectrogram needs. Each call uploads a
+single column.
+
+The data is organized in ``columns`` x ``rows`` (see data_size()),
+with row 0 shown at the bottom and the oldest column shown on the left.)doc";
+
+static const char *__doc_nanogui_Heatmap_Colormap = R"doc(Built-in colormaps)doc";
+
+static const char *__doc_nanogui_Heatmap_Heatmap =
+R"doc(Create a heatmap widget
+
+Parameter ``parent``:
+    The parent widget
+
+Parameter ``data_size``:
+    Number of columns and rows of the data
+
+Parameter ``component_format``:
+    Storage format of the values on the GPU. Must be ``Float32`` or
+    ``Float16`` (which halves the upload cost).)doc";
+
+static const char *__doc_nanogui_Heatmap_data_size = R"doc(Return the number of columns and rows of the data)doc";
+
+static const char *__doc_nanogui_Heatmap_draw_contents = R"doc()doc";
+
+static const char *__doc_nanogui_Heatmap_push_column =
+R"doc(Replace the oldest column and scroll the image by one column
+
+``values`` must contain ``rows`` entries, starting with the bottom row.)doc";
+
+static const char *__doc_nanogui_Heatmap_range_max =
+R"doc(Return the value that is mapped to the last entry of the colormap)doc";
+
+static const char *__doc_nanogui_Heatmap_range_min =
+R"doc(Return the value that is mapped to the first entry of the colormap)doc";
+
+static const char *__doc_nanogui_Heatmap_set_colormap = R"doc(Select one of the built-in colormaps)doc";
+
+static const char *__doc_nanogui_Heatmap_set_colormap_2 =
+R"doc(Set a colormap that interpolates between evenly spaced colors)doc";
+
+static const char *__doc_nanogui_Heatmap_set_data =
+R"doc(Replace all data
+
+``values`` must contain ``columns * rows`` entries stored row by row,
+starting with the bottom row. Column 0 is shown on the left.)doc";
+
+static const char *__doc_nanogui_Heatmap_set_range = R"doc(Set the range of values that is covered by the colormap)doc";
+
+static const char *__doc_nanogui_Heatmap_upload =
+R"doc(Convert values to the storage format and upload them to a region of the texture)doc";
+
+static const char *__doc_nanogui_Heatmap_upload_bytes = R"doc(Return the number of bytes uploaded to the GPU so far)doc";
+
+static const char *__doc_nanogui_ImageFileList =
+R"doc(\class ImageFileList imagepanel.h nanogui/imagepanel.h
+
+\brief ImageSource backed by a list of file names)doc";
+
+static const char *__doc_nanogui_ImageFileList_ImageFileList = R"doc()doc";
+
+static const char *__doc_nanogui_ImageFileList_filename = R"doc()doc";
+
+static const char *__doc_nanogui_ImageFileList_files = R"doc(Return the list of file names)doc";
+
+static const char *__doc_nanogui_ImageFileList_m_files = R"doc()doc";
+
+static const char *__doc_nanogui_ImageFileList_size = R"doc()doc";
+
+static const char *__doc_nanogui_ImageLoader =
+R"doc(\class ImageLoader imageloader.h nanogui/imageloader.h
+
+\brief Loads large numbers of images without blocking the user interface
+
+Files are decoded by a pool of worker threads using stb_image (PNG, JPEG,
+...). The decoded pixels are handed back to the thread owning the graphics
+context, where process() uploads at most upload_limit() images per call,
+either as NanoVG images or as Texture instances. Calling process() once
+per frame (e.g. from Screen::draw_contents()) keeps the application
+responsive while entire directories are loaded.
+
+To bound memory usage, the workers pause when decoded_limit() decoded
+images are waiting to be uploaded.)doc";
+
+static const char *__doc_nanogui_ImageLoader_Image = R"doc(Describes an image that finished loading)doc";
+
+static const char *__doc_nanogui_ImageLoader_ImageLoader =
+R"doc(Create an image loader
+
+Parameter ``target``:
+    Kind of GPU object that is created for each image
+
+Parameter ``threads``:
+    Number of worker threads (0: choose automatically))doc";
+
+static const char *__doc_nanogui_ImageLoader_Image_filename = R"doc(Name of the file)doc";
+
+static const char *__doc_nanogui_ImageLoader_Image_index = R"doc(Position of the image in the order of load() calls)doc";
+
+static const char *__doc_nanogui_ImageLoader_Image_nvg_image = R"doc(NanoVG image handle (only for Target::NanoVG))doc";
+
+static const char *__doc_nanogui_ImageLoader_Image_size = R"doc(Size of the image in pixels)doc";
+
+static const char *__doc_nanogui_ImageLoader_Image_texture = R"doc(Texture (only for Target::Texture))doc";
+
+static const char *__doc_nanogui_ImageLoader_Target = R"doc(Kind of GPU object that is created for each image)doc";
+
+static const char *__doc_nanogui_ImageLoader_Target_NanoVG =
+R"doc(NanoVG image handle (RGBA, for use with nvgImagePattern or ImagePanel))doc";
+
+static const char *__doc_nanogui_ImageLoader_Target_Texture = R"doc(Texture instance with the channel count of the file)doc";
+
+static const char *__doc_nanogui_ImageLoader_decoded_limit =
+R"doc(Return the maximum number of decoded images waiting to be uploaded)doc";
+
+static const char *__doc_nanogui_ImageLoader_failed = R"doc(Return the names of files that could not be decoded or uploaded)doc";
+
+static const char *__doc_nanogui_ImageLoader_load = R"doc(Queue an image file for loading and return its index)doc";
+
+static const char *__doc_nanogui_ImageLoader_load_directory =
+R"doc(Queue all files of a directory whose name contains ``extension``
+
+Returns the number of queued files. Throws an exception if the
+directory cannot be opened.)doc";
+
+static const char *__doc_nanogui_ImageLoader_loaded_count = R"doc(Return the number of images uploaded so far)doc";
+
+static const char *__doc_nanogui_ImageLoader_process =
+R"doc(Upload images that finished decoding
+
+Must be called on the thread that owns the graphics context. ``ctx`` is
+only needed for Target::NanoVG. Returns ``true`` if images are still
+being loaded, in which case the caller should schedule another frame.)doc";
+
+static const char *__doc_nanogui_ImageLoader_set_callback =
+R"doc(Set a function that is called by process() for each uploaded image)doc";
+
+static const char *__doc_nanogui_ImageLoader_set_decoded_limit =
+R"doc(Set the maximum number of decoded images waiting to be uploaded)doc";
+
+static const char *__doc_nanogui_ImageLoader_set_progress_callback =
+R"doc(Set a function that is called by process() to report progress)doc";
+
+static const char *__doc_nanogui_ImageLoader_set_upload_limit =
+R"doc(Set the maximum number of images uploaded by process() (0: unlimited))doc";
+
+static const char *__doc_nanogui_ImageLoader_set_wakeup_callback =
+R"doc(Set a function that is called (from a worker thread) when an image
+was decoded
+
+This is typically used to schedule a redraw, e.g. via Screen::redraw().)doc";
+
+static const char *__doc_nanogui_ImageLoader_target = R"doc(Return the kind of GPU object that is created for each image)doc";
+
+static const char *__doc_nanogui_ImageLoader_total_count = R"doc(Return the number of images queued so far)doc";
+
+static const char *__doc_nanogui_ImageLoader_upload_limit = R"doc(Return the maximum number of images uploaded by process())doc";
+
+static const char *__doc_nanogui_ImageLoader_wait =
+R"doc(Block until all queued images are uploaded
+
+Calls process() without an upload limit whenever images finish
+decoding. This still decodes in parallel, but does not return to the
+event loop in the meantime.)doc";
+
 static const char *__doc_nanogui_ImagePanel = R"doc()doc";
 
 static const char *__doc_nanogui_ImagePanel_2 =
 R"doc(\class ImagePanel imagepanel.h nanogui/imagepanel.h
 
-Image panel widget which shows a number of square-shaped icons.)doc";
+Image panel widget which shows a number of square-shaped icons.
+
+The icons are either NanoVG images specified via set_images(), or
+image files provided by an ImageSource (see set_source() and
+set_files()). In the latter case, a ThumbnailCache generates
+thumbnails in the background, so that only thumbnail-sized copies of
+the images are kept on the GPU.
+
+Only the rows that intersect the visible region of the panel (e.g.
+within a VScrollPanel) are drawn, and only their thumbnails are
+requested.)doc";
 
 static const char *__doc_nanogui_ImagePanel_ImagePanel = R"doc()doc";
 
@@ -1240,10 +1480,14 @@ static const char *__doc_nanogui_ImagePanel_draw = R"doc()doc";
 
 static const char *__doc_nanogui_ImagePanel_grid_size = R"doc()doc";
 
+static const char *__doc_nanogui_ImagePanel_image_count = R"doc(Return the number of icons)doc";
+
 static const char *__doc_nanogui_ImagePanel_images = R"doc()doc";
 
 static const char *__doc_nanogui_ImagePanel_index_for_position = R"doc()doc";
 
+static const char *__doc_nanogui_ImagePanel_m_cache_directory = R"doc()doc";
+
 static const char *__doc_nanogui_ImagePanel_m_callback = R"doc()doc";
 
 static const char *__doc_nanogui_ImagePanel_m_images = R"doc()doc";
@@ -1252,10 +1496,14 @@ static const char *__doc_nanogui_ImagePanel_m_margin = R"doc()doc";
 
 static const char *__doc_nanogui_ImagePanel_m_mouse_index = R"doc()doc";
 
+static const char *__doc_nanogui_ImagePanel_m_source = R"doc()doc";
+
 static const char *__doc_nanogui_ImagePanel_m_spacing = R"doc()doc";
 
 static const char *__doc_nanogui_ImagePanel_m_thumb_size = R"doc()doc";
 
+static const char *__doc_nanogui_ImagePanel_m_thumbnails = R"doc()doc";
+
 static const char *__doc_nanogui_ImagePanel_mouse_button_event = R"doc()doc";
 
 static const char *__doc_nanogui_ImagePanel_mouse_motion_event = R"doc()doc";
@@ -1264,15 +1512,58 @@ static const char *__doc_nanogui_ImagePanel_preferred_size = R"doc()doc";
 
 static const char *__doc_nanogui_ImagePanel_set_callback = R"doc()doc";
 
+static const char *__doc_nanogui_ImagePanel_set_files = R"doc(Convenience function that calls set_source() with an ImageFileList)doc";
+
 static const char *__doc_nanogui_ImagePanel_set_images = R"doc()doc";
 
+static const char *__doc_nanogui_ImagePanel_set_source =
+R"doc(Show thumbnails of image files instead of NanoVG images
+
+Parameter ``source``:
+    Source of the image file names
+
+Parameter ``cache_directory``:
+    Directory storing generated thumbnails on disk (empty: disable the
+    disk cache))doc";
+
+static const char *__doc_nanogui_ImagePanel_source = R"doc()doc";
+
+static const char *__doc_nanogui_ImagePanel_thumbnail_cache =
+R"doc(Return the thumbnail cache (created when the panel is first drawn after set_source()))doc";
+
+static const char *__doc_nanogui_ImagePanel_visible_rows =
+R"doc(Return the range ``[begin, end)`` of grid rows that intersect the
+visible region of the panel
+
+The visible region is the part of the panel that is not clipped by the
+bounds of its ancestors, which scissor the drawing of their children.)doc";
+
+static const char *__doc_nanogui_ImageSource =
+R"doc(\class ImageSource imagepanel.h nanogui/imagepanel.h
+
+\brief Interface to the image files browsed by an ImagePanel
+
+ImagePanel only queries the entries that are currently visible, so
+implementations can provide very large collections (e.g. the result of
+a database query) without materializing a list of file names.)doc";
+
+static const char *__doc_nanogui_ImageSource_filename = R"doc(Return the file name of the image with the given index)doc";
+
+static const char *__doc_nanogui_ImageSource_size = R"doc(Return the number of images)doc";
+
 static const char *__doc_nanogui_ImageView = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_2 =
 R"doc(\class ImageView imageview.h nanogui/imageview.h
 
 A widget for displaying, panning, and zooming images. Numerical RGBA
-pixel information is shown at large magnifications.)doc";
+pixel information is shown at large magnifications.
+
+Images that are too large to fit into GPU memory can be displayed in
+tiled mode (see set_tile_source()). Only the visible tiles of the
+resolution level that matches the current magnification are then
+loaded, in the background, while coarser tiles that are already
+resident are shown in their place.)doc";
 
 static const char *__doc_nanogui_ImageView_ImageView = R"doc(Initialize the widget)doc";
 
@@ -1282,10 +1573,23 @@ static const char *__doc_nanogui_ImageView_draw = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_draw_contents = R"doc()doc";
 
+static const char *__doc_nanogui_ImageView_draw_pixel_values =
+R"doc(Draw the numerical values of the visible pixels (at large magnifications))doc";
+
+static const char *__doc_nanogui_ImageView_draw_tiles = R"doc(Draw the visible tiles of the tiled image)doc";
+
 static const char *__doc_nanogui_ImageView_image = R"doc(Return the currently active image)doc";
 
 static const char *__doc_nanogui_ImageView_image_2 = R"doc(Return the currently active image (const version))doc";
 
+static const char *__doc_nanogui_ImageView_image_size = R"doc(Return the size of the active image or tiled image in pixels)doc";
+
+static const char *__doc_nanogui_ImageView_invalidate_pixel_values =
+R"doc(Discard the cached output of the pixel callback
+
+Must be called when the contents of the image changed without a call
+to set_image().)doc";
+
 static const char *__doc_nanogui_ImageView_keyboard_event = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_m_draw_image_border = R"doc()doc";
@@ -1312,6 +1616,9 @@ static const char *__doc_nanogui_ImageView_pixel_callback =
 R"doc(Return the callback that is used to acquire information about pixel
 components)doc";
 
+static const char *__doc_nanogui_ImageView_pixel_callback_count =
+R"doc(Return the number of times the pixel callback has been invoked so far)doc";
+
 static const char *__doc_nanogui_ImageView_pixel_to_pos = R"doc(Convert a pixel position in the image to a position within the widget)doc";
 
 static const char *__doc_nanogui_ImageView_pos_to_pixel = R"doc(Convert a position within the widget to a pixel position in the image)doc";
@@ -1328,10 +1635,27 @@ static const char *__doc_nanogui_ImageView_set_offset = R"doc(Set the pixel offs
 
 static const char *__doc_nanogui_ImageView_set_pixel_callback =
 R"doc(Set the callback that is used to acquire information about pixel
-components)doc";
+components
+
+The callback writes up to four strings (one per component, each with
+the given maximum length) for the given pixel. Results are cached, so
+that each pixel is only queried once while it remains visible.)doc";
 
 static const char *__doc_nanogui_ImageView_set_scale = R"doc(Set the current magnification of the image)doc";
 
+static const char *__doc_nanogui_ImageView_set_tile_source =
+R"doc(Display a tiled multi-resolution image instead of a texture
+
+Parameter ``source``:
+    Source of the image tiles
+
+Parameter ``cache_capacity``:
+    Number of tiles that can be resident on the GPU at once)doc";
+
+static const char *__doc_nanogui_ImageView_tile_cache = R"doc(Return the tile cache of the tiled image (if any))doc";
+
+static const char *__doc_nanogui_ImageView_tile_source = R"doc(Return the source of the tiled image (if any))doc";
+
 static const char *__doc_nanogui_IntBox =
 R"doc(\class IntBox textbox.h nanogui/textbox.h
 
@@ -1518,6 +1842,69 @@ static const char *__doc_nanogui_Orientation_Horizontal = R"doc(< Layout expands
 
 static const char *__doc_nanogui_Orientation_Vertical = R"doc(< Layout expands on vertical axis.)doc";
 
+static const char *__doc_nanogui_Plot =
+R"doc(\class Plot plot.h nanogui/plot.h
+
+GPU-accelerated line plot for large time series
+
+In contrast to Graph, which tessellates its polyline using NanoVG in
+every frame, this widget keeps the samples of each data series in GPU
+vertex buffers. Appending samples only uploads the new vertices, and
+lines are expanded into anti-aliased strips of the requested thickness
+by a dedicated vertex shader. Panning and zooming merely change a
+uniform.
+
+The visible region is specified in data coordinates using set_view().
+The mouse can be used to pan (dragging) and zoom (scrolling).
+
+Samples are stored in single precision. Large offsets (e.g. absolute
+timestamps) should therefore be subtracted before calling append().)doc";
+
+static const char *__doc_nanogui_Plot_Plot = R"doc(Create an empty plot)doc";
+
+static const char *__doc_nanogui_Plot_add_series = R"doc(Add a data series and return its index)doc";
+
+static const char *__doc_nanogui_Plot_append =
+R"doc(Append samples to a data series
+
+The samples are uploaded to the GPU when the plot is drawn next. Only
+the vertices of new samples (and of the previous last sample, whose
+line join changes) are transferred.)doc";
+
+static const char *__doc_nanogui_Plot_append_2 = R"doc(Append a single sample to a data series)doc";
+
+static const char *__doc_nanogui_Plot_clear = R"doc(Remove all samples of a data series)doc";
+
+static const char *__doc_nanogui_Plot_draw_contents = R"doc()doc";
+
+static const char *__doc_nanogui_Plot_fit_view = R"doc(Adjust the visible region so that all samples are shown)doc";
+
+static const char *__doc_nanogui_Plot_mouse_drag_event = R"doc()doc";
+
+static const char *__doc_nanogui_Plot_sample_count = R"doc(Return the number of samples of a data series)doc";
+
+static const char *__doc_nanogui_Plot_scroll_event = R"doc()doc";
+
+static const char *__doc_nanogui_Plot_series_color = R"doc(Return the color of a data series)doc";
+
+static const char *__doc_nanogui_Plot_series_count = R"doc(Return the number of data series)doc";
+
+static const char *__doc_nanogui_Plot_series_thickness = R"doc(Return the line thickness of a data series (in pixels))doc";
+
+static const char *__doc_nanogui_Plot_set_series_color = R"doc(Set the color of a data series)doc";
+
+static const char *__doc_nanogui_Plot_set_series_thickness = R"doc(Set the line thickness of a data series (in pixels))doc";
+
+static const char *__doc_nanogui_Plot_set_view = R"doc(Set the visible region (data coordinates))doc";
+
+static const char *__doc_nanogui_Plot_upload_bytes = R"doc(Return the number of bytes uploaded to the GPU so far)doc";
+
+static const char *__doc_nanogui_Plot_view_max =
+R"doc(Return the upper right corner of the visible region (data coordinates))doc";
+
+static const char *__doc_nanogui_Plot_view_min =
+R"doc(Return the lower left corner of the visible region (data coordinates))doc";
+
 static const char *__doc_nanogui_Popup = R"doc()doc";
 
 static const char *__doc_nanogui_Popup_2 =
@@ -1764,7 +2151,14 @@ static const char *__doc_nanogui_RenderPass_m_viewport_offset = R"doc()doc";
 
 static const char *__doc_nanogui_RenderPass_m_viewport_size = R"doc()doc";
 
-static const char *__doc_nanogui_RenderPass_resize = R"doc(Resize all texture targets attached to the render pass)doc";
+static const char *__doc_nanogui_RenderPass_resize =
+R"doc(Resize all texture targets attached to the render pass
+
+Also resets the viewport to cover the requested size (see
+set_resize_slack()).)doc";
+
+static const char *__doc_nanogui_RenderPass_resize_slack =
+R"doc(Are texture targets allowed to be larger than the rendered region?)doc";
 
 static const char *__doc_nanogui_RenderPass_set_clear_color = R"doc(Set the clear color for a given color attachment)doc";
 
@@ -1776,8 +2170,29 @@ static const char *__doc_nanogui_RenderPass_set_cull_mode = R"doc(Specify the cu
 
 static const char *__doc_nanogui_RenderPass_set_depth_test = R"doc(Specify the depth test and depth write mask of this render pass)doc";
 
+static const char *__doc_nanogui_RenderPass_set_resize_slack =
+R"doc(Allow texture targets to be larger than the rendered region
+
+Reallocating render targets on every frame of a window resize or
+layout animation is expensive. When this option is enabled, resize()
+rounds the size of texture targets up using slack_size() and keeps
+them as long as the requested size fits without wasting too much
+memory. Rendering is then restricted to a viewport within the targets,
+located at the origin of the texture coordinate system of the backend
+(bottom left for OpenGL, top left for Metal). viewport() reports this
+region, and blit_to() calls with a source offset of zero copy it.
+
+Disabled by default, since shaders sampling the targets would
+otherwise need to account for the unused border.)doc";
+
 static const char *__doc_nanogui_RenderPass_set_viewport = R"doc(Set the pixel offset and size of the viewport region)doc";
 
+static const char *__doc_nanogui_RenderPass_slack_size =
+R"doc(Round a render target size up to a coarse bucket
+
+Each dimension is rounded up to a multiple of 1/8 of the next power of
+two (at least 64 pixels), which bounds the unused area to roughly 25%.)doc";
+
 static const char *__doc_nanogui_RenderPass_targets =
 R"doc(Return the set of all render targets (including depth + stencil)
 associated with this render pass)doc";
@@ -1922,6 +2337,14 @@ static const char *__doc_nanogui_Screen_has_float_buffer = R"doc(Does the frameb
 
 static const char *__doc_nanogui_Screen_has_stencil_buffer = R"doc(Does the framebuffer have a stencil buffer)doc";
 
+static const char *__doc_nanogui_Screen_icon_atlas =
+R"doc(Return the atlas storing the image icons of this screen
+
+Icons created using nvgAtlasIcon() are packed into the pages of this
+atlas, so that consecutive icons can be drawn without switching
+textures. They are referenced by negative icon identifiers (see
+nvg_image_icon_pattern()).)doc";
+
 static const char *__doc_nanogui_Screen_initialize = R"doc(Initialize the Screen)doc";
 
 static const char *__doc_nanogui_Screen_key_callback_event = R"doc()doc";
@@ -1994,8 +2417,14 @@ static const char *__doc_nanogui_Screen_move_window_to_front = R"doc()doc";
 
 static const char *__doc_nanogui_Screen_nvg_context = R"doc(Return a pointer to the underlying NanoVG draw context)doc";
 
+static const char *__doc_nanogui_Screen_nvg_draw_call_count =
+R"doc(Return the number of NanoVG draw calls (fills, strokes, and text) of the last frame)doc";
+
 static const char *__doc_nanogui_Screen_nvg_flush = R"doc(Flush all queued up NanoVG rendering commands)doc";
 
+static const char *__doc_nanogui_Screen_nvg_image_switch_count =
+R"doc(Return how often NanoVG switched between images during the last frame)doc";
+
 static const char *__doc_nanogui_Screen_perform_layout = R"doc(Compute the layout of all widgets)doc";
 
 static const char *__doc_nanogui_Screen_pixel_format = R"doc(Return the pixel format underlying the screen)doc";
@@ -2006,7 +2435,9 @@ Mac Retina displays))doc";
 
 static const char *__doc_nanogui_Screen_redraw =
 R"doc(Send an event that will cause the screen to be redrawn at the next
-event loop iteration)doc";
+event loop iteration
+
+This function may be called from any thread.)doc";
 
 static const char *__doc_nanogui_Screen_resize_callback = R"doc(Set the resize callback)doc";
 
@@ -2030,10 +2461,35 @@ static const char *__doc_nanogui_Screen_set_visible = R"doc(Set the top-level wi
 
 static const char *__doc_nanogui_Screen_shutdown_glfw = R"doc()doc";
 
+static const char *__doc_nanogui_Screen_text_metrics_cache =
+R"doc(Return the text measurement cache shared by all widgets of this screen
+
+Measuring text only memoizes results, hence the cache is also
+available from a const screen.)doc";
+
 static const char *__doc_nanogui_Screen_tooltip_fade_in_progress = R"doc(Is a tooltip currently fading in?)doc";
 
 static const char *__doc_nanogui_Screen_update_focus = R"doc()doc";
 
+static const char *__doc_nanogui_Screen_warm_up_glyphs =
+R"doc(Pre-rasterize glyphs into NanoVG's font atlas
+
+NanoVG rasterizes glyphs lazily the first time they are drawn, which
+causes a stall when many new glyphs appear at once (e.g. the first
+frame of a screen, or a window full of icons). This function declares
+a set of glyphs that will be drawn using the given font and size. They
+are rasterized at the beginning of the next frame, and again whenever
+the pixel ratio changes (which requires new atlas entries).
+
+Parameter ``font``:
+    Name of a font known to NanoVG (e.g. ``"sans"`` or ``"icons"``)
+
+Parameter ``font_size``:
+    Font size at which the glyphs will be drawn
+
+Parameter ``glyphs``:
+    UTF-8 encoded string containing the glyphs)doc";
+
 static const char *__doc_nanogui_Serializer = R"doc()doc";
 
 static const char *__doc_nanogui_Shader = R"doc()doc";
@@ -2058,6 +2514,8 @@ static const char *__doc_nanogui_Shader_BufferType_FragmentTexture = R"doc()doc"
 
 static const char *__doc_nanogui_Shader_BufferType_IndexBuffer = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_BufferType_UniformBlock = R"doc()doc";
+
 static const char *__doc_nanogui_Shader_BufferType_UniformBuffer = R"doc()doc";
 
 static const char *__doc_nanogui_Shader_BufferType_Unknown = R"doc()doc";
@@ -2068,24 +2526,74 @@ static const char *__doc_nanogui_Shader_BufferType_VertexSampler = R"doc()doc";
 
 static const char *__doc_nanogui_Shader_BufferType_VertexTexture = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_BufferUsage =
+R"doc(Hint describing how often the contents of a vertex or index buffer
+change (see set_buffer_usage()))doc";
+
+static const char *__doc_nanogui_Shader_BufferUsage_Dynamic =
+R"doc(Modified occasionally, e.g. using update_buffer_range() (default))doc";
+
+static const char *__doc_nanogui_Shader_BufferUsage_Static = R"doc(Uploaded once and drawn many times)doc";
+
+static const char *__doc_nanogui_Shader_BufferUsage_Stream = R"doc(Replaced using set_buffer() every frame or more often)doc";
+
+static const char *__doc_nanogui_Shader_Buffer_block = R"doc(Uniform buffer range associated with a uniform block)doc";
+
+static const char *__doc_nanogui_Shader_Buffer_block_size = R"doc()doc";
+
 static const char *__doc_nanogui_Shader_Buffer_buffer = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_Buffer_components = R"doc()doc";
+
 static const char *__doc_nanogui_Shader_Buffer_dirty = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_Buffer_divisor = R"doc()doc";
+
 static const char *__doc_nanogui_Shader_Buffer_dtype = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_Buffer_gl_type =
+R"doc(Component type passed to glVertexAttribPointer() (vertex buffers))doc";
+
 static const char *__doc_nanogui_Shader_Buffer_index = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_Buffer_name = R"doc()doc";
+
 static const char *__doc_nanogui_Shader_Buffer_ndim = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_Buffer_normalized = R"doc()doc";
+
+static const char *__doc_nanogui_Shader_Buffer_offset = R"doc()doc";
+
 static const char *__doc_nanogui_Shader_Buffer_shape = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_Buffer_shared =
+R"doc(Is the storage owned by another attribute of the same interleaved buffer?)doc";
+
 static const char *__doc_nanogui_Shader_Buffer_size = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_Buffer_stream_fences =
+R"doc(Fences signaled once the GPU is done with each ring segment (streaming buffers))doc";
+
+static const char *__doc_nanogui_Shader_Buffer_stream_offset =
+R"doc(Byte offset of the ring segment holding the current contents (streaming buffers))doc";
+
+static const char *__doc_nanogui_Shader_Buffer_stream_segment_size = R"doc(Size of each ring segment in bytes (streaming buffers))doc";
+
+static const char *__doc_nanogui_Shader_Buffer_stride =
+R"doc(Layout of vertex attributes (a stride of 0 means tightly packed))doc";
+
+static const char *__doc_nanogui_Shader_Buffer_texture_unit = R"doc(Texture unit assigned at link time (textures))doc";
+
 static const char *__doc_nanogui_Shader_Buffer_to_string = R"doc()doc";
 
 static const char *__doc_nanogui_Shader_Buffer_type = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_Buffer_uniform_setter = R"doc(glUniform*() call matching the dtype and shape (uniforms))doc";
+
+static const char *__doc_nanogui_Shader_Buffer_usage = R"doc()doc";
+
+static const char *__doc_nanogui_Shader_Buffer_vertex_offset = R"doc()doc";
+
 static const char *__doc_nanogui_Shader_PrimitiveType = R"doc(The type of geometry that should be rendered)doc";
 
 static const char *__doc_nanogui_Shader_PrimitiveType_Line = R"doc()doc";
@@ -2114,6 +2622,34 @@ Parameter ``vertex_shader``:
 Parameter ``fragment_shader``:
     The source of the fragment shader as a string.)doc";
 
+static const char *__doc_nanogui_Shader_VertexAttribute =
+R"doc(Location of a vertex attribute within an interleaved vertex buffer)doc";
+
+static const char *__doc_nanogui_Shader_VertexAttribute_components = R"doc(Number of components (1-4))doc";
+
+static const char *__doc_nanogui_Shader_VertexAttribute_name = R"doc(Name of the attribute in the vertex shader)doc";
+
+static const char *__doc_nanogui_Shader_VertexAttribute_normalized =
+R"doc(Map integer components to [0, 1] (unsigned) or [-1, 1] (signed))doc";
+
+static const char *__doc_nanogui_Shader_VertexAttribute_offset =
+R"doc(Byte offset of the attribute relative to the start of a vertex)doc";
+
+static const char *__doc_nanogui_Shader_VertexAttribute_type = R"doc(Type of the components)doc";
+
+static const char *__doc_nanogui_Shader_add_buffer =
+R"doc(Append an entry to the binding table (used by the constructor))doc";
+
+static const char *__doc_nanogui_Shader_argument_handle =
+R"doc(Return a handle that identifies the named shader parameter
+
+Shader parameters are compiled into a flat binding table when the
+shader is linked. The returned handle indexes this table and can be
+passed to the handle-based overloads of set_buffer(), set_uniform(),
+set_texture(), and update_buffer_range() to avoid a string lookup per
+call. Handles remain valid for the lifetime of the shader. Throws an
+exception if no such parameter exists.)doc";
+
 static const char *__doc_nanogui_Shader_begin =
 R"doc(Begin drawing using this shader
 
@@ -2124,8 +2660,26 @@ The Python bindings also include extra ``__enter__`` and ``__exit__``
 aliases so that the shader can be activated via Pythons 'with'
 statement.)doc";
 
+static const char *__doc_nanogui_Shader_binary_cache_directory =
+R"doc(Return the directory of the program binary cache (empty if disabled))doc";
+
+static const char *__doc_nanogui_Shader_binary_cache_hits =
+R"doc(Return the number of shaders that were restored from the program binary cache)doc";
+
+static const char *__doc_nanogui_Shader_binary_cache_misses =
+R"doc(Return the number of shaders that were not found in the program binary cache)doc";
+
 static const char *__doc_nanogui_Shader_blend_mode = R"doc(Return the blending mode of this shader)doc";
 
+static const char *__doc_nanogui_Shader_buffer = R"doc(Look up a binding table entry, validating the handle)doc";
+
+static const char *__doc_nanogui_Shader_buffer_usage = R"doc(Return the usage hint of the named vertex or index buffer)doc";
+
+static const char *__doc_nanogui_Shader_count_binary_cache_access = R"doc(Record a lookup in the program binary cache)doc";
+
+static const char *__doc_nanogui_Shader_detach_buffer =
+R"doc(Give up the storage of a vertex buffer that is part of an interleaved buffer)doc";
+
 static const char *__doc_nanogui_Shader_draw_array =
 R"doc(Render geometry arrays, either directly or using an index array.
 
@@ -2144,11 +2698,31 @@ Parameter ``indexed``:
     Render indexed geometry? In this case, an ``uint32_t`` valued
     buffer with name ``indices`` must have been uploaded using set().)doc";
 
+static const char *__doc_nanogui_Shader_draw_array_instanced =
+R"doc(Render ``instance_count`` instances of the geometry using a single
+draw call
+
+The parameters match those of draw_array(). Vertex attributes with a
+nonzero divisor (see set_instance_divisor()) advance once per instance
+instead of once per vertex. Requires OpenGL 3.3, OpenGL ES 3, or Metal.)doc";
+
 static const char *__doc_nanogui_Shader_end = R"doc(End drawing using this shader)doc";
 
+static const char *__doc_nanogui_Shader_instance_divisor = R"doc(Return the instance divisor of the named vertex attribute)doc";
+
+static const char *__doc_nanogui_Shader_interleaved_handles =
+R"doc(Validate an interleaved vertex layout and return the handle of each
+attribute (or (size_t) -1 if the shader lacks it))doc";
+
+static const char *__doc_nanogui_Shader_link_program = R"doc(Compile and link the program, then reflect its parameters)doc";
+
+static const char *__doc_nanogui_Shader_load_program_binary = R"doc(Restore the program and its parameters from the binary cache)doc";
+
 static const char *__doc_nanogui_Shader_m_blend_mode = R"doc()doc";
 
-static const char *__doc_nanogui_Shader_m_buffers = R"doc()doc";
+static const char *__doc_nanogui_Shader_m_buffer_handles = R"doc(Maps parameter names to handles)doc";
+
+static const char *__doc_nanogui_Shader_m_buffers = R"doc(Binding table with one entry per shader parameter, addressed by handle)doc";
 
 static const char *__doc_nanogui_Shader_m_name = R"doc()doc";
 
@@ -2162,6 +2736,22 @@ static const char *__doc_nanogui_Shader_pipeline_state = R"doc()doc";
 
 static const char *__doc_nanogui_Shader_render_pass = R"doc(Return the render pass associated with this shader)doc";
 
+static const char *__doc_nanogui_Shader_set_binary_cache_directory =
+R"doc(Set a directory that caches linked shader programs across runs
+
+When set, the OpenGL backend stores the binary of every linked program
+(obtained via ``glGetProgramBinary``) along with the reflected
+attributes, uniforms, and uniform blocks in this directory. Subsequent
+shaders with identical source code are restored from the cache instead
+of being compiled and linked. Entries are keyed by the source code and
+the driver vendor, renderer, and version string. The shader is
+compiled from source if an entry does not match or is rejected by the
+driver, and the entry is then replaced.
+
+The cache is disabled by default (empty string). The directory must
+exist. This setting has no effect on Metal and on drivers that do not
+support program binaries (OpenGL < 4.1, OpenGL ES 2).)doc";
+
 static const char *__doc_nanogui_Shader_set_buffer =
 R"doc(Upload a buffer (e.g. vertex positions) that will be associated with a
 named shader parameter.
@@ -2175,15 +2765,137 @@ The buffer will be replaced if it is already present.)doc";
 
 static const char *__doc_nanogui_Shader_set_buffer_2 = R"doc()doc";
 
+static const char *__doc_nanogui_Shader_set_buffer_3 =
+R"doc(Upload a buffer to the shader parameter with the given handle)doc";
+
+static const char *__doc_nanogui_Shader_set_buffer_4 = R"doc()doc";
+
+static const char *__doc_nanogui_Shader_set_buffer_usage =
+R"doc(Specify how the named vertex or index buffer will be updated
+
+- BufferUsage::Static and BufferUsage::Dynamic buffers are stored in a
+  single allocation. update_buffer_range() only transfers the modified
+  bytes, but may wait for pending draw calls that read the buffer. On
+  OpenGL, the hint is passed to glBufferData(). On Metal, both are
+  kept in GPU-private memory.
+
+- BufferUsage::Stream buffers are meant to be replaced in full using
+  set_buffer(). On OpenGL 3 and OpenGL ES 3, each upload is written into
+  the next segment of a ring of stream_ring_size segments without
+  synchronizing with the GPU. A fence guards every segment, hence
+  uploads only block when the GPU falls more than two uploads behind. On
+  OpenGL ES 2, the driver orphans the previous storage. On Metal, every
+  upload allocates a new shared buffer, while buffers referenced by
+  pending command buffers are kept alive by Metal. update_buffer_range()
+  remains supported for streaming buffers, but is not faster than for
+  dynamic ones.
+
+The usage takes effect at the next call to set_buffer().)doc";
+
+static const char *__doc_nanogui_Shader_set_buffer_usage_2 = R"doc(Specify how the buffer with the given handle will be updated)doc";
+
+static const char *__doc_nanogui_Shader_set_instance_divisor =
+R"doc(Turn the named vertex attribute into a per-instance attribute
+
+The attribute advances by one entry every ``divisor`` instances when
+rendering with draw_array_instanced(). The default value ``0``
+advances it once per vertex. The shape of the buffer uploaded via
+set_buffer() is then ``(instances / divisor, components)``.
+
+On Metal, vertex functions access their buffers explicitly, hence the
+divisor is only recorded and per-instance data must be indexed using
+the ``[[instance_id]]`` attribute. OpenGL ES 2 only supports a
+divisor of zero.)doc";
+
+static const char *__doc_nanogui_Shader_set_instance_divisor_2 =
+R"doc(Set the instance divisor of the vertex attribute with the given handle)doc";
+
+static const char *__doc_nanogui_Shader_set_interleaved_buffer =
+R"doc(Upload a vertex buffer whose entries contain several attributes
+
+The buffer holds count vertices of stride bytes each, and is
+stored once on the GPU and shared by all attributes in attributes.
+Integer components with VertexAttribute::normalized set are converted
+to floating point values in [0, 1] or [-1, 1], which allows e.g.
+storing colors as four UInt8 values or normals as three Int16
+values.
+
+Attributes that the shader does not declare (or that were optimized
+away by the compiler) are skipped, so that a mesh layout can be used
+with different shaders. Calling set_buffer() for one of the attributes
+later on gives it separate storage again, and update_buffer_range()
+overwrites entire interleaved vertices.
+
+On Metal, vertex functions read the buffer through an argument named
+after one of the attributes, declared as a pointer to a struct that
+matches the layout. Normalization is then performed by the shader.)doc";
+
 static const char *__doc_nanogui_Shader_set_texture =
 R"doc(Associate a texture with a named shader parameter
 
 The association will be replaced if it is already present.)doc";
 
+static const char *__doc_nanogui_Shader_set_texture_2 =
+R"doc(Associate a texture with the shader parameter with the given handle)doc";
+
 static const char *__doc_nanogui_Shader_set_uniform =
 R"doc(Upload a uniform variable (e.g. a vector or matrix) that will be
 associated with a named shader parameter.)doc";
 
+static const char *__doc_nanogui_Shader_set_uniform_2 =
+R"doc(Upload a uniform variable to the shader parameter with the given handle)doc";
+
+static const char *__doc_nanogui_Shader_set_uniform_buffer =
+R"doc(Associate a range of a uniform buffer with a named uniform block
+
+On OpenGL, uniform blocks (e.g. <tt>layout(std140) uniform Camera {
+... };</tt>) are discovered when the shader is linked and referenced by
+their block name. On Metal, any buffer argument can be associated with
+a uniform buffer. ``offset`` must be a multiple of
+UniformBuffer::offset_alignment(), and the buffer must hold the
+complete block starting at this offset.
+
+The binding is re-issued by begin(), hence the same buffer can be
+shared by any number of shaders. Per-draw data can be appended using
+UniformBuffer::push(), followed by a call to this function with the
+returned offset.)doc";
+
+static const char *__doc_nanogui_Shader_set_uniform_buffer_2 = R"doc(Associate a range of a uniform buffer with the given handle)doc";
+
+static const char *__doc_nanogui_Shader_store_program_binary =
+R"doc(Store the program and its parameters in the binary cache)doc";
+
+static const char *__doc_nanogui_Shader_stream_buffer =
+R"doc(Write the contents of a streaming buffer into the next segment of its ring)doc";
+
+static const char *__doc_nanogui_Shader_stream_ring_size = R"doc(Number of segments of the ring used by streaming buffers)doc";
+
+static const char *__doc_nanogui_Shader_uniform_block_size =
+R"doc(Return the size of a uniform block in bytes (as reported by the shader compiler))doc";
+
+static const char *__doc_nanogui_Shader_update_buffer_range =
+R"doc(Overwrite part of a vertex or index buffer that was previously
+uploaded using set_buffer().
+
+``offset`` and ``count`` refer to entries along the first dimension
+(e.g. vertices), and ``data`` must contain ``count`` entries with the
+type and shape that were specified when the buffer was uploaded. Only
+the modified bytes are transferred to the GPU.)doc";
+
+static const char *__doc_nanogui_Shader_update_buffer_range_2 = R"doc(Overwrite part of the buffer with the given handle)doc";
+
+static const char *__doc_nanogui_Shader_update_buffer_range_3 =
+R"doc(Overwrite part of a buffer, validating the type and shape of the data
+
+shape[0] specifies the number of entries, and the remaining
+dimensions must match those of the uploaded buffer.)doc";
+
+static const char *__doc_nanogui_Shader_update_buffer_range_4 =
+R"doc(Overwrite part of the buffer with the given handle, validating the data)doc";
+
+static const char *__doc_nanogui_Shader_upload_buffer =
+R"doc(Upload the contents of a vertex or index buffer, allocating it if necessary)doc";
+
 static const char *__doc_nanogui_Slider = R"doc()doc";
 
 static const char *__doc_nanogui_Slider_2 =
@@ -2679,8 +3391,162 @@ static const char *__doc_nanogui_TextBox_update_cursor = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_value = R"doc()doc";
 
+static const char *__doc_nanogui_TextMetricsCache =
+R"doc(\class TextMetricsCache textmetrics.h nanogui/textmetrics.h
+
+Least-recently-used cache of text measurements
+
+Computing the extents of a string via ``nvgTextBounds()`` requires a
+glyph lookup for every character. Widgets re-measure the same captions
+during every layout pass and often during every frame, hence each
+Screen owns an instance of this class that memoizes measurements keyed
+by font face, font size, alignment and string contents.
+
+Widgets normally access the cache via Widget::measure_text().)doc";
+
+static const char *__doc_nanogui_TextMetricsCache_TextMetricsCache =
+R"doc(Create an empty cache holding up to ``capacity`` measurements)doc";
+
+static const char *__doc_nanogui_TextMetricsCache_capacity = R"doc(Return the maximum number of cached measurements)doc";
+
+static const char *__doc_nanogui_TextMetricsCache_clear = R"doc(Remove all cached measurements)doc";
+
+static const char *__doc_nanogui_TextMetricsCache_hit_rate = R"doc(Return the fraction of lookups answered from the cache)doc";
+
+static const char *__doc_nanogui_TextMetricsCache_hits =
+R"doc(Return the number of lookups that were answered from the cache)doc";
+
+static const char *__doc_nanogui_TextMetricsCache_misses =
+R"doc(Return the number of lookups that required measuring the string)doc";
+
+static const char *__doc_nanogui_TextMetricsCache_reset_statistics = R"doc(Reset the hit/miss counters)doc";
+
+static const char *__doc_nanogui_TextMetricsCache_set_capacity =
+R"doc(Set the maximum number of cached measurements (evicts as needed))doc";
+
+static const char *__doc_nanogui_TextMetricsCache_size = R"doc(Return the number of cached measurements)doc";
+
 static const char *__doc_nanogui_Texture = R"doc()doc";
 
+static const char *__doc_nanogui_TextureAtlas =
+R"doc(\class TextureAtlas textureatlas.h nanogui/textureatlas.h
+
+\brief Dynamic texture atlas for icons and other small images
+
+Every NanoVG image is a separate texture, and NanoVG must switch
+textures whenever consecutive draw calls reference different images.
+This class packs many small RGBA images into a few large pages (see
+nvg_texture_image()), which are referenced by sub-rectangles.
+
+Each page is filled by a skyline packer (the same strategy that
+NanoVG's font atlas uses). New pages are allocated when the existing
+ones are full. If a page limit is set and eviction is enabled, the
+least recently used page is cleared instead, which invalidates the
+identifiers of the images it contained.)doc";
+
+static const char *__doc_nanogui_TextureAtlas_Entry = R"doc(Location of an image within the atlas)doc";
+
+static const char *__doc_nanogui_TextureAtlas_Entry_image = R"doc(NanoVG image of the page containing the entry)doc";
+
+static const char *__doc_nanogui_TextureAtlas_Entry_origin = R"doc(Position of the entry within the page in pixels)doc";
+
+static const char *__doc_nanogui_TextureAtlas_Entry_page = R"doc(Index of the page containing the entry)doc";
+
+static const char *__doc_nanogui_TextureAtlas_Entry_size = R"doc(Size of the entry in pixels)doc";
+
+static const char *__doc_nanogui_TextureAtlas_TextureAtlas =
+R"doc(Create an empty texture atlas
+
+Parameter ``page_size``:
+    Size of an atlas page in pixels
+
+Parameter ``max_pages``:
+    Maximum number of pages (0: unlimited)
+
+Parameter ``padding``:
+    Border around every entry that replicates its edge pixels, which
+    prevents neighboring entries from bleeding into each other when
+    they are drawn using bilinear interpolation)doc";
+
+static const char *__doc_nanogui_TextureAtlas_add =
+R"doc(Add an RGBA image (8 bits per component) to the atlas
+
+Returns an identifier for lookup(), or ``-1`` if the atlas is full and
+eviction is disabled. Throws an exception if the image is larger than
+a page.)doc";
+
+static const char *__doc_nanogui_TextureAtlas_entry_count = R"doc(Return the number of images stored in the atlas)doc";
+
+static const char *__doc_nanogui_TextureAtlas_eviction =
+R"doc(Should the least recently used page be cleared when all pages are full?)doc";
+
+static const char *__doc_nanogui_TextureAtlas_eviction_count =
+R"doc(Return the number of pages that were cleared to make room for new images)doc";
+
+static const char *__doc_nanogui_TextureAtlas_lookup =
+R"doc(Look up an image and mark its page as recently used
+
+Returns ``false`` if the identifier is unknown or the image was
+evicted.)doc";
+
+static const char *__doc_nanogui_TextureAtlas_max_pages = R"doc(Return the maximum number of pages (0: unlimited))doc";
+
+static const char *__doc_nanogui_TextureAtlas_page_count = R"doc(Return the number of allocated pages)doc";
+
+static const char *__doc_nanogui_TextureAtlas_page_size = R"doc(Return the size of an atlas page in pixels)doc";
+
+static const char *__doc_nanogui_TextureAtlas_page_texture = R"doc(Return the texture of a page)doc";
+
+static const char *__doc_nanogui_TextureAtlas_pattern =
+R"doc(Create a NanoVG paint that maps an entry onto the rectangle (x, y, w, h))doc";
+
+static const char *__doc_nanogui_TextureAtlas_remove =
+R"doc(Remove an image (its space is reclaimed when the page is cleared))doc";
+
+static const char *__doc_nanogui_TextureAtlas_set_eviction =
+R"doc(Specify whether the least recently used page should be cleared when all pages are full)doc";
+
+static const char *__doc_nanogui_TextureTransfer =
+R"doc(\class TextureTransfer texture.h nanogui/texture.h
+
+Handle to an asynchronous transfer between CPU and GPU memory
+
+Returned by Texture::begin_upload(), Texture::upload_async(), and
+Texture::download_async(). The pixel data is staged in a buffer that
+the GPU reads from or writes to (a pixel buffer object on OpenGL and
+OpenGL ES 3, a shared buffer on Metal), and ready() reports when the
+GPU has finished the copy.
+
+The staging memory returned by data() may be filled from any thread,
+but all other functions must be called from the thread that owns the
+graphics context.)doc";
+
+static const char *__doc_nanogui_TextureTransfer_State = R"doc()doc";
+
+static const char *__doc_nanogui_TextureTransfer_State_Idle = R"doc(No transfer in progress, the staging buffer can be reused)doc";
+
+static const char *__doc_nanogui_TextureTransfer_State_Mapped = R"doc(Staging memory is being filled by the caller)doc";
+
+static const char *__doc_nanogui_TextureTransfer_State_Pending = R"doc(Submitted to the GPU)doc";
+
+static const char *__doc_nanogui_TextureTransfer_TextureTransfer = R"doc()doc";
+
+static const char *__doc_nanogui_TextureTransfer_data =
+R"doc(Return the staging memory (only valid until the transfer is submitted))doc";
+
+static const char *__doc_nanogui_TextureTransfer_is_download = R"doc(Return whether this transfer reads back from the texture)doc";
+
+static const char *__doc_nanogui_TextureTransfer_ready =
+R"doc(Return whether the GPU has finished the transfer (doesn't block))doc";
+
+static const char *__doc_nanogui_TextureTransfer_region_origin = R"doc(Return the origin of the texture region)doc";
+
+static const char *__doc_nanogui_TextureTransfer_region_size = R"doc(Return the size of the texture region)doc";
+
+static const char *__doc_nanogui_TextureTransfer_size = R"doc(Return the size of the staging memory in bytes)doc";
+
+static const char *__doc_nanogui_TextureTransfer_wait = R"doc(Block until the GPU has finished the transfer)doc";
+
 static const char *__doc_nanogui_Texture_2 = R"doc()doc";
 
 static const char *__doc_nanogui_Texture_3 = R"doc()doc";
@@ -2755,14 +3621,50 @@ static const char *__doc_nanogui_Texture_WrapMode_MirrorRepeat = R"doc(Repeat, b
 
 static const char *__doc_nanogui_Texture_WrapMode_Repeat = R"doc(Repeat the texture)doc";
 
+static const char *__doc_nanogui_Texture_allocation_count =
+R"doc(Return the number of times that texture storage was allocated
+
+This counter is shared by all textures and increases whenever storage
+is (re-)specified, e.g. on construction, resize(), or a full upload()
+in the OpenGL backend. Sampling it periodically reveals reallocations
+caused by resizing render targets.)doc";
+
+static const char *__doc_nanogui_Texture_begin_upload =
+R"doc(Begin an asynchronous upload to a rectangular sub-region of the
+texture
+
+Returns a handle whose staging memory (TextureTransfer::data()) must
+be filled with packed pixel data, possibly from a worker thread,
+before calling submit_upload(). Staging buffers are recycled from a
+ring of transfer_ring_size entries, so that a frame can be filled while
+the GPU is still copying the previous ones. This function only blocks
+when all buffers of the ring are still in use by the GPU.)doc";
+
 static const char *__doc_nanogui_Texture_bytes_per_pixel = R"doc(Return the number of bytes consumed per pixel of this texture)doc";
 
 static const char *__doc_nanogui_Texture_channels = R"doc(Return the number of channels of this texture)doc";
 
 static const char *__doc_nanogui_Texture_component_format = R"doc(Return the component format)doc";
 
+static const char *__doc_nanogui_Texture_count_allocation = R"doc(Increase the counter returned by allocation_count())doc";
+
 static const char *__doc_nanogui_Texture_download = R"doc(Download packed pixel data from the GPU to the CPU)doc";
 
+static const char *__doc_nanogui_Texture_download_async =
+R"doc(Start downloading the texture without waiting for the GPU
+
+Copies the texture into a staging buffer on the GPU timeline, which
+avoids the pipeline stall of download(). Poll TextureTransfer::ready()
+on later frames, and retrieve the pixels using finish_download() once
+it returns True. Staging buffers are recycled after
+transfer_ring_size further downloads.)doc";
+
+static const char *__doc_nanogui_Texture_finish_download =
+R"doc(Copy the result of download_async() to packed CPU memory
+
+Blocks if the transfer hasn't completed yet. Rows of render targets are
+flipped as in download().)doc";
+
 static const char *__doc_nanogui_Texture_flags = R"doc(Return a combination of flags (from Texture::TextureFlags))doc";
 
 static const char *__doc_nanogui_Texture_init = R"doc(Initialize the texture handle)doc";
@@ -2789,8 +3691,13 @@ static const char *__doc_nanogui_Texture_m_wrap_mode = R"doc()doc";
 
 static const char *__doc_nanogui_Texture_mag_interpolation_mode = R"doc(Return the interpolation mode for minimization)doc";
 
+static const char *__doc_nanogui_Texture_map_upload = R"doc(Provide staging memory of the given size for an upload)doc";
+
 static const char *__doc_nanogui_Texture_min_interpolation_mode = R"doc(Return the interpolation mode for minimization)doc";
 
+static const char *__doc_nanogui_Texture_next_transfer =
+R"doc(Return the next staging buffer of a ring, waiting for the GPU if necessary)doc";
+
 static const char *__doc_nanogui_Texture_pixel_format = R"doc(Return the pixel format)doc";
 
 static const char *__doc_nanogui_Texture_resize = R"doc(Resize the texture (discards the current contents))doc";
@@ -2801,11 +3708,60 @@ static const char *__doc_nanogui_Texture_samples = R"doc(Return the number of sa
 
 static const char *__doc_nanogui_Texture_size = R"doc(Return the size of this texture)doc";
 
+static const char *__doc_nanogui_Texture_source_region =
+R"doc(Validate the stride of a source image and return the address of the region within it)doc";
+
+static const char *__doc_nanogui_Texture_submit_upload =
+R"doc(Issue the transfer of an upload started with begin_upload()
+
+Returns immediately. The texture contents are updated before any
+subsequent draw call that reads from the texture executes on the GPU.)doc";
+
 static const char *__doc_nanogui_Texture_texture_handle = R"doc()doc";
 
 static const char *__doc_nanogui_Texture_upload = R"doc(Upload packed pixel data from the CPU to the GPU)doc";
 
-static const char *__doc_nanogui_Texture_upload_origin = R"doc(Upload packed pixel data to a rectangular sub-region of the texture from the CPU to the GPU)doc";
+static const char *__doc_nanogui_Texture_upload_2 =
+R"doc(Convert packed pixel data to the format of the texture and upload it
+from the CPU to the GPU
+
+The data is converted using convert_pixels() (e.g. to swizzle BGR
+data, pad RGB data with an alpha channel, or convert single to half
+precision), which is skipped when the formats already match.
+
+Parameter ``srgb``:
+    Encode the color channels using the sRGB transfer function)doc";
+
+static const char *__doc_nanogui_Texture_upload_async =
+R"doc(Upload packed pixel data to a sub-region of the texture without
+waiting for the transfer to complete
+
+Copies the data into a staging buffer and then behaves like
+submit_upload(). The parameters match those of upload_sub_region().)doc";
+
+static const char *__doc_nanogui_Texture_upload_origin =
+R"doc(Upload pixel data to a rectangular sub-region of the texture from the
+CPU to the GPU
+
+Parameter ``data``:
+    Pointer to the source image
+
+Parameter ``origin``:
+    Position of the region within the texture
+
+Parameter ``size``:
+    Size of the region
+
+Parameter ``row_stride``:
+    Distance between consecutive rows of the source image in bytes
+    (must be a multiple of bytes_per_pixel()). The default value of
+    zero refers to packed rows of ``size.x()`` pixels.
+
+Parameter ``source_origin``:
+    Position of the region within the source image. Together with
+    ``row_stride``, this allows uploading a rectangle of a larger image
+    (e.g. the dirty region of a CPU framebuffer) without copying it to
+    a temporary buffer first.)doc";
 
 static const char *__doc_nanogui_Texture_generate_mipmap = R"doc(Generates the mipmap. Done automatically upon upload if manual mipmapping is disabled)doc";
 
@@ -3017,6 +3973,203 @@ static const char *__doc_nanogui_Theme_m_window_title_unfocused =
 R"doc(The title color for a Window that is not in focus (default:
 intensity=``220``, alpha=``160``; see nanogui::Color::Color(int,int)).)doc";
 
+static const char *__doc_nanogui_ThumbnailCache =
+R"doc(\class ThumbnailCache thumbnailcache.h nanogui/thumbnailcache.h
+
+\brief Cache of square image thumbnails stored in atlas textures
+
+Thumbnails are generated by a pool of worker threads, which decode the
+image file, crop it to a centered square and reduce it to resolution()
+pixels using a box filter. Finished thumbnails are uploaded by
+begin_frame() into the slots of atlas pages (square RGBA textures that
+are also exposed as NanoVG images), so that GPU memory grows with the
+number of thumbnails rather than with the resolution of the images.
+Once capacity() thumbnails are resident, the least recently used ones
+are replaced. As in TileCache, requests that were not repeated in the
+previous frame are discarded.
+
+If a cache directory is specified, generated thumbnails are also
+stored on disk, keyed by a hash of the file contents and the
+resolution. Renamed or copied files thus reuse their thumbnail, while
+modified files receive a new one.)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_ThumbnailCache =
+R"doc(Create a thumbnail cache
+
+Parameter ``resolution``:
+    Width and height of the thumbnails in pixels
+
+Parameter ``capacity``:
+    Maximum number of thumbnails that are resident on the GPU
+
+Parameter ``cache_directory``:
+    Directory storing thumbnails on disk (empty: disable the disk
+    cache). The directory must exist.
+
+Parameter ``threads``:
+    Number of worker threads (0: choose automatically))doc";
+
+static const char *__doc_nanogui_ThumbnailCache_begin_frame =
+R"doc(Start a new frame and upload thumbnails that finished loading
+
+Atlas pages are allocated on demand and registered with the NanoVG
+context ``ctx``. Returns ``true`` if thumbnails are still being
+generated, in which case the caller should schedule another frame.)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_cache_directory = R"doc(Return the directory storing thumbnails on disk)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_capacity =
+R"doc(Return the maximum number of thumbnails that are resident on the GPU)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_clear = R"doc(Discard all resident thumbnails and pending requests)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_disk_hit_count =
+R"doc(Return the number of thumbnails that were found in the disk cache)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_downsample =
+R"doc(Crop an RGBA image to a centered square and reduce it to ``resolution
+* resolution`` pixels using a box filter
+
+Images smaller than the thumbnail are magnified using nearest neighbor
+interpolation.)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_eviction_count = R"doc(Return the number of thumbnails evicted so far)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_load_count = R"doc(Return the number of thumbnails uploaded so far)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_lookup =
+R"doc(Look up the thumbnail of an image file and mark it as recently used
+
+If the thumbnail is resident, returns ``true`` and writes the NanoVG
+image of its atlas page to ``image`` and the position of the
+thumbnail within that page (in pixels) to ``origin``. Otherwise, the
+thumbnail is requested if ``request`` is set.)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_page_count = R"doc(Return the number of allocated atlas pages)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_page_size = R"doc(Return the size of an atlas page in pixels)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_page_texture = R"doc(Return the texture of an atlas page)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_resident_count = R"doc(Return the number of resident thumbnails)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_resolution = R"doc(Return the width and height of the thumbnails in pixels)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_set_callback =
+R"doc(Set a function that is called (from a worker thread) when a thumbnail
+was generated)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_set_capacity =
+R"doc(Set the maximum number of thumbnails that are resident on the GPU
+
+Atlas pages are allocated on demand. Lowering the capacity does not
+release pages that were already allocated.)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_set_upload_limit = R"doc(Set the maximum number of thumbnails uploaded per frame)doc";
+
+static const char *__doc_nanogui_ThumbnailCache_upload_limit = R"doc(Return the maximum number of thumbnails uploaded per frame)doc";
+
+static const char *__doc_nanogui_TileCache =
+R"doc(\class TileCache tiledimage.h nanogui/tiledimage.h
+
+Fixed-size GPU cache of image tiles with LRU eviction
+
+The tiles are stored in the slots of a single RGBA texture. Tiles that
+are requested but not resident are loaded by a pool of worker threads,
+most recent requests first. Requests that were not repeated in the
+previous frame are discarded, so that the workers only process tiles
+that are still visible. Loaded tiles are uploaded by begin_frame() (at
+most upload_limit() per frame to keep zooming interactive), replacing
+the least recently used tiles. Loaded tiles that are no longer
+requested by the time they would be uploaded are discarded as well.
+
+GPU memory is bounded by the cache capacity, and CPU memory by the
+number of tiles that are visible at once (but at most the cache
+capacity).)doc";
+
+static const char *__doc_nanogui_TileCache_TileCache =
+R"doc(Create a tile cache
+
+Parameter ``source``:
+    Source of the tiles
+
+Parameter ``capacity``:
+    Number of tiles that can be resident on the GPU
+
+Parameter ``threads``:
+    Number of worker threads (0: choose automatically))doc";
+
+static const char *__doc_nanogui_TileCache_begin_frame =
+R"doc(Start a new frame and upload tiles that finished loading
+
+Returns True if tiles are still being loaded, in which case the
+caller should schedule another frame.)doc";
+
+static const char *__doc_nanogui_TileCache_eviction_count = R"doc(Return the number of tiles evicted so far)doc";
+
+static const char *__doc_nanogui_TileCache_load_count = R"doc(Return the number of tiles loaded so far)doc";
+
+static const char *__doc_nanogui_TileCache_lookup =
+R"doc(Look up a tile and mark it as recently used
+
+If the tile is resident, returns True and writes the region it
+occupies within texture() (in texture coordinates) to uv_min and
+uv_max. Otherwise, the tile is requested if request is set.)doc";
+
+static const char *__doc_nanogui_TileCache_resident_count = R"doc(Return the number of resident tiles)doc";
+
+static const char *__doc_nanogui_TileCache_set_callback =
+R"doc(Set a function that is called (from a worker thread) when a tile was loaded)doc";
+
+static const char *__doc_nanogui_TileCache_set_upload_limit = R"doc(Set the maximum number of tiles uploaded per frame)doc";
+
+static const char *__doc_nanogui_TileCache_source = R"doc(Return the source of the tiles)doc";
+
+static const char *__doc_nanogui_TileCache_source_2 = R"doc(Return the source of the tiles (const version))doc";
+
+static const char *__doc_nanogui_TileCache_texture = R"doc(Return the texture that stores the resident tiles)doc";
+
+static const char *__doc_nanogui_TileCache_texture_2 =
+R"doc(Return the texture that stores the resident tiles (const version))doc";
+
+static const char *__doc_nanogui_TileCache_upload_limit = R"doc(Return the maximum number of tiles uploaded per frame)doc";
+
+static const char *__doc_nanogui_TileCache_worker = R"doc(Main function of the worker threads)doc";
+
+static const char *__doc_nanogui_TileSource =
+R"doc(\class TileSource tiledimage.h nanogui/tiledimage.h
+
+Interface to images that are too large to be loaded at once
+
+The image is organized as a pyramid of resolution levels. Level 0 has
+the full resolution, and every subsequent level halves the width and
+height (rounding up). Each level is split into square tiles of
+tile_size() pixels, which are loaded on demand by TileCache.)doc";
+
+static const char *__doc_nanogui_TileSource_level_count =
+R"doc(Return the number of resolution levels
+
+The default implementation adds levels until the entire image fits
+into a single tile.)doc";
+
+static const char *__doc_nanogui_TileSource_level_size = R"doc(Return the size of the image at the given resolution level)doc";
+
+static const char *__doc_nanogui_TileSource_load_tile =
+R"doc(Load a tile
+
+Writes tile_size() * tile_size() RGBA pixels (8 bits per
+component) to rgba. Pixels outside of the image may be left
+uninitialized. This function is called from worker threads, possibly
+concurrently, and should return False if the tile could not be
+loaded.)doc";
+
+static const char *__doc_nanogui_TileSource_size = R"doc(Return the size of the image at full resolution)doc";
+
+static const char *__doc_nanogui_TileSource_tile_count =
+R"doc(Return the number of tiles along each axis at the given resolution level)doc";
+
+static const char *__doc_nanogui_TileSource_tile_size = R"doc(Return the width and height of a tile in pixels)doc";
+
 static const char *__doc_nanogui_ToolButton = R"doc()doc";
 
 static const char *__doc_nanogui_ToolButton_2 =
@@ -3026,6 +4179,69 @@ Simple radio+toggle button with an icon.)doc";
 
 static const char *__doc_nanogui_ToolButton_ToolButton = R"doc()doc";
 
+static const char *__doc_nanogui_UniformBuffer =
+R"doc(\class UniformBuffer uniformbuffer.h nanogui/uniformbuffer.h
+
+\brief GPU buffer holding the contents of one or more uniform blocks
+
+A range of the buffer is associated with a uniform block of a shader
+using Shader::set_uniform_buffer(). On OpenGL, uniform blocks must be
+declared with the ``std140`` layout (e.g. <tt>layout(std140) uniform
+Camera { mat4 view; mat4 proj; };</tt>), and the data written to the
+buffer must follow the same layout. Matrix4f, Vector4f and Color match
+it directly, while 3D vectors and scalar arrays are padded to 16 bytes.
+
+Two usage patterns are supported:
+
+- Shared data (e.g. camera matrices) is written once per frame using
+upload() and bound by any number of shaders.
+
+- Per-draw data is appended using push(), which returns the offset of
+a freshly allocated range. When the end of the buffer is reached, the
+storage is orphaned and allocation restarts at the beginning, so that
+ranges referenced by pending draw calls are never overwritten.
+Orphaning discards the previous contents, hence the two patterns
+should use separate buffers.)doc";
+
+static const char *__doc_nanogui_UniformBuffer_UniformBuffer = R"doc(Allocate a uniform buffer with the given size in bytes)doc";
+
+static const char *__doc_nanogui_UniformBuffer_buffer_handle = R"doc()doc";
+
+static const char *__doc_nanogui_UniformBuffer_m_buffer_handle = R"doc()doc";
+
+static const char *__doc_nanogui_UniformBuffer_m_head = R"doc()doc";
+
+static const char *__doc_nanogui_UniformBuffer_m_offset_alignment = R"doc()doc";
+
+static const char *__doc_nanogui_UniformBuffer_m_orphan_count = R"doc()doc";
+
+static const char *__doc_nanogui_UniformBuffer_m_size = R"doc()doc";
+
+static const char *__doc_nanogui_UniformBuffer_offset_alignment =
+R"doc(Return the required alignment of ranges bound to a uniform block
+(e.g. 256 bytes on many GPUs))doc";
+
+static const char *__doc_nanogui_UniformBuffer_orphan =
+R"doc(Replace the storage while pending draw calls keep using the old one)doc";
+
+static const char *__doc_nanogui_UniformBuffer_orphan_count =
+R"doc(Return how many times push() wrapped around and orphaned the storage)doc";
+
+static const char *__doc_nanogui_UniformBuffer_push =
+R"doc(Copy ``size`` bytes into the next free range of the buffer and return
+its offset
+
+The offset is a multiple of offset_alignment(). The data is written
+without synchronizing with the GPU.)doc";
+
+static const char *__doc_nanogui_UniformBuffer_size = R"doc(Return the size of the buffer in bytes)doc";
+
+static const char *__doc_nanogui_UniformBuffer_upload =
+R"doc(Overwrite ``size`` bytes of the buffer starting at ``offset``)doc";
+
+static const char *__doc_nanogui_UniformBuffer_write =
+R"doc(Write data to the buffer, optionally without synchronizing with the GPU)doc";
+
 static const char *__doc_nanogui_VScrollPanel = R"doc()doc";
 
 static const char *__doc_nanogui_VScrollPanel_2 =
@@ -3634,6 +4850,27 @@ static const char *__doc_nanogui_norm = R"doc()doc";
 
 static const char *__doc_nanogui_normalize = R"doc()doc";
 
+static const char *__doc_nanogui_nvg_image_icon_pattern =
+R"doc(Create a NanoVG paint that maps an image icon onto the rectangle (x,
+y, w, h)
+
+Unlike ``nvgImagePattern()``, this function also handles icons stored
+in the icon atlas of a screen.)doc";
+
+static const char *__doc_nanogui_nvg_image_icon_size =
+R"doc(Return the size of an image icon in pixels (NanoVG image or icon
+atlas entry)
+
+Throws an exception if an atlas icon does not belong to the screen
+owning ``ctx``.)doc";
+
+static const char *__doc_nanogui_nvg_is_atlas_icon =
+R"doc(Determine whether an icon ID refers to the icon atlas of a screen
+
+Such icons are created by nvgAtlasIcon and must be drawn using
+nvg_image_icon_pattern(). The value ``-1`` is not used, since several
+widgets use it to indicate that no image is set.)doc";
+
 static const char *__doc_nanogui_nvg_is_font_icon =
 R"doc(Determine whether an icon ID is a font-based icon (e.g. from
 ``entypo.ttf``).
@@ -3662,6 +4899,13 @@ Parameter ``value``:
 Returns:
     Whether or not this is an image icon.)doc";
 
+static const char *__doc_nanogui_nvg_texture_image =
+R"doc(Expose a texture as a NanoVG image
+
+The texture must use the ``RGBA`` pixel format and the ``UInt8``
+component format. NanoVG does not take ownership: the texture must
+outlive all uses of the returned image handle.)doc";
+
 static const char *__doc_nanogui_operator_const_NVGcolor =
 R"doc(Allows for conversion between nanogui::Color and the NanoVG NVGcolor
 class.)doc";
@@ -41,7 +41,9 @@ static VariableType dtype_to_enoki(const py::dtype &dtype) {
     return VariableType::Invalid;
 }
 
-static void shader_set_buffer(Shader &shader, const std::string &name, py::array array) {
+/// Upload a NumPy array to a shader parameter specified by name or handle
+template <typename Key>
+static void shader_set_buffer(Shader &shader, const Key &key, py::array array) {
     if (array.ndim() > 3)
         throw py::type_error("Shader::set_buffer(): tensor rank must be < 3!");
     array = py::array::ensure(array, py::array::c_style);
@@ -57,10 +59,46 @@ static void shader_set_buffer(Shader &shader, const std::string &name, py::array
         array.ndim() > 2 ? (size_t) array.shape(2) : 1
     };
 
-    shader.set_buffer(name, dtype, array.ndim(), dim, array.data());
+    shader.set_buffer(key, dtype, array.ndim(), dim, array.data());
 }
 
-static py::array texture_download(Texture &texture) {
+/// Upload a NumPy array (e.g. a structured array) holding interleaved vertices
+static void shader_set_interleaved_buffer(Shader &shader,
+                                          const std::vector<Shader::VertexAttribute> &attributes,
+                                          py::array array) {
+    if (array.ndim() < 1 || array.shape(0) == 0)
+        throw py::type_error("Shader::set_interleaved_buffer(): array must contain vertices!");
+    array = py::array::ensure(array, py::array::c_style);
+
+    size_t count = (size_t) array.shape(0);
+    shader.set_interleaved_buffer(attributes, (size_t) array.nbytes() / count, count,
+                                  array.data());
+}
+
+/// Overwrite part of a shader buffer with the entries of a NumPy array
+template <typename Key>
+static void shader_update_buffer_range(Shader &shader, const Key &key, size_t offset,
+                                       py::array array) {
+    if (array.ndim() < 1 || array.ndim() > 3)
+        throw py::type_error("Shader::update_buffer_range(): tensor rank must be 1..3!");
+    array = py::array::ensure(array, py::array::c_style);
+
+    VariableType dtype = dtype_to_enoki(array.dtype());
+
+    if (dtype == VariableType::Invalid)
+        throw py::type_error("Shader::update_buffer_range(): unsupported array dtype!");
+
+    size_t dim[3] {
+        (size_t) array.shape(0),
+        array.ndim() > 1 ? (size_t) array.shape(1) : 1,
+        array.ndim() > 2 ? (size_t) array.shape(2) : 1
+    };
+
+    shader.update_buffer_range(key, offset, dtype, array.ndim(), dim, array.data());
+}
+
+/// Allocate a NumPy array that can hold a region of a texture with the given size
+static py::array texture_array(Texture &texture, const Vector2i &size) {
     const char *dtype_name;
     switch (texture.component_format()) {
         case Texture::ComponentFormat::UInt8:   dtype_name = "u1"; break;
@@ -77,16 +115,28 @@ static py::array texture_download(Texture &texture) {
 
     py::array result(
         py::dtype(dtype_name),
-        std::vector<ssize_t> { texture.size().y(), texture.size().x(),
+        std::vector<ssize_t> { size.y(), size.x(),
                                (ssize_t) texture.channels() },
         std::vector<ssize_t> { }
     );
 
+    return result;
+}
+
+static py::array texture_download(Texture &texture) {
+    py::array result = texture_array(texture, texture.size());
     texture.download((uint8_t *) result.mutable_data());
     return result;
 }
 
-static void texture_upload(Texture &texture, py::array array) {
+static py::array texture_finish_download(Texture &texture, TextureTransfer *transfer) {
+    /* The texture may have been resized since download_async() */
+    py::array result = texture_array(texture, transfer->region_size());
+    texture.finish_download(transfer, (uint8_t *) result.mutable_data());
+    return result;
+}
+
+static void texture_upload(Texture &texture, py::array array, bool srgb) {
     size_t n_channels = array.ndim() == 3 ? array.shape(2) : 1;
     VariableType dtype         = dtype_to_enoki(array.dtype()),
                  dtype_texture = (VariableType) texture.component_format();
@@ -96,42 +146,121 @@ static void texture_upload(Texture &texture, py::array array) {
     else if (array.shape(0) != texture.size().y() ||
              array.shape(1) != texture.size().x())
         throw std::runtime_error("Texture::upload(): array size does not match the texture!");
-    else if (n_channels != texture.channels())
-        throw std::runtime_error(
-            std::string("Texture::upload(): number of color channels in array (") +
-            std::to_string(n_channels) + ") does not match the texture (" +
-            std::to_string(texture.channels()) + ")!");
-    else if (dtype != dtype_texture)
-        throw std::runtime_error(
-            std::string("Texture::upload(): dtype of array (") +
-            type_name(dtype) + ") does not match the texture (" +
-            type_name(dtype_texture) + ")!");
 
-    texture.upload((const uint8_t *) array.data());
+    if (n_channels == texture.channels() && dtype == dtype_texture && !srgb) {
+        array = py::array::ensure(array, py::array::c_style);
+        texture.upload((const uint8_t *) array.data());
+        return;
+    }
+
+    /* Convert the channel count and dtype on the fly */
+    Texture::PixelFormat pixel_format;
+    switch (n_channels) {
+        case 1: pixel_format = Texture::PixelFormat::R;    break;
+        case 2: pixel_format = Texture::PixelFormat::RA;   break;
+        case 3: pixel_format = Texture::PixelFormat::RGB;  break;
+        case 4: pixel_format = Texture::PixelFormat::RGBA; break;
+        default:
+            throw std::runtime_error(
+                std::string("Texture::upload(): unsupported number of color channels (") +
+                std::to_string(n_channels) + ")!");
+    }
+
+    if (dtype == VariableType::Invalid)
+        throw std::runtime_error("Texture::upload(): unsupported array dtype!");
+
+    array = py::array::ensure(array, py::array::c_style);
+    texture.upload((const uint8_t *) array.data(), pixel_format,
+                   (Texture::ComponentFormat) dtype, srgb);
 }
 
-static void texture_upload_sub_region(Texture &texture, py::array array, const Vector2i &origin) {
+static int texture_atlas_add(TextureAtlas &atlas, NVGcontext *ctx, py::array array) {
+    if (array.ndim() != 3 || array.shape(2) != 4)
+        throw std::runtime_error("TextureAtlas::add(): expected an array of shape (height, width, 4)!");
+    else if (dtype_to_enoki(array.dtype()) != VariableType::UInt8)
+        throw std::runtime_error("TextureAtlas::add(): expected an array of dtype uint8!");
+    array = py::array::ensure(array, py::array::c_style);
+
+    return atlas.add(ctx, (const uint8_t *) array.data(),
+                     Vector2i((int) array.shape(1), (int) array.shape(0)));
+}
+
+/**
+ * Check that an array can be uploaded to a region of a texture and return the
+ * row stride in bytes. Views with padded rows (e.g. slices of a larger image)
+ * are uploaded without copying, other layouts are converted to C order.
+ */
+static size_t texture_region_stride(const char *func, Texture &texture, py::array &array,
+                                    const Vector2i &origin) {
     size_t n_channels = array.ndim() == 3 ? array.shape(2) : 1;
     VariableType dtype         = dtype_to_enoki(array.dtype()),
                  dtype_texture = (VariableType) texture.component_format();
 
     if (array.ndim() != 2 && array.ndim() != 3)
-        throw std::runtime_error("Texture::upload_sub_region(): expected a 2 or 3-dimensional array!");
-    else if (array.shape(0) + origin.x() > texture.size().y() ||
-             array.shape(1) + origin.y() > texture.size().x())
-        throw std::runtime_error("Texture::upload_sub_region(): bounds exceed the size of the texture!");
+        throw std::runtime_error(std::string(func) + ": expected a 2 or 3-dimensional array!");
+    else if (origin.x() < 0 || origin.y() < 0 ||
+             array.shape(1) + origin.x() > texture.size().x() ||
+             array.shape(0) + origin.y() > texture.size().y())
+        throw std::runtime_error(std::string(func) + ": bounds exceed the size of the texture!");
     else if (n_channels != texture.channels())
         throw std::runtime_error(
-            std::string("Texture::upload_sub_region(): number of color channels in array (") +
+            std::string(func) + ": number of color channels in array (" +
             std::to_string(n_channels) + ") does not match the texture (" +
             std::to_string(texture.channels()) + ")!");
     else if (dtype != dtype_texture)
         throw std::runtime_error(
-            std::string("Texture::upload_sub_region(): dtype of array (") +
+            std::string(func) + ": dtype of array (" +
             type_name(dtype) + ") does not match the texture (" +
             type_name(dtype_texture) + ")!");
 
-    texture.upload_sub_region((const uint8_t *) array.data(), origin, {(int32_t) array.shape(0), (int32_t) array.shape(1)});
+    ssize_t item_size  = (ssize_t) array.itemsize(),
+            pixel_size = item_size * (ssize_t) n_channels;
+
+    bool packed_pixels = (array.ndim() == 2 || array.strides(2) == item_size) &&
+                         array.strides(1) == pixel_size;
+
+    bool packed_rows = array.shape(0) <= 1 ||
+                       (array.strides(0) >= pixel_size * array.shape(1) &&
+                        array.strides(0) % pixel_size == 0);
+
+    if (!packed_pixels || !packed_rows)
+        array = py::array::ensure(array, py::array::c_style);
+
+    return array.shape(0) > 1 ? (size_t) array.strides(0) : 0;
+}
+
+static void texture_upload_sub_region(Texture &texture, py::array array, const Vector2i &origin) {
+    size_t row_stride =
+        texture_region_stride("Texture::upload_sub_region()", texture, array, origin);
+
+    texture.upload_sub_region((const uint8_t *) array.data(), origin,
+                              { (int32_t) array.shape(1), (int32_t) array.shape(0) },
+                              row_stride);
+}
+
+static ref<TextureTransfer> texture_upload_async(Texture &texture, py::array array,
+                                                 const Vector2i &origin) {
+    size_t row_stride =
+        texture_region_stride("Texture::upload_async()", texture, array, origin);
+
+    return texture.upload_async((const uint8_t *) array.data(), origin,
+                                { (int32_t) array.shape(1), (int32_t) array.shape(0) },
+                                row_stride);
+}
+
+/// Access the contents of a NumPy array as raw bytes (std140 layout is up to the caller)
+static py::array uniform_buffer_data(py::array array) {
+    return py::array::ensure(array, py::array::c_style);
+}
+
+static void uniform_buffer_upload(UniformBuffer &buffer, py::array array, size_t offset) {
+    array = uniform_buffer_data(array);
+    buffer.upload(array.data(), (size_t) array.nbytes(), offset);
+}
+
+static size_t uniform_buffer_push(UniformBuffer &buffer, py::array array) {
+    array = uniform_buffer_data(array);
+    return buffer.push(array.data(), (size_t) array.nbytes());
 }
 
 void register_render(py::module &m) {
@@ -142,9 +271,18 @@ void register_render(py::module &m) {
     using TextureFlags      = Texture::TextureFlags;
     using PrimitiveType     = Shader::PrimitiveType;
     using BlendMode         = Shader::BlendMode;
+    using BufferUsage       = Shader::BufferUsage;
     using DepthTest         = RenderPass::DepthTest;
     using CullMode          = RenderPass::CullMode;
 
+    py::class_<TextureTransfer, Object, ref<TextureTransfer>>(m, "TextureTransfer", D(TextureTransfer))
+        .def("size", &TextureTransfer::size, D(TextureTransfer, size))
+        .def("is_download", &TextureTransfer::is_download, D(TextureTransfer, is_download))
+        .def("region_origin", &TextureTransfer::region_origin, D(TextureTransfer, region_origin))
+        .def("region_size", &TextureTransfer::region_size, D(TextureTransfer, region_size))
+        .def("ready", &TextureTransfer::ready, D(TextureTransfer, ready))
+        .def("wait", &TextureTransfer::wait, D(TextureTransfer, wait));
+
     auto texture = py::class_<Texture, Object, ref<Texture>>(m, "Texture", D(Texture));
 
     py::enum_<PixelFormat>(texture, "PixelFormat", D(Texture, PixelFormat))
@@ -206,10 +344,15 @@ void register_render(py::module &m) {
         .def("bytes_per_pixel", &Texture::bytes_per_pixel, D(Texture, bytes_per_pixel))
         .def("channels", &Texture::channels, D(Texture, channels))
         .def("download", &texture_download, D(Texture, download))
-        .def("upload", &texture_upload, D(Texture, upload))
+        .def("download_async", &Texture::download_async, D(Texture, download_async))
+        .def("finish_download", &texture_finish_download, D(Texture, finish_download))
+        .def("upload", &texture_upload, "array"_a, "srgb"_a = false, D(Texture, upload, 2))
         .def("upload_sub_region", &texture_upload_sub_region, D(Texture, upload, origin))
+        .def("upload_async", &texture_upload_async, "array"_a, "origin"_a = Vector2i(0),
+             D(Texture, upload_async))
         .def("generate_mipmap", &Texture::generate_mipmap, D(Texture, generate_mipmap))
         .def("resize", &Texture::resize, D(Texture, resize))
+        .def_static("allocation_count", &Texture::allocation_count, D(Texture, allocation_count))
 #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
         .def("texture_handle", &Texture::texture_handle)
         .def("renderbuffer_handle", &Texture::renderbuffer_handle)
@@ -219,12 +362,105 @@ void register_render(py::module &m) {
 #endif
         ;
 
+    auto image_loader = py::class_<ImageLoader, Object, ref<ImageLoader>>(
+        m, "ImageLoader", D(ImageLoader));
+
+    py::enum_<ImageLoader::Target>(image_loader, "Target", D(ImageLoader, Target))
+        .value("NanoVG", ImageLoader::Target::NanoVG, D(ImageLoader, Target, NanoVG))
+        .value("Texture", ImageLoader::Target::Texture, D(ImageLoader, Target, Texture));
+
+    py::class_<ImageLoader::Image>(image_loader, "Image", D(ImageLoader, Image))
+        .def_readonly("index", &ImageLoader::Image::index, D(ImageLoader, Image, index))
+        .def_readonly("filename", &ImageLoader::Image::filename, D(ImageLoader, Image, filename))
+        .def_readonly("size", &ImageLoader::Image::size, D(ImageLoader, Image, size))
+        .def_readonly("nvg_image", &ImageLoader::Image::nvg_image, D(ImageLoader, Image, nvg_image))
+        .def_readonly("texture", &ImageLoader::Image::texture, D(ImageLoader, Image, texture));
+
+    image_loader
+        .def(py::init<ImageLoader::Target, size_t>(), "target"_a = ImageLoader::Target::NanoVG,
+             "threads"_a = 0, D(ImageLoader, ImageLoader))
+        .def("target", &ImageLoader::target, D(ImageLoader, target))
+        .def("load", &ImageLoader::load, D(ImageLoader, load))
+        .def("load_directory", &ImageLoader::load_directory, "path"_a,
+             "extension"_a = "png", D(ImageLoader, load_directory))
+        .def("set_callback", &ImageLoader::set_callback, D(ImageLoader, set_callback))
+        .def("set_progress_callback", &ImageLoader::set_progress_callback,
+             D(ImageLoader, set_progress_callback))
+        .def("set_wakeup_callback", &ImageLoader::set_wakeup_callback,
+             D(ImageLoader, set_wakeup_callback))
+        .def("upload_limit", &ImageLoader::upload_limit, D(ImageLoader, upload_limit))
+        .def("set_upload_limit", &ImageLoader::set_upload_limit, D(ImageLoader, set_upload_limit))
+        .def("decoded_limit", &ImageLoader::decoded_limit, D(ImageLoader, decoded_limit))
+        .def("set_decoded_limit", &ImageLoader::set_decoded_limit, D(ImageLoader, set_decoded_limit))
+        .def("process", &ImageLoader::process, "ctx"_a = nullptr, D(ImageLoader, process))
+        /* Worker threads acquire the GIL to run the wakeup callback */
+        .def("wait", &ImageLoader::wait, "ctx"_a = nullptr,
+             py::call_guard<py::gil_scoped_release>(), D(ImageLoader, wait))
+        .def("total_count", &ImageLoader::total_count, D(ImageLoader, total_count))
+        .def("loaded_count", &ImageLoader::loaded_count, D(ImageLoader, loaded_count))
+        .def("failed", &ImageLoader::failed, D(ImageLoader, failed));
+
+    auto texture_atlas = py::class_<TextureAtlas, Object, ref<TextureAtlas>>(
+        m, "TextureAtlas", D(TextureAtlas));
+
+    py::class_<TextureAtlas::Entry>(texture_atlas, "Entry", D(TextureAtlas, Entry))
+        .def(py::init<>())
+        .def_readonly("image", &TextureAtlas::Entry::image, D(TextureAtlas, Entry, image))
+        .def_readonly("page", &TextureAtlas::Entry::page, D(TextureAtlas, Entry, page))
+        .def_readonly("origin", &TextureAtlas::Entry::origin, D(TextureAtlas, Entry, origin))
+        .def_readonly("size", &TextureAtlas::Entry::size, D(TextureAtlas, Entry, size));
+
+    texture_atlas
+        .def(py::init<const Vector2i &, size_t, int>(), "page_size"_a = Vector2i(1024),
+             "max_pages"_a = 0, "padding"_a = 1, D(TextureAtlas, TextureAtlas))
+        .def("page_size", &TextureAtlas::page_size, D(TextureAtlas, page_size))
+        .def("max_pages", &TextureAtlas::max_pages, D(TextureAtlas, max_pages))
+        .def("eviction", &TextureAtlas::eviction, D(TextureAtlas, eviction))
+        .def("set_eviction", &TextureAtlas::set_eviction, D(TextureAtlas, set_eviction))
+        .def("add", &texture_atlas_add, "ctx"_a, "rgba"_a, D(TextureAtlas, add))
+        .def("lookup", [](TextureAtlas &atlas, int id) -> py::object {
+                 TextureAtlas::Entry entry;
+                 if (!atlas.lookup(id, entry))
+                     return py::none();
+                 return py::cast(entry);
+             }, D(TextureAtlas, lookup))
+        .def("remove", &TextureAtlas::remove, D(TextureAtlas, remove))
+        .def("pattern", &TextureAtlas::pattern, "ctx"_a, "entry"_a, "x"_a, "y"_a,
+             "w"_a, "h"_a, "alpha"_a, D(TextureAtlas, pattern))
+        .def("page_count", &TextureAtlas::page_count, D(TextureAtlas, page_count))
+        .def("page_texture", &TextureAtlas::page_texture, D(TextureAtlas, page_texture))
+        .def("entry_count", &TextureAtlas::entry_count, D(TextureAtlas, entry_count))
+        .def("eviction_count", &TextureAtlas::eviction_count, D(TextureAtlas, eviction_count));
+
+    m.def("nvg_texture_image", &nvg_texture_image, D(nvg_texture_image));
+
     auto shader = py::class_<Shader, Object, ref<Shader>>(m, "Shader", D(Shader));
 
     py::enum_<BlendMode>(shader, "BlendMode", D(Shader, BlendMode))
         .value("None", BlendMode::None, D(Shader, BlendMode, None))
         .value("AlphaBlend", BlendMode::AlphaBlend, D(Shader, BlendMode, AlphaBlend));
 
+    py::enum_<BufferUsage>(shader, "BufferUsage", D(Shader, BufferUsage))
+        .value("Static", BufferUsage::Static, D(Shader, BufferUsage, Static))
+        .value("Dynamic", BufferUsage::Dynamic, D(Shader, BufferUsage, Dynamic))
+        .value("Stream", BufferUsage::Stream, D(Shader, BufferUsage, Stream));
+
+    py::class_<Shader::VertexAttribute>(shader, "VertexAttribute", D(Shader, VertexAttribute))
+        .def(py::init([](const std::string &name, const py::object &dtype, size_t components,
+                         size_t offset, bool normalized) {
+                 VariableType type = dtype_to_enoki(py::dtype::from_args(dtype));
+                 if (type == VariableType::Invalid)
+                     throw py::type_error("VertexAttribute(): unsupported dtype!");
+                 return Shader::VertexAttribute { name, type, components, offset, normalized };
+             }), "name"_a, "dtype"_a, "components"_a, "offset"_a, "normalized"_a = false)
+        .def_readwrite("name", &Shader::VertexAttribute::name, D(Shader, VertexAttribute, name))
+        .def_readwrite("components", &Shader::VertexAttribute::components,
+                       D(Shader, VertexAttribute, components))
+        .def_readwrite("offset", &Shader::VertexAttribute::offset,
+                       D(Shader, VertexAttribute, offset))
+        .def_readwrite("normalized", &Shader::VertexAttribute::normalized,
+                       D(Shader, VertexAttribute, normalized));
+
     shader
         .def(py::init<RenderPass *, const std::string &,
                       const std::string &, const std::string &, Shader::BlendMode>(),
@@ -232,14 +468,54 @@ void register_render(py::module &m) {
              "fragment_shader"_a, "blend_mode"_a = BlendMode::None)
         .def("name", &Shader::name, D(Shader, name))
         .def("blend_mode", &Shader::blend_mode, D(Shader, blend_mode))
-        .def("set_buffer", &shader_set_buffer, D(Shader, set_buffer))
-        .def("set_texture", &Shader::set_texture, D(Shader, set_texture))
+        .def("argument_handle", &Shader::argument_handle, D(Shader, argument_handle))
+        .def("set_buffer", &shader_set_buffer<std::string>, D(Shader, set_buffer))
+        .def("set_buffer", &shader_set_buffer<size_t>, D(Shader, set_buffer, 3))
+        .def("set_interleaved_buffer", &shader_set_interleaved_buffer,
+             D(Shader, set_interleaved_buffer), "attributes"_a, "array"_a)
+        .def("update_buffer_range", &shader_update_buffer_range<std::string>,
+             D(Shader, update_buffer_range, 3), "name"_a, "offset"_a, "array"_a)
+        .def("update_buffer_range", &shader_update_buffer_range<size_t>,
+             D(Shader, update_buffer_range, 4), "handle"_a, "offset"_a, "array"_a)
+        .def("set_buffer_usage",
+             py::overload_cast<const std::string &, BufferUsage>(&Shader::set_buffer_usage),
+             D(Shader, set_buffer_usage), "name"_a, "usage"_a)
+        .def("set_buffer_usage", py::overload_cast<size_t, BufferUsage>(&Shader::set_buffer_usage),
+             D(Shader, set_buffer_usage, 2), "handle"_a, "usage"_a)
+        .def("buffer_usage", &Shader::buffer_usage, D(Shader, buffer_usage))
+        .def("set_instance_divisor",
+             py::overload_cast<const std::string &, size_t>(&Shader::set_instance_divisor),
+             D(Shader, set_instance_divisor), "name"_a, "divisor"_a)
+        .def("set_instance_divisor", py::overload_cast<size_t, size_t>(&Shader::set_instance_divisor),
+             D(Shader, set_instance_divisor, 2), "handle"_a, "divisor"_a)
+        .def("instance_divisor", &Shader::instance_divisor, D(Shader, instance_divisor))
+        .def("set_texture", py::overload_cast<const std::string &, Texture *>(&Shader::set_texture),
+             D(Shader, set_texture))
+        .def("set_texture", py::overload_cast<size_t, Texture *>(&Shader::set_texture),
+             D(Shader, set_texture, 2))
+        .def("set_uniform_buffer",
+             py::overload_cast<const std::string &, UniformBuffer *, size_t>(&Shader::set_uniform_buffer),
+             D(Shader, set_uniform_buffer), "name"_a, "buffer"_a, "offset"_a = 0)
+        .def("set_uniform_buffer",
+             py::overload_cast<size_t, UniformBuffer *, size_t>(&Shader::set_uniform_buffer),
+             D(Shader, set_uniform_buffer, 2), "handle"_a, "buffer"_a, "offset"_a = 0)
+        .def("uniform_block_size", &Shader::uniform_block_size, D(Shader, uniform_block_size))
         .def("begin", &Shader::begin, D(Shader, begin))
         .def("end", &Shader::end, D(Shader, end))
         .def("__enter__", &Shader::begin)
         .def("__exit__", [](Shader &s, py::handle, py::handle, py::handle) { s.end(); })
         .def("draw_array", &Shader::draw_array, D(Shader, draw_array),
              "primitive_type"_a, "offset"_a, "count"_a, "indexed"_a = false)
+        .def("draw_array_instanced", &Shader::draw_array_instanced,
+             D(Shader, draw_array_instanced), "primitive_type"_a, "offset"_a, "count"_a,
+             "instance_count"_a, "indexed"_a = false)
+        .def_static("set_binary_cache_directory", &Shader::set_binary_cache_directory,
+                    D(Shader, set_binary_cache_directory), "directory"_a)
+        .def_static("binary_cache_directory", &Shader::binary_cache_directory,
+                    D(Shader, binary_cache_directory))
+        .def_static("binary_cache_hits", &Shader::binary_cache_hits, D(Shader, binary_cache_hits))
+        .def_static("binary_cache_misses", &Shader::binary_cache_misses,
+                    D(Shader, binary_cache_misses))
 #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
         .def("shader_handle", &Shader::shader_handle)
 #elif defined(NANOGUI_USE_METAL)
@@ -250,6 +526,16 @@ void register_render(py::module &m) {
 #endif
         ;
 
+    py::class_<UniformBuffer, Object, ref<UniformBuffer>>(m, "UniformBuffer", D(UniformBuffer))
+        .def(py::init<size_t>(), D(UniformBuffer, UniformBuffer), "size"_a)
+        .def("size", &UniformBuffer::size, D(UniformBuffer, size))
+        .def("offset_alignment", &UniformBuffer::offset_alignment, D(UniformBuffer, offset_alignment))
+        .def("upload", &uniform_buffer_upload, D(UniformBuffer, upload), "array"_a, "offset"_a = 0)
+        .def("push", &uniform_buffer_push, D(UniformBuffer, push), "array"_a)
+        .def("orphan_count", &UniformBuffer::orphan_count, D(UniformBuffer, orphan_count))
+        .def("buffer_handle", &UniformBuffer::buffer_handle)
+        ;
+
     py::enum_<PrimitiveType>(shader, "PrimitiveType", D(Shader, PrimitiveType))
         .value("Point", PrimitiveType::Point, D(Shader, PrimitiveType, Point))
         .value("Line", PrimitiveType::Line, D(Shader, PrimitiveType, Line))
@@ -276,6 +562,9 @@ void register_render(py::module &m) {
         .def("begin", &RenderPass::begin, D(RenderPass, begin))
         .def("end", &RenderPass::end, D(RenderPass, end))
         .def("resize", &RenderPass::resize, D(RenderPass, resize))
+        .def("set_resize_slack", &RenderPass::set_resize_slack, D(RenderPass, set_resize_slack))
+        .def("resize_slack", &RenderPass::resize_slack, D(RenderPass, resize_slack))
+        .def_static("slack_size", &RenderPass::slack_size, D(RenderPass, slack_size))
         .def("blit_to", &RenderPass::blit_to, D(RenderPass, blit_to),
              "src_offset"_a, "src_size"_a, "dst"_a, "dst_offset"_a)
         .def("__enter__", &RenderPass::begin)
@@ -95,6 +95,18 @@ void register_widget(py::module &m) {
         .def("button_panel", &Window::button_panel, D(Window, button_panel))
         .def("center", &Window::center, D(Window, center));
 
+    py::class_<TextMetricsCache, Object, ref<TextMetricsCache>>(m, "TextMetricsCache", D(TextMetricsCache))
+        .def(py::init<size_t>(), "capacity"_a = 4096, D(TextMetricsCache, TextMetricsCache))
+        .def("capacity", &TextMetricsCache::capacity, D(TextMetricsCache, capacity))
+        .def("set_capacity", &TextMetricsCache::set_capacity, D(TextMetricsCache, set_capacity))
+        .def("size", &TextMetricsCache::size, D(TextMetricsCache, size))
+        .def("clear", &TextMetricsCache::clear, D(TextMetricsCache, clear))
+        .def("hits", &TextMetricsCache::hits, D(TextMetricsCache, hits))
+        .def("misses", &TextMetricsCache::misses, D(TextMetricsCache, misses))
+        .def("hit_rate", &TextMetricsCache::hit_rate, D(TextMetricsCache, hit_rate))
+        .def("reset_statistics", &TextMetricsCache::reset_statistics,
+             D(TextMetricsCache, reset_statistics));
+
     py::class_<Screen, Widget, ref<Screen>, PyScreen>(m, "Screen", D(Screen))
         .def(py::init<const Vector2i &, const std::string &, bool, bool, bool,
                       bool, bool, unsigned int, unsigned int>(),
@@ -129,6 +141,13 @@ void register_widget(py::module &m) {
         .def("pixel_format", &Screen::pixel_format, D(Screen, pixel_format))
         .def("component_format", &Screen::component_format, D(Screen, component_format))
         .def("nvg_flush", &Screen::nvg_flush, D(Screen, nvg_flush))
+        .def("text_metrics_cache", &Screen::text_metrics_cache, D(Screen, text_metrics_cache))
+        .def("warm_up_glyphs", &Screen::warm_up_glyphs, "font"_a, "font_size"_a,
+             "glyphs"_a, D(Screen, warm_up_glyphs))
+        .def("icon_atlas", &Screen::icon_atlas, D(Screen, icon_atlas))
+        .def("nvg_draw_call_count", &Screen::nvg_draw_call_count, D(Screen, nvg_draw_call_count))
+        .def("nvg_image_switch_count", &Screen::nvg_image_switch_count,
+             D(Screen, nvg_image_switch_count))
 #if defined(NANOGUI_USE_METAL)
         .def("metal_layer", &Screen::metal_layer)
         .def("metal_texture", &Screen::metal_texture)
@@ -0,0 +1,64 @@
+/*
+    src/renderpass.cpp -- Backend-independent parts of the RenderPass class
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/renderpass.h>
+#include <nanogui/texture.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+Vector2i RenderPass::slack_size(const Vector2i &size) {
+    Vector2i result;
+    for (size_t i = 0; i < 2; ++i) {
+        int value = std::max(size[i], 1), pow2 = 1;
+        while (pow2 < value)
+            pow2 <<= 1;
+        int granularity = std::max(pow2 / 8, 64);
+        result[i] = (value + granularity - 1) / granularity * granularity;
+    }
+    return result;
+}
+
+void RenderPass::resize(const Vector2i &size) {
+    Vector2i target_size = size;
+
+    if (m_resize_slack) {
+        Texture *texture = nullptr;
+        for (size_t i = 0; i < m_targets.size() && !texture; ++i)
+            texture = dynamic_cast<Texture *>(m_targets[i].get());
+
+        if (texture) {
+            /* Keep the current targets unless they are too small or twice as
+               large as necessary (which avoids thrashing near a bucket edge) */
+            Vector2i current = texture->size(),
+                     bucket  = slack_size(size);
+            bool fits   = size.x() <= current.x() && size.y() <= current.y(),
+                 wasted = current.x() > 2 * bucket.x() || current.y() > 2 * bucket.y();
+            target_size = (fits && !wasted) ? current : bucket;
+        }
+    }
+
+    for (size_t i = 0; i < m_targets.size(); ++i) {
+        Texture *texture = dynamic_cast<Texture *>(m_targets[i].get());
+        if (texture)
+            texture->resize(target_size);
+    }
+
+    m_framebuffer_size = target_size;
+    m_viewport_size = size;
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+    /* Viewport offsets are specified from the top, OpenGL's origin is at the bottom */
+    m_viewport_offset = Vector2i(0, target_size.y() - size.y());
+#else
+    m_viewport_offset = Vector2i(0, 0);
+#endif
+}
+
+NAMESPACE_END(nanogui)
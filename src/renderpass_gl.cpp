@@ -241,17 +241,6 @@ void RenderPass::end() {
     m_active = false;
 }
 
-void RenderPass::resize(const Vector2i &size) {
-    for (size_t i = 0; i < m_targets.size(); ++i) {
-        Texture *texture = dynamic_cast<Texture *>(m_targets[i].get());
-        if (texture)
-            texture->resize(size);
-    }
-    m_framebuffer_size = size;
-    m_viewport_offset = Vector2i(0, 0);
-    m_viewport_size = size;
-}
-
 void RenderPass::set_clear_color(size_t index, const Color &color) {
     m_clear_color.at(index) = color;
 }
@@ -17,6 +17,7 @@
 #include <nanogui/window.h>
 #include <nanogui/popup.h>
 #include <nanogui/metal.h>
+#include <stb_image.h>
 #include <map>
 #include <iostream>
 
@@ -72,6 +73,48 @@ std::map<GLFWwindow *, Screen *> __nanogui_screens;
 static bool glad_initialized = false;
 #endif
 
+/* Per-frame statistics of the NanoVG render calls, keyed by the backend's user pointer */
+struct NVGStats {
+    size_t draw_calls = 0;
+    size_t image_switches = 0;
+    int image = -1;
+};
+
+static std::map<void *, NVGStats> nvg_stats;
+static decltype(NVGparams::renderFill) nvg_render_fill = nullptr;
+static decltype(NVGparams::renderStroke) nvg_render_stroke = nullptr;
+static decltype(NVGparams::renderTriangles) nvg_render_triangles = nullptr;
+
+static void nvg_count_call(void *uptr, const NVGpaint *paint) {
+    NVGStats &stats = nvg_stats[uptr];
+    stats.draw_calls++;
+    if (paint->image != stats.image) {
+        stats.image_switches++;
+        stats.image = paint->image;
+    }
+}
+
+/* Route the render calls of a NanoVG context through the counters above */
+static void nvg_install_stats(NVGcontext *ctx) {
+    NVGparams *params = nvgInternalParams(ctx);
+    nvg_render_fill = params->renderFill;
+    nvg_render_stroke = params->renderStroke;
+    nvg_render_triangles = params->renderTriangles;
+
+    params->renderFill = [](void *uptr, NVGpaint *paint, auto... args) {
+        nvg_count_call(uptr, paint);
+        nvg_render_fill(uptr, paint, args...);
+    };
+    params->renderStroke = [](void *uptr, NVGpaint *paint, auto... args) {
+        nvg_count_call(uptr, paint);
+        nvg_render_stroke(uptr, paint, args...);
+    };
+    params->renderTriangles = [](void *uptr, NVGpaint *paint, auto... args) {
+        nvg_count_call(uptr, paint);
+        nvg_render_triangles(uptr, paint, args...);
+    };
+}
+
 /* Calculate pixel ratio for hi-dpi devices. */
 static float get_pixel_ratio(GLFWwindow *window) {
 #if defined(EMSCRIPTEN)
@@ -385,6 +428,8 @@ Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
             Screen* s = it->second;
 
             s->m_pixel_ratio = get_pixel_ratio(w);
+            if (s->m_text_metrics_cache)
+                s->m_text_metrics_cache->set_pixel_ratio(s->m_pixel_ratio);
             s->resize_callback_event(s->m_size.x(), s->m_size.y());
         }
     );
@@ -472,9 +517,12 @@ void Screen::initialize(GLFWwindow *window, bool shutdown_glfw) {
 
     if (!m_nvg_context)
         throw std::runtime_error("Could not initialize NanoVG!");
+    nvg_install_stats(m_nvg_context);
 
     m_visible = glfwGetWindowAttrib(window, GLFW_VISIBLE) != 0;
     set_theme(new Theme(m_nvg_context));
+    m_text_metrics_cache = new TextMetricsCache();
+    m_text_metrics_cache->set_pixel_ratio(m_pixel_ratio);
     m_mouse_pos = Vector2i(0);
     m_mouse_state = m_modifiers = 0;
     m_drag_active = false;
@@ -498,7 +546,23 @@ Screen::~Screen() {
             glfwDestroyCursor(m_cursors[i]);
     }
 
+    /* Release the child widgets and the icon atlas while the NanoVG context
+       still exists, since they may own NanoVG images */
+    for (Widget *child : m_children) {
+        if (child)
+            child->dec_ref();
+    }
+    m_children.clear();
+    m_icon_atlas = nullptr;
+
     if (m_nvg_context) {
+        for (const auto &kv : m_atlas_icons) {
+            if (!nvg_is_atlas_icon(kv.second))
+                nvgDeleteImage(m_nvg_context, kv.second);
+        }
+        __nanogui_release_images(m_nvg_context);
+
+        nvg_stats.erase(nvgInternalParams(m_nvg_context)->userPtr);
 #if defined(NANOGUI_USE_OPENGL)
         nvgDeleteGL3(m_nvg_context);
 #elif defined(NANOGUI_USE_GLES)
@@ -581,6 +645,9 @@ void Screen::draw_setup() {
 #endif
 #endif
 
+    if (m_text_metrics_cache)
+        m_text_metrics_cache->set_pixel_ratio(m_pixel_ratio);
+
 #if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
     CHK(glViewport(0, 0, m_fbsize[0], m_fbsize[1]));
 #endif
@@ -598,8 +665,7 @@ void Screen::draw_teardown() {
 }
 
 void Screen::draw_all() {
-    if (m_redraw) {
-        m_redraw = false;
+    if (m_redraw.exchange(false)) {
 
 #if defined(NANOGUI_USE_METAL)
         void *pool = autorelease_init();
@@ -626,9 +692,75 @@ void Screen::nvg_flush() {
     params->renderViewport(params->userPtr, m_size[0], m_size[1], m_pixel_ratio);
 }
 
+void Screen::warm_up_glyphs(const std::string &font, float font_size,
+                            const std::string &glyphs) {
+    m_glyph_warm_up.push_back(GlyphWarmUp { font, font_size, glyphs });
+    redraw();
+}
+
+void Screen::rasterize_glyphs() {
+    /* Atlas entries depend on the pixel ratio: start over when it changes */
+    if (m_glyph_warm_up_ratio != m_pixel_ratio) {
+        m_glyph_warm_up_ratio = m_pixel_ratio;
+        m_glyph_warm_up_done = 0;
+    }
+
+    if (m_glyph_warm_up_done == m_glyph_warm_up.size())
+        return;
+
+    /* Drawing invisible, fully clipped text populates the atlas */
+    nvgSave(m_nvg_context);
+    nvgScissor(m_nvg_context, 0, 0, 0, 0);
+    nvgGlobalAlpha(m_nvg_context, 0.f);
+    nvgTextAlign(m_nvg_context, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+    for (size_t i = m_glyph_warm_up_done; i < m_glyph_warm_up.size(); ++i) {
+        const GlyphWarmUp &warm_up = m_glyph_warm_up[i];
+        nvgFontFace(m_nvg_context, warm_up.font.c_str());
+        nvgFontSize(m_nvg_context, warm_up.font_size);
+        nvgText(m_nvg_context, 0, 0, warm_up.glyphs.c_str(), nullptr);
+    }
+    nvgRestore(m_nvg_context);
+    m_glyph_warm_up_done = m_glyph_warm_up.size();
+}
+
+TextureAtlas *Screen::icon_atlas() {
+    if (!m_icon_atlas)
+        m_icon_atlas = new TextureAtlas(Vector2i(512));
+    return m_icon_atlas;
+}
+
+int Screen::atlas_icon(const std::string &name, const uint8_t *data, uint32_t size) {
+    auto it = m_atlas_icons.find(name);
+    if (it != m_atlas_icons.end())
+        return it->second;
+
+    int w = 0, h = 0, n = 0;
+    uint8_t *rgba = stbi_load_from_memory(data, (int) size, &w, &h, &n, 4);
+    if (!rgba)
+        throw std::runtime_error("Screen::atlas_icon(): unable to load resource data.");
+
+    int icon_id = 0;
+    TextureAtlas *atlas = icon_atlas();
+    Vector2i limit = atlas->page_size() / 4;
+    if (w <= limit.x() && h <= limit.y())
+        icon_id = -2 - atlas->add(m_nvg_context, rgba, Vector2i(w, h));
+    else
+        icon_id = nvgCreateImageRGBA(m_nvg_context, w, h, 0, rgba);
+    stbi_image_free(rgba);
+
+    if (icon_id == 0)
+        throw std::runtime_error("Screen::atlas_icon(): unable to load resource data.");
+    m_atlas_icons[name] = icon_id;
+    return icon_id;
+}
+
 void Screen::draw_widgets() {
+    void *uptr = nvgInternalParams(m_nvg_context)->userPtr;
+    nvg_stats[uptr] = NVGStats();
+
     nvgBeginFrame(m_nvg_context, m_size[0], m_size[1], m_pixel_ratio);
 
+    rasterize_glyphs();
     draw(m_nvg_context);
 
     double elapsed = glfwGetTime() - m_last_interaction;
@@ -639,16 +771,19 @@ void Screen::draw_widgets() {
         if (widget && !widget->tooltip().empty()) {
             int tooltip_width = 150;
 
-            float bounds[4];
+            Vector2i pos = widget->absolute_position() +
+                           Vector2i(widget->width() / 2, widget->height() + 10);
+
+            TextMetrics metrics = m_text_metrics_cache->measure(
+                m_nvg_context, "sans", 15.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP,
+                widget->tooltip());
             nvgFontFace(m_nvg_context, "sans");
             nvgFontSize(m_nvg_context, 15.0f);
             nvgTextAlign(m_nvg_context, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
             nvgTextLineHeight(m_nvg_context, 1.1f);
-            Vector2i pos = widget->absolute_position() +
-                           Vector2i(widget->width() / 2, widget->height() + 10);
 
-            nvgTextBounds(m_nvg_context, pos.x(), pos.y(),
-                          widget->tooltip().c_str(), nullptr, bounds);
+            float bounds[4] = { metrics.bounds[0] + pos.x(), metrics.bounds[1] + pos.y(),
+                                metrics.bounds[2] + pos.x(), metrics.bounds[3] + pos.y() };
 
             int h = (bounds[2] - bounds[0]) / 2;
             if (h > tooltip_width / 2) {
@@ -691,6 +826,10 @@ void Screen::draw_widgets() {
     }
 
     nvgEndFrame(m_nvg_context);
+
+    const NVGStats &stats = nvg_stats[uptr];
+    m_nvg_draw_call_count = stats.draw_calls;
+    m_nvg_image_switch_count = stats.image_switches;
 }
 
 bool Screen::keyboard_event(int key, int scancode, int action, int modifiers) {
@@ -721,8 +860,7 @@ bool Screen::resize_event(const Vector2i& size) {
 }
 
 void Screen::redraw() {
-    if (!m_redraw) {
-        m_redraw = true;
+    if (!m_redraw.exchange(true)) {
         #if !defined(EMSCRIPTEN)
             glfwPostEmptyEvent();
         #endif
@@ -757,7 +895,8 @@ void Screen::cursor_pos_callback_event(double x, double y) {
             ret = mouse_motion_event(p, p - m_mouse_pos, m_mouse_state, m_modifiers);
 
         m_mouse_pos = p;
-        m_redraw |= ret;
+        if (ret)
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -790,9 +929,10 @@ void Screen::mouse_button_callback_event(int button, int action, int modifiers)
         auto drop_widget = find_widget(m_mouse_pos);
         if (m_drag_active && action == GLFW_RELEASE &&
             drop_widget != m_drag_widget) {
-            m_redraw |= m_drag_widget->mouse_button_event(
-                m_mouse_pos - m_drag_widget->parent()->absolute_position(), button,
-                false, m_modifiers);
+            if (m_drag_widget->mouse_button_event(
+                    m_mouse_pos - m_drag_widget->parent()->absolute_position(), button,
+                    false, m_modifiers))
+                m_redraw = true;
         }
 
         if (drop_widget != nullptr && drop_widget->cursor() != m_cursor) {
@@ -814,8 +954,8 @@ void Screen::mouse_button_callback_event(int button, int action, int modifiers)
             m_drag_widget = nullptr;
         }
 
-        m_redraw |= mouse_button_event(m_mouse_pos, button,
-                                       action == GLFW_PRESS, m_modifiers);
+        if (mouse_button_event(m_mouse_pos, button, action == GLFW_PRESS, m_modifiers))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -824,7 +964,8 @@ void Screen::mouse_button_callback_event(int button, int action, int modifiers)
 void Screen::key_callback_event(int key, int scancode, int action, int mods) {
     m_last_interaction = glfwGetTime();
     try {
-        m_redraw |= keyboard_event(key, scancode, action, mods);
+        if (keyboard_event(key, scancode, action, mods))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -833,7 +974,8 @@ void Screen::key_callback_event(int key, int scancode, int action, int mods) {
 void Screen::char_callback_event(unsigned int codepoint) {
     m_last_interaction = glfwGetTime();
     try {
-        m_redraw |= keyboard_character_event(codepoint);
+        if (keyboard_character_event(codepoint))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -843,7 +985,8 @@ void Screen::drop_callback_event(int count, const char **filenames) {
     std::vector<std::string> arg(count);
     for (int i = 0; i < count; ++i)
         arg[i] = filenames[i];
-    m_redraw |= drop_event(arg);
+    if (drop_event(arg))
+        m_redraw = true;
 }
 
 void Screen::scroll_callback_event(double x, double y) {
@@ -857,7 +1000,8 @@ void Screen::scroll_callback_event(double x, double y) {
                     return;
             }
         }
-        m_redraw |= scroll_event(m_mouse_pos, Vector2f(x, y));
+        if (scroll_event(m_mouse_pos, Vector2f(x, y)))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
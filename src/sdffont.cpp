@@ -0,0 +1,572 @@
+/*
+    src/sdffont.cpp -- Text rendering using a signed distance field glyph
+    atlas that is shared by all font sizes
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/sdffont.h>
+#include <nanogui/textmetrics.h>
+#include <nanogui/texture.h>
+#include <nanogui/shader.h>
+#include <nanogui/opengl.h>
+#include <nanogui_resources.h>
+#include <algorithm>
+
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#if defined(_MSC_VER)
+#  pragma warning (disable: 4505) // don't warn about dead code in stb_truetype.h
+#elif defined(__GNUC__)
+#   pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include <stb_truetype.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+struct SDFFont::FontInfo {
+    stbtt_fontinfo info;
+};
+
+/// Upper bound on the atlas height before giving up
+static const int sdf_max_atlas_size = 4096;
+
+/// Identifies (and versions) the on-disk cache format
+static const char sdf_cache_magic[8] = { 'N', 'G', 'S', 'D', 'F', 0, 0, 1 };
+
+/// Header of the on-disk cache, followed by the glyphs and the atlas
+struct SDFCacheHeader {
+    char magic[8];
+    uint64_t font_hash;
+    int32_t glyph_size, padding;
+    int32_t atlas_size[2];
+    int32_t shelf_pos[2], shelf_height;
+    uint32_t glyph_count;
+};
+
+/// Glyph record of the on-disk cache
+struct SDFCacheGlyph {
+    uint32_t codepoint;
+    int32_t pos[2], size[2];
+    float offset[2], advance;
+    int32_t index;
+};
+
+/// 64-bit FNV-1a hash
+static uint64_t fnv1a(const uint8_t *data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/// Decode the next UTF-8 code point, advancing \c ptr
+static uint32_t utf8_next(const char *&ptr, const char *end) {
+    uint8_t c = (uint8_t) *ptr++;
+    int extra = c < 0x80 ? 0 : c < 0xE0 ? 1 : c < 0xF0 ? 2 : 3;
+    uint32_t codepoint = extra == 0 ? c : c & (0x3F >> extra);
+    for (int i = 0; i < extra && ptr < end; ++i)
+        codepoint = (codepoint << 6) | ((uint8_t) *ptr++ & 0x3F);
+    return codepoint;
+}
+
+SDFFont::SDFFont(RenderPass *render_pass, const std::string &font,
+                 int glyph_size, int atlas_size)
+    : m_font(font), m_glyph_size(glyph_size),
+      m_padding(std::max(glyph_size / 8, 2)), m_info(new FontInfo()),
+      m_atlas_size(atlas_size), m_shelf_pos(0), m_dirty_begin(0),
+      m_dirty_end(0) {
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    if (!TextMetricsService::instance()->font_data(font, &data, &size))
+        throw std::runtime_error("SDFFont::SDFFont(): unknown font \"" + font +
+                                 "\"!");
+    m_font_hash = fnv1a(data, size);
+
+    if (!stbtt_InitFont(&m_info->info, data,
+                        stbtt_GetFontOffsetForIndex(data, 0)))
+        throw std::runtime_error("SDFFont::SDFFont(): could not parse font \"" +
+                                 font + "\"!");
+
+    int ascent, descent, line_gap;
+    stbtt_GetFontVMetrics(&m_info->info, &ascent, &descent, &line_gap);
+    m_scale = stbtt_ScaleForPixelHeight(&m_info->info, (float) glyph_size);
+    m_ascent = ascent * m_scale;
+    m_descent = descent * m_scale;
+
+    size_t atlas_bytes = (size_t) m_atlas_size.x() * (size_t) m_atlas_size.y();
+    m_atlas.reset(new uint8_t[atlas_bytes]);
+    memset(m_atlas.get(), 0, atlas_bytes);
+
+    m_texture = new Texture(
+        Texture::PixelFormat::R,
+        Texture::ComponentFormat::UInt8,
+        m_atlas_size,
+        Texture::InterpolationMode::Bilinear,
+        Texture::InterpolationMode::Bilinear
+    );
+
+    m_shader = new Shader(
+        render_pass,
+        /* An identifying name */
+        "sdf_font",
+        NANOGUI_SHADER(sdffont_vertex),
+        NANOGUI_SHADER(sdffont_fragment),
+        Shader::BlendMode::AlphaBlend
+    );
+    m_shader->set_texture("atlas", m_texture);
+
+    /* Vertices of draw_text() are replaced at every call */
+    for (const char *name : { "position", "uv", "color" })
+        m_shader->set_buffer_usage(name, Shader::BufferUsage::Stream);
+}
+
+SDFFont::~SDFFont() { }
+
+const SDFFont::Glyph &SDFFont::glyph(uint32_t codepoint) {
+    auto it = m_glyphs.find(codepoint);
+    if (it != m_glyphs.end())
+        return it->second;
+
+    Glyph g;
+    g.index = stbtt_FindGlyphIndex(&m_info->info, (int) codepoint);
+
+    int advance, lsb;
+    stbtt_GetGlyphHMetrics(&m_info->info, g.index, &advance, &lsb);
+    g.advance = advance * m_scale;
+
+    /* One distance field unit corresponds to 1/m_padding of the range */
+    int w = 0, h = 0, xoff = 0, yoff = 0;
+    uint8_t *sdf = stbtt_GetGlyphSDF(&m_info->info, m_scale, g.index, m_padding,
+                                     128, 128.f / m_padding, &w, &h, &xoff, &yoff);
+
+    g.pos = Vector2i(0);
+    g.size = Vector2i(w, h);
+    g.offset = Vector2f((float) xoff, (float) yoff);
+
+    if (sdf && w > m_atlas_size.x()) {
+        stbtt_FreeSDF(sdf, nullptr);
+        throw std::runtime_error("SDFFont::glyph(): glyph is wider than the atlas!");
+    }
+
+    if (sdf) {
+        /* Shelf packing with a one pixel gutter */
+        if (m_shelf_pos.x() + w + 1 > m_atlas_size.x()) {
+            m_shelf_pos = Vector2i(0, m_shelf_pos.y() + m_shelf_height + 1);
+            m_shelf_height = 0;
+        }
+
+        if (m_shelf_pos.y() + h > m_atlas_size.y()) {
+            int new_height = m_atlas_size.y();
+            while (m_shelf_pos.y() + h > new_height)
+                new_height *= 2;
+            if (new_height > sdf_max_atlas_size) {
+                stbtt_FreeSDF(sdf, nullptr);
+                throw std::runtime_error("SDFFont::glyph(): atlas is full!");
+            }
+
+            size_t old_bytes = (size_t) m_atlas_size.x() * (size_t) m_atlas_size.y(),
+                   new_bytes = (size_t) m_atlas_size.x() * (size_t) new_height;
+            std::unique_ptr<uint8_t[]> atlas(new uint8_t[new_bytes]);
+            memcpy(atlas.get(), m_atlas.get(), old_bytes);
+            memset(atlas.get() + old_bytes, 0, new_bytes - old_bytes);
+            m_atlas = std::move(atlas);
+            m_atlas_size.y() = new_height;
+            m_texture->resize(m_atlas_size);
+            m_texture_stale = true;
+        }
+
+        g.pos = m_shelf_pos;
+        for (int y = 0; y < h; ++y)
+            memcpy(m_atlas.get() + (size_t) (g.pos.y() + y) * m_atlas_size.x() + g.pos.x(),
+                   sdf + (size_t) y * w, (size_t) w);
+        stbtt_FreeSDF(sdf, nullptr);
+
+        if (m_dirty_begin == m_dirty_end) {
+            m_dirty_begin = g.pos.y();
+            m_dirty_end = g.pos.y() + h;
+        } else {
+            m_dirty_begin = std::min(m_dirty_begin, g.pos.y());
+            m_dirty_end = std::max(m_dirty_end, g.pos.y() + h);
+        }
+
+        m_shelf_pos.x() += w + 1;
+        m_shelf_height = std::max(m_shelf_height, h);
+    }
+
+    return m_glyphs.emplace(codepoint, g).first->second;
+}
+
+void SDFFont::warm_up(const std::string &glyphs) {
+    const char *ptr = glyphs.c_str(), *end = ptr + glyphs.size();
+    while (ptr < end)
+        glyph(utf8_next(ptr, end));
+    update_texture();
+}
+
+std::string SDFFont::cache_key() const {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "-%i-%i-%016llx", m_glyph_size, m_padding,
+             (unsigned long long) m_font_hash);
+    return m_font + buf;
+}
+
+std::string SDFFont::cache_filename(const std::string &directory) const {
+    return directory + "/" + cache_key() + ".sdfcache";
+}
+
+bool SDFFont::load_cache(const std::string &directory) {
+    FILE *file = fopen(cache_filename(directory).c_str(), "rb");
+    if (!file)
+        return false;
+
+    SDFCacheHeader header;
+    std::vector<SDFCacheGlyph> glyphs;
+    std::unique_ptr<uint8_t[]> atlas;
+    bool success = false;
+
+    do {
+        long file_size = -1;
+        if (fseek(file, 0, SEEK_END) == 0) {
+            file_size = ftell(file);
+            if (fseek(file, 0, SEEK_SET) != 0)
+                file_size = -1;
+        }
+
+        if (file_size < (long) sizeof(SDFCacheHeader) ||
+            fread(&header, sizeof(SDFCacheHeader), 1, file) != 1 ||
+            memcmp(header.magic, sdf_cache_magic, sizeof(sdf_cache_magic)) != 0 ||
+            header.font_hash != m_font_hash ||
+            header.glyph_size != m_glyph_size || header.padding != m_padding ||
+            header.atlas_size[0] <= 0 || header.atlas_size[1] <= 0 ||
+            header.atlas_size[0] > sdf_max_atlas_size ||
+            header.atlas_size[1] > sdf_max_atlas_size)
+            break;
+
+        /* glyph() continues packing at the stored shelf, which must lie
+           within the atlas */
+        int64_t width = header.atlas_size[0], height = header.atlas_size[1];
+        if (header.shelf_pos[0] < 0 || header.shelf_pos[1] < 0 ||
+            header.shelf_height < 0 || header.shelf_pos[0] > width ||
+            (int64_t) header.shelf_pos[1] + header.shelf_height > height)
+            break;
+
+        /* The glyph records and the atlas must fit into the file */
+        size_t atlas_bytes = (size_t) width * (size_t) height,
+               remaining = (size_t) file_size - sizeof(SDFCacheHeader);
+        if (atlas_bytes > remaining ||
+            header.glyph_count > (remaining - atlas_bytes) / sizeof(SDFCacheGlyph))
+            break;
+
+        glyphs.resize(header.glyph_count);
+        if (header.glyph_count > 0 &&
+            fread(glyphs.data(), sizeof(SDFCacheGlyph), header.glyph_count,
+                  file) != header.glyph_count)
+            break;
+
+        bool valid = true;
+        for (const SDFCacheGlyph &cg : glyphs)
+            valid &= cg.pos[0] >= 0 && cg.pos[1] >= 0 && cg.size[0] >= 0 && cg.size[1] >= 0 &&
+                     (int64_t) cg.pos[0] + cg.size[0] <= width &&
+                     (int64_t) cg.pos[1] + cg.size[1] <= height;
+        if (!valid)
+            break;
+
+        atlas.reset(new uint8_t[atlas_bytes]);
+        if (fread(atlas.get(), 1, atlas_bytes, file) != atlas_bytes)
+            break;
+
+        success = true;
+    } while (false);
+
+    fclose(file);
+    if (!success)
+        return false;
+
+    m_glyphs.clear();
+    for (const SDFCacheGlyph &cg : glyphs) {
+        Glyph g;
+        g.pos = Vector2i(cg.pos[0], cg.pos[1]);
+        g.size = Vector2i(cg.size[0], cg.size[1]);
+        g.offset = Vector2f(cg.offset[0], cg.offset[1]);
+        g.advance = cg.advance;
+        g.index = cg.index;
+        m_glyphs[cg.codepoint] = g;
+    }
+
+    m_atlas = std::move(atlas);
+    m_shelf_pos = Vector2i(header.shelf_pos[0], header.shelf_pos[1]);
+    m_shelf_height = header.shelf_height;
+    if (m_atlas_size != Vector2i(header.atlas_size[0], header.atlas_size[1])) {
+        m_atlas_size = Vector2i(header.atlas_size[0], header.atlas_size[1]);
+        m_texture->resize(m_atlas_size);
+    }
+    m_texture_stale = true;
+    update_texture();
+
+    return true;
+}
+
+void SDFFont::save_cache(const std::string &directory) const {
+    /* Write to a temporary file first so that other processes never
+       observe a partially written cache */
+    std::string filename = cache_filename(directory),
+                tmp_filename = __nanogui_temporary_filename(filename);
+    FILE *file = fopen(tmp_filename.c_str(), "wb");
+    if (!file)
+        throw std::runtime_error("SDFFont::save_cache(): could not open \"" +
+                                 tmp_filename + "\" for writing!");
+
+    SDFCacheHeader header;
+    memset(&header, 0, sizeof(SDFCacheHeader));
+    memcpy(header.magic, sdf_cache_magic, sizeof(sdf_cache_magic));
+    header.font_hash = m_font_hash;
+    header.glyph_size = m_glyph_size;
+    header.padding = m_padding;
+    header.atlas_size[0] = m_atlas_size.x();
+    header.atlas_size[1] = m_atlas_size.y();
+    header.shelf_pos[0] = m_shelf_pos.x();
+    header.shelf_pos[1] = m_shelf_pos.y();
+    header.shelf_height = m_shelf_height;
+    header.glyph_count = (uint32_t) m_glyphs.size();
+
+    std::vector<SDFCacheGlyph> glyphs;
+    glyphs.reserve(m_glyphs.size());
+    for (const auto &kv : m_glyphs) {
+        const Glyph &g = kv.second;
+        SDFCacheGlyph cg;
+        cg.codepoint = kv.first;
+        cg.pos[0] = g.pos.x(); cg.pos[1] = g.pos.y();
+        cg.size[0] = g.size.x(); cg.size[1] = g.size.y();
+        cg.offset[0] = g.offset.x(); cg.offset[1] = g.offset.y();
+        cg.advance = g.advance;
+        cg.index = g.index;
+        glyphs.push_back(cg);
+    }
+
+    size_t atlas_bytes = (size_t) m_atlas_size.x() * (size_t) m_atlas_size.y();
+    bool success =
+        fwrite(&header, sizeof(SDFCacheHeader), 1, file) == 1 &&
+        fwrite(glyphs.data(), sizeof(SDFCacheGlyph), glyphs.size(), file) == glyphs.size() &&
+        fwrite(m_atlas.get(), 1, atlas_bytes, file) == atlas_bytes;
+
+    success &= fclose(file) == 0;
+    if (!success || std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        std::remove(tmp_filename.c_str());
+        throw std::runtime_error("SDFFont::save_cache(): could not write \"" +
+                                 filename + "\"!");
+    }
+}
+
+float SDFFont::layout(const Vector2f &pos, float font_size, int align,
+                      const std::string &text, std::vector<float> *positions,
+                      std::vector<float> *uvs) {
+    float f = font_size / (float) m_glyph_size;
+    const char *ptr = text.c_str(), *end = ptr + text.size();
+
+    /* First pass: compute the advance for horizontal alignment */
+    float width = 0.f;
+    int prev_index = -1;
+    while (ptr < end) {
+        const Glyph &g = glyph(utf8_next(ptr, end));
+        if (prev_index >= 0)
+            width += stbtt_GetGlyphKernAdvance(&m_info->info, prev_index, g.index) * m_scale;
+        width += g.advance;
+        prev_index = g.index;
+    }
+    width *= f;
+
+    if (!positions)
+        return width;
+
+    Vector2f pen = pos;
+    if (align & NVG_ALIGN_CENTER)
+        pen.x() -= width * .5f;
+    else if (align & NVG_ALIGN_RIGHT)
+        pen.x() -= width;
+
+    if (align & NVG_ALIGN_TOP)
+        pen.y() += m_ascent * f;
+    else if (align & NVG_ALIGN_MIDDLE)
+        pen.y() += (m_ascent + m_descent) * .5f * f;
+    else if (align & NVG_ALIGN_BOTTOM)
+        pen.y() += m_descent * f;
+
+    /* Second pass: emit two triangles per visible glyph */
+    Vector2f inv_atlas_size = 1.f / Vector2f(m_atlas_size);
+    ptr = text.c_str();
+    prev_index = -1;
+    while (ptr < end) {
+        const Glyph &g = glyph(utf8_next(ptr, end));
+        if (prev_index >= 0)
+            pen.x() += stbtt_GetGlyphKernAdvance(&m_info->info, prev_index, g.index) * m_scale * f;
+        prev_index = g.index;
+
+        if (g.size.x() > 0 && g.size.y() > 0) {
+            Vector2f p0 = pen + g.offset * f,
+                     p1 = p0 + Vector2f(g.size) * f,
+                     t0 = Vector2f(g.pos) * inv_atlas_size,
+                     t1 = Vector2f(g.pos + g.size) * inv_atlas_size;
+
+            const float p[12] = { p0.x(), p0.y(), p1.x(), p0.y(), p1.x(), p1.y(),
+                                  p0.x(), p0.y(), p1.x(), p1.y(), p0.x(), p1.y() };
+            const float t[12] = { t0.x(), t0.y(), t1.x(), t0.y(), t1.x(), t1.y(),
+                                  t0.x(), t0.y(), t1.x(), t1.y(), t0.x(), t1.y() };
+            positions->insert(positions->end(), p, p + 12);
+            uvs->insert(uvs->end(), t, t + 12);
+        }
+
+        pen.x() += g.advance * f;
+    }
+
+    return width;
+}
+
+float SDFFont::text_width(float font_size, const std::string &text) {
+    return layout(Vector2f(0.f), font_size, 0, text, nullptr, nullptr);
+}
+
+void SDFFont::update_texture() {
+    if (m_texture_stale) {
+        m_texture->upload(m_atlas.get());
+        m_upload_count++;
+    } else if (m_dirty_begin != m_dirty_end) {
+        /* Rows are contiguous in memory, upload the modified band only */
+        m_texture->upload_sub_region(
+            m_atlas.get() + (size_t) m_dirty_begin * m_atlas_size.x(),
+            Vector2i(0, m_dirty_begin),
+            Vector2i(m_atlas_size.x(), m_dirty_end - m_dirty_begin));
+        m_upload_count++;
+    }
+    m_texture_stale = false;
+    m_dirty_begin = m_dirty_end = 0;
+}
+
+void SDFFont::set_outline(const Color &color, float width) {
+    if (width < 0.f)
+        throw std::runtime_error("SDFFont::set_outline(): width must be nonnegative!");
+    m_outline_color = color;
+    m_outline_width = width;
+}
+
+void SDFFont::draw(const Matrix4f &mvp, size_t vertex_count, float font_size,
+                   float opacity) {
+    /* Distance field values per reference pixel */
+    float unit = (128.f / m_padding) / 255.f;
+
+    /* Half a device pixel worth of distance on either side of the edge */
+    float device_scale = font_size * m_pixel_ratio / (float) m_glyph_size;
+    float smoothing = std::min(.5f, .5f * unit / std::max(device_scale, 1e-3f));
+
+    /* The outline can't extend beyond the padding of the distance field */
+    float outline = std::min(.45f, m_outline_width * m_glyph_size * unit);
+
+    m_shader->set_uniform("mvp", mvp);
+    m_shader->set_uniform("smoothing", smoothing);
+    m_shader->set_uniform("outline", outline);
+    m_shader->set_uniform("outline_color", m_outline_color);
+    m_shader->set_uniform("opacity", opacity);
+
+    m_shader->begin();
+    m_shader->draw_array(Shader::PrimitiveType::Triangle, 0, vertex_count);
+    m_shader->end();
+}
+
+void SDFFont::draw_text(const Matrix4f &mvp, const Vector2f &pos,
+                        float font_size, int align, const Color &color,
+                        const std::string &text) {
+    m_positions.clear();
+    m_uvs.clear();
+    layout(pos, font_size, align, text, &m_positions, &m_uvs);
+    update_texture();
+
+    size_t vertex_count = m_positions.size() / 2;
+    if (vertex_count == 0)
+        return;
+
+    m_colors.resize(vertex_count * 4);
+    for (size_t i = 0; i < vertex_count * 4; ++i)
+        m_colors[i] = color[i % 4];
+
+    m_shader->set_buffer("position", VariableType::Float32, { vertex_count, 2 },
+                         m_positions.data());
+    m_shader->set_buffer("uv", VariableType::Float32, { vertex_count, 2 },
+                         m_uvs.data());
+    m_shader->set_buffer("color", VariableType::Float32, { vertex_count, 4 },
+                         m_colors.data());
+    m_batch_uploaded = false;
+
+    draw(mvp, vertex_count, font_size, 1.f);
+}
+
+void SDFFont::rescale_batch(size_t vertex_count) {
+    if (m_batch_atlas_size == m_atlas_size)
+        return;
+
+    /* Texture coordinates are normalized by the atlas size at layout time */
+    Vector2f factor = Vector2f(m_batch_atlas_size) / Vector2f(m_atlas_size);
+    for (size_t i = 0; i < vertex_count; ++i) {
+        m_batch_uvs[2 * i]     *= factor.x();
+        m_batch_uvs[2 * i + 1] *= factor.y();
+    }
+
+    m_batch_atlas_size = m_atlas_size;
+    m_batch_uploaded = false;
+}
+
+void SDFFont::add_text(const Vector2f &pos, float font_size, int align,
+                       const Color &color, const std::string &text) {
+    if (m_batch_positions.empty())
+        m_batch_atlas_size = m_atlas_size;
+
+    size_t offset = m_batch_positions.size() / 2;
+    layout(pos, font_size, align, text, &m_batch_positions, &m_batch_uvs);
+
+    /* Laying out new glyphs may have grown the atlas */
+    rescale_batch(offset);
+
+    size_t vertex_count = m_batch_positions.size() / 2;
+    m_batch_colors.resize(vertex_count * 4);
+    for (size_t i = offset * 4; i < vertex_count * 4; ++i)
+        m_batch_colors[i] = color[i % 4];
+
+    m_batch_font_size = font_size;
+    m_batch_uploaded = false;
+}
+
+void SDFFont::clear_batch() {
+    m_batch_positions.clear();
+    m_batch_uvs.clear();
+    m_batch_colors.clear();
+    m_batch_uploaded = false;
+}
+
+void SDFFont::draw_batch(const Matrix4f &mvp, float opacity) {
+    size_t vertex_count = m_batch_positions.size() / 2;
+    if (vertex_count == 0)
+        return;
+
+    rescale_batch(vertex_count);
+    update_texture();
+
+    if (!m_batch_uploaded) {
+        m_shader->set_buffer("position", VariableType::Float32, { vertex_count, 2 },
+                             m_batch_positions.data());
+        m_shader->set_buffer("uv", VariableType::Float32, { vertex_count, 2 },
+                             m_batch_uvs.data());
+        m_shader->set_buffer("color", VariableType::Float32, { vertex_count, 4 },
+                             m_batch_colors.data());
+        m_batch_uploaded = true;
+    }
+
+    draw(mvp, vertex_count, m_batch_font_size, opacity);
+}
+
+NAMESPACE_END(nanogui)
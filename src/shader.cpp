@@ -1,7 +1,39 @@
 #include <nanogui/shader.h>
+#include <atomic>
+#include <mutex>
 
 NAMESPACE_BEGIN(nanogui)
 
+static std::mutex binary_cache_mutex;
+static std::string binary_cache_directory_value;
+static std::atomic<size_t> binary_cache_hit_count { 0 };
+static std::atomic<size_t> binary_cache_miss_count { 0 };
+
+void Shader::set_binary_cache_directory(const std::string &directory) {
+    std::lock_guard<std::mutex> guard(binary_cache_mutex);
+    binary_cache_directory_value = directory;
+}
+
+std::string Shader::binary_cache_directory() {
+    std::lock_guard<std::mutex> guard(binary_cache_mutex);
+    return binary_cache_directory_value;
+}
+
+size_t Shader::binary_cache_hits() {
+    return binary_cache_hit_count;
+}
+
+size_t Shader::binary_cache_misses() {
+    return binary_cache_miss_count;
+}
+
+void Shader::count_binary_cache_access(bool hit) {
+    if (hit)
+        binary_cache_hit_count++;
+    else
+        binary_cache_miss_count++;
+}
+
 std::string Shader::Buffer::to_string() const {
     std::string result = "Buffer[type=";
     switch (type) {
@@ -9,6 +41,7 @@ std::string Shader::Buffer::to_string() const {
         case BufferType::FragmentBuffer: result += "fragment"; break;
         case BufferType::UniformBuffer: result += "uniform"; break;
         case BufferType::IndexBuffer: result += "index"; break;
+        case BufferType::UniformBlock: result += "uniform block"; break;
         default: result += "unknown"; break;
     }
     result += ", dtype=";
@@ -23,4 +56,120 @@ std::string Shader::Buffer::to_string() const {
     return result;
 }
 
+Shader::Buffer &Shader::add_buffer(const std::string &name, BufferType type) {
+    if (m_buffer_handles.find(name) != m_buffer_handles.end())
+        throw std::runtime_error(
+            "Shader::Shader(): \"" + name +
+            "\": duplicate argument name in shader code!");
+
+    m_buffer_handles[name] = m_buffers.size();
+    Buffer &buf = m_buffers.emplace_back();
+    buf.name = name;
+    buf.type = type;
+    return buf;
+}
+
+Shader::Buffer &Shader::buffer(size_t handle, const char *caller) {
+    if (handle >= m_buffers.size())
+        throw std::runtime_error(std::string("Shader::") + caller +
+                                 "(): invalid argument handle!");
+    return m_buffers[handle];
+}
+
+size_t Shader::argument_handle(const std::string &name) const {
+    auto it = m_buffer_handles.find(name);
+    if (it == m_buffer_handles.end())
+        throw std::runtime_error(
+            "Shader::argument_handle(): could not find argument named \"" + name + "\"");
+    return it->second;
+}
+
+void Shader::update_buffer_range(size_t handle, size_t offset, VariableType dtype,
+                                 size_t ndim, const size_t *shape, const void *data) {
+    Buffer &buf = buffer(handle, "update_buffer_range");
+
+    bool mismatch = ndim != buf.ndim || dtype != buf.dtype || ndim == 0;
+    for (size_t i = 1; i < ndim; ++i)
+        mismatch |= shape[i] != buf.shape[i];
+
+    if (mismatch) {
+        Buffer arg;
+        arg.type = buf.type;
+        arg.ndim = ndim;
+        for (size_t i = 0; i < 3; ++i)
+            arg.shape[i] = i < arg.ndim ? shape[i] : 1;
+        arg.dtype = dtype;
+        throw std::runtime_error("Shader::update_buffer_range(\"" + buf.name +
+                                 "\"): shape/dtype mismatch: expected " + buf.to_string() +
+                                 ", got " + arg.to_string());
+    }
+
+    update_buffer_range(handle, offset, shape[0], data);
+}
+
+void Shader::set_buffer_usage(size_t handle, BufferUsage usage) {
+    Buffer &buf = buffer(handle, "set_buffer_usage");
+    if (!(buf.type == VertexBuffer || buf.type == FragmentBuffer ||
+          buf.type == IndexBuffer))
+        throw std::runtime_error(
+            "Shader::set_buffer_usage(): argument named \"" + buf.name +
+            "\" is not a vertex or index buffer!");
+    buf.usage = usage;
+}
+
+std::vector<size_t>
+Shader::interleaved_handles(const std::vector<VertexAttribute> &attributes, size_t stride) {
+    if (stride == 0)
+        throw std::runtime_error("Shader::set_interleaved_buffer(): stride must be nonzero!");
+
+    std::vector<size_t> handles;
+    handles.reserve(attributes.size());
+
+    for (const VertexAttribute &attr : attributes) {
+        if (attr.components < 1 || attr.components > 4)
+            throw std::runtime_error("Shader::set_interleaved_buffer(): attribute \"" +
+                                     attr.name + "\" must have 1-4 components!");
+        else if (attr.offset + type_size(attr.type) * attr.components > stride)
+            throw std::runtime_error("Shader::set_interleaved_buffer(): attribute \"" +
+                                     attr.name + "\" exceeds the stride!");
+        else if (attr.normalized && (attr.type == VariableType::Float16 ||
+                                     attr.type == VariableType::Float32 ||
+                                     attr.type == VariableType::Float64))
+            throw std::runtime_error("Shader::set_interleaved_buffer(): attribute \"" +
+                                     attr.name + "\": only integer components can be normalized!");
+
+        auto it = m_buffer_handles.find(attr.name);
+        if (it == m_buffer_handles.end()) {
+            handles.push_back((size_t) -1);
+            continue;
+        }
+
+        if (m_buffers[it->second].type != VertexBuffer)
+            throw std::runtime_error("Shader::set_interleaved_buffer(): argument named \"" +
+                                     attr.name + "\" is not a vertex attribute!");
+        handles.push_back(it->second);
+    }
+
+    return handles;
+}
+
+void Shader::set_instance_divisor(size_t handle, size_t divisor) {
+    Buffer &buf = buffer(handle, "set_instance_divisor");
+    if (buf.type != VertexBuffer)
+        throw std::runtime_error(
+            "Shader::set_instance_divisor(): argument named \"" + buf.name +
+            "\" is not a vertex attribute!");
+#if defined(NANOGUI_USE_GLES) && NANOGUI_GLES_VERSION == 2
+    if (divisor != 0)
+        throw std::runtime_error(
+            "Shader::set_instance_divisor(): instancing is not supported on GLES 2!");
+#endif
+    buf.divisor = divisor;
+    buf.dirty = true;
+}
+
+size_t Shader::uniform_block_size(const std::string &name) const {
+    return m_buffers[argument_handle(name)].block_size;
+}
+
 NAMESPACE_END(nanogui)
@@ -4,11 +4,28 @@
 #include <nanogui/texture.h>
 #include <nanogui/renderpass.h>
 #include "opengl_check.h"
+#include <cstring>
 
 #if !defined(GL_HALF_FLOAT)
 #  define GL_HALF_FLOAT 0x140B
 #endif
 
+/* Program binaries require OpenGL 4.1 (or ARB_get_program_binary) or OpenGL ES 3 */
+#if defined(GL_PROGRAM_BINARY_RETRIEVABLE_HINT) && \
+    (defined(NANOGUI_USE_OPENGL) || NANOGUI_GLES_VERSION >= 3)
+#  define NANOGUI_PROGRAM_BINARY
+#endif
+
+/* Unsynchronized buffer mapping and fences require OpenGL 3 or OpenGL ES 3 */
+#if defined(NANOGUI_USE_OPENGL) || (defined(NANOGUI_USE_GLES) && NANOGUI_GLES_VERSION >= 3)
+#  define NANOGUI_STREAM_RING
+#endif
+
+/* Instanced rendering requires OpenGL 3.3 or OpenGL ES 3 */
+#if defined(NANOGUI_USE_OPENGL) || (defined(NANOGUI_USE_GLES) && NANOGUI_GLES_VERSION >= 3)
+#  define NANOGUI_INSTANCING
+#endif
+
 NAMESPACE_BEGIN(nanogui)
 
 static GLuint compile_gl_shader(GLenum type,
@@ -49,13 +66,245 @@ static GLuint compile_gl_shader(GLenum type,
     return id;
 }
 
-Shader::Shader(RenderPass *render_pass,
-               const std::string &name,
-               const std::string &vertex_shader,
-               const std::string &fragment_shader,
-               BlendMode blend_mode)
-    : m_render_pass(render_pass), m_name(name), m_blend_mode(blend_mode), m_shader_handle(0) {
+using UniformSetter = void (*)(int, const void *);
+
+/// Select the glUniform*() call for a uniform with the given dtype and shape
+static UniformSetter gl_uniform_setter(VariableType dtype, size_t ndim, size_t n) {
+    if (ndim == 2) {
+        if (dtype != VariableType::Float32)
+            return nullptr;
+        switch (n) {
+            case 2: return [](int i, const void *v) { CHK(glUniformMatrix2fv(i, 1, GL_FALSE, (const GLfloat *) v)); };
+            case 3: return [](int i, const void *v) { CHK(glUniformMatrix3fv(i, 1, GL_FALSE, (const GLfloat *) v)); };
+            case 4: return [](int i, const void *v) { CHK(glUniformMatrix4fv(i, 1, GL_FALSE, (const GLfloat *) v)); };
+            default: return nullptr;
+        }
+    } else if (ndim > 2) {
+        return nullptr;
+    }
+
+    switch (dtype) {
+        case VariableType::Float32:
+            switch (n) {
+                case 1: return [](int i, const void *v) { CHK(glUniform1fv(i, 1, (const GLfloat *) v)); };
+                case 2: return [](int i, const void *v) { CHK(glUniform2fv(i, 1, (const GLfloat *) v)); };
+                case 3: return [](int i, const void *v) { CHK(glUniform3fv(i, 1, (const GLfloat *) v)); };
+                case 4: return [](int i, const void *v) { CHK(glUniform4fv(i, 1, (const GLfloat *) v)); };
+                default: return nullptr;
+            }
+
+        case VariableType::Int32:
+            switch (n) {
+                case 1: return [](int i, const void *v) { CHK(glUniform1iv(i, 1, (const GLint *) v)); };
+                case 2: return [](int i, const void *v) { CHK(glUniform2iv(i, 1, (const GLint *) v)); };
+                case 3: return [](int i, const void *v) { CHK(glUniform3iv(i, 1, (const GLint *) v)); };
+                case 4: return [](int i, const void *v) { CHK(glUniform4iv(i, 1, (const GLint *) v)); };
+                default: return nullptr;
+            }
+
+#if defined(NANOGUI_USE_OPENGL)
+        case VariableType::UInt32:
+            switch (n) {
+                case 1: return [](int i, const void *v) { CHK(glUniform1uiv(i, 1, (const GLuint *) v)); };
+                case 2: return [](int i, const void *v) { CHK(glUniform2uiv(i, 1, (const GLuint *) v)); };
+                case 3: return [](int i, const void *v) { CHK(glUniform3uiv(i, 1, (const GLuint *) v)); };
+                case 4: return [](int i, const void *v) { CHK(glUniform4uiv(i, 1, (const GLuint *) v)); };
+                default: return nullptr;
+            }
+#endif
+
+        /* Booleans are stored as bytes on the host side */
+        case VariableType::Bool:
+            switch (n) {
+                case 1: return [](int i, const void *v) { const uint8_t *b = (const uint8_t *) v;
+                                                          CHK(glUniform1i(i, b[0])); };
+                case 2: return [](int i, const void *v) { const uint8_t *b = (const uint8_t *) v;
+                                                          CHK(glUniform2i(i, b[0], b[1])); };
+                case 3: return [](int i, const void *v) { const uint8_t *b = (const uint8_t *) v;
+                                                          CHK(glUniform3i(i, b[0], b[1], b[2])); };
+                case 4: return [](int i, const void *v) { const uint8_t *b = (const uint8_t *) v;
+                                                          CHK(glUniform4i(i, b[0], b[1], b[2], b[3])); };
+                default: return nullptr;
+            }
+
+        default:
+            return nullptr;
+    }
+}
+
+/// Identifies (and versions) the file format of the program binary cache
+static const char program_binary_magic[4] = { 'N', 'G', 'P', '1' };
+
+/// 64-bit FNV-1a hash, used to name the files of the program binary cache
+static uint64_t fnv1a_hash(const std::string &str) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : str) {
+        hash ^= (uint8_t) c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool Shader::load_program_binary(const std::string &filename, const std::string &key) {
+#if defined(NANOGUI_PROGRAM_BINARY)
+    std::vector<uint8_t> data;
+    FILE *f = fopen(filename.c_str(), "rb");
+    if (!f)
+        return false;
+    fseek(f, 0, SEEK_END);
+    long file_size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    bool success = file_size > 0;
+    if (success) {
+        data.resize((size_t) file_size);
+        success = fread(data.data(), 1, data.size(), f) == data.size();
+    }
+    fclose(f);
+    if (!success)
+        return false;
+
+    size_t pos = 0;
+    auto read = [&](void *out, size_t size) {
+        if (pos + size > data.size())
+            return false;
+        memcpy(out, data.data() + pos, size);
+        pos += size;
+        return true;
+    };
+    auto read_u32 = [&](uint32_t &value) { return read(&value, sizeof(uint32_t)); };
+
+    /* The cached key includes the driver version and the full shader source */
+    uint32_t key_size = 0;
+    if (!read_u32(key_size) || key_size != key.size() || pos + key_size > data.size() ||
+        memcmp(data.data() + pos, key.data(), key_size) != 0)
+        return false;
+    pos += key_size;
+
+    std::vector<Buffer> buffers;
+    uint32_t buffer_count = 0;
+    if (!read_u32(buffer_count))
+        return false;
+    for (uint32_t i = 0; i < buffer_count; ++i) {
+        Buffer buf;
+        uint32_t name_size = 0, type = 0, dtype = 0, ndim = 0, shape[3], block_size = 0;
+        int32_t index = 0, texture_unit = 0;
+        if (!read_u32(name_size) || pos + name_size > data.size())
+            return false;
+        buf.name.assign((const char *) data.data() + pos, name_size);
+        pos += name_size;
+        if (!read_u32(type) || !read_u32(dtype) || !read(&index, sizeof(int32_t)) ||
+            !read_u32(ndim) || !read(shape, sizeof(shape)) ||
+            !read(&texture_unit, sizeof(int32_t)) || !read_u32(block_size))
+            return false;
+        buf.type = (BufferType) type;
+        buf.dtype = (VariableType) dtype;
+        buf.index = index;
+        buf.ndim = ndim;
+        for (int j = 0; j < 3; ++j)
+            buf.shape[j] = shape[j];
+        buf.texture_unit = texture_unit;
+        buf.block_size = block_size;
+        if (buf.type == UniformBuffer) {
+            buf.uniform_setter = gl_uniform_setter(buf.dtype, buf.ndim, buf.shape[0]);
+            if (!buf.uniform_setter)
+                return false;
+        }
+        buffers.push_back(std::move(buf));
+    }
+
+    uint32_t binary_format = 0, binary_size = 0;
+    if (!read_u32(binary_format) || !read_u32(binary_size) ||
+        pos + binary_size != data.size())
+        return false;
+
+    /* The driver may reject the binary (e.g. after an update), in which
+       case the program is compiled from source instead */
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, (GLenum) binary_format, data.data() + pos, (GLsizei) binary_size);
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    while (glGetError() != GL_NO_ERROR)
+        ;
+    if (status != GL_TRUE) {
+        glDeleteProgram(program);
+        return false;
+    }
 
+    m_shader_handle = program;
+    for (Buffer &buf : buffers) {
+        Buffer &buf2 = add_buffer(buf.name, buf.type);
+        buf2 = std::move(buf);
+    }
+    return true;
+#else
+    (void) filename; (void) key;
+    return false;
+#endif
+}
+
+void Shader::store_program_binary(const std::string &filename, const std::string &key) {
+#if defined(NANOGUI_PROGRAM_BINARY)
+    GLint binary_size = 0;
+    CHK(glGetProgramiv(m_shader_handle, GL_PROGRAM_BINARY_LENGTH, &binary_size));
+    if (binary_size <= 0)
+        return;
+
+    std::vector<uint8_t> binary((size_t) binary_size);
+    GLenum binary_format = 0;
+    CHK(glGetProgramBinary(m_shader_handle, binary_size, nullptr, &binary_format,
+                           binary.data()));
+
+    std::vector<uint8_t> data;
+    auto write = [&](const void *ptr, size_t size) {
+        data.insert(data.end(), (const uint8_t *) ptr, (const uint8_t *) ptr + size);
+    };
+    auto write_u32 = [&](size_t value) {
+        uint32_t value_u32 = (uint32_t) value;
+        write(&value_u32, sizeof(uint32_t));
+    };
+    auto write_i32 = [&](int value) {
+        int32_t value_i32 = (int32_t) value;
+        write(&value_i32, sizeof(int32_t));
+    };
+
+    write_u32(key.size());
+    write(key.data(), key.size());
+    write_u32(m_buffers.size());
+    for (const Buffer &buf : m_buffers) {
+        write_u32(buf.name.size());
+        write(buf.name.data(), buf.name.size());
+        write_u32((size_t) buf.type);
+        write_u32((size_t) buf.dtype);
+        write_i32(buf.index);
+        write_u32(buf.ndim);
+        for (int i = 0; i < 3; ++i)
+            write_u32(buf.shape[i]);
+        write_i32(buf.texture_unit);
+        write_u32(buf.block_size);
+    }
+    write_u32(binary_format);
+    write_u32(binary.size());
+    write(binary.data(), binary.size());
+
+    /* Write to a temporary file first so that concurrently starting
+       applications never observe partially written programs */
+    std::string tmp_file = __nanogui_temporary_filename(filename);
+    FILE *f = fopen(tmp_file.c_str(), "wb");
+    if (!f)
+        return;
+    bool success = fwrite(data.data(), 1, data.size(), f) == data.size();
+    success &= fclose(f) == 0;
+    if (!success || std::rename(tmp_file.c_str(), filename.c_str()) != 0)
+        std::remove(tmp_file.c_str());
+#else
+    (void) filename; (void) key;
+#endif
+}
+
+void Shader::link_program(const std::string &vertex_shader,
+                          const std::string &fragment_shader,
+                          bool retrievable) {
+    const std::string &name = m_name;
     GLuint vertex_shader_handle   = compile_gl_shader(GL_VERTEX_SHADER,   name, vertex_shader),
            fragment_shader_handle = compile_gl_shader(GL_FRAGMENT_SHADER, name, fragment_shader);
 
@@ -64,6 +313,12 @@ Shader::Shader(RenderPass *render_pass,
     GLint status;
     CHK(glAttachShader(m_shader_handle, vertex_shader_handle));
     CHK(glAttachShader(m_shader_handle, fragment_shader_handle));
+#if defined(NANOGUI_PROGRAM_BINARY)
+    if (retrievable)
+        CHK(glProgramParameteri(m_shader_handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+#else
+    (void) retrievable;
+#endif
     CHK(glLinkProgram(m_shader_handle));
     CHK(glDeleteShader(vertex_shader_handle));
     CHK(glDeleteShader(fragment_shader_handle));
@@ -81,21 +336,27 @@ Shader::Shader(RenderPass *render_pass,
     CHK(glGetProgramiv(m_shader_handle, GL_ACTIVE_ATTRIBUTES, &attribute_count));
     CHK(glGetProgramiv(m_shader_handle, GL_ACTIVE_UNIFORMS, &uniform_count));
 
+    /* The index buffer always occupies the first entry of the binding table */
+    Buffer &indices = add_buffer("indices", IndexBuffer);
+    indices.index = -1;
+    indices.ndim = 1;
+    indices.shape[0] = 0;
+    indices.shape[1] = indices.shape[2] = 1;
+    indices.dtype = VariableType::UInt32;
+
+    int texture_count = 0;
+
     auto register_buffer = [&](BufferType type, const std::string &name,
                                int index, GLenum gl_type) {
-        if (m_buffers.find(name) != m_buffers.end())
-            throw std::runtime_error(
-                "Shader::Shader(): duplicate attribute/uniform name in shader code!");
-        else if (name == "indices")
+        if (name == "indices")
             throw std::runtime_error(
                 "Shader::Shader(): argument name 'indices' is reserved!");
 
-        Buffer &buf = m_buffers[name];
+        Buffer &buf = add_buffer(name, type);
         for (int i = 0; i < 3; ++i)
             buf.shape[i] = 1;
         buf.ndim = 1;
         buf.index = index;
-        buf.type = type;
 
         switch (gl_type) {
             case GL_FLOAT:
@@ -202,6 +463,7 @@ Shader::Shader(RenderPass *render_pass,
                 buf.dtype = VariableType::Invalid;
                 buf.ndim = 0;
                 buf.type = FragmentTexture;
+                buf.texture_unit = texture_count++;
                 break;
 
             default:
@@ -215,6 +477,12 @@ Shader::Shader(RenderPass *render_pass,
             }
             buf.shape[0] = 0;
             buf.ndim++;
+        } else if (buf.type == UniformBuffer) {
+            buf.uniform_setter = gl_uniform_setter(buf.dtype, buf.ndim, buf.shape[0]);
+            if (!buf.uniform_setter)
+                throw std::runtime_error("Shader::Shader(): uniform \"" + name +
+                                         "\" has an unsupported dtype/shape "
+                                         "configuration: " + buf.to_string());
         }
     };
 
@@ -234,17 +502,103 @@ Shader::Shader(RenderPass *render_pass,
         GLint size = 0;
         CHK(glGetActiveUniform(m_shader_handle, i, sizeof(uniform_name), nullptr,
                                &size, &type, uniform_name));
+#if defined(NANOGUI_USE_OPENGL) || (defined(NANOGUI_USE_GLES) && NANOGUI_GLES_VERSION >= 3)
+        /* Members of uniform blocks are provided by a uniform buffer */
+        GLuint uniform_index = (GLuint) i;
+        GLint block_index = -1;
+        CHK(glGetActiveUniformsiv(m_shader_handle, 1, &uniform_index,
+                                  GL_UNIFORM_BLOCK_INDEX, &block_index));
+        if (block_index != -1)
+            continue;
+#endif
         GLint index = glGetUniformLocation(m_shader_handle, uniform_name);
         register_buffer(UniformBuffer, uniform_name, index, type);
     }
 
-    Buffer &buf = m_buffers["indices"];
-    buf.index = -1;
-    buf.ndim = 1;
-    buf.shape[0] = 0;
-    buf.shape[1] = buf.shape[2] = 1;
-    buf.type = IndexBuffer;
-    buf.dtype = VariableType::UInt32;
+#if defined(NANOGUI_USE_OPENGL) || (defined(NANOGUI_USE_GLES) && NANOGUI_GLES_VERSION >= 3)
+    GLint block_count = 0;
+    CHK(glGetProgramiv(m_shader_handle, GL_ACTIVE_UNIFORM_BLOCKS, &block_count));
+
+    for (int i = 0; i < block_count; ++i) {
+        char block_name[128];
+        GLint data_size = 0;
+        CHK(glGetActiveUniformBlockName(m_shader_handle, i, sizeof(block_name),
+                                        nullptr, block_name));
+        CHK(glGetActiveUniformBlockiv(m_shader_handle, i,
+                                      GL_UNIFORM_BLOCK_DATA_SIZE, &data_size));
+        if (strcmp(block_name, "indices") == 0)
+            throw std::runtime_error(
+                "Shader::Shader(): argument name 'indices' is reserved!");
+
+        Buffer &buf = add_buffer(block_name, UniformBlock);
+        buf.index = i;
+        buf.block_size = (size_t) data_size;
+    }
+#endif
+}
+
+Shader::Shader(RenderPass *render_pass,
+               const std::string &name,
+               const std::string &vertex_shader,
+               const std::string &fragment_shader,
+               BlendMode blend_mode)
+    : m_render_pass(render_pass), m_name(name), m_blend_mode(blend_mode), m_shader_handle(0) {
+    std::string cache_file, cache_key;
+    bool cached = false;
+
+#if defined(NANOGUI_PROGRAM_BINARY)
+    std::string cache_directory = binary_cache_directory();
+    GLint binary_formats = 0;
+    if (!cache_directory.empty())
+        CHK(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_formats));
+
+    if (binary_formats > 0) {
+        /* Program binaries are only valid for the driver that created them */
+        cache_key = std::string(program_binary_magic, 4) + "\n" +
+                    (const char *) glGetString(GL_VENDOR) + "\n" +
+                    (const char *) glGetString(GL_RENDERER) + "\n" +
+                    (const char *) glGetString(GL_VERSION) + "\n" +
+                    vertex_shader + '\0' + fragment_shader;
+
+        char filename[32];
+        snprintf(filename, sizeof(filename), "/%016llx.glprog",
+                 (unsigned long long) fnv1a_hash(cache_key));
+        cache_file = cache_directory + filename;
+        cached = load_program_binary(cache_file, cache_key);
+        count_binary_cache_access(cached);
+    }
+#endif
+
+    if (!cached) {
+        link_program(vertex_shader, fragment_shader, !cache_file.empty());
+        if (!cache_file.empty())
+            store_program_binary(cache_file, cache_key);
+    }
+
+#if defined(NANOGUI_USE_OPENGL) || (defined(NANOGUI_USE_GLES) && NANOGUI_GLES_VERSION >= 3)
+    /* Each uniform block uses the binding point matching its index */
+    for (const Buffer &buf : m_buffers) {
+        if (buf.type == UniformBlock)
+            CHK(glUniformBlockBinding(m_shader_handle, (GLuint) buf.index, (GLuint) buf.index));
+    }
+#endif
+
+    /* Samplers refer to fixed texture units, which only need to be
+       specified once */
+    bool has_textures = false;
+    for (const Buffer &buf : m_buffers)
+        has_textures |= buf.texture_unit >= 0;
+
+    if (has_textures) {
+        GLint current_program = 0;
+        CHK(glGetIntegerv(GL_CURRENT_PROGRAM, &current_program));
+        CHK(glUseProgram(m_shader_handle));
+        for (const Buffer &buf : m_buffers) {
+            if (buf.texture_unit >= 0)
+                CHK(glUniform1i(buf.index, buf.texture_unit));
+        }
+        CHK(glUseProgram((GLuint) current_program));
+    }
 
 #if defined(NANOGUI_USE_OPENGL)
     CHK(glGenVertexArrays(1, &m_vertex_array_handle));
@@ -253,24 +607,88 @@ Shader::Shader(RenderPass *render_pass,
 #endif
 }
 
+static GLenum gl_vertex_type(VariableType type) {
+    switch (type) {
+        case VariableType::Int8:    return GL_BYTE;
+        case VariableType::UInt8:   return GL_UNSIGNED_BYTE;
+        case VariableType::Int16:   return GL_SHORT;
+        case VariableType::UInt16:  return GL_UNSIGNED_SHORT;
+        case VariableType::Int32:   return GL_INT;
+        case VariableType::UInt32:  return GL_UNSIGNED_INT;
+        case VariableType::Float16: return GL_HALF_FLOAT;
+        case VariableType::Float32: return GL_FLOAT;
+        default:                    return 0;
+    }
+}
+
+static GLenum gl_buffer_usage(Shader::BufferUsage usage) {
+    switch (usage) {
+        case Shader::BufferUsage::Static: return GL_STATIC_DRAW;
+        case Shader::BufferUsage::Stream: return GL_STREAM_DRAW;
+        default:                          return GL_DYNAMIC_DRAW;
+    }
+}
+
+#if defined(NANOGUI_STREAM_RING)
+static void delete_fences(void *(&fences)[Shader::stream_ring_size]) {
+    for (void *&fence : fences) {
+        if (fence)
+            CHK(glDeleteSync((GLsync) fence));
+        fence = nullptr;
+    }
+}
+#endif
+
+#if defined(NANOGUI_USE_OPENGL)
+/* The element array buffer binding is vertex array object state. Index
+   buffer uploads temporarily bind the shader's own VAO so that the one
+   currently bound (by another shader, or by NanoVG) is left untouched. */
+struct VertexArrayScope {
+    VertexArrayScope(GLuint handle, bool active) : active(active) {
+        if (!active)
+            return;
+        GLint current = 0;
+        CHK(glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &current));
+        previous = (GLuint) current;
+        CHK(glBindVertexArray(handle));
+    }
+
+    ~VertexArrayScope() {
+        if (active)
+            glBindVertexArray(previous);
+    }
+
+    GLuint previous = 0;
+    bool active;
+};
+#endif
+
 Shader::~Shader() {
+    for (Buffer &buf : m_buffers) {
+        if (!buf.buffer)
+            continue;
+        if ((buf.type == VertexBuffer && !buf.shared) || buf.type == IndexBuffer) {
+            GLuint buffer_id = (GLuint) ((uintptr_t) buf.buffer);
+            CHK(glDeleteBuffers(1, &buffer_id));
+        } else if (buf.type == UniformBuffer) {
+            delete[] (uint8_t *) buf.buffer;
+        }
+#if defined(NANOGUI_STREAM_RING)
+        delete_fences(buf.stream_fences);
+#endif
+    }
     CHK(glDeleteProgram(m_shader_handle));
 #if defined(NANOGUI_USE_OPENGL)
     CHK(glDeleteVertexArrays(1, &m_vertex_array_handle));
 #endif
 }
 
-void Shader::set_buffer(const std::string &name,
+void Shader::set_buffer(size_t handle,
                         VariableType dtype,
                         size_t ndim,
                         const size_t *shape,
                         const void *data) {
-    auto it = m_buffers.find(name);
-    if (it == m_buffers.end())
-        throw std::runtime_error(
-            "Shader::set_buffer(): could not find argument named \"" + name + "\"");
-
-    Buffer &buf = m_buffers[name];
+    Buffer &buf = buffer(handle, "set_buffer");
 
     bool mismatch = ndim != buf.ndim || dtype != buf.dtype;
     for (size_t i = (buf.type == UniformBuffer ? 0 : 1); i < ndim; ++i)
@@ -283,7 +701,7 @@ void Shader::set_buffer(const std::string &name,
         for (size_t i = 0; i < 3; ++i)
             arg.shape[i] = i < arg.ndim ? shape[i] : 1;
         arg.dtype = dtype;
-        throw std::runtime_error("Buffer::set_buffer(\"" + name +
+        throw std::runtime_error("Buffer::set_buffer(\"" + buf.name +
                                  "\"): shape/dtype mismatch: expected " + buf.to_string() +
                                  ", got " + arg.to_string());
     }
@@ -303,17 +721,27 @@ void Shader::set_buffer(const std::string &name,
             buf.buffer = new uint8_t[size];
         memcpy(buf.buffer, data, size);
     } else {
-        GLuint buffer_id = 0;
-        if (buf.buffer) {
-            buffer_id = (GLuint) ((uintptr_t) buf.buffer);
-        } else {
-            CHK(glGenBuffers(1, &buffer_id));
-            buf.buffer = (void *) ((uintptr_t) buffer_id);
+        if (buf.type == VertexBuffer) {
+            buf.gl_type = gl_vertex_type(dtype);
+            if (!buf.gl_type)
+                throw std::runtime_error(
+                    "Shader::set_buffer(): unsupported vertex buffer type!");
+
+            /* Scalar attributes ('float' etc.) are specified with ndim=1 */
+            if (ndim != 1 && ndim != 2)
+                throw std::runtime_error("\"" + m_name + "\": vertex attribute \"" + buf.name +
+                                         "\" has an invalid shapeension (expected ndim=1/2, got " +
+                                         std::to_string(ndim) + ")");
+
+            /* The attribute no longer belongs to an interleaved buffer */
+            if (buf.stride != 0)
+                detach_buffer(buf);
+            buf.stride = buf.vertex_offset = 0;
+            buf.components = buf.shape[1];
+            buf.normalized = false;
         }
-        GLenum buf_type = (name == "indices")
-            ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
-        CHK(glBindBuffer(buf_type, buffer_id));
-        CHK(glBufferData(buf_type, size, data, GL_DYNAMIC_DRAW));
+
+        upload_buffer(buf, data, size);
     }
 
     buf.dtype = dtype;
@@ -322,185 +750,280 @@ void Shader::set_buffer(const std::string &name,
     buf.dirty = true;
 }
 
-void Shader::set_texture(const std::string &name, Texture *texture) {
-    auto it = m_buffers.find(name);
-    if (it == m_buffers.end())
+void Shader::update_buffer_range(size_t handle, size_t offset,
+                                 size_t count, const void *data) {
+    Buffer &buf = buffer(handle, "update_buffer_range");
+    if (!(buf.type == VertexBuffer || buf.type == IndexBuffer))
+        throw std::runtime_error(
+            "Shader::update_buffer_range(): argument named \"" + buf.name +
+            "\" is not a vertex or index buffer!");
+    else if (!buf.buffer)
         throw std::runtime_error(
-            "Shader::set_texture(): could not find argument named \"" + name + "\"");
-    Buffer &buf = m_buffers[name];
+            "Shader::update_buffer_range(): buffer \"" + buf.name +
+            "\" must be uploaded using set_buffer() first!");
+    else if (offset + count > buf.shape[0])
+        throw std::runtime_error(
+            "Shader::update_buffer_range(): range exceeds the size of buffer \"" +
+            buf.name + "\"!");
+
+    if (count == 0)
+        return;
+
+    size_t entry_size = buf.size / buf.shape[0];
+    GLenum buf_type = buf.type == IndexBuffer
+        ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+#if defined(NANOGUI_USE_OPENGL)
+    VertexArrayScope vertex_array(m_vertex_array_handle, buf.type == IndexBuffer);
+#endif
+    CHK(glBindBuffer(buf_type, (GLuint) ((uintptr_t) buf.buffer)));
+    CHK(glBufferSubData(buf_type, (GLintptr) (buf.stream_offset + offset * entry_size),
+                        (GLsizeiptr) (count * entry_size), data));
+}
+
+void Shader::set_interleaved_buffer(const std::vector<VertexAttribute> &attributes,
+                                    size_t stride, size_t count, const void *data) {
+    std::vector<size_t> handles = interleaved_handles(attributes, stride);
+
+    /* The first attribute in the caller's list that the shader declares owns the storage */
+    Buffer *owner = nullptr;
+    for (size_t i = 0; i < attributes.size(); ++i) {
+        if (handles[i] == (size_t) -1)
+            continue;
+
+        const VertexAttribute &attr = attributes[i];
+        Buffer &buf = m_buffers[handles[i]];
+        buf.gl_type = gl_vertex_type(attr.type);
+        if (!buf.gl_type)
+            throw std::runtime_error("Shader::set_interleaved_buffer(): attribute \"" +
+                                     attr.name + "\" has an unsupported type!");
+
+        detach_buffer(buf);
+        if (!owner) {
+            upload_buffer(buf, data, stride * count);
+            owner = &buf;
+        } else {
+            if (buf.buffer) {
+                GLuint buffer_id = (GLuint) ((uintptr_t) buf.buffer);
+                CHK(glDeleteBuffers(1, &buffer_id));
+#if defined(NANOGUI_STREAM_RING)
+                delete_fences(buf.stream_fences);
+                buf.stream_segment_size = 0;
+#endif
+            }
+            buf.buffer = owner->buffer;
+            buf.stream_offset = owner->stream_offset;
+            buf.shared = true;
+        }
+
+        buf.shape[0]      = count;
+        buf.size          = stride * count;
+        buf.stride        = stride;
+        buf.vertex_offset = attr.offset;
+        buf.components    = attr.components;
+        buf.normalized    = attr.normalized;
+        buf.dirty         = true;
+    }
+}
+
+void Shader::detach_buffer(Buffer &buf) {
+    if (buf.shared) {
+        /* Leave the storage to its owner */
+        buf.buffer = nullptr;
+        buf.shared = false;
+        buf.stream_offset = 0;
+        return;
+    }
+
+    /* Attributes that share the storage become unbound */
+    for (Buffer &other : m_buffers) {
+        if (other.shared && other.buffer == buf.buffer) {
+            other.buffer = nullptr;
+            other.shared = false;
+            other.stream_offset = 0;
+        }
+    }
+}
+
+void Shader::upload_buffer(Buffer &buf, const void *data, size_t size) {
+    GLuint buffer_id = 0;
+    if (buf.buffer) {
+        buffer_id = (GLuint) ((uintptr_t) buf.buffer);
+    } else {
+        CHK(glGenBuffers(1, &buffer_id));
+        buf.buffer = (void *) ((uintptr_t) buffer_id);
+#if defined(NANOGUI_STREAM_RING)
+        delete_fences(buf.stream_fences);
+        buf.stream_segment_size = 0;
+#endif
+    }
+    GLenum buf_type = buf.type == IndexBuffer
+        ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+#if defined(NANOGUI_USE_OPENGL)
+    VertexArrayScope vertex_array(m_vertex_array_handle, buf.type == IndexBuffer);
+#endif
+    CHK(glBindBuffer(buf_type, buffer_id));
+
+#if defined(NANOGUI_STREAM_RING)
+    if (buf.usage == BufferUsage::Stream) {
+        stream_buffer(buf, buf_type, data, size);
+    } else {
+        delete_fences(buf.stream_fences);
+        buf.stream_offset = buf.stream_segment_size = 0;
+        CHK(glBufferData(buf_type, size, data, gl_buffer_usage(buf.usage)));
+    }
+#else
+    CHK(glBufferData(buf_type, size, data, gl_buffer_usage(buf.usage)));
+#endif
+}
+
+#if defined(NANOGUI_STREAM_RING)
+void Shader::stream_buffer(Buffer &buf, uint32_t target, const void *data, size_t size) {
+    size_t segment = 0;
+
+    if (buf.stream_segment_size >= size) {
+        /* Draw calls issued so far read the current segment: fence it and
+           move on to the next one, which the GPU has likely finished with */
+        segment = buf.stream_offset / buf.stream_segment_size;
+        buf.stream_fences[segment] = (void *) glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        segment = (segment + 1) % stream_ring_size;
+
+        GLsync fence = (GLsync) buf.stream_fences[segment];
+        if (fence) {
+            GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+            while (true) {
+                GLenum status = glClientWaitSync(fence, flags, 1000000000ull);
+                if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+                    break;
+                else if (status == GL_WAIT_FAILED)
+                    throw std::runtime_error("Shader::set_buffer(): waiting for the GPU failed!");
+                flags = 0;
+            }
+            CHK(glDeleteSync(fence));
+            buf.stream_fences[segment] = nullptr;
+        }
+    } else {
+        /* (Re-)allocate the ring. Pending draw calls keep using the
+           orphaned storage, hence the fences are no longer needed. */
+        delete_fences(buf.stream_fences);
+        buf.stream_segment_size = (size + 255) / 256 * 256;
+        CHK(glBufferData(target, (GLsizeiptr) (buf.stream_segment_size * stream_ring_size),
+                         nullptr, GL_STREAM_DRAW));
+    }
+
+    buf.stream_offset = segment * buf.stream_segment_size;
+
+    void *ptr = glMapBufferRange(target, (GLintptr) buf.stream_offset, (GLsizeiptr) size,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                 GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!ptr)
+        throw std::runtime_error("Shader::set_buffer(): could not map buffer \"" +
+                                 buf.name + "\"!");
+    memcpy(ptr, data, size);
+    CHK(glUnmapBuffer(target));
+}
+#endif
+
+void Shader::set_texture(size_t handle, Texture *texture) {
+    Buffer &buf = buffer(handle, "set_texture");
     if (!(buf.type == VertexTexture || buf.type == FragmentTexture))
         throw std::runtime_error(
-            "Shader::set_texture(): argument named \"" + name + "\" is not a texture!");
+            "Shader::set_texture(): argument named \"" + buf.name + "\" is not a texture!");
 
     buf.buffer = (void *) ((uintptr_t) texture->texture_handle());
-    buf.dirty  = true;
 }
 
-void Shader::begin() {
-    int texture_unit = 0;
+void Shader::set_uniform_buffer(size_t handle, nanogui::UniformBuffer *block,
+                                size_t offset) {
+    Buffer &buf = buffer(handle, "set_uniform_buffer");
+    if (buf.type != UniformBlock)
+        throw std::runtime_error(
+            "Shader::set_uniform_buffer(): argument named \"" + buf.name +
+            "\" is not a uniform block!");
+    else if (!block)
+        throw std::runtime_error(
+            "Shader::set_uniform_buffer(): uniform buffer must not be null!");
+    else if (offset % block->offset_alignment() != 0)
+        throw std::runtime_error(
+            "Shader::set_uniform_buffer(): offset must be a multiple of " +
+            std::to_string(block->offset_alignment()) + " bytes!");
+    else if (offset + buf.block_size > block->size())
+        throw std::runtime_error(
+            "Shader::set_uniform_buffer(): uniform block \"" + buf.name + "\" (" +
+            std::to_string(buf.block_size) + " bytes) exceeds the end of the buffer!");
+
+    buf.block = block;
+    buf.offset = offset;
+}
 
+void Shader::begin() {
     CHK(glUseProgram(m_shader_handle));
 
 #if defined(NANOGUI_USE_OPENGL)
     CHK(glBindVertexArray(m_vertex_array_handle));
 #endif
 
-    for (auto &[key, buf] : m_buffers) {
-        bool indices = key == "indices";
+    for (Buffer &buf : m_buffers) {
+#if defined(NANOGUI_USE_OPENGL) || (defined(NANOGUI_USE_GLES) && NANOGUI_GLES_VERSION >= 3)
+        if (buf.block) {
+            /* Binding points are shared with other shaders */
+            CHK(glBindBufferRange(GL_UNIFORM_BUFFER, (GLuint) buf.index,
+                                  buf.block->buffer_handle(), (GLintptr) buf.offset,
+                                  (GLsizeiptr) buf.block_size));
+            continue;
+        }
+#endif
+
         if (!buf.buffer) {
-            if (!indices)
+            if (buf.type != IndexBuffer)
                 fprintf(stderr,
                         "Shader::begin(): shader \"%s\" has an unbound "
                         "argument \"%s\"!\n",
-                        m_name.c_str(), key.c_str());
+                        m_name.c_str(), buf.name.c_str());
             continue;
         }
 
         GLuint buffer_id = (GLuint) ((uintptr_t) buf.buffer);
-        GLenum gl_type = 0;
-
-#if defined(NANOGUI_USE_OPENGL)
-        if (!buf.dirty && buf.type != VertexTexture && buf.type != FragmentTexture)
-            continue;
-#endif
 
-        bool uniform_error = false;
         switch (buf.type) {
-            case IndexBuffer:
-                CHK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer_id));
-                break;
-
-            case VertexBuffer:
-                CHK(glBindBuffer(GL_ARRAY_BUFFER, buffer_id));
-                CHK(glEnableVertexAttribArray(buf.index));
-
-                switch (buf.dtype) {
-                    case VariableType::Int8:    gl_type = GL_BYTE;           break;
-                    case VariableType::UInt8:   gl_type = GL_UNSIGNED_BYTE;  break;
-                    case VariableType::Int16:   gl_type = GL_SHORT;          break;
-                    case VariableType::UInt16:  gl_type = GL_UNSIGNED_SHORT; break;
-                    case VariableType::Int32:   gl_type = GL_INT;            break;
-                    case VariableType::UInt32:  gl_type = GL_UNSIGNED_INT;   break;
-                    case VariableType::Float16: gl_type = GL_HALF_FLOAT;     break;
-                    case VariableType::Float32: gl_type = GL_FLOAT;          break;
-                    default:
-                        throw std::runtime_error(
-                            "Shader::begin(): unsupported vertex buffer type!");
-                }
-
-                if (buf.ndim != 2)
-                    throw std::runtime_error("\"" + m_name + "\": vertex attribute \"" + key +
-                                             "\" has an invalid shapeension (expected ndim=2, got " +
-                                             std::to_string(buf.ndim) + ")");
-
-                CHK(glVertexAttribPointer(buf.index, (GLint) buf.shape[1],
-                                          gl_type, GL_FALSE, 0, nullptr));
-                break;
-
             case VertexTexture:
             case FragmentTexture:
-                CHK(glActiveTexture(GL_TEXTURE0 + texture_unit));
-                CHK(glBindTexture(GL_TEXTURE_2D, (GLuint) ((uintptr_t) buf.buffer)));
-                if (buf.dirty)
-                    CHK(glUniform1i(buf.index, texture_unit));
-                texture_unit++;
-                break;
+                /* Texture units are shared with NanoVG and other shaders */
+                CHK(glActiveTexture(GL_TEXTURE0 + buf.texture_unit));
+                CHK(glBindTexture(GL_TEXTURE_2D, buffer_id));
+                continue;
 
             case UniformBuffer:
-                if (buf.ndim > 2)
-                    throw std::runtime_error("\"" + m_name + "\": uniform attribute \"" + key +
-                                             "\" has an invalid shapeension (expected ndim=0/1/2, got " +
-                                             std::to_string(buf.ndim) + ")");
-                switch (buf.dtype) {
-                    case VariableType::Float32:
-                        if (buf.ndim < 2) {
-                            const float *v = (const float *) buf.buffer;
-                            switch (buf.shape[0]) {
-                                case 1: CHK(glUniform1f(buf.index, v[0])); break;
-                                case 2: CHK(glUniform2f(buf.index, v[0], v[1])); break;
-                                case 3: CHK(glUniform3f(buf.index, v[0], v[1], v[2])); break;
-                                case 4: CHK(glUniform4f(buf.index, v[0], v[1], v[2], v[3])); break;
-                                default: uniform_error = true; break;
-                            }
-                        } else if (buf.ndim == 2 && buf.shape[0] == buf.shape[1]) {
-                            const float *v = (const float *) buf.buffer;
-                            switch (buf.shape[0]) {
-                                case 2: CHK(glUniformMatrix2fv(buf.index, 1, GL_FALSE, v)); break;
-                                case 3: CHK(glUniformMatrix3fv(buf.index, 1, GL_FALSE, v)); break;
-                                case 4: CHK(glUniformMatrix4fv(buf.index, 1, GL_FALSE, v)); break;
-                                default: uniform_error = true; break;
-                            }
-                        } else {
-                            uniform_error = true;
-                        }
-                        break;
-
-#if defined(NANOGUI_USE_GLES)
-                    case VariableType::UInt32:
-#endif
-                    case VariableType::Int32: {
-                            const int32_t *v = (const int32_t *) buf.buffer;
-                            if (buf.ndim < 2) {
-                                switch (buf.shape[0]) {
-                                    case 1: CHK(glUniform1i(buf.index, v[0])); break;
-                                    case 2: CHK(glUniform2i(buf.index, v[0], v[1])); break;
-                                    case 3: CHK(glUniform3i(buf.index, v[0], v[1], v[2])); break;
-                                    case 4: CHK(glUniform4i(buf.index, v[0], v[1], v[2], v[3])); break;
-                                    default: uniform_error = true; break;
-                                }
-                            } else {
-                                uniform_error = true;
-                            }
-                        }
-                        break;
+                /* Uniform values persist in the program object */
+                if (buf.dirty)
+                    buf.uniform_setter(buf.index, buf.buffer);
+                break;
 
+            case IndexBuffer:
+            case VertexBuffer:
 #if defined(NANOGUI_USE_OPENGL)
-                    case VariableType::UInt32: {
-                            const uint32_t *v = (const uint32_t *) buf.buffer;
-                            if (buf.ndim < 2) {
-                                switch (buf.shape[0]) {
-                                    case 1: CHK(glUniform1ui(buf.index, v[0])); break;
-                                    case 2: CHK(glUniform2ui(buf.index, v[0], v[1])); break;
-                                    case 3: CHK(glUniform3ui(buf.index, v[0], v[1], v[2])); break;
-                                    case 4: CHK(glUniform4ui(buf.index, v[0], v[1], v[2], v[3])); break;
-                                    default: uniform_error = true; break;
-                                }
-                            } else {
-                                uniform_error = true;
-                            }
-                        }
-                        break;
-#endif
-
-                    case VariableType::Bool: {
-                            const uint8_t *v = (const uint8_t *) buf.buffer;
-                            if (buf.ndim < 2) {
-                                switch (buf.shape[0]) {
-                                    case 1: CHK(glUniform1i(buf.index, v[0])); break;
-                                    case 2: CHK(glUniform2i(buf.index, v[0], v[1])); break;
-                                    case 3: CHK(glUniform3i(buf.index, v[0], v[1], v[2])); break;
-                                    case 4: CHK(glUniform4i(buf.index, v[0], v[1], v[2], v[3])); break;
-                                    default: uniform_error = true; break;
-                                }
-                            } else {
-                                uniform_error = true;
-                            }
-                        }
-                        break;
-
-                    default:
-                        uniform_error = true;
-                        break;
+                /* .. and vertex bindings in the vertex array object */
+                if (!buf.dirty)
+                    continue;
+#endif
+                if (buf.type == IndexBuffer) {
+                    CHK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer_id));
+                } else {
+                    CHK(glBindBuffer(GL_ARRAY_BUFFER, buffer_id));
+                    CHK(glEnableVertexAttribArray(buf.index));
+                    CHK(glVertexAttribPointer(buf.index, (GLint) buf.components, buf.gl_type,
+                                              buf.normalized ? GL_TRUE : GL_FALSE,
+                                              (GLsizei) buf.stride,
+                                              (const void *) (buf.stream_offset +
+                                                              buf.vertex_offset)));
+#if defined(NANOGUI_INSTANCING)
+                    CHK(glVertexAttribDivisor(buf.index, (GLuint) buf.divisor));
+#endif
                 }
-
-                if (uniform_error)
-                    throw std::runtime_error("\"" + m_name + "\": uniform attribute \"" + key +
-                                             "\" has an unsupported dtype/shape configuration: " + buf.to_string());
                 break;
 
             default:
-                throw std::runtime_error("\"" + m_name + "\": uniform attribute \"" + key +
-                                         "\" has an unsupported dtype/shape configuration:" + buf.to_string());
+                throw std::runtime_error("\"" + m_name + "\": argument \"" + buf.name +
+                                         "\" has an unsupported type: " + buf.to_string());
         }
 
         buf.dirty = false;
@@ -525,33 +1048,65 @@ void Shader::end() {
         CHK(glDisable(GL_PROGRAM_POINT_SIZE));
     CHK(glBindVertexArray(0));
 #else
-    for (const auto &[key, buf] : m_buffers) {
+    for (const Buffer &buf : m_buffers) {
         if (buf.type != VertexBuffer)
             continue;
         CHK(glDisableVertexAttribArray(buf.index));
+#  if defined(NANOGUI_INSTANCING)
+        /* Without vertex array objects, divisors are global state */
+        if (buf.divisor != 0)
+            CHK(glVertexAttribDivisor(buf.index, 0));
+#  endif
     }
 #endif
     CHK(glUseProgram(0));
 }
 
+static GLenum gl_primitive_type(Shader::PrimitiveType primitive_type, const char *caller) {
+    switch (primitive_type) {
+        case Shader::PrimitiveType::Point:         return GL_POINTS;
+        case Shader::PrimitiveType::Line:          return GL_LINES;
+        case Shader::PrimitiveType::LineStrip:     return GL_LINE_STRIP;
+        case Shader::PrimitiveType::Triangle:      return GL_TRIANGLES;
+        case Shader::PrimitiveType::TriangleStrip: return GL_TRIANGLE_STRIP;
+        default: throw std::runtime_error(std::string("Shader::") + caller +
+                                          "(): invalid primitive type!");
+    }
+}
+
 void Shader::draw_array(PrimitiveType primitive_type,
                         size_t offset, size_t count,
                         bool indexed) {
-    GLenum primitive_type_gl;
-    switch (primitive_type) {
-        case PrimitiveType::Point:         primitive_type_gl = GL_POINTS;         break;
-        case PrimitiveType::Line:          primitive_type_gl = GL_LINES;          break;
-        case PrimitiveType::LineStrip:     primitive_type_gl = GL_LINE_STRIP;     break;
-        case PrimitiveType::Triangle:      primitive_type_gl = GL_TRIANGLES;      break;
-        case PrimitiveType::TriangleStrip: primitive_type_gl = GL_TRIANGLE_STRIP; break;
-        default: throw std::runtime_error("Shader::draw_array(): invalid primitive type!");
-    }
+    GLenum primitive_type_gl = gl_primitive_type(primitive_type, "draw_array");
 
     if (!indexed)
         CHK(glDrawArrays(primitive_type_gl, (GLint) offset, (GLsizei) count));
     else
         CHK(glDrawElements(primitive_type_gl, (GLsizei) count, GL_UNSIGNED_INT,
-                           (const void *) (offset * sizeof(uint32_t))));
+                           (const void *) (m_buffers[0].stream_offset +
+                                           offset * sizeof(uint32_t))));
+}
+
+void Shader::draw_array_instanced(PrimitiveType primitive_type,
+                                  size_t offset, size_t count,
+                                  size_t instance_count,
+                                  bool indexed) {
+#if defined(NANOGUI_INSTANCING)
+    GLenum primitive_type_gl = gl_primitive_type(primitive_type, "draw_array_instanced");
+
+    if (!indexed)
+        CHK(glDrawArraysInstanced(primitive_type_gl, (GLint) offset, (GLsizei) count,
+                                  (GLsizei) instance_count));
+    else
+        CHK(glDrawElementsInstanced(primitive_type_gl, (GLsizei) count, GL_UNSIGNED_INT,
+                                    (const void *) (m_buffers[0].stream_offset +
+                                                    offset * sizeof(uint32_t)),
+                                    (GLsizei) instance_count));
+#else
+    (void) primitive_type; (void) offset; (void) count;
+    (void) instance_count; (void) indexed;
+    throw std::runtime_error("Shader::draw_array_instanced(): not supported on GLES 2!");
+#endif
 }
 
 NAMESPACE_END(nanogui)
@@ -138,60 +138,61 @@ Shader::Shader(RenderPass *render_pass,
 
     m_pipeline_state = (__bridge_retained void *) pipeline_state;
 
+    /* The index buffer always occupies the first entry of the binding table */
+    Buffer &indices = add_buffer("indices", IndexBuffer);
+    indices.index = -1;
+
     for (MTLArgument *arg in [reflection vertexArguments]) {
         std::string name = [arg.name UTF8String];
-        if (m_buffers.find(name) != m_buffers.end())
-            throw std::runtime_error(
-                "Shader::Shader(): \"" + name +
-                "\": duplicate argument name in shader code!");
-        else if (name == "indices")
+        if (name == "indices")
             throw std::runtime_error(
                 "Shader::Shader(): argument name 'indices' is reserved!");
 
-        Buffer &buf = m_buffers[name];
-        buf.index = arg.index;
+        BufferType type;
         if (arg.type == MTLArgumentTypeBuffer)
-            buf.type = VertexBuffer;
+            type = VertexBuffer;
         else if (arg.type == MTLArgumentTypeTexture)
-            buf.type = VertexTexture;
+            type = VertexTexture;
         else if (arg.type == MTLArgumentTypeSampler)
-            buf.type = VertexSampler;
+            type = VertexSampler;
         else
             throw std::runtime_error("Shader::Shader(): \"" + name +
                                      "\": unsupported argument type!");
+
+        Buffer &buf = add_buffer(name, type);
+        buf.index = arg.index;
+        if (arg.type == MTLArgumentTypeBuffer)
+            buf.block_size = arg.bufferDataSize;
     }
 
     for (MTLArgument *arg in [reflection fragmentArguments]) {
         std::string name = [arg.name UTF8String];
-        if (m_buffers.find(name) != m_buffers.end())
-            throw std::runtime_error(
-                "Shader::Shader(): \"" + name +
-                "\": duplicate argument name in shader code!");
-        else if (name == "indices")
+        if (name == "indices")
             throw std::runtime_error(
                 "Shader::Shader(): argument name 'indices' is reserved!");
 
-        Buffer &buf = m_buffers[name];
-        buf.index = arg.index;
+        BufferType type;
         if (arg.type == MTLArgumentTypeBuffer)
-            buf.type = FragmentBuffer;
+            type = FragmentBuffer;
         else if (arg.type == MTLArgumentTypeTexture)
-            buf.type = FragmentTexture;
+            type = FragmentTexture;
         else if (arg.type == MTLArgumentTypeSampler)
-            buf.type = FragmentSampler;
+            type = FragmentSampler;
         else
             throw std::runtime_error("Shader::Shader(): \"" + name +
                                      "\": unsupported argument type!");
+
+        Buffer &buf = add_buffer(name, type);
+        buf.index = arg.index;
+        if (arg.type == MTLArgumentTypeBuffer)
+            buf.block_size = arg.bufferDataSize;
     }
 
-    Buffer &buf = m_buffers["indices"];
-    buf.index = -1;
-    buf.type = IndexBuffer;
 }
 
 Shader::~Shader() {
-    for (const auto &[key, buf] : m_buffers) {
-        if (!buf.buffer)
+    for (const Buffer &buf : m_buffers) {
+        if (!buf.buffer || buf.shared)
             continue;
         if (buf.type == VertexBuffer ||
             buf.type == FragmentBuffer ||
@@ -213,25 +214,28 @@ Shader::~Shader() {
     (void) (__bridge_transfer id<MTLRenderPipelineState>) m_pipeline_state;
 }
 
-void Shader::set_buffer(const std::string &name,
+void Shader::set_buffer(size_t handle,
                         VariableType dtype,
                         size_t ndim,
                         const size_t *shape,
                         const void *data) {
-    auto it = m_buffers.find(name);
-    if (it == m_buffers.end())
-        throw std::runtime_error(
-            "Shader::set_buffer(): could not find argument named \"" + name + "\"");
-    Buffer &buf = m_buffers[name];
+    Buffer &buf = buffer(handle, "set_buffer");
     if (!(buf.type == VertexBuffer ||
           buf.type == FragmentBuffer ||
           buf.type == IndexBuffer))
         throw std::runtime_error(
-            "Shader::set_buffer(): argument named \"" + name + "\" is not a buffer!");
+            "Shader::set_buffer(): argument named \"" + buf.name + "\" is not a buffer!");
+
+    buf.block = nullptr;
 
     for (size_t i = 0; i < 3; ++i)
         buf.shape[i] = i < ndim ? shape[i] : 1;
 
+    /* The argument no longer belongs to an interleaved buffer */
+    if (buf.stride != 0)
+        detach_buffer(buf);
+    buf.stride = 0;
+
     size_t size = type_size(dtype) * buf.shape[0] * buf.shape[1] * buf.shape[2];
     if (buf.buffer && buf.size != size) {
         if (buf.size <= NANOGUI_BUFFER_THRESHOLD)
@@ -241,10 +245,23 @@ void Shader::set_buffer(const std::string &name,
         buf.buffer = nullptr;
     }
 
-    if (size <= NANOGUI_BUFFER_THRESHOLD && name != "indices") {
+    if (size <= NANOGUI_BUFFER_THRESHOLD && buf.type != IndexBuffer) {
         if (!buf.buffer)
             buf.buffer = new uint8_t[size];
         memcpy(buf.buffer, data, size);
+    } else if (buf.usage == BufferUsage::Stream) {
+        /* Replace the buffer instead of waiting for the GPU, Metal keeps the
+           previous one alive until pending command buffers have completed */
+        id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+        if (buf.buffer)
+            (void) (__bridge_transfer id<MTLBuffer>) buf.buffer;
+
+        id<MTLBuffer> mtl_buffer =
+            [device newBufferWithBytes: data
+                                length: size
+                               options: MTLResourceStorageModeShared];
+
+        buf.buffer = (__bridge_retained void *) mtl_buffer;
     } else {
         /* Procedure recommended by Apple: create a temporary shared buffer and
            blit into a private GPU-only buffer */
@@ -287,15 +304,150 @@ void Shader::set_buffer(const std::string &name,
     buf.size  = size;
 }
 
-void Shader::set_texture(const std::string &name, Texture *texture) {
-    auto it = m_buffers.find(name);
-    if (it == m_buffers.end())
+void Shader::set_interleaved_buffer(const std::vector<VertexAttribute> &attributes,
+                                    size_t stride, size_t count, const void *data) {
+    std::vector<size_t> handles = interleaved_handles(attributes, stride);
+
+    /* Vertex functions access the vertices through a struct, hence every
+       attribute declared by the shader refers to the complete buffer. The
+       first one in the caller's list owns the storage, the others borrow it */
+    Buffer *owner = nullptr;
+    for (size_t i = 0; i < attributes.size(); ++i) {
+        if (handles[i] == (size_t) -1)
+            continue;
+
+        Buffer &buf = m_buffers[handles[i]];
+        if (!owner) {
+            size_t shape[2] = { count, stride };
+            set_buffer(handles[i], VariableType::UInt8, 2, shape, data);
+            owner = &buf;
+        } else {
+            detach_buffer(buf);
+            if (buf.buffer) {
+                if (buf.size <= NANOGUI_BUFFER_THRESHOLD)
+                    delete[] (uint8_t *) buf.buffer;
+                else
+                    (void) (__bridge_transfer id<MTLBuffer>) buf.buffer;
+            }
+
+            buf.buffer = owner->buffer;
+            buf.shared = true;
+            buf.dtype  = owner->dtype;
+            buf.ndim   = owner->ndim;
+            for (size_t j = 0; j < 3; ++j)
+                buf.shape[j] = owner->shape[j];
+            buf.size   = owner->size;
+        }
+
+        buf.stride        = stride;
+        buf.vertex_offset = attributes[i].offset;
+        buf.components    = attributes[i].components;
+        buf.normalized    = attributes[i].normalized;
+    }
+}
+
+void Shader::detach_buffer(Buffer &buf) {
+    if (buf.shared) {
+        /* Leave the storage to its owner */
+        buf.buffer = nullptr;
+        buf.shared = false;
+        return;
+    }
+
+    /* Attributes that share the storage become unbound */
+    for (Buffer &other : m_buffers) {
+        if (buf.buffer && other.shared && other.buffer == buf.buffer) {
+            other.buffer = nullptr;
+            other.shared = false;
+        }
+    }
+}
+
+void Shader::update_buffer_range(size_t handle, size_t offset,
+                                 size_t count, const void *data) {
+    Buffer &buf = buffer(handle, "update_buffer_range");
+    if (!(buf.type == VertexBuffer ||
+          buf.type == FragmentBuffer ||
+          buf.type == IndexBuffer))
+        throw std::runtime_error(
+            "Shader::update_buffer_range(): argument named \"" + buf.name + "\" is not a buffer!");
+    else if (!buf.buffer)
         throw std::runtime_error(
-            "Shader::set_texture(): could not find argument named \"" + name + "\"");
-    Buffer &buf = m_buffers[name];
+            "Shader::update_buffer_range(): buffer \"" + buf.name +
+            "\" must be uploaded using set_buffer() first!");
+    else if (offset + count > buf.shape[0])
+        throw std::runtime_error(
+            "Shader::update_buffer_range(): range exceeds the size of buffer \"" +
+            buf.name + "\"!");
+
+    if (count == 0)
+        return;
+
+    size_t entry_size = buf.size / buf.shape[0];
+
+    if (buf.size <= NANOGUI_BUFFER_THRESHOLD && buf.type != IndexBuffer) {
+        memcpy((uint8_t *) buf.buffer + offset * entry_size, data,
+               count * entry_size);
+    } else if (buf.usage == BufferUsage::Stream &&
+               ((__bridge id<MTLBuffer>) buf.buffer).storageMode == MTLStorageModeShared) {
+        /* Copy on write, since pending draw calls may still read the buffer */
+        id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+        id<MTLBuffer> mtl_buffer = (__bridge id<MTLBuffer>) buf.buffer;
+
+        id<MTLBuffer> copy =
+            [device newBufferWithBytes: mtl_buffer.contents
+                                length: buf.size
+                               options: MTLResourceStorageModeShared];
+        memcpy((uint8_t *) copy.contents + offset * entry_size, data,
+               count * entry_size);
+
+        /* Switch all attributes of an interleaved buffer over to the copy,
+           the owner holds the only reference */
+        void *old_buffer = buf.buffer,
+             *new_buffer = (__bridge_retained void *) copy;
+        for (Buffer &other : m_buffers) {
+            if (other.buffer != old_buffer)
+                continue;
+            if (!other.shared)
+                (void) (__bridge_transfer id<MTLBuffer>) other.buffer;
+            other.buffer = new_buffer;
+        }
+    } else {
+        /* Blit only the modified range into the private GPU-only buffer */
+        id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+        id<MTLBuffer> mtl_buffer = (__bridge id<MTLBuffer>) buf.buffer;
+
+        id<MTLBuffer> temp_buffer =
+            [device newBufferWithBytes: data
+                                length: count * entry_size
+                               options: MTLResourceStorageModeShared];
+
+        id<MTLCommandQueue> command_queue =
+            (__bridge id<MTLCommandQueue>) metal_command_queue();
+        id<MTLCommandBuffer> command_buffer = [command_queue commandBuffer];
+        id<MTLBlitCommandEncoder> blit_encoder =
+            [command_buffer blitCommandEncoder];
+
+        [blit_encoder copyFromBuffer: temp_buffer
+                        sourceOffset: 0
+                            toBuffer: mtl_buffer
+                   destinationOffset: offset * entry_size
+                                size: count * entry_size];
+
+        [blit_encoder endEncoding];
+
+        /* Command buffers of a queue execute in order and retain the staging
+           buffer, so there is no need to wait for the copy here */
+        [command_buffer commit];
+    }
+}
+
+void Shader::set_texture(size_t handle, Texture *texture) {
+    Buffer &buf = buffer(handle, "set_texture");
     if (!(buf.type == VertexTexture || buf.type == FragmentTexture))
         throw std::runtime_error(
-            "Shader::set_texture(): argument named \"" + name + "\" is not a texture!");
+            "Shader::set_texture(): argument named \"" + buf.name + "\" is not a texture!");
+    const std::string &name = buf.name;
 
     if (buf.buffer) {
         (void) (__bridge_transfer id<MTLTexture>) buf.buffer;
@@ -311,9 +463,10 @@ void Shader::set_texture(const std::string &name, Texture *texture) {
     else
         sampler_name = name + "_sampler";
 
-    if (m_buffers.find(sampler_name) != m_buffers.end()) {
+    auto it = m_buffer_handles.find(sampler_name);
+    if (it != m_buffer_handles.end()) {
         /* Also set the sampler state */
-        Buffer &buf2 = m_buffers[sampler_name];
+        Buffer &buf2 = m_buffers[it->second];
 
         if (buf2.buffer) {
             (void) (__bridge_transfer id<MTLTexture>) buf2.buffer;
@@ -326,6 +479,29 @@ void Shader::set_texture(const std::string &name, Texture *texture) {
     }
 }
 
+void Shader::set_uniform_buffer(size_t handle, nanogui::UniformBuffer *block,
+                                size_t offset) {
+    Buffer &buf = buffer(handle, "set_uniform_buffer");
+    if (!(buf.type == VertexBuffer || buf.type == FragmentBuffer))
+        throw std::runtime_error(
+            "Shader::set_uniform_buffer(): argument named \"" + buf.name +
+            "\" is not a buffer!");
+    else if (!block)
+        throw std::runtime_error(
+            "Shader::set_uniform_buffer(): uniform buffer must not be null!");
+    else if (offset % block->offset_alignment() != 0)
+        throw std::runtime_error(
+            "Shader::set_uniform_buffer(): offset must be a multiple of " +
+            std::to_string(block->offset_alignment()) + " bytes!");
+    else if (offset + buf.block_size > block->size())
+        throw std::runtime_error(
+            "Shader::set_uniform_buffer(): argument \"" + buf.name + "\" (" +
+            std::to_string(buf.block_size) + " bytes) exceeds the end of the buffer!");
+
+    buf.block = block;
+    buf.offset = offset;
+}
+
 void Shader::begin() {
     id<MTLRenderPipelineState> pipeline_state =
         (__bridge id<MTLRenderPipelineState>) m_pipeline_state;
@@ -334,14 +510,28 @@ void Shader::begin() {
 
     [command_enc setRenderPipelineState: pipeline_state];
 
-    for (const auto &[key, buf] : m_buffers) {
+    for (const Buffer &buf : m_buffers) {
         bool indices = buf.type == IndexBuffer;
+
+        if (buf.block) {
+            id<MTLBuffer> buffer = (__bridge id<MTLBuffer>) buf.block->buffer_handle();
+            if (buf.type == VertexBuffer)
+                [command_enc setVertexBuffer: buffer
+                                      offset: buf.offset
+                                     atIndex: buf.index];
+            else
+                [command_enc setFragmentBuffer: buffer
+                                        offset: buf.offset
+                                       atIndex: buf.index];
+            continue;
+        }
+
         if (!buf.buffer) {
             if (!indices)
                 fprintf(stderr,
                         "Shader::begin(): shader \"%s\" has an unbound "
                         "argument \"%s\"!\n",
-                        m_name.c_str(), key.c_str());
+                        m_name.c_str(), buf.name.c_str());
             continue;
         }
 
@@ -402,18 +592,24 @@ void Shader::end() {
     /* No-op */
 }
 
+static MTLPrimitiveType metal_primitive_type(Shader::PrimitiveType primitive_type,
+                                             const char *caller) {
+    switch (primitive_type) {
+        case Shader::PrimitiveType::Point:         return MTLPrimitiveTypePoint;
+        case Shader::PrimitiveType::Line:          return MTLPrimitiveTypeLine;
+        case Shader::PrimitiveType::LineStrip:     return MTLPrimitiveTypeLineStrip;
+        case Shader::PrimitiveType::Triangle:      return MTLPrimitiveTypeTriangle;
+        case Shader::PrimitiveType::TriangleStrip: return MTLPrimitiveTypeTriangleStrip;
+        default: throw std::runtime_error(std::string("Shader::") + caller +
+                                          "(): invalid primitive type!");
+    }
+}
+
 void Shader::draw_array(PrimitiveType primitive_type,
                         size_t offset, size_t count,
                         bool indexed) {
-    MTLPrimitiveType primitive_type_mtl;
-    switch (primitive_type) {
-        case PrimitiveType::Point:         primitive_type_mtl = MTLPrimitiveTypePoint;         break;
-        case PrimitiveType::Line:          primitive_type_mtl = MTLPrimitiveTypeLine;          break;
-        case PrimitiveType::LineStrip:     primitive_type_mtl = MTLPrimitiveTypeLineStrip;     break;
-        case PrimitiveType::Triangle:      primitive_type_mtl = MTLPrimitiveTypeTriangle;      break;
-        case PrimitiveType::TriangleStrip: primitive_type_mtl = MTLPrimitiveTypeTriangleStrip; break;
-        default: throw std::runtime_error("Shader::draw_array(): invalid primitive type!");
-    }
+    MTLPrimitiveType primitive_type_mtl =
+        metal_primitive_type(primitive_type, "draw_array");
 
     id<MTLRenderCommandEncoder> command_enc =
         (__bridge id<MTLRenderCommandEncoder>) m_render_pass->command_encoder();
@@ -423,8 +619,9 @@ void Shader::draw_array(PrimitiveType primitive_type,
                         vertexStart: offset
                         vertexCount: count];
     } else {
+        /* Handle 0 refers to the index buffer */
         id<MTLBuffer> index_buffer =
-            (__bridge id<MTLBuffer>) m_buffers["indices"].buffer;
+            (__bridge id<MTLBuffer>) m_buffers[0].buffer;
         [command_enc drawIndexedPrimitives: primitive_type_mtl
                                 indexCount: count
                                  indexType: MTLIndexTypeUInt32
@@ -433,4 +630,31 @@ void Shader::draw_array(PrimitiveType primitive_type,
     }
 }
 
+void Shader::draw_array_instanced(PrimitiveType primitive_type,
+                                  size_t offset, size_t count,
+                                  size_t instance_count,
+                                  bool indexed) {
+    MTLPrimitiveType primitive_type_mtl =
+        metal_primitive_type(primitive_type, "draw_array_instanced");
+
+    id<MTLRenderCommandEncoder> command_enc =
+        (__bridge id<MTLRenderCommandEncoder>) m_render_pass->command_encoder();
+
+    if (!indexed) {
+        [command_enc drawPrimitives: primitive_type_mtl
+                        vertexStart: offset
+                        vertexCount: count
+                      instanceCount: instance_count];
+    } else {
+        id<MTLBuffer> index_buffer =
+            (__bridge id<MTLBuffer>) m_buffers[0].buffer;
+        [command_enc drawIndexedPrimitives: primitive_type_mtl
+                                indexCount: count
+                                 indexType: MTLIndexTypeUInt32
+                               indexBuffer: index_buffer
+                         indexBufferOffset: offset * 4
+                             instanceCount: instance_count];
+    }
+}
+
 NAMESPACE_END(nanogui)
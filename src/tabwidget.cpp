@@ -72,16 +72,11 @@ int TabWidgetBase::tab_index(int id) const {
 void TabWidgetBase::update_visibility() { /* No-op */ }
 
 void TabWidgetBase::perform_layout(NVGcontext* ctx) {
-    m_tab_offsets.clear();
-    nvgFontFace(ctx, m_font.c_str());
-    nvgFontSize(ctx, font_size());
-    nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
-
     m_tab_offsets.clear();
     int width = 0;
-    float unused[4];
     for (const std::string &label : m_tab_captions) {
-        int label_width = nvgTextBounds(ctx, 0, 0, label.c_str(), nullptr, unused);
+        int label_width = measure_text(ctx, m_font, font_size(),
+                                       NVG_ALIGN_LEFT | NVG_ALIGN_TOP, label).advance;
         m_tab_offsets.push_back(width);
         width += label_width + 2 * m_theme->m_tab_button_horizontal_padding;
         if (m_tabs_closeable)
@@ -89,20 +84,16 @@ void TabWidgetBase::perform_layout(NVGcontext* ctx) {
     }
     m_tab_offsets.push_back(width);
 
-    nvgFontFace(ctx, "icons");
-    m_close_width =
-        nvgTextBounds(ctx, 0, 0, utf8(FA_TIMES_CIRCLE).data(), nullptr, unused);
+    m_close_width = measure_text(ctx, "icons", font_size(),
+                                 NVG_ALIGN_LEFT | NVG_ALIGN_TOP,
+                                 utf8(FA_TIMES_CIRCLE)).advance;
 }
 
 Vector2i TabWidgetBase::preferred_size(NVGcontext* ctx) const {
-    nvgFontFace(ctx, m_font.c_str());
-    nvgFontSize(ctx, font_size());
-    nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
-
     int width = 0;
     for (const std::string &label : m_tab_captions) {
-        float unused[4];
-        int label_width = nvgTextBounds(ctx, 0, 0, label.c_str(), nullptr, unused);
+        int label_width = measure_text(ctx, m_font, font_size(),
+                                       NVG_ALIGN_LEFT | NVG_ALIGN_TOP, label).advance;
         width += label_width + 2 * m_theme->m_tab_button_horizontal_padding;
         if (m_tabs_closeable)
             width += m_close_width;
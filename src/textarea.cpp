@@ -26,9 +26,6 @@ TextArea::TextArea(Widget *parent) : Widget(parent),
 void TextArea::append(const std::string &text) {
     NVGcontext *ctx = screen()->nvg_context();
 
-    nvgFontSize(ctx, font_size());
-    nvgFontFace(ctx, m_font.c_str());
-
     const char *str = text.c_str();
     do {
         const char *begin = str;
@@ -39,7 +36,8 @@ void TextArea::append(const std::string &text) {
         std::string line(begin, str);
         if (line.empty())
             continue;
-        int width = nvgTextBounds(ctx, 0, 0, line.c_str(), nullptr, nullptr);
+        int width = (int) measure_text(ctx, m_font, font_size(),
+                                       NVG_ALIGN_LEFT | NVG_ALIGN_TOP, line).advance;
         m_blocks.push_back(Block { m_offset, width, line, m_foreground_color });
 
         m_offset.x() += width;
@@ -62,20 +62,21 @@ Vector2i TextBox::preferred_size(NVGcontext *ctx) const {
     Vector2i size(0, font_size() * 1.4f);
 
     float uw = 0;
-    if (m_units_image > 0) {
-        int w, h;
-        nvgImageSize(ctx, m_units_image, &w, &h);
+    if (m_units_image > 0 || nvg_is_atlas_icon(m_units_image)) {
+        Vector2i image_size = nvg_image_icon_size(ctx, m_units_image);
         float uh = size[1] * 0.4f;
-        uw = w * uh / h;
+        uw = image_size.x() * uh / image_size.y();
     } else if (!m_units.empty()) {
-        uw = nvgTextBounds(ctx, 0, 0, m_units.c_str(), nullptr, nullptr);
+        uw = measure_text(ctx, "sans", font_size(), NVG_ALIGN_LEFT | NVG_ALIGN_TOP,
+                          m_units).advance;
     }
     float sw = 0;
     if (m_spinnable) {
         sw = 14.f;
     }
 
-    float ts = nvgTextBounds(ctx, 0, 0, m_value.c_str(), nullptr, nullptr);
+    float ts = measure_text(ctx, "sans", font_size(), NVG_ALIGN_LEFT | NVG_ALIGN_TOP,
+                            m_value).advance;
     size[0] = size[1] + ts + uw + sw;
     return size;
 }
@@ -120,15 +121,14 @@ void TextBox::draw(NVGcontext* ctx) {
 
     float unit_width = 0;
 
-    if (m_units_image > 0) {
-        int w, h;
-        nvgImageSize(ctx, m_units_image, &w, &h);
+    if (m_units_image > 0 || nvg_is_atlas_icon(m_units_image)) {
+        Vector2i image_size = nvg_image_icon_size(ctx, m_units_image);
         float unit_height = m_size.y() * 0.4f;
-        unit_width = w * unit_height / h;
-        NVGpaint img_paint = nvgImagePattern(
-            ctx, m_pos.x() + m_size.x() - x_spacing - unit_width,
-            draw_pos.y() - unit_height * 0.5f, unit_width, unit_height, 0,
-            m_units_image, m_enabled ? 0.7f : 0.35f);
+        unit_width = image_size.x() * unit_height / image_size.y();
+        NVGpaint img_paint = nvg_image_icon_pattern(
+            ctx, m_units_image, m_pos.x() + m_size.x() - x_spacing - unit_width,
+            draw_pos.y() - unit_height * 0.5f, unit_width, unit_height,
+            m_enabled ? 0.7f : 0.35f);
         nvgBeginPath(ctx);
         nvgRect(ctx, m_pos.x() + m_size.x() - x_spacing - unit_width,
                 draw_pos.y() - unit_height * 0.5f, unit_width, unit_height);
@@ -136,7 +136,8 @@ void TextBox::draw(NVGcontext* ctx) {
         nvgFill(ctx);
         unit_width += 2;
     } else if (!m_units.empty()) {
-        unit_width = nvgTextBounds(ctx, 0, 0, m_units.c_str(), nullptr, nullptr);
+        unit_width = measure_text(ctx, "sans", font_size(), NVG_ALIGN_RIGHT | NVG_ALIGN_MIDDLE,
+                                  m_units).advance;
         nvgFillColor(ctx, Color(255, m_enabled ? 64 : 32));
         nvgTextAlign(ctx, NVG_ALIGN_RIGHT | NVG_ALIGN_MIDDLE);
         nvgText(ctx, m_pos.x() + m_size.x() - x_spacing, draw_pos.y(),
@@ -178,20 +179,22 @@ void TextBox::draw(NVGcontext* ctx) {
         nvgFontFace(ctx, "sans");
     }
 
+    int text_align = NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE;
     switch (m_alignment) {
         case Alignment::Left:
-            nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
+            text_align = NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE;
             draw_pos.x() += x_spacing + spin_arrows_width;
             break;
         case Alignment::Right:
-            nvgTextAlign(ctx, NVG_ALIGN_RIGHT | NVG_ALIGN_MIDDLE);
+            text_align = NVG_ALIGN_RIGHT | NVG_ALIGN_MIDDLE;
             draw_pos.x() += m_size.x() - unit_width - x_spacing;
             break;
         case Alignment::Center:
-            nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
+            text_align = NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE;
             draw_pos.x() += m_size.x() * 0.5f;
             break;
     }
+    nvgTextAlign(ctx, text_align);
 
     nvgFontSize(ctx, font_size());
     nvgFillColor(ctx, m_enabled && (!m_committed || !m_value.empty()) ?
@@ -215,9 +218,10 @@ void TextBox::draw(NVGcontext* ctx) {
     } else {
         const int max_glyphs = 1024;
         NVGglyphPosition glyphs[max_glyphs];
-        float text_bound[4];
-        nvgTextBounds(ctx, draw_pos.x(), draw_pos.y(), m_value_temp.c_str(),
-                      nullptr, text_bound);
+        TextMetrics metrics =
+            measure_text(ctx, "sans", font_size(), text_align, m_value_temp);
+        float text_bound[4] = { draw_pos.x() + metrics.bounds[0], draw_pos.y() + metrics.bounds[1],
+                                draw_pos.x() + metrics.bounds[2], draw_pos.y() + metrics.bounds[3] };
         float lineh = text_bound[3] - text_bound[1];
 
         // find cursor positions
@@ -241,8 +245,8 @@ void TextBox::draw(NVGcontext* ctx) {
 
         // draw text with offset
         nvgText(ctx, draw_pos.x(), draw_pos.y(), m_value_temp.c_str(), nullptr);
-        nvgTextBounds(ctx, draw_pos.x(), draw_pos.y(), m_value_temp.c_str(),
-                      nullptr, text_bound);
+        text_bound[0] = draw_pos.x() + metrics.bounds[0];
+        text_bound[2] = draw_pos.x() + metrics.bounds[2];
 
         // recompute cursor positions
         nglyphs = nvgTextGlyphPositions(ctx, draw_pos.x(), draw_pos.y(),
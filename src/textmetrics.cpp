@@ -0,0 +1,319 @@
+/*
+    src/textmetrics.cpp -- Thread-safe text measurement service and LRU
+    cache for text measurements shared by all widgets of a Screen
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/textmetrics.h>
+#include <nanogui/opengl.h>
+#include <nanogui_resources.h>
+#include <algorithm>
+#include <cstring>
+
+/* The font stash implementation is compiled as part of nanovg.c */
+extern "C" {
+#include "fontstash.h"
+}
+
+NAMESPACE_BEGIN(nanogui)
+
+/* Atlas size used by the font stashes, matches NanoVG's initial size */
+static const int stash_atlas_size = 512;
+
+static void stash_error_callback(void *ptr, int error, int /* value */) {
+    /* Glyph bitmaps are never rendered, simply start over when full */
+    if (error == FONS_ATLAS_FULL)
+        fonsResetAtlas((FONScontext *) ptr, stash_atlas_size, stash_atlas_size);
+}
+
+TextMetricsService *TextMetricsService::instance() {
+    static ref<TextMetricsService> service = []() {
+        ref<TextMetricsService> s = new TextMetricsService();
+        s->add_font("sans", roboto_regular_ttf, roboto_regular_ttf_size);
+        s->add_font("sans-bold", roboto_bold_ttf, roboto_bold_ttf_size);
+        s->add_font("icons", fontawesome_solid_ttf, fontawesome_solid_ttf_size);
+        s->add_font("mono", inconsolata_regular_ttf, inconsolata_regular_ttf_size);
+        return s;
+    }();
+    return service.get();
+}
+
+TextMetricsService::TextMetricsService() { }
+
+TextMetricsService::~TextMetricsService() {
+    for (FONScontext *stash : m_stashes)
+        fonsDeleteInternal(stash);
+}
+
+void TextMetricsService::add_font(const std::string &name, const uint8_t *data,
+                                  size_t size) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (const Font &font : m_fonts) {
+        if (font.name == name)
+            return;
+    }
+
+    m_fonts.push_back(Font { name, data, size });
+
+    /* Stashes that are currently in use pick up the font once released */
+    for (FONScontext *stash : m_pool) {
+        if (fonsAddFontMem(stash, name.c_str(), (unsigned char *) data,
+                           (int) size, 0) == FONS_INVALID)
+            throw std::runtime_error(
+                "TextMetricsService::add_font(): could not load font \"" +
+                name + "\"!");
+    }
+}
+
+bool TextMetricsService::has_font(const std::string &name) const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (const Font &font : m_fonts) {
+        if (font.name == name)
+            return true;
+    }
+    return false;
+}
+
+bool TextMetricsService::font_data(const std::string &name,
+                                   const uint8_t **data, size_t *size) const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (const Font &font : m_fonts) {
+        if (font.name == name) {
+            *data = font.data;
+            *size = font.size;
+            return true;
+        }
+    }
+    return false;
+}
+
+FONScontext *TextMetricsService::create_stash() const {
+    FONSparams params;
+    memset(&params, 0, sizeof(FONSparams));
+    params.width = stash_atlas_size;
+    params.height = stash_atlas_size;
+    params.flags = FONS_ZERO_TOPLEFT;
+
+    FONScontext *stash = fonsCreateInternal(&params);
+    if (!stash)
+        throw std::runtime_error(
+            "TextMetricsService::create_stash(): could not create font stash!");
+    fonsSetErrorCallback(stash, stash_error_callback, stash);
+    m_stashes.push_back(stash);
+    return stash;
+}
+
+FONScontext *TextMetricsService::acquire_stash() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    FONScontext *stash;
+    if (m_pool.empty()) {
+        stash = create_stash();
+    } else {
+        stash = m_pool.back();
+        m_pool.pop_back();
+    }
+
+    /* Load fonts that were registered since the stash was last used */
+    for (const Font &font : m_fonts) {
+        if (fonsGetFontByName(stash, font.name.c_str()) != FONS_INVALID)
+            continue;
+        if (fonsAddFontMem(stash, font.name.c_str(), (unsigned char *) font.data,
+                           (int) font.size, 0) == FONS_INVALID) {
+            m_pool.push_back(stash);
+            throw std::runtime_error(
+                "TextMetricsService::acquire_stash(): could not load font \"" +
+                font.name + "\"!");
+        }
+    }
+
+    return stash;
+}
+
+void TextMetricsService::release_stash(FONScontext *stash) const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_pool.push_back(stash);
+}
+
+bool TextMetricsService::measure(const std::string &font, float font_size,
+                                 int align, const std::string &text,
+                                 float pixel_ratio, TextMetrics &metrics) const {
+    if (!has_font(font))
+        return false;
+
+    FONScontext *stash = acquire_stash();
+
+    /* Replicates nvgTextBounds() for an untransformed context */
+    float scale = pixel_ratio, inv_scale = 1.f / scale;
+    fonsClearState(stash);
+    fonsSetFont(stash, fonsGetFontByName(stash, font.c_str()));
+    fonsSetSize(stash, font_size * scale);
+    fonsSetAlign(stash, align);
+
+    float bounds[4];
+    float advance = fonsTextBounds(stash, 0.f, 0.f, text.c_str(),
+                                   text.c_str() + text.size(), bounds);
+    fonsLineBounds(stash, 0.f, &bounds[1], &bounds[3]);
+
+    release_stash(stash);
+
+    metrics.advance = advance * inv_scale;
+    for (int i = 0; i < 4; ++i)
+        metrics.bounds[i] = bounds[i] * inv_scale;
+
+    return true;
+}
+
+/// 64-bit FNV-1a hash
+static uint64_t fnv1a(const void *data, size_t size, uint64_t hash) {
+    const uint8_t *ptr = (const uint8_t *) data;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= ptr[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static uint64_t text_metrics_hash(const std::string &font, float font_size,
+                                  int align, const std::string &text) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    hash = fnv1a(font.data(), font.size() + 1, hash);
+    hash = fnv1a(&font_size, sizeof(float), hash);
+    hash = fnv1a(&align, sizeof(int), hash);
+    hash = fnv1a(text.data(), text.size(), hash);
+    return hash;
+}
+
+TextMetricsCache::TextMetricsCache(size_t capacity)
+    : m_capacity(capacity) { }
+
+bool TextMetricsCache::lookup(uint64_t hash, const std::string &font,
+                              float font_size, int align,
+                              const std::string &text, TextMetrics &metrics) {
+    auto it = m_lookup.find(hash);
+    if (it == m_lookup.end())
+        return false;
+
+    Entry &entry = *it->second;
+    if (entry.font_size == font_size && entry.align == align &&
+        entry.font == font && entry.text == text) {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        metrics = entry.metrics;
+        return true;
+    }
+
+    /* Hash collision: drop the previous occupant of this slot */
+    m_entries.erase(it->second);
+    m_lookup.erase(it);
+    return false;
+}
+
+TextMetrics TextMetricsCache::measure(NVGcontext *ctx, const std::string &font,
+                                      float font_size, int align,
+                                      const std::string &text) {
+    uint64_t hash = text_metrics_hash(font, font_size, align, text);
+    TextMetrics metrics;
+    float pixel_ratio;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (lookup(hash, font, font_size, align, text, metrics)) {
+            m_hits++;
+            return metrics;
+        }
+        m_misses++;
+        pixel_ratio = m_pixel_ratio > 0.f ? m_pixel_ratio : 1.f;
+    }
+
+    /* Measure without holding the lock so that other threads can proceed */
+    bool success = TextMetricsService::instance()->measure(
+        font, font_size, align, text, pixel_ratio, metrics);
+
+    if (!success && !ctx)
+        return TextMetrics();
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    if (!success) {
+        /* Unknown font: ask NanoVG. This is serialized by the lock. */
+        nvgSave(ctx);
+        nvgFontFace(ctx, font.c_str());
+        nvgFontSize(ctx, font_size);
+        nvgTextAlign(ctx, align);
+        metrics.advance = nvgTextBounds(ctx, 0.f, 0.f, text.c_str(), nullptr,
+                                        metrics.bounds);
+        nvgRestore(ctx);
+    }
+
+    /* Another thread may have inserted the same string in the meantime */
+    TextMetrics unused;
+    if (!lookup(hash, font, font_size, align, text, unused)) {
+        m_entries.push_front(Entry { hash, font, font_size, align, text, metrics });
+        m_lookup[hash] = m_entries.begin();
+        evict();
+    }
+
+    return metrics;
+}
+
+void TextMetricsCache::set_pixel_ratio(float pixel_ratio) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_pixel_ratio == pixel_ratio)
+        return;
+    m_pixel_ratio = pixel_ratio;
+    m_entries.clear();
+    m_lookup.clear();
+}
+
+void TextMetricsCache::set_capacity(size_t capacity) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_capacity = capacity;
+    evict();
+}
+
+size_t TextMetricsCache::size() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_entries.size();
+}
+
+void TextMetricsCache::clear() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_entries.clear();
+    m_lookup.clear();
+}
+
+size_t TextMetricsCache::hits() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_hits;
+}
+
+size_t TextMetricsCache::misses() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_misses;
+}
+
+float TextMetricsCache::hit_rate() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    size_t total = m_hits + m_misses;
+    return total > 0 ? (float) m_hits / (float) total : 0.f;
+}
+
+void TextMetricsCache::reset_statistics() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_hits = m_misses = 0;
+}
+
+void TextMetricsCache::evict() {
+    /* Always keep the most recent entry, even when capacity == 0 */
+    while (m_entries.size() > std::max(m_capacity, (size_t) 1)) {
+        m_lookup.erase(m_entries.back().hash);
+        m_entries.pop_back();
+    }
+}
+
+NAMESPACE_END(nanogui)
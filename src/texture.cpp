@@ -1,9 +1,22 @@
 #include <nanogui/texture.h>
+#include <nanogui/pixelconvert.h>
 #include <stb_image.h>
+#include <atomic>
+#include <cstring>
 #include <memory>
 
 NAMESPACE_BEGIN(nanogui)
 
+static std::atomic<size_t> texture_allocation_count { 0 };
+
+size_t Texture::allocation_count() {
+    return texture_allocation_count;
+}
+
+void Texture::count_allocation() {
+    texture_allocation_count++;
+}
+
 Texture::Texture(PixelFormat pixel_format,
                  ComponentFormat component_format,
                  const Vector2i &size,
@@ -54,9 +67,23 @@ Texture::Texture(const std::string &filename,
     }
     PixelFormat pixel_format = m_pixel_format;
     init();
-    if (m_pixel_format != pixel_format)
-        throw std::runtime_error("Texture::Texture(): pixel format not supported by the hardware!");
-    upload((const uint8_t *) texture_data.get());
+
+    /* The backend may substitute a format (e.g. RGBA for RGB on Metal) */
+    upload((const uint8_t *) texture_data.get(), pixel_format, ComponentFormat::UInt8);
+}
+
+void Texture::upload(const uint8_t *data, PixelFormat pixel_format,
+                     ComponentFormat component_format, bool srgb) {
+    if (pixel_format == m_pixel_format && component_format == m_component_format && !srgb) {
+        upload(data);
+        return;
+    }
+
+    size_t count = (size_t) m_size.x() * (size_t) m_size.y();
+    std::unique_ptr<uint8_t[]> converted(new uint8_t[count * bytes_per_pixel()]);
+    convert_pixels(data, pixel_format, component_format, converted.get(),
+                   m_pixel_format, m_component_format, count, srgb);
+    upload(converted.get());
 }
 
 size_t Texture::bytes_per_pixel() const {
@@ -94,4 +121,76 @@ size_t Texture::channels() const {
     return result;
 }
 
+ref<TextureTransfer> Texture::next_transfer(std::vector<ref<TextureTransfer>> &ring,
+                                            size_t &index, bool download,
+                                            const char *caller) {
+    if (ring.size() < transfer_ring_size) {
+        ring.push_back(new TextureTransfer(this, download));
+        return ring.back();
+    }
+
+    /* Recycle the oldest staging buffer once the GPU is done with it */
+    ref<TextureTransfer> transfer = ring[index];
+    index = (index + 1) % transfer_ring_size;
+    if (transfer->m_state == TextureTransfer::State::Mapped)
+        throw std::runtime_error(
+            std::string("Texture::") + caller + "(): too many transfers were not submitted!");
+    transfer->wait();
+    return transfer;
+}
+
+ref<TextureTransfer> Texture::begin_upload(const Vector2i &origin, const Vector2i &size) {
+    if (m_samples > 1)
+        throw std::runtime_error("Texture::begin_upload(): only implemented for samples=1!");
+    if (origin.x() < 0 || origin.y() < 0 || size.x() <= 0 || size.y() <= 0 ||
+        origin.x() + size.x() > m_size.x() || origin.y() + size.y() > m_size.y())
+        throw std::runtime_error("Texture::begin_upload(): out of bounds!");
+
+    ref<TextureTransfer> transfer = next_transfer(m_upload_ring, m_upload_index, false, "begin_upload");
+    transfer->m_origin = origin;
+    transfer->m_size = size;
+    map_upload(transfer, (size_t) size.x() * (size_t) size.y() * bytes_per_pixel());
+    return transfer;
+}
+
+ref<TextureTransfer> Texture::upload_async(const uint8_t *data, const Vector2i &origin,
+                                           const Vector2i &size, size_t row_stride,
+                                           const Vector2i &source_origin) {
+    data = source_region("Texture::upload_async()", data, size, row_stride, source_origin);
+
+    ref<TextureTransfer> transfer = begin_upload(origin, size);
+    size_t row_size = bytes_per_pixel() * (size_t) size.x();
+
+    if (row_stride == row_size) {
+        memcpy(transfer->data(), data, transfer->size());
+    } else {
+        for (int y = 0; y < size.y(); ++y)
+            memcpy(transfer->data() + y * row_size, data + y * row_stride, row_size);
+    }
+
+    submit_upload(transfer);
+    return transfer;
+}
+
+const uint8_t *Texture::source_region(const char *func, const uint8_t *data,
+                                      const Vector2i &size, size_t &row_stride,
+                                      const Vector2i &source_origin) const {
+    size_t bpp = bytes_per_pixel(),
+           row_size = bpp * (size_t) size.x();
+
+    if (row_stride == 0)
+        row_stride = row_size;
+    else if (row_stride < row_size || row_stride % bpp != 0)
+        throw std::runtime_error(std::string(func) + ": invalid row stride!");
+
+    if (source_origin.x() < 0 || source_origin.y() < 0)
+        throw std::runtime_error(std::string(func) + ": invalid source origin!");
+
+    if (!data)
+        return nullptr;
+
+    return data + (size_t) source_origin.y() * row_stride +
+           (size_t) source_origin.x() * bpp;
+}
+
 NAMESPACE_END(nanogui)
@@ -1,6 +1,8 @@
 #include <nanogui/texture.h>
 #include <nanogui/opengl.h>
 #include "opengl_check.h"
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #if !defined(GL_HALF_FLOAT)
@@ -48,6 +50,11 @@
 #  define GL_DEPTH_COMPONENT32F 0x8CAC
 #endif
 
+/* Pixel buffer objects, fences, and GL_UNPACK_ROW_LENGTH require OpenGL 3 or OpenGL ES 3 */
+#if defined(NANOGUI_USE_OPENGL) || (defined(NANOGUI_USE_GLES) && NANOGUI_GLES_VERSION >= 3)
+#  define NANOGUI_TEXTURE_PBO
+#endif
+
 NAMESPACE_BEGIN(nanogui)
 
 static void gl_map_texture_format(Texture::PixelFormat &pixel_format,
@@ -114,6 +121,7 @@ void Texture::init() {
         if (m_flags & (uint8_t) TextureFlags::RenderTarget)
             upload(nullptr);
     } else if (m_flags & (uint8_t) TextureFlags::RenderTarget) {
+        count_allocation();
         CHK(glGenRenderbuffers(1, &m_renderbuffer_handle));
         CHK(glBindRenderbuffer(GL_RENDERBUFFER, m_renderbuffer_handle));
 #if defined(NANOGUI_USE_OPENGL)
@@ -152,6 +160,7 @@ void Texture::upload(const uint8_t *data) {
                           component_format_gl,
                           internal_format_gl);
 
+    count_allocation();
     if (m_texture_handle != 0) {
         GLenum tex_mode = m_samples > 1 ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
         CHK(glBindTexture(tex_mode, m_texture_handle));
@@ -196,7 +205,8 @@ void Texture::upload(const uint8_t *data) {
     }
 }
 
-void Texture::upload_sub_region(const uint8_t *data, const Vector2i& origin, const Vector2i& size) {
+void Texture::upload_sub_region(const uint8_t *data, const Vector2i& origin, const Vector2i& size,
+                                size_t row_stride, const Vector2i &source_origin) {
     if (m_samples > 1 && data != nullptr)
         throw std::runtime_error("Texture::upload_sub_region(): only implemented for samples=1!");
 
@@ -216,28 +226,202 @@ void Texture::upload_sub_region(const uint8_t *data, const Vector2i& origin, con
     if (origin.x() + size.x() > m_size.x() || origin.y() + size.y() > m_size.y())
         throw std::runtime_error("Texture::upload_sub_region(): out of bounds!");
 
+    data = source_region("Texture::upload_sub_region()", data, size, row_stride,
+                         source_origin);
+
     GLenum tex_mode = m_samples > 1 ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
     CHK(glBindTexture(tex_mode, m_texture_handle));
 
     if (data)
         CHK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
 
-#if defined(NANOGUI_USE_OPENGL)
+    size_t bpp = bytes_per_pixel();
+
+#if defined(NANOGUI_TEXTURE_PBO)
+    bool strided = data && row_stride != bpp * (size_t) size.x();
     if (data) {
-        CHK(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+        /* Let OpenGL skip the padding between rows of the source image */
+        CHK(glPixelStorei(GL_UNPACK_ROW_LENGTH, strided ? (GLint) (row_stride / bpp) : 0));
         CHK(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
         CHK(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
     }
+#else
+    /* OpenGL ES 2 lacks GL_UNPACK_ROW_LENGTH, repack strided rows */
+    std::unique_ptr<uint8_t[]> packed;
+    size_t row_size = bpp * (size_t) size.x();
+    if (data && row_stride != row_size) {
+        packed.reset(new uint8_t[row_size * (size_t) size.y()]);
+        for (int y = 0; y < size.y(); ++y)
+            memcpy(packed.get() + y * row_size, data + y * row_stride, row_size);
+        data = packed.get();
+    }
 #endif
 
     CHK(glTexSubImage2D(tex_mode, 0, (GLsizei) origin.x(), (GLsizei) origin.y(), (GLsizei) size.x(),
                         (GLsizei) size.y(), pixel_format_gl, component_format_gl, data));
 
+#if defined(NANOGUI_TEXTURE_PBO)
+    if (strided)
+        CHK(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+
     if (!m_mipmap_manual && (m_min_interpolation_mode == InterpolationMode::Trilinear ||
         m_mag_interpolation_mode == InterpolationMode::Trilinear))
         generate_mipmap();
 }
 
+void Texture::map_upload(TextureTransfer *transfer, size_t bytes) {
+#if defined(NANOGUI_TEXTURE_PBO)
+    if (transfer->m_buffer == 0)
+        CHK(glGenBuffers(1, &transfer->m_buffer));
+    CHK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, transfer->m_buffer));
+    if (bytes > transfer->m_capacity) {
+        CHK(glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) bytes, nullptr, GL_STREAM_DRAW));
+        transfer->m_capacity = bytes;
+    }
+
+    /* The caller waited for the fence, hence the GPU no longer reads from the buffer */
+    transfer->m_data = (uint8_t *) glMapBufferRange(
+        GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr) bytes,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    CHK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+    if (!transfer->m_data)
+        throw std::runtime_error("Texture::begin_upload(): could not map the staging buffer!");
+#else
+    if (bytes > transfer->m_capacity) {
+        transfer->m_staging.reset(new uint8_t[bytes]);
+        transfer->m_capacity = bytes;
+    }
+    transfer->m_data = transfer->m_staging.get();
+#endif
+
+    transfer->m_bytes = bytes;
+    transfer->m_state = TextureTransfer::State::Mapped;
+}
+
+void Texture::submit_upload(TextureTransfer *transfer) {
+    if (transfer->m_texture != this || transfer->m_download ||
+        transfer->m_state != TextureTransfer::State::Mapped)
+        throw std::runtime_error(
+            "Texture::submit_upload(): transfer was not started by begin_upload()!");
+
+    const Vector2i &origin = transfer->m_origin,
+                   &size   = transfer->m_size;
+
+#if defined(NANOGUI_TEXTURE_PBO)
+    GLenum pixel_format_gl,
+           component_format_gl,
+           internal_format_gl;
+
+    gl_map_texture_format(m_pixel_format,
+                          m_component_format,
+                          pixel_format_gl,
+                          component_format_gl,
+                          internal_format_gl);
+
+    (void) internal_format_gl;
+
+    CHK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, transfer->m_buffer));
+    CHK(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+    transfer->m_data = nullptr;
+
+    CHK(glBindTexture(GL_TEXTURE_2D, m_texture_handle));
+    CHK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+#if defined(NANOGUI_USE_OPENGL)
+    CHK(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+    CHK(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+    CHK(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+#endif
+
+    /* Sources from the bound pixel buffer object, returns without waiting */
+    CHK(glTexSubImage2D(GL_TEXTURE_2D, 0, (GLsizei) origin.x(), (GLsizei) origin.y(),
+                        (GLsizei) size.x(), (GLsizei) size.y(), pixel_format_gl,
+                        component_format_gl, nullptr));
+    CHK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+    if (transfer->m_fence)
+        CHK(glDeleteSync((GLsync) transfer->m_fence));
+    transfer->m_fence = (void *) glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    transfer->m_state = TextureTransfer::State::Pending;
+
+    if (!m_mipmap_manual && (m_min_interpolation_mode == InterpolationMode::Trilinear ||
+        m_mag_interpolation_mode == InterpolationMode::Trilinear))
+        generate_mipmap();
+#else
+    transfer->m_state = TextureTransfer::State::Idle;
+    transfer->m_data = nullptr;
+    upload_sub_region(transfer->m_staging.get(), origin, size);
+#endif
+}
+
+TextureTransfer::~TextureTransfer() {
+#if defined(NANOGUI_TEXTURE_PBO)
+    if (m_fence)
+        CHK(glDeleteSync((GLsync) m_fence));
+    if (m_buffer) {
+        if (m_state == State::Mapped) {
+            CHK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffer));
+            CHK(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+            CHK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+        }
+        CHK(glDeleteBuffers(1, &m_buffer));
+    }
+#endif
+}
+
+bool TextureTransfer::ready() {
+    if (m_state != State::Pending)
+        return m_state == State::Idle;
+
+#if defined(NANOGUI_TEXTURE_PBO)
+    GLenum status = glClientWaitSync((GLsync) m_fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+        return false;
+    CHK(glDeleteSync((GLsync) m_fence));
+    m_fence = nullptr;
+#endif
+
+    m_state = State::Idle;
+    return true;
+}
+
+void TextureTransfer::wait() {
+    if (m_state == State::Mapped)
+        throw std::runtime_error("TextureTransfer::wait(): transfer was not submitted!");
+    else if (m_state == State::Idle)
+        return;
+
+#if defined(NANOGUI_TEXTURE_PBO)
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while (true) {
+        GLenum status = glClientWaitSync((GLsync) m_fence, flags, 1000000000ull);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+            break;
+        else if (status == GL_WAIT_FAILED)
+            throw std::runtime_error("TextureTransfer::wait(): waiting for the GPU failed!");
+        flags = 0;
+    }
+    CHK(glDeleteSync((GLsync) m_fence));
+    m_fence = nullptr;
+#endif
+
+    m_state = State::Idle;
+}
+
+#if !defined(NANOGUI_USE_GLES)
+/// Copy rows of a packed image, optionally in reverse order (OpenGL render targets are upside down)
+static void copy_rows(uint8_t *dst, const uint8_t *src, size_t row_size, size_t rows,
+                      bool flip) {
+    if (!flip) {
+        memcpy(dst, src, row_size * rows);
+        return;
+    }
+    for (size_t y = 0; y < rows; ++y)
+        memcpy(dst + y * row_size, src + (rows - 1 - y) * row_size, row_size);
+}
+#endif
+
 void Texture::download(uint8_t *data) {
 #if defined(NANOGUI_USE_GLES)
     (void) data;
@@ -260,21 +444,100 @@ void Texture::download(uint8_t *data) {
 
     (void) internal_format_gl;
     CHK(glBindTexture(GL_TEXTURE_2D, m_texture_handle));
+    CHK(glPixelStorei(GL_PACK_ALIGNMENT, 1));
     CHK(glGetTexImage(GL_TEXTURE_2D, 0, pixel_format_gl, component_format_gl, data));
 
     if (m_flags & (uint8_t) TextureFlags::RenderTarget) {
+        /* Swap rows in place, a single pass that the compiler vectorizes */
         size_t stride = bytes_per_pixel() * m_size.x();
-        std::unique_ptr<uint8_t[]> temp(new uint8_t[stride]);
-
         uint8_t *low = (uint8_t *) data,
                 *high = low + (m_size.y() - 1) * stride;
 
-        for (; low < high; low += stride, high -= stride) {
-            memcpy(temp.get(), low, stride);
-            memcpy(low, high, stride);
-            memcpy(high, temp.get(), stride);
-        }
+        for (; low < high; low += stride, high -= stride)
+            std::swap_ranges(low, low + stride, high);
+    }
+#endif
+}
+
+ref<TextureTransfer> Texture::download_async() {
+#if defined(NANOGUI_USE_GLES)
+    throw std::runtime_error("Texture::download_async(): not supported on GLES!");
+#else
+    if (m_texture_handle == 0)
+        throw std::runtime_error("Texture::download_async(): no texture handle!");
+    else if (m_samples > 1)
+        throw std::runtime_error("Texture::download_async(): only implemented for samples=1!");
+
+    GLenum pixel_format_gl,
+           component_format_gl,
+           internal_format_gl;
+
+    gl_map_texture_format(m_pixel_format,
+                          m_component_format,
+                          pixel_format_gl,
+                          component_format_gl,
+                          internal_format_gl);
+
+    (void) internal_format_gl;
+
+    ref<TextureTransfer> transfer = next_transfer(m_download_ring, m_download_index, true,
+                                                  "download_async");
+    size_t bytes = bytes_per_pixel() * (size_t) m_size.x() * (size_t) m_size.y();
+
+    if (transfer->m_buffer == 0)
+        CHK(glGenBuffers(1, &transfer->m_buffer));
+    CHK(glBindBuffer(GL_PIXEL_PACK_BUFFER, transfer->m_buffer));
+    if (bytes > transfer->m_capacity) {
+        CHK(glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr) bytes, nullptr, GL_STREAM_READ));
+        transfer->m_capacity = bytes;
     }
+
+    /* Writes into the bound pixel buffer object, returns without waiting */
+    CHK(glBindTexture(GL_TEXTURE_2D, m_texture_handle));
+    CHK(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+    CHK(glGetTexImage(GL_TEXTURE_2D, 0, pixel_format_gl, component_format_gl, nullptr));
+    CHK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    if (transfer->m_fence)
+        CHK(glDeleteSync((GLsync) transfer->m_fence));
+    transfer->m_fence = (void *) glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    /* Make sure that the commands reach the GPU before the caller polls */
+    CHK(glFlush());
+
+    transfer->m_origin = Vector2i(0);
+    transfer->m_size = m_size;
+    transfer->m_bytes = bytes;
+    transfer->m_state = TextureTransfer::State::Pending;
+    return transfer;
+#endif
+}
+
+void Texture::finish_download(TextureTransfer *transfer, uint8_t *data) {
+#if defined(NANOGUI_USE_GLES)
+    (void) transfer; (void) data;
+    throw std::runtime_error("Texture::finish_download(): not supported on GLES!");
+#else
+    if (transfer->m_texture != this || !transfer->m_download)
+        throw std::runtime_error(
+            "Texture::finish_download(): transfer was not started by download_async()!");
+
+    transfer->wait();
+
+    CHK(glBindBuffer(GL_PIXEL_PACK_BUFFER, transfer->m_buffer));
+    const uint8_t *src = (const uint8_t *) glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr) transfer->m_bytes, GL_MAP_READ_BIT);
+    if (!src) {
+        CHK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+        throw std::runtime_error("Texture::finish_download(): could not map the staging buffer!");
+    }
+
+    copy_rows(data, src, bytes_per_pixel() * (size_t) transfer->m_size.x(),
+              (size_t) transfer->m_size.y(),
+              m_flags & (uint8_t) TextureFlags::RenderTarget);
+
+    CHK(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    CHK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
 #endif
 }
 
@@ -86,7 +86,11 @@ void Texture::upload(const uint8_t *data) {
         generate_mipmap();
 }
 
-void Texture::upload_sub_region(const uint8_t *data, const Vector2i& origin, const Vector2i& size) {
+void Texture::upload_sub_region(const uint8_t *data, const Vector2i& origin, const Vector2i& size,
+                                size_t row_stride, const Vector2i &source_origin) {
+    data = source_region("Texture::upload_sub_region()", data, size, row_stride,
+                         source_origin);
+
     id<MTLTexture> texture = (__bridge id<MTLTexture>) m_texture_handle;
 
     MTLTextureDescriptor *texture_desc =
@@ -104,7 +108,7 @@ void Texture::upload_sub_region(const uint8_t *data, const Vector2i& origin, con
     [temp_texture replaceRegion: MTLRegionMake2D(0, 0, (NSUInteger) size.x(), (NSUInteger) size.y())
                   mipmapLevel: 0
                   withBytes: data
-                  bytesPerRow: (NSUInteger) (bytes_per_pixel() * size.x())];
+                  bytesPerRow: (NSUInteger) row_stride];
 
     [command_encoder
                  copyFromTexture: temp_texture
@@ -125,6 +129,95 @@ void Texture::upload_sub_region(const uint8_t *data, const Vector2i& origin, con
         generate_mipmap();
 }
 
+void Texture::map_upload(TextureTransfer *transfer, size_t bytes) {
+    if (bytes > transfer->m_capacity) {
+        if (transfer->m_buffer)
+            (void) (__bridge_transfer id<MTLBuffer>) transfer->m_buffer;
+        id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+        id<MTLBuffer> buffer =
+            [device newBufferWithLength: bytes
+                                options: MTLResourceStorageModeShared];
+        transfer->m_buffer = (__bridge_retained void *) buffer;
+        transfer->m_capacity = bytes;
+    }
+
+    id<MTLBuffer> buffer = (__bridge id<MTLBuffer>) transfer->m_buffer;
+    transfer->m_data = (uint8_t *) buffer.contents;
+    transfer->m_bytes = bytes;
+    transfer->m_state = TextureTransfer::State::Mapped;
+}
+
+void Texture::submit_upload(TextureTransfer *transfer) {
+    if (transfer->m_texture != this || transfer->m_download ||
+        transfer->m_state != TextureTransfer::State::Mapped)
+        throw std::runtime_error(
+            "Texture::submit_upload(): transfer was not started by begin_upload()!");
+
+    const Vector2i &origin = transfer->m_origin,
+                   &size   = transfer->m_size;
+
+    id<MTLCommandQueue> command_queue = (__bridge id<MTLCommandQueue>) metal_command_queue();
+    id<MTLCommandBuffer> command_buffer = [command_queue commandBuffer];
+    id<MTLBlitCommandEncoder> command_encoder = [command_buffer blitCommandEncoder];
+    id<MTLTexture> texture = (__bridge id<MTLTexture>) m_texture_handle;
+    id<MTLBuffer> buffer = (__bridge id<MTLBuffer>) transfer->m_buffer;
+
+    [command_encoder
+                 copyFromBuffer: buffer
+                   sourceOffset: 0
+              sourceBytesPerRow: (NSUInteger) (bytes_per_pixel() * size.x())
+            sourceBytesPerImage: (NSUInteger) transfer->m_bytes
+                     sourceSize: MTLSizeMake((NSUInteger) size.x(), (NSUInteger) size.y(), 1)
+                      toTexture: texture
+               destinationSlice: 0
+               destinationLevel: 0
+              destinationOrigin: MTLOriginMake((NSUInteger) origin.x(), (NSUInteger) origin.y(), 0)];
+
+    [command_encoder endEncoding];
+    [command_buffer commit];
+
+    /* Command buffers of a queue execute in order, no need to wait here */
+    if (transfer->m_command_buffer)
+        (void) (__bridge_transfer id<MTLCommandBuffer>) transfer->m_command_buffer;
+    transfer->m_command_buffer = (__bridge_retained void *) command_buffer;
+    transfer->m_data = nullptr;
+    transfer->m_state = TextureTransfer::State::Pending;
+
+    if (!m_mipmap_manual && m_min_interpolation_mode == InterpolationMode::Trilinear)
+        generate_mipmap();
+}
+
+TextureTransfer::~TextureTransfer() {
+    if (m_command_buffer)
+        (void) (__bridge_transfer id<MTLCommandBuffer>) m_command_buffer;
+    if (m_buffer)
+        (void) (__bridge_transfer id<MTLBuffer>) m_buffer;
+}
+
+bool TextureTransfer::ready() {
+    if (m_state != State::Pending)
+        return m_state == State::Idle;
+
+    id<MTLCommandBuffer> command_buffer = (__bridge id<MTLCommandBuffer>) m_command_buffer;
+    if (command_buffer.status != MTLCommandBufferStatusCompleted &&
+        command_buffer.status != MTLCommandBufferStatusError)
+        return false;
+
+    m_state = State::Idle;
+    return true;
+}
+
+void TextureTransfer::wait() {
+    if (m_state == State::Mapped)
+        throw std::runtime_error("TextureTransfer::wait(): transfer was not submitted!");
+    else if (m_state == State::Idle)
+        return;
+
+    id<MTLCommandBuffer> command_buffer = (__bridge id<MTLCommandBuffer>) m_command_buffer;
+    [command_buffer waitUntilCompleted];
+    m_state = State::Idle;
+}
+
 void Texture::download(uint8_t *data) {
     id<MTLCommandQueue> command_queue =
         (__bridge id<MTLCommandQueue>) metal_command_queue();
@@ -158,6 +251,66 @@ void Texture::download(uint8_t *data) {
     memcpy(data, buffer.contents, img_bytes);
 }
 
+ref<TextureTransfer> Texture::download_async() {
+    ref<TextureTransfer> transfer = next_transfer(m_download_ring, m_download_index, true,
+                                                  "download_async");
+
+    size_t row_bytes = bytes_per_pixel() * m_size.x(),
+           img_bytes = row_bytes * m_size.y();
+
+    id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+    if (img_bytes > transfer->m_capacity) {
+        if (transfer->m_buffer)
+            (void) (__bridge_transfer id<MTLBuffer>) transfer->m_buffer;
+        id<MTLBuffer> buffer =
+            [device newBufferWithLength: img_bytes
+                                options: MTLResourceStorageModeShared];
+        transfer->m_buffer = (__bridge_retained void *) buffer;
+        transfer->m_capacity = img_bytes;
+    }
+
+    id<MTLCommandQueue> command_queue =
+        (__bridge id<MTLCommandQueue>) metal_command_queue();
+    id<MTLCommandBuffer> command_buffer = [command_queue commandBuffer];
+    id<MTLBlitCommandEncoder> command_encoder =
+        [command_buffer blitCommandEncoder];
+    id<MTLTexture> texture = (__bridge id<MTLTexture>) m_texture_handle;
+    id<MTLBuffer> buffer = (__bridge id<MTLBuffer>) transfer->m_buffer;
+
+    [command_encoder
+                 copyFromTexture: texture
+                     sourceSlice: 0
+                     sourceLevel: 0
+                    sourceOrigin: MTLOriginMake(0, 0, 0)
+                      sourceSize: MTLSizeMake(texture.width, texture.height, 1)
+                        toBuffer: buffer
+               destinationOffset: 0
+          destinationBytesPerRow: row_bytes
+        destinationBytesPerImage: img_bytes];
+
+    [command_encoder endEncoding];
+    [command_buffer commit];
+
+    if (transfer->m_command_buffer)
+        (void) (__bridge_transfer id<MTLCommandBuffer>) transfer->m_command_buffer;
+    transfer->m_command_buffer = (__bridge_retained void *) command_buffer;
+    transfer->m_origin = Vector2i(0);
+    transfer->m_size = m_size;
+    transfer->m_bytes = img_bytes;
+    transfer->m_state = TextureTransfer::State::Pending;
+    return transfer;
+}
+
+void Texture::finish_download(TextureTransfer *transfer, uint8_t *data) {
+    if (transfer->m_texture != this || !transfer->m_download)
+        throw std::runtime_error(
+            "Texture::finish_download(): transfer was not started by download_async()!");
+
+    transfer->wait();
+    id<MTLBuffer> buffer = (__bridge id<MTLBuffer>) transfer->m_buffer;
+    memcpy(data, buffer.contents, transfer->m_bytes);
+}
+
 void Texture::resize(const Vector2i &size) {
     if (m_size == size)
         return;
@@ -299,6 +452,7 @@ void Texture::resize(const Vector2i &size) {
 
     id<MTLTexture> texture = [device newTextureWithDescriptor:texture_desc];
     m_texture_handle = (__bridge_retained void *) texture;
+    count_allocation();
 }
 
 void Texture::generate_mipmap() {
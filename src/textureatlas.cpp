@@ -0,0 +1,245 @@
+/*
+    src/textureatlas.cpp -- Packs small images into shared texture pages
+    that can be drawn using NanoVG
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/textureatlas.h>
+#include <nanogui/opengl.h>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <memory>
+
+#if defined(NANOGUI_USE_OPENGL)
+#  define NANOVG_GL3
+#  include <nanovg_gl.h>
+#elif defined(NANOGUI_USE_GLES)
+#  define NANOVG_GLES2
+#  include <nanovg_gl.h>
+#elif defined(NANOGUI_USE_METAL)
+#  include <nanovg_mtl.h>
+#endif
+
+NAMESPACE_BEGIN(nanogui)
+
+int nvg_texture_image(NVGcontext *ctx, Texture *texture) {
+    if (texture->pixel_format() != Texture::PixelFormat::RGBA ||
+        texture->component_format() != Texture::ComponentFormat::UInt8)
+        throw std::runtime_error("nvg_texture_image(): expected an RGBA8 texture!");
+
+    const Vector2i &size = texture->size();
+    int image = 0;
+#if defined(NANOGUI_USE_OPENGL)
+    image = nvglCreateImageFromHandleGL3(ctx, texture->texture_handle(),
+                                         size.x(), size.y(), NVG_IMAGE_NODELETE);
+#elif defined(NANOGUI_USE_GLES)
+    image = nvglCreateImageFromHandleGLES2(ctx, texture->texture_handle(),
+                                           size.x(), size.y(), NVG_IMAGE_NODELETE);
+#elif defined(NANOGUI_USE_METAL)
+    image = mnvgCreateImageFromHandle(ctx, texture->texture_handle(),
+                                      size.x(), size.y());
+#endif
+
+    if (image == 0)
+        throw std::runtime_error("nvg_texture_image(): could not create NanoVG image!");
+    return image;
+}
+
+TextureAtlas::TextureAtlas(const Vector2i &page_size, size_t max_pages, int padding)
+    : m_page_size(page_size), m_max_pages(max_pages), m_padding(padding) {
+    if (page_size.x() <= 0 || page_size.y() <= 0 || padding < 0)
+        throw std::runtime_error("TextureAtlas::TextureAtlas(): invalid page size or padding!");
+}
+
+TextureAtlas::~TextureAtlas() {
+    for (const Page &page : m_pages)
+        nvgDeleteImage(m_nvg_context, page.image);
+}
+
+void TextureAtlas::add_page(NVGcontext *ctx) {
+    Page page;
+    page.texture = new Texture(
+        Texture::PixelFormat::RGBA,
+        Texture::ComponentFormat::UInt8,
+        m_page_size,
+        Texture::InterpolationMode::Bilinear,
+        Texture::InterpolationMode::Bilinear,
+        Texture::WrapMode::ClampToEdge
+    );
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+    /* Allocate storage, entries are filled in using upload_sub_region() */
+    page.texture->upload(nullptr);
+#endif
+    page.image = nvg_texture_image(ctx, page.texture);
+    m_nvg_context = ctx;
+    page.skyline.push_back(Node { 0, 0, m_page_size.x() });
+    page.last_use = m_use_count;
+    m_pages.push_back(std::move(page));
+}
+
+void TextureAtlas::clear_page(Page &page) {
+    for (int id : page.entries)
+        m_entries.erase(id);
+    page.entries.clear();
+    page.skyline.clear();
+    page.skyline.push_back(Node { 0, 0, m_page_size.x() });
+}
+
+bool TextureAtlas::pack(Page &page, const Vector2i &page_size, const Vector2i &size,
+                        Vector2i &origin) {
+    std::vector<Node> &nodes = page.skyline;
+    int best_index = -1, best_bottom = INT_MAX, best_width = INT_MAX;
+
+    /* Bottom-left heuristic: lowest resulting top edge, then narrowest segment */
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        int x = nodes[i].x;
+        if (x + size.x() > page_size.x())
+            continue;
+
+        /* Rest on the highest segment covered by the rectangle */
+        int y = nodes[i].y, remaining = size.x();
+        size_t j = i;
+        while (remaining > 0 && j < nodes.size()) {
+            y = std::max(y, nodes[j].y);
+            remaining -= nodes[j].width;
+            ++j;
+        }
+        if (remaining > 0 || y + size.y() > page_size.y())
+            continue;
+
+        if (y + size.y() < best_bottom ||
+            (y + size.y() == best_bottom && nodes[i].width < best_width)) {
+            best_index = (int) i;
+            best_bottom = y + size.y();
+            best_width = nodes[i].width;
+            origin = Vector2i(x, y);
+        }
+    }
+
+    if (best_index < 0)
+        return false;
+
+    /* Insert the new segment and shrink or remove the ones it covers */
+    nodes.insert(nodes.begin() + best_index,
+                 Node { origin.x(), origin.y() + size.y(), size.x() });
+    for (size_t i = best_index + 1; i < nodes.size(); ) {
+        int overlap = nodes[i - 1].x + nodes[i - 1].width - nodes[i].x;
+        if (overlap <= 0)
+            break;
+        nodes[i].x += overlap;
+        nodes[i].width -= overlap;
+        if (nodes[i].width > 0)
+            break;
+        nodes.erase(nodes.begin() + i);
+    }
+
+    /* Merge neighboring segments of equal height */
+    for (size_t i = 0; i + 1 < nodes.size(); ) {
+        if (nodes[i].y == nodes[i + 1].y) {
+            nodes[i].width += nodes[i + 1].width;
+            nodes.erase(nodes.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+int TextureAtlas::add(NVGcontext *ctx, const uint8_t *rgba, const Vector2i &size) {
+    Vector2i padded = size + 2 * m_padding;
+    if (size.x() <= 0 || size.y() <= 0 ||
+        padded.x() > m_page_size.x() || padded.y() > m_page_size.y())
+        throw std::runtime_error("TextureAtlas::add(): image does not fit into an atlas page!");
+
+    Vector2i origin;
+    int page_index = -1;
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        if (pack(m_pages[i], m_page_size, padded, origin)) {
+            page_index = (int) i;
+            break;
+        }
+    }
+
+    if (page_index < 0) {
+        if (m_max_pages == 0 || m_pages.size() < m_max_pages) {
+            add_page(ctx);
+            page_index = (int) m_pages.size() - 1;
+        } else if (m_eviction) {
+            auto lru = std::min_element(m_pages.begin(), m_pages.end(),
+                [](const Page &a, const Page &b) { return a.last_use < b.last_use; });
+            clear_page(*lru);
+            page_index = (int) (lru - m_pages.begin());
+            m_eviction_count++;
+        } else {
+            return -1;
+        }
+
+        if (!pack(m_pages[page_index], m_page_size, padded, origin))
+            throw std::runtime_error("TextureAtlas::add(): internal error!");
+    }
+
+    /* Upload the image along with a border that replicates its edge pixels,
+       so that bilinear lookups at the edges don't blend in transparent black */
+    Page &page = m_pages[page_index];
+    if (m_padding > 0) {
+        std::unique_ptr<uint8_t[]> buf(new uint8_t[(size_t) padded.x() * padded.y() * 4]);
+        for (int y = 0; y < padded.y(); ++y) {
+            int sy = std::min(std::max(y - m_padding, 0), size.y() - 1);
+            const uint8_t *src = rgba + (size_t) sy * size.x() * 4;
+            uint8_t *dst = buf.get() + (size_t) y * padded.x() * 4;
+
+            for (int x = 0; x < m_padding; ++x) {
+                memcpy(dst + x * 4, src, 4);
+                memcpy(dst + (size_t) (m_padding + size.x() + x) * 4,
+                       src + (size_t) (size.x() - 1) * 4, 4);
+            }
+            memcpy(dst + (size_t) m_padding * 4, src, (size_t) size.x() * 4);
+        }
+        page.texture->upload_sub_region(buf.get(), origin, padded);
+    } else {
+        page.texture->upload_sub_region(rgba, origin, size);
+    }
+
+    int id = m_next_id++;
+    m_entries[id] = Entry { page.image, page_index, origin + m_padding, size };
+    page.entries.push_back(id);
+    page.last_use = ++m_use_count;
+    return id;
+}
+
+bool TextureAtlas::lookup(int id, Entry &entry) {
+    auto it = m_entries.find(id);
+    if (it == m_entries.end())
+        return false;
+    entry = it->second;
+    m_pages[entry.page].last_use = ++m_use_count;
+    return true;
+}
+
+void TextureAtlas::remove(int id) {
+    auto it = m_entries.find(id);
+    if (it == m_entries.end())
+        return;
+    std::vector<int> &entries = m_pages[it->second.page].entries;
+    entries.erase(std::find(entries.begin(), entries.end(), id));
+    m_entries.erase(it);
+}
+
+NVGpaint TextureAtlas::pattern(NVGcontext *ctx, const Entry &entry, float x, float y,
+                               float w, float h, float alpha) const {
+    /* Scale and offset the page so that the entry covers the rectangle */
+    float sx = w / entry.size.x(), sy = h / entry.size.y();
+    return nvgImagePattern(ctx, x - entry.origin.x() * sx, y - entry.origin.y() * sy,
+                           m_page_size.x() * sx, m_page_size.y() * sy, 0.f,
+                           entry.image, alpha);
+}
+
+NAMESPACE_END(nanogui)
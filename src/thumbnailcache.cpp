@@ -0,0 +1,422 @@
+/*
+    src/thumbnailcache.cpp -- Generates image thumbnails using background
+    threads and packs them into atlas textures
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/thumbnailcache.h>
+#include <nanogui/textureatlas.h>
+#include <nanogui/opengl.h>
+#include <stb_image.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define NANOGUI_THUMBNAIL_SSE2
+#elif defined(__ARM_NEON)
+#  include <arm_neon.h>
+#  define NANOGUI_THUMBNAIL_NEON
+#endif
+
+NAMESPACE_BEGIN(nanogui)
+
+/// Header of thumbnails stored in the disk cache (followed by the RGBA pixels)
+struct ThumbnailHeader {
+    char magic[4];
+    uint32_t resolution;
+};
+
+static const char thumbnail_magic[4] = { 'N', 'G', 'T', '1' };
+
+/// Add the channels of \c count consecutive RGBA pixels to \c acc
+static void accumulate_span(const uint8_t *rgba, int count, uint32_t *acc) {
+    int i = 0;
+
+#if defined(NANOGUI_THUMBNAIL_SSE2) || defined(NANOGUI_THUMBNAIL_NEON)
+    /* Two pixels per step, summed in 16 bit lanes for up to 256 steps */
+#  if defined(NANOGUI_THUMBNAIL_SSE2)
+    __m128i zero = _mm_setzero_si128(), sum32 = zero;
+#  else
+    uint32x4_t sum32 = vdupq_n_u32(0);
+#  endif
+
+    while (i + 2 <= count) {
+        int steps = std::min((count - i) / 2, 256);
+#  if defined(NANOGUI_THUMBNAIL_SSE2)
+        __m128i sum16 = zero;
+        for (int j = 0; j < steps; ++j, i += 2) {
+            __m128i px = _mm_loadl_epi64((const __m128i *) (rgba + i * 4));
+            sum16 = _mm_add_epi16(sum16, _mm_unpacklo_epi8(px, zero));
+        }
+        sum32 = _mm_add_epi32(sum32, _mm_add_epi32(_mm_unpacklo_epi16(sum16, zero),
+                                                   _mm_unpackhi_epi16(sum16, zero)));
+#  else
+        uint16x8_t sum16 = vdupq_n_u16(0);
+        for (int j = 0; j < steps; ++j, i += 2)
+            sum16 = vaddw_u8(sum16, vld1_u8(rgba + i * 4));
+        sum32 = vaddq_u32(sum32, vaddl_u16(vget_low_u16(sum16), vget_high_u16(sum16)));
+#  endif
+    }
+
+    uint32_t partial[4];
+#  if defined(NANOGUI_THUMBNAIL_SSE2)
+    _mm_storeu_si128((__m128i *) partial, sum32);
+#  else
+    vst1q_u32(partial, sum32);
+#  endif
+    for (int c = 0; c < 4; ++c)
+        acc[c] += partial[c];
+#endif
+
+    for (; i < count; ++i)
+        for (int c = 0; c < 4; ++c)
+            acc[c] += rgba[i * 4 + c];
+}
+
+void ThumbnailCache::downsample(const uint8_t *rgba, const Vector2i &size,
+                                int resolution, uint8_t *out) {
+    int extent = std::min(size.x(), size.y());
+    Vector2i offset = (size - extent) / 2;
+
+    /* Source pixels [bounds[i], bounds[i + 1]) map to output pixel i */
+    std::vector<int> bounds(resolution + 1);
+    for (int i = 0; i <= resolution; ++i)
+        bounds[i] = (int) ((int64_t) i * extent / resolution);
+
+    std::vector<uint32_t> acc((size_t) resolution * 4);
+    for (int y = 0; y < resolution; ++y) {
+        int y0 = bounds[y], y1 = std::max(bounds[y + 1], y0 + 1);
+        std::fill(acc.begin(), acc.end(), 0u);
+
+        for (int sy = y0; sy < y1; ++sy) {
+            const uint8_t *row =
+                rgba + ((size_t) (offset.y() + sy) * size.x() + offset.x()) * 4;
+            for (int x = 0; x < resolution; ++x) {
+                int x0 = bounds[x], x1 = std::max(bounds[x + 1], x0 + 1);
+                accumulate_span(row + (size_t) x0 * 4, x1 - x0, acc.data() + x * 4);
+            }
+        }
+
+        uint8_t *out_row = out + (size_t) y * resolution * 4;
+        for (int x = 0; x < resolution; ++x) {
+            int x0 = bounds[x], x1 = std::max(bounds[x + 1], x0 + 1);
+            uint32_t count = (uint32_t) ((x1 - x0) * (y1 - y0));
+            for (int c = 0; c < 4; ++c)
+                out_row[x * 4 + c] = (uint8_t) ((acc[x * 4 + c] + count / 2) / count);
+        }
+    }
+}
+
+/// 64-bit FNV-1a hash of the file contents, used to key the disk cache
+static uint64_t content_hash(const std::vector<uint8_t> &data) {
+    uint64_t hash = 14695981039346656037ull;
+    for (uint8_t value : data) {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static bool read_file(const std::string &filename, std::vector<uint8_t> &data) {
+    FILE *f = fopen(filename.c_str(), "rb");
+    if (!f)
+        return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    bool success = size > 0;
+    if (success) {
+        data.resize((size_t) size);
+        success = fread(data.data(), 1, data.size(), f) == data.size();
+    }
+    fclose(f);
+    return success;
+}
+
+ThumbnailCache::ThumbnailCache(int resolution, size_t capacity,
+                               const std::string &cache_directory, size_t threads)
+    : m_resolution(resolution), m_capacity(capacity),
+      m_cache_directory(cache_directory) {
+    if (resolution <= 0)
+        throw std::runtime_error("ThumbnailCache::ThumbnailCache(): resolution must be positive!");
+    if (capacity == 0)
+        throw std::runtime_error("ThumbnailCache::ThumbnailCache(): capacity must be positive!");
+
+    /* Atlas pages of roughly 2048x2048 pixels */
+    m_page_slots = std::max(1, 2048 / resolution);
+
+    if (threads == 0)
+        threads = std::min(4u, std::max(1u, std::thread::hardware_concurrency() / 2));
+
+    for (size_t i = 0; i < threads; ++i)
+        m_workers.emplace_back([this]() { worker(); });
+}
+
+ThumbnailCache::~ThumbnailCache() {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_shutdown = true;
+    }
+    m_cv.notify_all();
+    for (std::thread &t : m_workers)
+        t.join();
+
+    for (const Page &page : m_pages)
+        nvgDeleteImage(m_nvg_context, page.nvg_image);
+}
+
+void ThumbnailCache::set_capacity(size_t capacity) {
+    if (capacity == 0)
+        throw std::runtime_error("ThumbnailCache::set_capacity(): capacity must be positive!");
+    m_capacity = capacity;
+}
+
+void ThumbnailCache::set_callback(const Callback &callback) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_callback = callback;
+}
+
+bool ThumbnailCache::generate(const std::string &filename, uint8_t *out, bool &disk_hit) {
+    std::vector<uint8_t> data;
+    if (!read_file(filename, data))
+        return false;
+
+    size_t out_size = (size_t) m_resolution * (size_t) m_resolution * 4;
+    std::string cache_file;
+    disk_hit = false;
+
+    if (!m_cache_directory.empty()) {
+        char name[64];
+        snprintf(name, sizeof(name), "/%016llx-%i.thumb",
+                 (unsigned long long) content_hash(data), m_resolution);
+        cache_file = m_cache_directory + name;
+
+        FILE *f = fopen(cache_file.c_str(), "rb");
+        if (f) {
+            ThumbnailHeader header;
+            disk_hit = fread(&header, sizeof(header), 1, f) == 1 &&
+                       memcmp(header.magic, thumbnail_magic, 4) == 0 &&
+                       header.resolution == (uint32_t) m_resolution &&
+                       fread(out, 1, out_size, f) == out_size;
+            fclose(f);
+            if (disk_hit)
+                return true;
+        }
+    }
+
+    int w = 0, h = 0, n = 0;
+    uint8_t *pixels = stbi_load_from_memory(data.data(), (int) data.size(),
+                                            &w, &h, &n, 4);
+    if (!pixels)
+        return false;
+    downsample(pixels, Vector2i(w, h), m_resolution, out);
+    stbi_image_free(pixels);
+
+    if (!cache_file.empty()) {
+        /* Write to a temporary file first so that other processes never
+           observe partially written thumbnails */
+        std::string tmp_file = __nanogui_temporary_filename(cache_file);
+        FILE *f = fopen(tmp_file.c_str(), "wb");
+        if (f) {
+            ThumbnailHeader header;
+            memcpy(header.magic, thumbnail_magic, 4);
+            header.resolution = (uint32_t) m_resolution;
+            bool success = fwrite(&header, sizeof(header), 1, f) == 1 &&
+                           fwrite(out, 1, out_size, f) == out_size;
+            success &= fclose(f) == 0;
+            if (!success || std::rename(tmp_file.c_str(), cache_file.c_str()) != 0)
+                std::remove(tmp_file.c_str());
+        }
+    }
+
+    return true;
+}
+
+void ThumbnailCache::worker() {
+    size_t out_size = (size_t) m_resolution * (size_t) m_resolution * 4;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this]() { return m_shutdown || !m_queue.empty(); });
+        if (m_shutdown)
+            break;
+
+        /* Most recent requests first */
+        std::string filename = std::move(m_queue.back());
+        m_queue.pop_back();
+
+        auto it = m_requests.find(filename);
+        if (it == m_requests.end())
+            continue;
+
+        /* Skip thumbnails that were not requested in the previous frame */
+        if (it->second.frame + 1 < m_frame) {
+            m_requests.erase(it);
+            continue;
+        }
+
+        m_in_flight++;
+        lock.unlock();
+
+        std::unique_ptr<uint8_t[]> pixels(new uint8_t[out_size]);
+        bool disk_hit = false;
+        if (!generate(filename, pixels.get(), disk_hit))
+            pixels.reset();
+
+        lock.lock();
+        m_in_flight--;
+        m_loaded.push_back(Loaded { std::move(filename), std::move(pixels), disk_hit });
+
+        if (m_callback) {
+            Callback callback = m_callback;
+            lock.unlock();
+            callback();
+            lock.lock();
+        }
+    }
+}
+
+int ThumbnailCache::allocate_slot(NVGcontext *ctx) {
+    if (!m_free_slots.empty()) {
+        int slot = m_free_slots.back();
+        m_free_slots.pop_back();
+        return slot;
+    }
+
+    if (m_slot_count >= m_capacity && !m_resident.empty()) {
+        /* Evict the least recently used thumbnail */
+        Resident &lru = m_resident.back();
+        int slot = lru.slot;
+        m_resident_lookup.erase(lru.filename);
+        m_resident.pop_back();
+        m_eviction_count++;
+        return slot;
+    }
+
+    size_t slots_per_page = (size_t) m_page_slots * (size_t) m_page_slots;
+    int slot = (int) m_slot_count++;
+
+    if ((size_t) slot / slots_per_page == m_pages.size()) {
+        Vector2i size = page_size();
+
+        /* Thumbnails are drawn at their native resolution */
+        Page page;
+        page.texture = new Texture(
+            Texture::PixelFormat::RGBA,
+            Texture::ComponentFormat::UInt8,
+            size,
+            Texture::InterpolationMode::Nearest,
+            Texture::InterpolationMode::Nearest,
+            Texture::WrapMode::ClampToEdge
+        );
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+        page.texture->upload(nullptr);
+#endif
+        page.nvg_image = nvg_texture_image(ctx, page.texture);
+        m_nvg_context = ctx;
+        m_pages.push_back(page);
+    }
+
+    return slot;
+}
+
+bool ThumbnailCache::begin_frame(NVGcontext *ctx) {
+    std::vector<Loaded> loaded;
+    bool pending;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_frame++;
+
+        size_t count = std::min(m_loaded.size(), m_upload_limit);
+        for (size_t i = 0; i < count; ++i) {
+            loaded.push_back(std::move(m_loaded.back()));
+            m_loaded.pop_back();
+        }
+
+        pending = !m_queue.empty() || m_in_flight > 0 || !m_loaded.empty();
+    }
+
+    size_t slots_per_page = (size_t) m_page_slots * (size_t) m_page_slots;
+    for (Loaded &thumb : loaded) {
+        if (!thumb.pixels) {
+            m_failed.insert(thumb.filename);
+            continue;
+        }
+        if (m_resident_lookup.find(thumb.filename) != m_resident_lookup.end())
+            continue;
+
+        int slot = allocate_slot(ctx),
+            index = (int) (slot % slots_per_page);
+        Vector2i origin(index % m_page_slots, index / m_page_slots);
+        m_pages[slot / slots_per_page].texture->upload_sub_region(
+            thumb.pixels.get(), origin * m_resolution, Vector2i(m_resolution));
+
+        m_resident.push_front(Resident { thumb.filename, slot });
+        m_resident_lookup[thumb.filename] = m_resident.begin();
+        m_load_count++;
+        if (thumb.disk_hit)
+            m_disk_hit_count++;
+    }
+
+    if (!loaded.empty()) {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        for (Loaded &thumb : loaded)
+            m_requests.erase(thumb.filename);
+    }
+
+    return pending;
+}
+
+bool ThumbnailCache::lookup(const std::string &filename, bool request, int &image,
+                            Vector2i &origin) {
+    auto it = m_resident_lookup.find(filename);
+    if (it != m_resident_lookup.end()) {
+        m_resident.splice(m_resident.begin(), m_resident, it->second);
+
+        size_t slots_per_page = (size_t) m_page_slots * (size_t) m_page_slots;
+        int slot = it->second->slot,
+            index = (int) (slot % slots_per_page);
+        image = m_pages[slot / slots_per_page].nvg_image;
+        origin = Vector2i(index % m_page_slots, index / m_page_slots) * m_resolution;
+        return true;
+    }
+
+    if (request && m_failed.find(filename) == m_failed.end()) {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto it2 = m_requests.find(filename);
+        if (it2 != m_requests.end()) {
+            it2->second.frame = m_frame;
+        } else {
+            m_requests[filename] = Request { m_frame };
+            m_queue.push_back(filename);
+            m_cv.notify_one();
+        }
+    }
+
+    return false;
+}
+
+void ThumbnailCache::clear() {
+    for (const Resident &resident : m_resident)
+        m_free_slots.push_back(resident.slot);
+    m_resident.clear();
+    m_resident_lookup.clear();
+    m_failed.clear();
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_requests.clear();
+    m_queue.clear();
+    m_loaded.clear();
+}
+
+NAMESPACE_END(nanogui)
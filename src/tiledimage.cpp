@@ -0,0 +1,273 @@
+/*
+    src/tiledimage.cpp -- Multi-resolution tile sources and a GPU tile
+    cache that streams tiles using background threads
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/tiledimage.h>
+#include <nanogui/texture.h>
+#include <stb_image.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+NAMESPACE_BEGIN(nanogui)
+
+int TileSource::level_count() const {
+    int levels = 1;
+    while (tile_count(levels - 1) != Vector2i(1))
+        levels++;
+    return levels;
+}
+
+Vector2i TileSource::level_size(int level) const {
+    Vector2i result = size();
+    for (int i = 0; i < level; ++i)
+        result = (result + 1) / 2;
+    return result;
+}
+
+Vector2i TileSource::tile_count(int level) const {
+    int ts = tile_size();
+    return (level_size(level) + (ts - 1)) / ts;
+}
+
+DirectoryTileSource::DirectoryTileSource(const std::string &directory,
+                                         const Vector2i &size, int tile_size,
+                                         const std::string &extension)
+    : m_directory(directory), m_size(size), m_tile_size(tile_size),
+      m_extension(extension) {
+    if (tile_size <= 0 || size.x() <= 0 || size.y() <= 0)
+        throw std::runtime_error(
+            "DirectoryTileSource::DirectoryTileSource(): invalid image or tile size!");
+}
+
+bool DirectoryTileSource::load_tile(int level, const Vector2i &tile, uint8_t *rgba) {
+    std::string filename = m_directory + "/" + std::to_string(level) + "/" +
+                           std::to_string(tile.x()) + "_" +
+                           std::to_string(tile.y()) + "." + m_extension;
+
+    int w = 0, h = 0, n = 0;
+    uint8_t *data = stbi_load(filename.c_str(), &w, &h, &n, 4);
+    if (!data)
+        return false;
+
+    /* Border tiles may be smaller than the nominal tile size */
+    int rows = std::min(h, m_tile_size),
+        row_size = std::min(w, m_tile_size) * 4;
+    for (int y = 0; y < rows; ++y)
+        memcpy(rgba + (size_t) y * m_tile_size * 4, data + (size_t) y * w * 4,
+               (size_t) row_size);
+
+    stbi_image_free(data);
+    return true;
+}
+
+TileCache::TileCache(TileSource *source, size_t capacity, size_t threads)
+    : m_source(source), m_tile_size(source->tile_size()), m_capacity(capacity) {
+    if (capacity == 0)
+        throw std::runtime_error("TileCache::TileCache(): capacity must be positive!");
+
+    int columns = (int) std::ceil(std::sqrt((double) capacity)),
+        rows = (int) ((capacity + columns - 1) / columns);
+    m_slots = Vector2i(columns, rows);
+
+    m_texture = new Texture(
+        Texture::PixelFormat::RGBA,
+        Texture::ComponentFormat::UInt8,
+        m_slots * m_tile_size,
+        Texture::InterpolationMode::Bilinear,
+        Texture::InterpolationMode::Bilinear,
+        Texture::WrapMode::ClampToEdge
+    );
+
+#if defined(NANOGUI_USE_OPENGL) || defined(NANOGUI_USE_GLES)
+    /* Allocate storage, slots are filled in using upload_sub_region() */
+    m_texture->upload(nullptr);
+#endif
+
+    for (int i = (int) capacity - 1; i >= 0; --i)
+        m_free_slots.push_back(i);
+
+    if (threads == 0)
+        threads = std::min(4u, std::max(1u, std::thread::hardware_concurrency() / 2));
+
+    for (size_t i = 0; i < threads; ++i)
+        m_workers.emplace_back([this]() { worker(); });
+}
+
+TileCache::~TileCache() {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_shutdown = true;
+    }
+    m_cv.notify_all();
+    for (std::thread &t : m_workers)
+        t.join();
+}
+
+void TileCache::set_callback(const Callback &callback) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_callback = callback;
+}
+
+void TileCache::worker() {
+    size_t pixel_count = (size_t) m_tile_size * (size_t) m_tile_size;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this]() { return m_shutdown || !m_queue.empty(); });
+        if (m_shutdown)
+            break;
+
+        /* Most recent requests first */
+        Key key = m_queue.back();
+        m_queue.pop_back();
+
+        auto it = m_requests.find(key);
+        if (it == m_requests.end())
+            continue;
+
+        /* Skip tiles that were not requested in the previous frame */
+        Request request = it->second;
+        if (request.frame + 1 < m_frame) {
+            m_requests.erase(it);
+            continue;
+        }
+
+        m_in_flight++;
+        lock.unlock();
+
+        /* Missing tiles are displayed empty rather than being retried */
+        std::unique_ptr<uint8_t[]> pixels(new uint8_t[pixel_count * 4]());
+        try {
+            m_source->load_tile(request.level, request.tile, pixels.get());
+        } catch (const std::exception &e) {
+            fprintf(stderr, "TileCache::worker(): could not load tile: %s\n", e.what());
+        }
+
+        lock.lock();
+        m_in_flight--;
+        m_loaded.push_back(Loaded { key, std::move(pixels) });
+
+        if (m_callback) {
+            Callback callback = m_callback;
+            lock.unlock();
+            callback();
+            lock.lock();
+        }
+    }
+}
+
+bool TileCache::begin_frame() {
+    std::vector<Loaded> loaded;
+    bool pending;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_frame++;
+
+        /* Discard loaded tiles that were not requested in the previous frame
+           (they left the viewport or belong to another level) */
+        size_t kept = 0;
+        for (size_t i = 0; i < m_loaded.size(); ++i) {
+            auto it = m_requests.find(m_loaded[i].key);
+            if (it == m_requests.end() || it->second.frame + 1 < m_frame) {
+                if (it != m_requests.end())
+                    m_requests.erase(it);
+                continue;
+            }
+            if (kept != i)
+                m_loaded[kept] = std::move(m_loaded[i]);
+            kept++;
+        }
+        m_loaded.erase(m_loaded.begin() + kept, m_loaded.end());
+
+        /* Uploading more tiles than the cache holds would only evict them
+           again, drop the oldest ones */
+        if (m_loaded.size() > m_capacity) {
+            size_t excess = m_loaded.size() - m_capacity;
+            for (size_t i = 0; i < excess; ++i)
+                m_requests.erase(m_loaded[i].key);
+            m_loaded.erase(m_loaded.begin(), m_loaded.begin() + excess);
+        }
+
+        size_t count = std::min(m_loaded.size(), m_upload_limit);
+        for (size_t i = 0; i < count; ++i) {
+            loaded.push_back(std::move(m_loaded.back()));
+            m_loaded.pop_back();
+        }
+
+        pending = !m_queue.empty() || m_in_flight > 0 || !m_loaded.empty();
+    }
+
+    for (Loaded &tile : loaded) {
+        int slot;
+        if (!m_free_slots.empty()) {
+            slot = m_free_slots.back();
+            m_free_slots.pop_back();
+        } else {
+            /* Evict the least recently used tile */
+            Resident &lru = m_resident.back();
+            slot = lru.slot;
+            m_resident_lookup.erase(lru.key);
+            m_resident.pop_back();
+            m_eviction_count++;
+        }
+
+        Vector2i origin(slot % m_slots.x(), slot / m_slots.x());
+        m_texture->upload_sub_region(tile.pixels.get(), origin * m_tile_size,
+                                     Vector2i(m_tile_size));
+
+        m_resident.push_front(Resident { tile.key, slot });
+        m_resident_lookup[tile.key] = m_resident.begin();
+        m_load_count++;
+    }
+
+    if (!loaded.empty()) {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        for (Loaded &tile : loaded)
+            m_requests.erase(tile.key);
+    }
+
+    return pending;
+}
+
+bool TileCache::lookup(int level, const Vector2i &tile, bool request,
+                       Vector2f &uv_min, Vector2f &uv_max) {
+    Key k = key(level, tile);
+
+    auto it = m_resident_lookup.find(k);
+    if (it != m_resident_lookup.end()) {
+        m_resident.splice(m_resident.begin(), m_resident, it->second);
+
+        int slot = it->second->slot;
+        Vector2f scale = 1.f / Vector2f(m_slots);
+        uv_min = Vector2f((float) (slot % m_slots.x()), (float) (slot / m_slots.x())) * scale;
+        uv_max = uv_min + scale;
+        return true;
+    }
+
+    if (request) {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto it2 = m_requests.find(k);
+        if (it2 != m_requests.end()) {
+            it2->second.frame = m_frame;
+        } else {
+            m_requests[k] = Request { level, tile, m_frame };
+            m_queue.push_back(k);
+            m_cv.notify_one();
+        }
+    }
+
+    return false;
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,27 @@
+#include <nanogui/uniformbuffer.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+void UniformBuffer::upload(const void *data, size_t size, size_t offset) {
+    if (offset + size > m_size)
+        throw std::runtime_error("UniformBuffer::upload(): range exceeds the size of the buffer!");
+    write(data, size, offset, false);
+}
+
+size_t UniformBuffer::push(const void *data, size_t size) {
+    if (size > m_size)
+        throw std::runtime_error("UniformBuffer::push(): data exceeds the size of the buffer!");
+
+    size_t offset = (m_head + m_offset_alignment - 1) / m_offset_alignment * m_offset_alignment;
+    if (offset + size > m_size) {
+        orphan();
+        m_orphan_count++;
+        offset = 0;
+    }
+
+    write(data, size, offset, true);
+    m_head = offset + size;
+    return offset;
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,68 @@
+#include <nanogui/uniformbuffer.h>
+#include <nanogui/opengl.h>
+#include "opengl_check.h"
+#include <cstring>
+
+NAMESPACE_BEGIN(nanogui)
+
+#if defined(NANOGUI_USE_OPENGL) || (defined(NANOGUI_USE_GLES) && NANOGUI_GLES_VERSION >= 3)
+
+UniformBuffer::UniformBuffer(size_t size) : m_size(size) {
+    GLint alignment = 0;
+    CHK(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment));
+    if (alignment > 0)
+        m_offset_alignment = (size_t) alignment;
+
+    CHK(glGenBuffers(1, &m_buffer_handle));
+    CHK(glBindBuffer(GL_UNIFORM_BUFFER, m_buffer_handle));
+    CHK(glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr) m_size, nullptr, GL_DYNAMIC_DRAW));
+    CHK(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+}
+
+UniformBuffer::~UniformBuffer() {
+    CHK(glDeleteBuffers(1, &m_buffer_handle));
+}
+
+void UniformBuffer::write(const void *data, size_t size, size_t offset,
+                          bool unsynchronized) {
+    if (size == 0)
+        return;
+
+    CHK(glBindBuffer(GL_UNIFORM_BUFFER, m_buffer_handle));
+    if (unsynchronized) {
+        /* The range is not referenced by any pending draw call */
+        void *ptr = glMapBufferRange(GL_UNIFORM_BUFFER, (GLintptr) offset, (GLsizeiptr) size,
+                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                     GL_MAP_UNSYNCHRONIZED_BIT);
+        if (!ptr)
+            throw std::runtime_error("UniformBuffer::write(): could not map buffer!");
+        memcpy(ptr, data, size);
+        CHK(glUnmapBuffer(GL_UNIFORM_BUFFER));
+    } else {
+        CHK(glBufferSubData(GL_UNIFORM_BUFFER, (GLintptr) offset, (GLsizeiptr) size, data));
+    }
+    CHK(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+}
+
+void UniformBuffer::orphan() {
+    CHK(glBindBuffer(GL_UNIFORM_BUFFER, m_buffer_handle));
+    CHK(glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr) m_size, nullptr, GL_DYNAMIC_DRAW));
+    CHK(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+}
+
+#else
+
+UniformBuffer::UniformBuffer(size_t size) : m_size(size) {
+    throw std::runtime_error("UniformBuffer::UniformBuffer(): uniform buffers "
+                             "require OpenGL 3.3 or OpenGL ES 3!");
+}
+
+UniformBuffer::~UniformBuffer() { }
+
+void UniformBuffer::write(const void *, size_t, size_t, bool) { }
+
+void UniformBuffer::orphan() { }
+
+#endif
+
+NAMESPACE_END(nanogui)
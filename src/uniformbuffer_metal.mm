@@ -0,0 +1,36 @@
+#include <nanogui/uniformbuffer.h>
+#include <nanogui/metal.h>
+
+#import <Metal/Metal.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+UniformBuffer::UniformBuffer(size_t size) : m_size(size) {
+    /* Offsets of constant buffers must be multiples of 256 bytes on macOS */
+    m_offset_alignment = 256;
+    orphan();
+}
+
+UniformBuffer::~UniformBuffer() {
+    (void) (__bridge_transfer id<MTLBuffer>) m_buffer_handle;
+}
+
+void UniformBuffer::write(const void *data, size_t size, size_t offset,
+                          bool /* unsynchronized */) {
+    id<MTLBuffer> buffer = (__bridge id<MTLBuffer>) m_buffer_handle;
+    memcpy((uint8_t *) [buffer contents] + offset, data, size);
+}
+
+void UniformBuffer::orphan() {
+    /* Command buffers retain the previous buffer until they complete */
+    if (m_buffer_handle)
+        (void) (__bridge_transfer id<MTLBuffer>) m_buffer_handle;
+
+    id<MTLDevice> device = (__bridge id<MTLDevice>) metal_device();
+    id<MTLBuffer> buffer =
+        [device newBufferWithLength: m_size
+                            options: MTLResourceStorageModeShared];
+    m_buffer_handle = (__bridge_retained void *) buffer;
+}
+
+NAMESPACE_END(nanogui)
@@ -80,6 +80,28 @@ void Widget::perform_layout(NVGcontext *ctx) {
     }
 }
 
+TextMetrics Widget::measure_text(NVGcontext *ctx, const std::string &font,
+                                 float font_size, int align,
+                                 const std::string &text) const {
+    const Screen *scr = screen();
+    if (scr && scr->text_metrics_cache())
+        return scr->text_metrics_cache()->measure(ctx, font, font_size, align, text);
+
+    TextMetrics metrics;
+    if (TextMetricsService::instance()->measure(font, font_size, align, text,
+                                                1.f, metrics))
+        return metrics;
+
+    nvgSave(ctx);
+    nvgFontFace(ctx, font.c_str());
+    nvgFontSize(ctx, font_size);
+    nvgTextAlign(ctx, align);
+    metrics.advance = nvgTextBounds(ctx, 0.f, 0.f, text.c_str(), nullptr,
+                                    metrics.bounds);
+    nvgRestore(ctx);
+    return metrics;
+}
+
 Widget *Widget::find_widget(const Vector2i &p) {
     for (auto it = m_children.rbegin(); it != m_children.rend(); ++it) {
         Widget *child = *it;
@@ -28,10 +28,9 @@ Vector2i Window::preferred_size(NVGcontext *ctx) const {
     if (m_button_panel)
         m_button_panel->set_visible(true);
 
-    nvgFontSize(ctx, 18.0f);
-    nvgFontFace(ctx, "sans-bold");
-    float bounds[4];
-    nvgTextBounds(ctx, 0, 0, m_title.c_str(), nullptr, bounds);
+    TextMetrics metrics = measure_text(ctx, "sans-bold", 18.f,
+                                       NVG_ALIGN_LEFT | NVG_ALIGN_TOP, m_title);
+    const float *bounds = metrics.bounds;
 
     return Vector2i(
         std::max(result.x(), (int) (bounds[2]-bounds[0] + 20)),